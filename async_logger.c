@@ -0,0 +1,329 @@
+/**
+ * @file async_logger.c
+ * @brief Asynchronous logger implementation
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "async_logger.h"
+#include "clock_ns.h"
+#include "spsc_ring.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+/** How long the drain thread sleeps when every ring is empty */
+#define DRAIN_IDLE_SLEEP_NS 100000L
+
+/**
+ * @brief Binary log record; formatting happens on the drain thread
+ */
+typedef struct {
+    uint64_t timestamp_ns;
+    const char *format;
+    long args[ASYNC_LOG_MAX_ARGS];
+} log_record_t;
+
+/**
+ * @brief One producing thread's ring and identity
+ */
+typedef struct log_producer {
+    spsc_ring_t *ring;
+    char name[ASYNC_LOG_NAME_LENGTH];
+    unsigned long dropped;
+    struct log_producer *next;
+} log_producer_t;
+
+/*============================================================================
+ * GLOBAL AND THREAD-LOCAL STATE
+ *============================================================================*/
+
+static FILE *log_output = NULL;
+static pthread_t drain_thread;
+static int logger_active = 0;
+static unsigned long logger_epoch = 0;
+static unsigned long dropped_total = 0;
+
+/** Producers are only ever prepended, so the drain thread walks the list lock-free */
+static log_producer_t *producer_list = NULL;
+static pthread_mutex_t register_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static __thread log_producer_t *thread_producer = NULL;
+static __thread unsigned long thread_epoch = 0;
+static __thread char thread_name[ASYNC_LOG_NAME_LENGTH];
+
+/*============================================================================
+ * UTILITY FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Name of the calling thread, generating a default if none was set
+ */
+static const char *current_thread_name(void) {
+    if (thread_name[0] == '\0') {
+        snprintf(thread_name, sizeof(thread_name), "thread-%lu",
+                 (unsigned long)pthread_self());
+    }
+    return thread_name;
+}
+
+/**
+ * @brief Format one message with its "[name] " prefix as a single stdio unit
+ */
+static void write_message(FILE *out, const char *name, const char *format, const long *args) {
+    flockfile(out);
+    fprintf(out, "[%s] ", name);
+    fprintf(out, format, args[0], args[1], args[2], args[3]);
+    funlockfile(out);
+}
+
+/**
+ * @brief Create and publish a producer for the calling thread
+ * @return The producer, or NULL on allocation failure
+ */
+static log_producer_t *register_producer(void) {
+    log_producer_t *producer = malloc(sizeof(*producer));
+    if (!producer) {
+        return NULL;
+    }
+
+    producer->ring = spsc_ring_create(ASYNC_LOG_RING_CAPACITY, sizeof(log_record_t));
+    if (!producer->ring) {
+        free(producer);
+        return NULL;
+    }
+    snprintf(producer->name, sizeof(producer->name), "%s", current_thread_name());
+    producer->dropped = 0;
+
+    pthread_mutex_lock(&register_lock);
+    producer->next = producer_list;
+    __atomic_store_n(&producer_list, producer, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&register_lock);
+
+    thread_producer = producer;
+    thread_epoch = __atomic_load_n(&logger_epoch, __ATOMIC_ACQUIRE);
+    return producer;
+}
+
+/**
+ * @brief Producer of the calling thread for the current logger run
+ */
+static log_producer_t *current_producer(void) {
+    if (thread_producer && thread_epoch == __atomic_load_n(&logger_epoch, __ATOMIC_ACQUIRE)) {
+        return thread_producer;
+    }
+    return register_producer();
+}
+
+/*============================================================================
+ * DRAIN THREAD
+ *============================================================================*/
+
+/**
+ * @brief Format every pending record, oldest first across all rings
+ * @return Number of records written
+ */
+static size_t drain_all(FILE *out) {
+    size_t written = 0;
+
+    for (;;) {
+        log_producer_t *oldest = NULL;
+        log_record_t *oldest_record = NULL;
+
+        for (log_producer_t *producer = __atomic_load_n(&producer_list, __ATOMIC_ACQUIRE);
+             producer; producer = producer->next) {
+            log_record_t *record = spsc_ring_front(producer->ring);
+            if (record && (!oldest_record || record->timestamp_ns < oldest_record->timestamp_ns)) {
+                oldest = producer;
+                oldest_record = record;
+            }
+        }
+
+        if (!oldest) {
+            return written;
+        }
+
+        write_message(out, oldest->name, oldest_record->format, oldest_record->args);
+        spsc_ring_pop(oldest->ring);
+        written++;
+    }
+}
+
+/**
+ * @brief Background thread draining the producer rings until stopped
+ */
+static void *drain_thread_function(void *arg) {
+    FILE *out = (FILE *)arg;
+    const struct timespec idle = { 0, DRAIN_IDLE_SLEEP_NS };
+
+    for (;;) {
+        // Sample the flag first so the final pass sees every record
+        int stopping = !__atomic_load_n(&logger_active, __ATOMIC_ACQUIRE);
+
+        if (drain_all(out) == 0) {
+            if (stopping) {
+                break;
+            }
+            fflush(out);
+            nanosleep(&idle, NULL);
+        }
+    }
+
+    fflush(out);
+    return NULL;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Start the background drain thread
+ * @param out Stream that receives the formatted messages
+ * @return 0 on success, otherwise an error number
+ */
+int async_logger_start(FILE *out) {
+    if (!out) {
+        return EINVAL;
+    }
+    if (__atomic_load_n(&logger_active, __ATOMIC_ACQUIRE)) {
+        return EBUSY;
+    }
+
+    log_output = out;
+    dropped_total = 0;
+    __atomic_add_fetch(&logger_epoch, 1, __ATOMIC_ACQ_REL);
+    __atomic_store_n(&logger_active, 1, __ATOMIC_RELEASE);
+
+    int result = pthread_create(&drain_thread, NULL, drain_thread_function, out);
+    if (result != 0) {
+        __atomic_store_n(&logger_active, 0, __ATOMIC_RELEASE);
+        return result;
+    }
+    return 0;
+}
+
+/**
+ * @brief Drain all pending records, stop the drain thread and free the rings
+ * @note Producing threads must have stopped logging (e.g. been joined)
+ */
+void async_logger_stop(void) {
+    if (!__atomic_load_n(&logger_active, __ATOMIC_ACQUIRE)) {
+        return;
+    }
+
+    __atomic_store_n(&logger_active, 0, __ATOMIC_RELEASE);
+    pthread_join(drain_thread, NULL);
+
+    pthread_mutex_lock(&register_lock);
+    log_producer_t *producer = producer_list;
+    producer_list = NULL;
+    pthread_mutex_unlock(&register_lock);
+
+    while (producer) {
+        log_producer_t *next = producer->next;
+        dropped_total += producer->dropped;
+        spsc_ring_destroy(producer->ring);
+        free(producer);
+        producer = next;
+    }
+
+    thread_producer = NULL;
+}
+
+/**
+ * @brief Name the calling thread and create its ring up front
+ * @param name Label printed in front of this thread's messages
+ * @return 0 on success, ENOMEM if the ring could not be allocated
+ *
+ * Optional: unregistered threads get a ring lazily on their first message.
+ * Registering early keeps that allocation out of the hot loop.
+ */
+int async_logger_register_thread(const char *name) {
+    snprintf(thread_name, sizeof(thread_name), "%s", name ? name : "");
+
+    if (!__atomic_load_n(&logger_active, __ATOMIC_ACQUIRE)) {
+        return 0;
+    }
+    return register_producer() ? 0 : ENOMEM;
+}
+
+/**
+ * @brief Queue a message; see ASYNC_LOG() for the convenience wrapper
+ *
+ * Records are dropped (and counted) if the thread's ring is full, so the
+ * caller never blocks on the drain thread.
+ */
+void async_log(const char *format, long arg0, long arg1, long arg2, long arg3) {
+    if (!__atomic_load_n(&logger_active, __ATOMIC_ACQUIRE)) {
+        long args[ASYNC_LOG_MAX_ARGS] = { arg0, arg1, arg2, arg3 };
+        write_message(stdout, current_thread_name(), format, args);
+        return;
+    }
+
+    log_producer_t *producer = current_producer();
+    if (!producer) {
+        long args[ASYNC_LOG_MAX_ARGS] = { arg0, arg1, arg2, arg3 };
+        write_message(log_output, current_thread_name(), format, args);
+        return;
+    }
+
+    log_record_t *record = spsc_ring_reserve(producer->ring);
+    if (!record) {
+        __atomic_add_fetch(&producer->dropped, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    record->timestamp_ns = (uint64_t)now_ns();
+    record->format = format;
+    record->args[0] = arg0;
+    record->args[1] = arg1;
+    record->args[2] = arg2;
+    record->args[3] = arg3;
+    spsc_ring_publish(producer->ring);
+}
+
+/**
+ * @brief Wait until everything the calling thread logged has been written
+ *
+ * Use before switching back to direct stdio output so lines stay in order.
+ */
+void async_log_flush(void) {
+    if (!__atomic_load_n(&logger_active, __ATOMIC_ACQUIRE) || !thread_producer ||
+        thread_epoch != __atomic_load_n(&logger_epoch, __ATOMIC_ACQUIRE)) {
+        return;
+    }
+
+    const struct timespec pause = { 0, DRAIN_IDLE_SLEEP_NS / 2 };
+    while (!spsc_ring_empty(thread_producer->ring)) {
+        nanosleep(&pause, NULL);
+    }
+}
+
+/**
+ * @brief Records dropped because a ring was full
+ * @return Count for the last completed run, or so far in the current run
+ */
+unsigned long async_logger_dropped(void) {
+    if (!__atomic_load_n(&logger_active, __ATOMIC_ACQUIRE)) {
+        return dropped_total;
+    }
+
+    unsigned long dropped = 0;
+    pthread_mutex_lock(&register_lock);
+    for (log_producer_t *producer = producer_list; producer; producer = producer->next) {
+        dropped += __atomic_load_n(&producer->dropped, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&register_lock);
+    return dropped;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file async_logger.h
+ * @brief Asynchronous logger with per-thread lock-free ring buffers
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * Logging from a hot loop with printf() takes the stdio lock and formats the
+ * message on the calling thread. This logger moves both off the hot path:
+ * - Each producing thread owns an SPSC ring of fixed-size binary records
+ *   (timestamp, format pointer, up to ASYNC_LOG_MAX_ARGS integer arguments)
+ * - A background thread drains every ring, merges records by timestamp and
+ *   does the printf-style formatting
+ * - A full ring drops the record and counts it rather than blocking
+ *
+ * Format strings are stored by pointer, so they must be string literals (or
+ * otherwise outlive the logger), and every conversion must consume a long
+ * (%ld, %lx, %lu, ...). Each line is prefixed with "[thread name] ".
+ *
+ * When the logger is not running, messages are formatted synchronously.
+ */
+
+#ifndef ASYNC_LOGGER_H
+#define ASYNC_LOGGER_H
+
+#include <stdio.h>
+
+/*============================================================================
+ * CONSTANTS AND MACROS
+ *============================================================================*/
+
+/** Maximum number of integer arguments per record */
+#define ASYNC_LOG_MAX_ARGS 4
+
+/** Records buffered per producing thread */
+#define ASYNC_LOG_RING_CAPACITY 4096
+
+/** Maximum length of a producer's thread name */
+#define ASYNC_LOG_NAME_LENGTH 32
+
+/**
+ * @brief Log a message with zero to four integer arguments
+ *
+ * Example: ASYNC_LOG("Progress: %ld/%ld iterations\n", i, total);
+ */
+#define ASYNC_LOG(...) ASYNC_LOG_PICK_(__VA_ARGS__, 0L, 0L, 0L, 0L, 0)
+#define ASYNC_LOG_PICK_(format, a0, a1, a2, a3, ...) \
+    async_log((format), (long)(a0), (long)(a1), (long)(a2), (long)(a3))
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+int async_logger_start(FILE *out);
+void async_logger_stop(void);
+int async_logger_register_thread(const char *name);
+void async_log(const char *format, long arg0, long arg1, long arg2, long arg3);
+void async_log_flush(void);
+unsigned long async_logger_dropped(void);
+
+#endif /* ASYNC_LOGGER_H */
@@ -0,0 +1,231 @@
+/**
+ * @file atomic_counter_bench.c
+ * @brief Throughput of volatile, mutex, C11 atomic and batched counters
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * All threads add to one shared counter, N increments each. Reported per
+ * configuration, for 1 thread and for N threads:
+ * - ns/op:   wall time divided by the increments per thread
+ * - Mops/s:  total increments per second across all threads
+ * - lost:    increments missing from the final value
+ *
+ * The volatile row is the demos' old `static volatile long shared_counter`
+ * updated without its mutex; it is fast and wrong as soon as two threads
+ * run at the same time. The mutex row is how the demos made it correct.
+ *
+ * Usage: ./atomic_counter_bench [threads] [increments_per_thread]
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "atomic_counter.h"
+#include "clock_ns.h"
+#include "futex_sync.h"
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+#define DEFAULT_INCREMENTS 10000000L
+#define MAX_BENCH_THREADS 64
+
+/** Counter kinds under test */
+typedef enum {
+    COUNTER_VOLATILE,
+    COUNTER_MUTEX,
+    COUNTER_ATOMIC,
+    COUNTER_BATCHED
+} counter_kind_t;
+
+/**
+ * @brief One benchmark configuration
+ */
+typedef struct {
+    const char *name;
+    counter_kind_t kind;
+    atomic_counter_order_t order;   /**< For ATOMIC and BATCHED */
+    long batch_size;                /**< For BATCHED */
+} config_t;
+
+/** Every configuration, in report order */
+static const config_t configs[] = {
+    { "volatile long (racy)",   COUNTER_VOLATILE, ATOMIC_COUNTER_RELAXED, 0 },
+    { "mutex + volatile long",  COUNTER_MUTEX,    ATOMIC_COUNTER_RELAXED, 0 },
+    { "atomic relaxed",         COUNTER_ATOMIC,   ATOMIC_COUNTER_RELAXED, 0 },
+    { "atomic acq_rel",         COUNTER_ATOMIC,   ATOMIC_COUNTER_ACQ_REL, 0 },
+    { "atomic seq_cst",         COUNTER_ATOMIC,   ATOMIC_COUNTER_SEQ_CST, 0 },
+    { "batched relaxed, 16",    COUNTER_BATCHED,  ATOMIC_COUNTER_RELAXED, 16 },
+    { "batched relaxed, 256",   COUNTER_BATCHED,  ATOMIC_COUNTER_RELAXED, 256 },
+    { "batched relaxed, 4096",  COUNTER_BATCHED,  ATOMIC_COUNTER_RELAXED, 4096 },
+};
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+/** Counters, each on its own cache line */
+static volatile long volatile_counter __attribute__((aligned(64))) = 0;
+static atomic_counter_t shared_counter __attribute__((aligned(64)));
+static pthread_mutex_t counter_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** Run parameters, read-only while workers run */
+static const config_t *active_config = NULL;
+static long active_increments = 0;
+static futex_start_gate_t start_gate;
+
+/*============================================================================
+ * THREAD FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Worker: wait for the common start, then increment
+ *
+ * The atomic case switches on a constant per run, so the compiler hoists
+ * it out of the loop; each variant's loop is a single atomic instruction.
+ */
+static void *worker_thread(void *arg) {
+    const config_t *config = active_config;
+    long increments = active_increments;
+    (void)arg;
+
+    futex_start_gate_arrive(&start_gate);
+
+    switch (config->kind) {
+        case COUNTER_VOLATILE:
+            for (long i = 0; i < increments; i++) {
+                volatile_counter++;
+            }
+            break;
+
+        case COUNTER_MUTEX:
+            for (long i = 0; i < increments; i++) {
+                pthread_mutex_lock(&counter_mutex);
+                volatile_counter++;
+                pthread_mutex_unlock(&counter_mutex);
+            }
+            break;
+
+        case COUNTER_ATOMIC:
+            if (config->order == ATOMIC_COUNTER_RELAXED) {
+                for (long i = 0; i < increments; i++) {
+                    atomic_counter_add_relaxed(&shared_counter, 1);
+                }
+            } else if (config->order == ATOMIC_COUNTER_ACQ_REL) {
+                for (long i = 0; i < increments; i++) {
+                    atomic_counter_add_acq_rel(&shared_counter, 1);
+                }
+            } else {
+                for (long i = 0; i < increments; i++) {
+                    atomic_counter_add_seq_cst(&shared_counter, 1);
+                }
+            }
+            break;
+
+        case COUNTER_BATCHED: {
+            atomic_counter_batch_t batch;
+            atomic_counter_batch_init(&batch, &shared_counter, config->batch_size,
+                                      config->order);
+            for (long i = 0; i < increments; i++) {
+                atomic_counter_batch_add(&batch, 1);
+            }
+            atomic_counter_batch_flush(&batch);
+            break;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Run one configuration
+ * @param[out] lost Increments missing from the final counter value
+ * @return Wall time in nanoseconds
+ */
+static long long run_config(const config_t *config, int threads, long increments, long *lost) {
+    pthread_t ids[MAX_BENCH_THREADS];
+
+    volatile_counter = 0;
+    atomic_counter_init(&shared_counter, 0);
+    active_config = config;
+    active_increments = increments;
+    futex_start_gate_init(&start_gate, (unsigned int)threads);
+
+    for (int i = 0; i < threads; i++) {
+        int result = pthread_create(&ids[i], NULL, worker_thread, NULL);
+        if (result != 0) {
+            fprintf(stderr, "Failed to create thread %d: %s\n", i, strerror(result));
+            exit(EXIT_FAILURE); // The gate would never open
+        }
+    }
+
+    futex_latch_wait(&start_gate.ready);
+    long long start = now_ns();
+    futex_event_set(&start_gate.go);
+    for (int i = 0; i < threads; i++) {
+        pthread_join(ids[i], NULL);
+    }
+    long long elapsed = now_ns() - start;
+
+    long final = (config->kind == COUNTER_VOLATILE || config->kind == COUNTER_MUTEX) ?
+                 volatile_counter : atomic_counter_load(&shared_counter, ATOMIC_COUNTER_RELAXED);
+    *lost = increments * threads - final;
+    return elapsed;
+}
+
+/*============================================================================
+ * MAIN FUNCTION
+ *============================================================================*/
+
+/**
+ * @brief Main function - runs every configuration with 1 and N threads
+ * @return EXIT_SUCCESS on success, EXIT_FAILURE on bad arguments or if a
+ *         synchronized counter lost increments
+ */
+int main(int argc, char **argv) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int threads = cpus > 2 ? (int)cpus : 2;
+    long increments = DEFAULT_INCREMENTS;
+
+    if (argc > 1) {
+        threads = (int)strtol(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        increments = strtol(argv[2], NULL, 10);
+    }
+    if (threads < 1 || threads > MAX_BENCH_THREADS || increments <= 0) {
+        fprintf(stderr, "Usage: %s [threads 1..%d] [increments_per_thread > 0]\n",
+                argv[0], MAX_BENCH_THREADS);
+        return EXIT_FAILURE;
+    }
+
+    printf("========================================================\n");
+    printf("    SHARED COUNTER THROUGHPUT BENCHMARK\n");
+    printf("========================================================\n");
+    printf("Threads: %d, online CPUs: %ld, increments per thread: %ld\n\n",
+           threads, cpus, increments);
+    printf("%-24s %9s %9s %11s %12s\n", "configuration", "1T ns/op", "NT ns/op",
+           "NT Mops/s", "NT lost");
+
+    int failed = 0;
+    for (size_t c = 0; c < sizeof(configs) / sizeof(configs[0]); c++) {
+        long single_lost, multi_lost;
+        long long single = run_config(&configs[c], 1, increments, &single_lost);
+        long long multi = run_config(&configs[c], threads, increments, &multi_lost);
+
+        printf("%-24s %9.2f %9.2f %11.1f %12ld\n", configs[c].name,
+               (double)single / (double)increments, (double)multi / (double)increments,
+               (double)increments * threads / ((double)multi / 1e3), multi_lost);
+
+        if (configs[c].kind != COUNTER_VOLATILE && (single_lost != 0 || multi_lost != 0)) {
+            failed = 1;
+        }
+    }
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file builtin_bench.c
+ * @brief Latency of external commands vs their in-process builtins
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * For each command the system demo runs (`ls -la`, `date`, `df -h .`,
+ * `uname -a`), captures its output:
+ * - external: posix_spawn + pipe (launcher_capture())
+ * - builtin:  builtin_capture(), the same output produced in-process
+ *
+ * Check: the builtin prints byte-for-byte what the program prints. The
+ * builtins always format like the C locale, so the programs are run with
+ * LC_ALL=C; under the user's locale the date format, ls sort order and df
+ * decimal separator would differ. `date` can straddle a second boundary,
+ * so a comparison is retried a few times before it counts as a mismatch.
+ *
+ * Usage: ./builtin_bench [runs]
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+
+#include "builtin_commands.h"
+#include "clock_ns.h"
+#include "command_launcher.h"
+
+/*============================================================================
+ * CONSTANTS
+ *============================================================================*/
+
+#define DEFAULT_RUNS 200L
+
+/** Comparisons attempted before outputs count as different */
+#define COMPARE_ATTEMPTS 3
+
+static const char *const commands[] = { "ls -la", "date", "df -h .", "uname -a" };
+
+#define NUM_COMMANDS ((int)(sizeof(commands) / sizeof(commands[0])))
+
+/*============================================================================
+ * UTILITY FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Capture a command either way
+ * @return 0 if it ran and exited with status 0
+ */
+static int capture(const char *command, int builtin, launcher_output_t *output) {
+    int status;
+    int result = builtin ? builtin_capture_line(command, output, &status)
+                         : launcher_capture_line(command, LAUNCHER_CAPTURE_PIPE, output, &status);
+    if (result == 0 && (!WIFEXITED(status) || WEXITSTATUS(status) != 0)) {
+        result = ECHILD;
+    }
+    return result;
+}
+
+/**
+ * @brief Average microseconds per capture
+ * @return Negative if a capture failed
+ */
+static double time_captures(const char *command, int builtin, long runs) {
+    launcher_output_t output;
+
+    long long start = now_ns();
+    for (long i = 0; i < runs; i++) {
+        int result = capture(command, builtin, &output);
+        launcher_output_free(&output);
+        if (result != 0) {
+            return -1.0;
+        }
+    }
+    return (double)(now_ns() - start) / (double)runs / 1e3;
+}
+
+/**
+ * @brief Whether both ways print the same bytes
+ */
+static int outputs_match(const char *command) {
+    for (int attempt = 0; attempt < COMPARE_ATTEMPTS; attempt++) {
+        launcher_output_t external;
+        launcher_output_t builtin;
+
+        int failed = capture(command, 0, &external) != 0;
+        failed |= capture(command, 1, &builtin) != 0;
+        int same = !failed && external.length == builtin.length &&
+                   memcmp(external.data, builtin.data, external.length) == 0;
+        if (!same && attempt == COMPARE_ATTEMPTS - 1 && !failed) {
+            printf("\n--- %s (external)\n%s--- %s (builtin)\n%s", command, external.data,
+                   command, builtin.data);
+        }
+        launcher_output_free(&external);
+        launcher_output_free(&builtin);
+        if (same) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*============================================================================
+ * MAIN FUNCTION
+ *============================================================================*/
+
+/**
+ * @brief Main function - times both ways for each command and compares output
+ * @return EXIT_SUCCESS on success, EXIT_FAILURE on bad arguments, a failed
+ *         command or different output
+ */
+int main(int argc, char **argv) {
+    long runs = DEFAULT_RUNS;
+
+    if (argc > 1) {
+        runs = strtol(argv[1], NULL, 10);
+    }
+    if (runs < 1) {
+        fprintf(stderr, "Usage: %s [runs >= 1]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // The programs inherit this; compare them with the builtins in the C locale
+    setenv("LC_ALL", "C", 1);
+
+    printf("========================================================\n");
+    printf("    BUILTIN VS EXTERNAL COMMAND BENCHMARK\n");
+    printf("========================================================\n");
+    printf("Runs per command: %ld\n\n", runs);
+    printf("%-10s %14s %14s %9s %7s\n", "command", "external (us)", "builtin (us)", "speedup",
+           "output");
+
+    int failed = 0;
+    for (int i = 0; i < NUM_COMMANDS; i++) {
+        double external_us = time_captures(commands[i], 0, runs);
+        double builtin_us = time_captures(commands[i], 1, runs);
+        int same = outputs_match(commands[i]);
+
+        if (external_us < 0 || builtin_us < 0) {
+            printf("%-10s failed to run\n", commands[i]);
+            failed = 1;
+            continue;
+        }
+        printf("%-10s %14.1f %14.1f %8.0fx %7s\n", commands[i], external_us, builtin_us,
+               external_us / builtin_us, same ? "same" : "DIFFERS");
+        failed |= !same;
+    }
+
+    printf("\nCheck: builtins run and match the programs' output: %s\n",
+           failed ? "FAILED" : "ok");
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,901 @@
+/**
+ * @file builtin_commands.c
+ * @brief date, uname, ls -l, df and echo without spawning a process
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#define _GNU_SOURCE
+
+#include "builtin_commands.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <grp.h>
+#include <inttypes.h>
+#include <pwd.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <sys/syscall.h>
+#include <sys/sysmacros.h>
+#include <sys/utsname.h>
+#include <sys/wait.h>
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+/** uid/gid -> name translations remembered by ls */
+#define NAME_CACHE_SIZE 16
+
+/** coreutils df minimum column widths */
+#define DF_SOURCE_WIDTH 14
+#define DF_NUMBER_WIDTH 5
+#define DF_PERCENT_WIDTH 4
+
+/**
+ * @brief Record returned by the getdents64 system call
+ */
+struct linux_dirent64 {
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+
+/**
+ * @brief A builtin: check() accepts or refuses the arguments without side
+ *        effects, run() is only called with accepted arguments
+ */
+typedef struct {
+    const char *name;
+    int (*check)(int argc, char *const argv[]);
+    int (*run)(int argc, char *const argv[], FILE *out, int *exit_code);
+} builtin_command_t;
+
+/** uname fields, in the order -a prints them */
+enum {
+    UNAME_SYSNAME = 1 << 0,
+    UNAME_NODENAME = 1 << 1,
+    UNAME_RELEASE = 1 << 2,
+    UNAME_VERSION = 1 << 3,
+    UNAME_MACHINE = 1 << 4,
+    UNAME_OS = 1 << 5,
+    UNAME_ALL = (1 << 6) - 1
+};
+
+typedef struct {
+    int long_format;
+    int all;
+    const char *path;
+} ls_options_t;
+
+typedef struct {
+    int human;
+    const char *path;
+} df_options_t;
+
+/**
+ * @brief One line of a long listing
+ */
+typedef struct {
+    char *name;
+    char *target;               /**< Symlink target, or NULL */
+    struct statx stx;
+} ls_entry_t;
+
+/**
+ * @brief Remembered uid or gid translation
+ */
+typedef struct {
+    unsigned int id;
+    char name[64];
+} id_name_t;
+
+/*============================================================================
+ * UTILITY FUNCTIONS
+ *============================================================================*/
+
+static int count_args(char *const argv[]) {
+    int argc = 0;
+    while (argv[argc]) {
+        argc++;
+    }
+    return argc;
+}
+
+/**
+ * @brief Number of characters needed to print value in decimal
+ */
+static int decimal_width(uintmax_t value) {
+    int width = 1;
+    while (value >= 10) {
+        value /= 10;
+        width++;
+    }
+    return width;
+}
+
+/**
+ * @brief Format bytes like coreutils -h: powers of 1024, rounded up, one
+ *        decimal below 10
+ */
+static void format_human(uint64_t bytes, char *buffer, size_t size) {
+    static const char units[] = "KMGTPE";
+    uint64_t divisor = 1024;
+    int exponent = 0;
+
+    if (bytes < 1024) {
+        snprintf(buffer, size, "%" PRIu64, bytes);
+        return;
+    }
+    while (bytes / divisor >= 1024) {
+        divisor *= 1024;
+        exponent++;
+    }
+
+    uint64_t whole = bytes / divisor;
+    uint64_t rest = bytes % divisor;
+    if (whole < 10) {
+        uint64_t tenths = whole * 10 + (rest * 10 + divisor - 1) / divisor;
+        if (tenths < 100) {
+            snprintf(buffer, size, "%" PRIu64 ".%" PRIu64 "%c",
+                     tenths / 10, tenths % 10, units[exponent]);
+            return;
+        }
+        whole = 10;
+        rest = 0;
+    }
+    whole += (rest != 0);
+    if (whole == 1024 && units[exponent + 1]) {
+        snprintf(buffer, size, "1.0%c", units[exponent + 1]);
+        return;
+    }
+    snprintf(buffer, size, "%" PRIu64 "%c", whole, units[exponent]);
+}
+
+/*============================================================================
+ * ECHO AND DATE
+ *============================================================================*/
+
+static int echo_check(int argc, char *const argv[]) {
+    // -n, -e and -E would change the output; refuse any option-like word
+    return (argc > 1 && argv[1][0] == '-') ? ENOTSUP : 0;
+}
+
+static int echo_run(int argc, char *const argv[], FILE *out, int *exit_code) {
+    for (int i = 1; i < argc; i++) {
+        fputs(argv[i], out);
+        fputc(i + 1 < argc ? ' ' : '\n', out);
+    }
+    if (argc == 1) {
+        fputc('\n', out);
+    }
+    *exit_code = 0;
+    return 0;
+}
+
+static int date_check(int argc, char *const argv[]) {
+    (void)argv;
+    return argc == 1 ? 0 : ENOTSUP;
+}
+
+static int date_run(int argc, char *const argv[], FILE *out, int *exit_code) {
+    struct timespec now;
+    struct tm local;
+    char text[128];
+
+    (void)argc;
+    (void)argv;
+    clock_gettime(CLOCK_REALTIME, &now);
+    localtime_r(&now.tv_sec, &local);
+    strftime(text, sizeof(text), "%a %b %e %H:%M:%S %Z %Y", &local);
+    fprintf(out, "%s\n", text);
+    *exit_code = 0;
+    return 0;
+}
+
+/*============================================================================
+ * UNAME
+ *============================================================================*/
+
+static int uname_parse(int argc, char *const argv[], int *fields) {
+    *fields = 0;
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] != '-' || argv[i][1] == '\0') {
+            return ENOTSUP;
+        }
+        for (const char *flag = argv[i] + 1; *flag; flag++) {
+            switch (*flag) {
+            case 'a': *fields |= UNAME_ALL; break;
+            case 's': *fields |= UNAME_SYSNAME; break;
+            case 'n': *fields |= UNAME_NODENAME; break;
+            case 'r': *fields |= UNAME_RELEASE; break;
+            case 'v': *fields |= UNAME_VERSION; break;
+            case 'm': *fields |= UNAME_MACHINE; break;
+            case 'o': *fields |= UNAME_OS; break;
+            default: return ENOTSUP;
+            }
+        }
+    }
+    if (*fields == 0) {
+        *fields = UNAME_SYSNAME;
+    }
+    return 0;
+}
+
+static int uname_check(int argc, char *const argv[]) {
+    int fields;
+    return uname_parse(argc, argv, &fields);
+}
+
+static int uname_run(int argc, char *const argv[], FILE *out, int *exit_code) {
+    struct utsname names;
+    int fields;
+
+    uname_parse(argc, argv, &fields);
+    if (uname(&names) == -1) {
+        fprintf(stderr, "uname: cannot get system name: %s\n", strerror(errno));
+        *exit_code = 1;
+        return 0;
+    }
+
+    const char *values[] = {
+        names.sysname, names.nodename, names.release, names.version, names.machine,
+        "GNU/Linux"
+    };
+    int printed = 0;
+    for (int i = 0; i < (int)(sizeof(values) / sizeof(values[0])); i++) {
+        if (fields & (1 << i)) {
+            fprintf(out, "%s%s", printed++ ? " " : "", values[i]);
+        }
+    }
+    fputc('\n', out);
+    *exit_code = 0;
+    return 0;
+}
+
+/*============================================================================
+ * LS
+ *============================================================================*/
+
+static int ls_parse(int argc, char *const argv[], ls_options_t *options) {
+    memset(options, 0, sizeof(*options));
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            for (const char *flag = argv[i] + 1; *flag; flag++) {
+                if (*flag == 'l') {
+                    options->long_format = 1;
+                } else if (*flag == 'a') {
+                    options->all = 1;
+                } else {
+                    return ENOTSUP;
+                }
+            }
+        } else if (options->path) {
+            // Several operands get headings and their own totals
+            return ENOTSUP;
+        } else {
+            options->path = argv[i];
+        }
+    }
+    // The short format depends on whether stdout is a terminal
+    if (!options->long_format) {
+        return ENOTSUP;
+    }
+    if (!options->path) {
+        options->path = ".";
+    }
+    return 0;
+}
+
+static int ls_check(int argc, char *const argv[]) {
+    ls_options_t options;
+    return ls_parse(argc, argv, &options);
+}
+
+/**
+ * @brief Name of a uid or gid, or the number if it has none
+ */
+static const char *lookup_id_name(id_name_t *cache, int *count, unsigned int id, int is_group) {
+    for (int i = 0; i < *count; i++) {
+        if (cache[i].id == id) {
+            return cache[i].name;
+        }
+    }
+
+    id_name_t *slot = &cache[*count < NAME_CACHE_SIZE ? (*count)++ : (int)(id % NAME_CACHE_SIZE)];
+    const char *name = NULL;
+    if (is_group) {
+        struct group *group = getgrgid(id);
+        name = group ? group->gr_name : NULL;
+    } else {
+        struct passwd *user = getpwuid(id);
+        name = user ? user->pw_name : NULL;
+    }
+
+    slot->id = id;
+    if (name) {
+        snprintf(slot->name, sizeof(slot->name), "%s", name);
+    } else {
+        snprintf(slot->name, sizeof(slot->name), "%u", id);
+    }
+    return slot->name;
+}
+
+static void format_mode(unsigned int mode, char text[11]) {
+    char type = '?';
+    switch (mode & S_IFMT) {
+    case S_IFREG: type = '-'; break;
+    case S_IFDIR: type = 'd'; break;
+    case S_IFLNK: type = 'l'; break;
+    case S_IFCHR: type = 'c'; break;
+    case S_IFBLK: type = 'b'; break;
+    case S_IFIFO: type = 'p'; break;
+    case S_IFSOCK: type = 's'; break;
+    }
+
+    text[0] = type;
+    text[1] = (mode & S_IRUSR) ? 'r' : '-';
+    text[2] = (mode & S_IWUSR) ? 'w' : '-';
+    text[3] = (mode & S_ISUID) ? ((mode & S_IXUSR) ? 's' : 'S') : ((mode & S_IXUSR) ? 'x' : '-');
+    text[4] = (mode & S_IRGRP) ? 'r' : '-';
+    text[5] = (mode & S_IWGRP) ? 'w' : '-';
+    text[6] = (mode & S_ISGID) ? ((mode & S_IXGRP) ? 's' : 'S') : ((mode & S_IXGRP) ? 'x' : '-');
+    text[7] = (mode & S_IROTH) ? 'r' : '-';
+    text[8] = (mode & S_IWOTH) ? 'w' : '-';
+    text[9] = (mode & S_ISVTX) ? ((mode & S_IXOTH) ? 't' : 'T') : ((mode & S_IXOTH) ? 'x' : '-');
+    text[10] = '\0';
+}
+
+static int is_device(const struct statx *stx) {
+    return S_ISCHR(stx->stx_mode) || S_ISBLK(stx->stx_mode);
+}
+
+static int compare_entries(const void *a, const void *b) {
+    return strcoll(((const ls_entry_t *)a)->name, ((const ls_entry_t *)b)->name);
+}
+
+static void free_entries(ls_entry_t *entries, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        free(entries[i].name);
+        free(entries[i].target);
+    }
+    free(entries);
+}
+
+/**
+ * @brief statx an entry (without following symlinks) and read its target
+ */
+static int stat_entry(int dir_fd, const char *path, ls_entry_t *entry) {
+    if (statx(dir_fd, path, AT_SYMLINK_NOFOLLOW | AT_NO_AUTOMOUNT,
+              STATX_BASIC_STATS, &entry->stx) == -1) {
+        return errno;
+    }
+    if (S_ISLNK(entry->stx.stx_mode)) {
+        size_t size = entry->stx.stx_size ? entry->stx.stx_size + 1 : 4096;
+        entry->target = malloc(size);
+        if (!entry->target) {
+            return ENOMEM;
+        }
+        ssize_t length = readlinkat(dir_fd, path, entry->target, size - 1);
+        entry->target[length > 0 ? length : 0] = '\0';
+    }
+    return 0;
+}
+
+/**
+ * @brief Read a directory with getdents64 and statx every entry
+ */
+static int read_entries(int dir_fd, int all, ls_entry_t **entries_out, size_t *count_out) {
+    char *buffer = malloc(BUILTIN_DIRENT_BUFFER);
+    ls_entry_t *entries = NULL;
+    size_t count = 0;
+    size_t capacity = 0;
+    int result = 0;
+
+    if (!buffer) {
+        return ENOMEM;
+    }
+
+    for (;;) {
+        long bytes = syscall(SYS_getdents64, dir_fd, buffer, BUILTIN_DIRENT_BUFFER);
+        if (bytes == -1) {
+            result = errno;
+            break;
+        }
+        if (bytes == 0) {
+            break;
+        }
+
+        for (long offset = 0; offset < bytes && result == 0;) {
+            struct linux_dirent64 *dirent = (struct linux_dirent64 *)(buffer + offset);
+            offset += dirent->d_reclen;
+            if (!all && dirent->d_name[0] == '.') {
+                continue;
+            }
+
+            if (count == capacity) {
+                size_t new_capacity = capacity ? capacity * 2 : 64;
+                ls_entry_t *grown = realloc(entries, new_capacity * sizeof(ls_entry_t));
+                if (!grown) {
+                    result = ENOMEM;
+                    break;
+                }
+                entries = grown;
+                capacity = new_capacity;
+            }
+
+            ls_entry_t *entry = &entries[count];
+            memset(entry, 0, sizeof(*entry));
+            entry->name = strdup(dirent->d_name);
+            if (!entry->name) {
+                result = ENOMEM;
+                break;
+            }
+            count++;
+            result = stat_entry(dir_fd, dirent->d_name, entry);
+        }
+        if (result != 0) {
+            break;
+        }
+    }
+
+    free(buffer);
+    if (result != 0) {
+        free_entries(entries, count);
+        return result;
+    }
+    *entries_out = entries;
+    *count_out = count;
+    return 0;
+}
+
+/**
+ * @brief Print a long listing with coreutils' column layout
+ */
+static void print_long_listing(FILE *out, ls_entry_t *entries, size_t count) {
+    id_name_t users[NAME_CACHE_SIZE];
+    id_name_t groups[NAME_CACHE_SIZE];
+    int user_count = 0;
+    int group_count = 0;
+    int links_width = 0;
+    int owner_width = 0;
+    int group_width = 0;
+    int size_width = 0;
+    int major_width = 0;
+    int minor_width = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        const struct statx *stx = &entries[i].stx;
+        int width = decimal_width(stx->stx_nlink);
+        links_width = width > links_width ? width : links_width;
+        width = (int)strlen(lookup_id_name(users, &user_count, stx->stx_uid, 0));
+        owner_width = width > owner_width ? width : owner_width;
+        width = (int)strlen(lookup_id_name(groups, &group_count, stx->stx_gid, 1));
+        group_width = width > group_width ? width : group_width;
+        if (is_device(stx)) {
+            width = decimal_width(stx->stx_rdev_major);
+            major_width = width > major_width ? width : major_width;
+            width = decimal_width(stx->stx_rdev_minor);
+            minor_width = width > minor_width ? width : minor_width;
+        } else {
+            width = decimal_width(stx->stx_size);
+            size_width = width > size_width ? width : size_width;
+        }
+    }
+    if (major_width && major_width + 2 + minor_width > size_width) {
+        size_width = major_width + 2 + minor_width;
+    }
+
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+
+    for (size_t i = 0; i < count; i++) {
+        const struct statx *stx = &entries[i].stx;
+        char mode[11];
+        char when[64];
+        struct tm local;
+        time_t mtime = (time_t)stx->stx_mtime.tv_sec;
+
+        format_mode(stx->stx_mode, mode);
+        localtime_r(&mtime, &local);
+        int recent = mtime > now.tv_sec - BUILTIN_LS_RECENT_SECONDS && mtime <= now.tv_sec;
+        strftime(when, sizeof(when), recent ? "%b %e %H:%M" : "%b %e  %Y", &local);
+
+        fprintf(out, "%s %*u %-*s %-*s ", mode, links_width, stx->stx_nlink,
+                owner_width, lookup_id_name(users, &user_count, stx->stx_uid, 0),
+                group_width, lookup_id_name(groups, &group_count, stx->stx_gid, 1));
+        if (is_device(stx)) {
+            fprintf(out, "%*u, %*u", size_width - 2 - minor_width, stx->stx_rdev_major,
+                    minor_width, stx->stx_rdev_minor);
+        } else {
+            fprintf(out, "%*" PRIu64, size_width, (uint64_t)stx->stx_size);
+        }
+        fprintf(out, " %s %s", when, entries[i].name);
+        if (entries[i].target) {
+            fprintf(out, " -> %s", entries[i].target);
+        }
+        fputc('\n', out);
+    }
+}
+
+static int ls_run(int argc, char *const argv[], FILE *out, int *exit_code) {
+    ls_options_t options;
+    ls_entry_t *entries = NULL;
+    size_t count = 0;
+
+    ls_parse(argc, argv, &options);
+
+    // A non-directory operand is listed as itself, under the name given
+    ls_entry_t single;
+    memset(&single, 0, sizeof(single));
+    int result = stat_entry(AT_FDCWD, options.path, &single);
+    if (result == ENOMEM) {
+        return result;
+    }
+    if (result != 0) {
+        fprintf(stderr, "ls: cannot access '%s': %s\n", options.path, strerror(result));
+        *exit_code = 2;
+        return 0;
+    }
+    if (!S_ISDIR(single.stx.stx_mode)) {
+        single.name = (char *)options.path;
+        print_long_listing(out, &single, 1);
+        free(single.target);
+        *exit_code = 0;
+        return 0;
+    }
+
+    int dir_fd = open(options.path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dir_fd == -1) {
+        fprintf(stderr, "ls: cannot open directory '%s': %s\n", options.path, strerror(errno));
+        *exit_code = 2;
+        return 0;
+    }
+    result = read_entries(dir_fd, options.all, &entries, &count);
+    close(dir_fd);
+    if (result == ENOMEM) {
+        return result;
+    }
+    if (result != 0) {
+        fprintf(stderr, "ls: reading directory '%s': %s\n", options.path, strerror(result));
+        *exit_code = 2;
+        return 0;
+    }
+
+    qsort(entries, count, sizeof(ls_entry_t), compare_entries);
+
+    // st_blocks counts 512-byte units; the total is in 1K blocks, rounded up
+    uint64_t blocks = 0;
+    for (size_t i = 0; i < count; i++) {
+        blocks += entries[i].stx.stx_blocks;
+    }
+    fprintf(out, "total %" PRIu64 "\n", (blocks + 1) / 2);
+    print_long_listing(out, entries, count);
+
+    free_entries(entries, count);
+    *exit_code = 0;
+    return 0;
+}
+
+/*============================================================================
+ * DF
+ *============================================================================*/
+
+static int df_parse(int argc, char *const argv[], df_options_t *options) {
+    memset(options, 0, sizeof(*options));
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0) {
+            options->human = 1;
+        } else if (argv[i][0] == '-' || options->path) {
+            return ENOTSUP;
+        } else {
+            options->path = argv[i];
+        }
+    }
+    // Without an operand df lists every filesystem
+    return options->path ? 0 : ENOTSUP;
+}
+
+static int df_check(int argc, char *const argv[]) {
+    df_options_t options;
+    return df_parse(argc, argv, &options);
+}
+
+/**
+ * @brief Undo the octal escapes (\040 for a space...) of a mountinfo field
+ */
+static void unescape_field(char *field) {
+    char *write = field;
+    for (char *read = field; *read; read++) {
+        if (read[0] == '\\' && read[1] >= '0' && read[1] <= '3' &&
+            read[2] >= '0' && read[2] <= '7' && read[3] >= '0' && read[3] <= '7') {
+            *write++ = (char)((read[1] - '0') * 64 + (read[2] - '0') * 8 + (read[3] - '0'));
+            read += 3;
+        } else {
+            *write++ = *read;
+        }
+    }
+    *write = '\0';
+}
+
+/**
+ * @brief Find the mount holding path: the longest mount point that is a
+ *        prefix of its real path, preferring mounts of its device
+ */
+static int find_mount(const char *path, dev_t device, char *source, size_t source_size,
+                      char *target, size_t target_size) {
+    char *real = realpath(path, NULL);
+    if (!real) {
+        return errno;
+    }
+    FILE *mounts = fopen("/proc/self/mountinfo", "re");
+    if (!mounts) {
+        int result = errno;
+        free(real);
+        return result;
+    }
+
+    char *line = NULL;
+    size_t line_size = 0;
+    size_t best_length = 0;
+    int best_matches_device = 0;
+    int found = 0;
+
+    while (getline(&line, &line_size, mounts) != -1) {
+        // id parent major:minor root mount-point options [optional...] - type source ...
+        unsigned int major_number;
+        unsigned int minor_number;
+        char *save;
+        strtok_r(line, " ", &save);
+        strtok_r(NULL, " ", &save);
+        char *numbers = strtok_r(NULL, " ", &save);
+        strtok_r(NULL, " ", &save);
+        char *mount_point = strtok_r(NULL, " ", &save);
+        char *field;
+        while ((field = strtok_r(NULL, " ", &save)) && strcmp(field, "-") != 0) {
+        }
+        strtok_r(NULL, " ", &save);
+        char *mount_source = strtok_r(NULL, " ", &save);
+        if (!numbers || !mount_point || !mount_source ||
+            sscanf(numbers, "%u:%u", &major_number, &minor_number) != 2) {
+            continue;
+        }
+
+        unescape_field(mount_point);
+        size_t length = strlen(mount_point);
+        int is_prefix = strcmp(mount_point, "/") == 0 ||
+                        (strncmp(real, mount_point, length) == 0 &&
+                         (real[length] == '/' || real[length] == '\0'));
+        if (!is_prefix) {
+            continue;
+        }
+        int matches_device = makedev(major_number, minor_number) == device;
+        // Later lines are mounted on top of earlier ones, hence >=
+        if ((matches_device && !best_matches_device) ||
+            (matches_device == best_matches_device && length >= best_length)) {
+            unescape_field(mount_source);
+            snprintf(source, source_size, "%s", mount_source);
+            snprintf(target, target_size, "%s", mount_point);
+            best_length = length;
+            best_matches_device = matches_device;
+            found = 1;
+        }
+    }
+
+    free(line);
+    fclose(mounts);
+    free(real);
+    return found ? 0 : ENOENT;
+}
+
+static int df_run(int argc, char *const argv[], FILE *out, int *exit_code) {
+    df_options_t options;
+    struct statvfs vfs;
+    struct stat st;
+    char source[4096];
+    char target[4096];
+
+    df_parse(argc, argv, &options);
+    if (stat(options.path, &st) == -1 || statvfs(options.path, &vfs) == -1) {
+        fprintf(stderr, "df: %s: %s\n", options.path, strerror(errno));
+        *exit_code = 1;
+        return 0;
+    }
+    if (find_mount(options.path, st.st_dev, source, sizeof(source),
+                   target, sizeof(target)) != 0) {
+        snprintf(source, sizeof(source), "-");
+        snprintf(target, sizeof(target), "-");
+    }
+
+    uint64_t unit = vfs.f_frsize ? vfs.f_frsize : vfs.f_bsize;
+    uint64_t total = (uint64_t)vfs.f_blocks * unit;
+    uint64_t used = (uint64_t)(vfs.f_blocks - vfs.f_bfree) * unit;
+    uint64_t available = (uint64_t)vfs.f_bavail * unit;
+
+    char numbers[3][32];
+    uint64_t values[3] = { total, used, available };
+    for (int i = 0; i < 3; i++) {
+        if (options.human) {
+            format_human(values[i], numbers[i], sizeof(numbers[i]));
+        } else {
+            snprintf(numbers[i], sizeof(numbers[i]), "%" PRIu64, (values[i] + 1023) / 1024);
+        }
+    }
+
+    char percent[8] = "-";
+    if (used + available > 0) {
+        uint64_t whole = used * 100 / (used + available);
+        whole += (used * 100 % (used + available)) != 0;
+        snprintf(percent, sizeof(percent), "%" PRIu64 "%%", whole);
+    }
+
+    const char *headers[] = { "Filesystem", options.human ? "Size" : "1K-blocks", "Used",
+                              options.human ? "Avail" : "Available", "Use%", "Mounted on" };
+    const char *cells[] = { source, numbers[0], numbers[1], numbers[2], percent, target };
+    int minimum[] = { DF_SOURCE_WIDTH, DF_NUMBER_WIDTH, DF_NUMBER_WIDTH, DF_NUMBER_WIDTH,
+                      DF_PERCENT_WIDTH, 0 };
+    int widths[6];
+    for (int i = 0; i < 6; i++) {
+        int header = (int)strlen(headers[i]);
+        int cell = (int)strlen(cells[i]);
+        widths[i] = minimum[i];
+        widths[i] = header > widths[i] ? header : widths[i];
+        widths[i] = cell > widths[i] ? cell : widths[i];
+    }
+
+    // Numbers are right-aligned; the last column is not padded
+    for (int row = 0; row < 2; row++) {
+        const char **text = row == 0 ? headers : cells;
+        fprintf(out, "%-*s %*s %*s %*s %*s %s\n", widths[0], text[0], widths[1], text[1],
+                widths[2], text[2], widths[3], text[3], widths[4], text[4], text[5]);
+    }
+    *exit_code = 0;
+    return 0;
+}
+
+/*============================================================================
+ * DISPATCH
+ *============================================================================*/
+
+static const builtin_command_t builtins[] = {
+    { "date", date_check, date_run },
+    { "df", df_check, df_run },
+    { "echo", echo_check, echo_run },
+    { "ls", ls_check, ls_run },
+    { "uname", uname_check, uname_run }
+};
+
+#define NUM_BUILTINS ((int)(sizeof(builtins) / sizeof(builtins[0])))
+
+/**
+ * @brief The builtin that accepts argv, or NULL
+ */
+static const builtin_command_t *find_builtin(char *const argv[]) {
+    if (!argv || !argv[0]) {
+        return NULL;
+    }
+    for (int i = 0; i < NUM_BUILTINS; i++) {
+        if (strcmp(argv[0], builtins[i].name) == 0) {
+            return builtins[i].check(count_args(argv), argv) == 0 ? &builtins[i] : NULL;
+        }
+    }
+    return NULL;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Whether builtin_run() would handle argv in-process
+ */
+int builtin_supported(char *const argv[]) {
+    return find_builtin(argv) != NULL;
+}
+
+/**
+ * @brief Run argv in-process, writing what the program would print to out
+ * @param[out] status Wait status, as for a child that exited
+ * @return 0 if the builtin ran (see status), ENOTSUP if argv is not a
+ *         supported form (nothing printed), EINVAL or ENOMEM
+ */
+int builtin_run(char *const argv[], FILE *out, int *status) {
+    if (!argv || !argv[0] || !out || !status) {
+        return EINVAL;
+    }
+    const builtin_command_t *builtin = find_builtin(argv);
+    if (!builtin) {
+        return ENOTSUP;
+    }
+
+    int exit_code = 0;
+    int result = builtin->run(count_args(argv), argv, out, &exit_code);
+    if (result == 0) {
+        *status = W_EXITCODE(exit_code, 0);
+    }
+    return result;
+}
+
+/**
+ * @brief Split a command line (see launcher_split()) and run it in-process
+ */
+int builtin_run_line(const char *command, FILE *out, int *status) {
+    char *argv[LAUNCHER_MAX_ARGS];
+    int argc;
+
+    if (!command) {
+        return EINVAL;
+    }
+    char *line = strdup(command);
+    if (!line) {
+        return ENOMEM;
+    }
+    int result = launcher_split(line, argv, LAUNCHER_MAX_ARGS, &argc);
+    if (result == 0) {
+        result = builtin_run(argv, out, status);
+    }
+    free(line);
+    return result;
+}
+
+/**
+ * @brief Run argv in-process and collect its output in memory
+ * @param[out] output Same form as launcher_capture() produces; free with
+ *             launcher_output_free() whatever the result
+ * @param[out] status Wait status
+ */
+int builtin_capture(char *const argv[], launcher_output_t *output, int *status) {
+    if (!output) {
+        return EINVAL;
+    }
+    memset(output, 0, sizeof(*output));
+    if (!builtin_supported(argv)) {
+        return argv && argv[0] ? ENOTSUP : EINVAL;
+    }
+
+    FILE *stream = open_memstream(&output->data, &output->length);
+    if (!stream) {
+        return errno;
+    }
+    int result = builtin_run(argv, stream, status);
+    // Closing finalizes data and length (NUL-terminated)
+    if (fclose(stream) != 0 && result == 0) {
+        result = errno;
+    }
+    output->capacity = output->length + 1;
+    return result;
+}
+
+/**
+ * @brief Split a command line (see launcher_split()) and capture it in-process
+ */
+int builtin_capture_line(const char *command, launcher_output_t *output, int *status) {
+    char *argv[LAUNCHER_MAX_ARGS];
+    int argc;
+
+    if (!output) {
+        return EINVAL;
+    }
+    memset(output, 0, sizeof(*output));
+    if (!command) {
+        return EINVAL;
+    }
+    char *line = strdup(command);
+    if (!line) {
+        return ENOMEM;
+    }
+    int result = launcher_split(line, argv, LAUNCHER_MAX_ARGS, &argc);
+    if (result == 0) {
+        result = builtin_capture(argv, output, status);
+    }
+    free(line);
+    return result;
+}
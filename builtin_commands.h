@@ -0,0 +1,58 @@
+/**
+ * @file builtin_commands.h
+ * @brief In-process versions of date, uname, ls -l and df
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * The demos run `date`, `uname -a`, `ls -la` and `df -h .` only to print
+ * what they report. Each of those costs a process (spawn, exec, dynamic
+ * linking, locale setup) for a few system calls. The builtins make the
+ * same calls directly and print what GNU coreutils prints in the C locale:
+ * - date:  clock_gettime() + localtime_r() + strftime()
+ * - uname: uname(2); -a omits the "unknown" processor and hardware fields
+ * - ls:    getdents64 + statx for long listings (-l, optionally -a) of one
+ *          directory, sorted by name, with coreutils' column widths
+ * - df:    statvfs() for the numbers; /proc/self/mountinfo for the device
+ *          and mount point; -h or 1K blocks, sizes rounded up
+ * - echo:  arguments separated by spaces (no options)
+ *
+ * Only forms whose output is reproduced exactly are accepted. Anything
+ * else (another command, an unsupported option, ls on a plain file)
+ * returns ENOTSUP without printing, so callers can fall back to running
+ * the real program. Errors are reported on stderr the way the programs
+ * report them, and reflected in the exit status.
+ *
+ * The status is a wait status (W_EXITCODE), interchangeable with the
+ * launcher's (command_launcher.h). All functions return 0 or an errno code.
+ */
+
+#ifndef BUILTIN_COMMANDS_H
+#define BUILTIN_COMMANDS_H
+
+#include <stdio.h>
+
+#include "command_launcher.h"
+
+/*============================================================================
+ * CONSTANTS
+ *============================================================================*/
+
+/** ls shows the time of day instead of the year for files newer than this */
+#define BUILTIN_LS_RECENT_SECONDS (31556952 / 2)
+
+/** Bytes requested per getdents64 call */
+#define BUILTIN_DIRENT_BUFFER (32 * 1024)
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+int builtin_supported(char *const argv[]);
+
+int builtin_run(char *const argv[], FILE *out, int *status);
+int builtin_run_line(const char *command, FILE *out, int *status);
+
+int builtin_capture(char *const argv[], launcher_output_t *output, int *status);
+int builtin_capture_line(const char *command, launcher_output_t *output, int *status);
+
+#endif /* BUILTIN_COMMANDS_H */
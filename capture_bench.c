@@ -0,0 +1,283 @@
+/**
+ * @file capture_bench.c
+ * @brief Capturing a command's entire stdout: popen+fgets vs read() vs memfd
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * A child process (this program re-executed with --generate) writes S bytes
+ * of text in lines of L bytes, and the parent captures all of it with:
+ * - popen+fgets:  the old execute_command_with_output() loop, made to keep
+ *                 everything: fgets per line, strlen per line, appended to
+ *                 a growing buffer
+ * - read pipe:    launcher_capture(LAUNCHER_CAPTURE_PIPE); large read()
+ *                 calls straight into a geometrically growing buffer
+ * - memfd:        launcher_capture(LAUNCHER_CAPTURE_MEMFD); the child writes
+ *                 into a memory file that the parent maps afterwards
+ *
+ * Times cover spawn to captured result, including the child's own writing.
+ *
+ * Checks: the captured length and every byte match what was generated.
+ *
+ * Usage: ./capture_bench [megabytes] [line_length]
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "clock_ns.h"
+#include "command_launcher.h"
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+#define DEFAULT_MEGABYTES 1024L
+#define DEFAULT_LINE_LENGTH 64L
+
+/** Generator write size; a whole number of lines of at most this length */
+#define GENERATE_BLOCK (1 << 20)
+#define MAX_LINE_LENGTH 4096L
+
+/** fgets() line buffer of the old capture loop */
+#define FGETS_LINE_SIZE 4096
+
+/**
+ * @brief One capture method
+ */
+typedef struct {
+    const char *name;
+    /** Captures the generator's output; returns 0 or an errno code */
+    int (*capture)(char *const argv[], launcher_output_t *output);
+} capture_method_t;
+
+/*============================================================================
+ * UTILITY FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Fill a block with whole lines of line_length bytes
+ * @return Bytes used (a multiple of line_length)
+ */
+static size_t fill_block(char *block, size_t size, long line_length) {
+    size_t lines = size / (size_t)line_length;
+
+    for (size_t line = 0; line < lines; line++) {
+        char *start = block + line * (size_t)line_length;
+        memset(start, 'a' + (int)(line % 26), (size_t)line_length - 1);
+        start[line_length - 1] = '\n';
+    }
+    return lines * (size_t)line_length;
+}
+
+/*============================================================================
+ * GENERATOR (CHILD)
+ *============================================================================*/
+
+/**
+ * @brief Write `bytes` bytes of lines to stdout
+ */
+static int generate(long long bytes, long line_length) {
+    char *block = malloc(GENERATE_BLOCK);
+    if (!block) {
+        return EXIT_FAILURE;
+    }
+    size_t used = fill_block(block, GENERATE_BLOCK, line_length);
+
+    while (bytes > 0) {
+        size_t chunk = bytes < (long long)used ? (size_t)bytes : used;
+        size_t written = 0;
+        while (written < chunk) {
+            ssize_t result = write(STDOUT_FILENO, block + written, chunk - written);
+            if (result == -1) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                free(block);
+                return EXIT_FAILURE;
+            }
+            written += (size_t)result;
+        }
+        bytes -= (long long)chunk;
+    }
+
+    free(block);
+    return EXIT_SUCCESS;
+}
+
+/*============================================================================
+ * CAPTURE METHODS
+ *============================================================================*/
+
+/**
+ * @brief The old loop, without the truncation: popen, fgets, strlen, append
+ */
+static int capture_popen_fgets(char *const argv[], launcher_output_t *output) {
+    char command[1024];
+    char line[FGETS_LINE_SIZE];
+
+    memset(output, 0, sizeof(*output));
+    snprintf(command, sizeof(command), "%s %s %s %s", argv[0], argv[1], argv[2], argv[3]);
+
+    FILE *pipe = popen(command, "r");
+    if (!pipe) {
+        return errno;
+    }
+
+    while (fgets(line, sizeof(line), pipe) != NULL) {
+        size_t line_length = strlen(line);
+        if (output->length + line_length + 1 > output->capacity) {
+            size_t capacity = output->capacity ? output->capacity * 2 : FGETS_LINE_SIZE;
+            char *data = realloc(output->data, capacity);
+            if (!data) {
+                pclose(pipe);
+                return ENOMEM;
+            }
+            output->data = data;
+            output->capacity = capacity;
+        }
+        memcpy(output->data + output->length, line, line_length + 1);
+        output->length += line_length;
+    }
+
+    int status = pclose(pipe);
+    return (status != -1 && WIFEXITED(status) && WEXITSTATUS(status) == 0) ? 0 : ECHILD;
+}
+
+static int capture_with_mode(char *const argv[], launcher_output_t *output,
+                             launcher_capture_mode_t mode) {
+    int status;
+
+    int result = launcher_capture(argv, mode, output, &status);
+    if (result != 0) {
+        return result;
+    }
+    return (WIFEXITED(status) && WEXITSTATUS(status) == 0) ? 0 : ECHILD;
+}
+
+static int capture_read_pipe(char *const argv[], launcher_output_t *output) {
+    return capture_with_mode(argv, output, LAUNCHER_CAPTURE_PIPE);
+}
+
+static int capture_memfd(char *const argv[], launcher_output_t *output) {
+    return capture_with_mode(argv, output, LAUNCHER_CAPTURE_MEMFD);
+}
+
+static const capture_method_t capture_methods[] = {
+    { "popen+fgets", capture_popen_fgets },
+    { "read pipe", capture_read_pipe },
+    { "memfd", capture_memfd }
+};
+
+/*============================================================================
+ * BENCHMARK
+ *============================================================================*/
+
+/**
+ * @brief Whether output is exactly `bytes` bytes of generated lines
+ */
+static int verify_output(const launcher_output_t *output, long long bytes, long line_length) {
+    if (output->length != (size_t)bytes || output->data[output->length] != '\0') {
+        return 0;
+    }
+
+    char *block = malloc(GENERATE_BLOCK);
+    if (!block) {
+        return 0;
+    }
+    size_t used = fill_block(block, GENERATE_BLOCK, line_length);
+
+    int ok = 1;
+    for (size_t offset = 0; ok && offset < output->length; offset += used) {
+        size_t chunk = output->length - offset < used ? output->length - offset : used;
+        ok = memcmp(output->data + offset, block, chunk) == 0;
+    }
+
+    free(block);
+    return ok;
+}
+
+/**
+ * @brief Run one capture method and print its row
+ * @return Non-zero if the capture failed or the output was wrong
+ */
+static int bench_method(const capture_method_t *method, char *const argv[],
+                        long long bytes, long line_length) {
+    launcher_output_t output;
+
+    long long start = now_ns();
+    int result = method->capture(argv, &output);
+    long long elapsed = now_ns() - start;
+
+    int ok = result == 0 && verify_output(&output, bytes, line_length);
+    printf("%-14s %10.3f %10.0f %14zu  %s\n", method->name, (double)elapsed / 1e9,
+           (double)bytes / (1 << 20) / ((double)elapsed / 1e9), output.length,
+           ok ? "ok" : result != 0 ? strerror(result) : "FAILED");
+
+    launcher_output_free(&output);
+    return !ok;
+}
+
+/*============================================================================
+ * MAIN FUNCTION
+ *============================================================================*/
+
+/**
+ * @brief Main function - runs every capture method on the same output
+ * @return EXIT_SUCCESS on success, EXIT_FAILURE on bad arguments or a
+ *         capture that lost, truncated or changed output
+ */
+int main(int argc, char **argv) {
+    if (argc == 4 && strcmp(argv[1], "--generate") == 0) {
+        return generate(strtoll(argv[2], NULL, 10), strtol(argv[3], NULL, 10));
+    }
+
+    long megabytes = DEFAULT_MEGABYTES;
+    long line_length = DEFAULT_LINE_LENGTH;
+
+    if (argc > 1) {
+        megabytes = strtol(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        line_length = strtol(argv[2], NULL, 10);
+    }
+    if (megabytes <= 0 || line_length < 2 || line_length > MAX_LINE_LENGTH) {
+        fprintf(stderr, "Usage: %s [megabytes > 0] [line_length 2..%ld]\n",
+                argv[0], MAX_LINE_LENGTH);
+        return EXIT_FAILURE;
+    }
+
+    long long bytes = (long long)megabytes << 20;
+    char bytes_arg[32];
+    char line_arg[32];
+    snprintf(bytes_arg, sizeof(bytes_arg), "%lld", bytes);
+    snprintf(line_arg, sizeof(line_arg), "%ld", line_length);
+    // Resolved here: under popen's shell, /proc/self/exe would be the shell
+    char self[512];
+    ssize_t self_length = readlink("/proc/self/exe", self, sizeof(self) - 1);
+    if (self_length <= 0) {
+        fprintf(stderr, "Failed to resolve /proc/self/exe: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    self[self_length] = '\0';
+    char *generator[] = { self, "--generate", bytes_arg, line_arg, NULL };
+
+    printf("========================================================\n");
+    printf("    COMMAND OUTPUT CAPTURE BENCHMARK\n");
+    printf("========================================================\n");
+    printf("Output: %ld MB in lines of %ld bytes, read chunk >= %d KB, pipe size %d KB\n\n",
+           megabytes, line_length, LAUNCHER_READ_CHUNK >> 10, LAUNCHER_PIPE_SIZE >> 10);
+    printf("%-14s %10s %10s %14s  %s\n", "method", "seconds", "MB/s", "bytes", "check");
+
+    int failed = 0;
+    for (size_t i = 0; i < sizeof(capture_methods) / sizeof(capture_methods[0]); i++) {
+        failed |= bench_method(&capture_methods[i], generator, bytes, line_length);
+    }
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,22 @@
+/**
+ * @file clock_ns.h
+ * @brief Monotonic clock reading in nanoseconds, for timing and deadlines
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#ifndef CLOCK_NS_H
+#define CLOCK_NS_H
+
+#include <time.h>
+
+/**
+ * @brief CLOCK_MONOTONIC in nanoseconds; only differences are meaningful
+ */
+static inline long long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+#endif /* CLOCK_NS_H */
@@ -0,0 +1,525 @@
+/**
+ * @file command_launcher.c
+ * @brief posix_spawn launcher, output capture and shell-free command line splitting
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#define _GNU_SOURCE
+
+#include "command_launcher.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+
+extern char **environ;
+
+/*============================================================================
+ * COMMAND LINE SPLITTING
+ *============================================================================*/
+
+/** Characters that mean something to a shell outside quotes */
+static const char shell_syntax[] = "|&;<>()$`\\*?[]{}~#!\n";
+
+/**
+ * @brief Split a command line into words, in place
+ * @param line Command line; overwritten with the NUL-terminated words
+ * @param argv Receives pointers into line, followed by a NULL
+ * @param max_args Size of argv, including the terminating NULL
+ * @param[out] argc Number of words
+ * @return 0, EINVAL for shell syntax, unbalanced quotes or an empty line,
+ *         E2BIG if there are more than max_args - 1 words
+ *
+ * Words are separated by blanks; '...' and "..." quote blanks. Inside
+ * double quotes, $, ` and \ are rejected as they would be expanded.
+ */
+int launcher_split(char *line, char *argv[], int max_args, int *argc) {
+    char *read = line;
+    char *write = line;
+    int count = 0;
+
+    if (!line || !argv || max_args < 2 || !argc) {
+        return EINVAL;
+    }
+
+    for (;;) {
+        while (*read == ' ' || *read == '\t') {
+            read++;
+        }
+        if (*read == '\0') {
+            break;
+        }
+        if (count == max_args - 1) {
+            return E2BIG;
+        }
+
+        argv[count++] = write;
+        char quote = '\0';
+        while (*read != '\0' && (quote || (*read != ' ' && *read != '\t'))) {
+            char c = *read++;
+            if (quote) {
+                if (c == quote) {
+                    quote = '\0';
+                    continue;
+                }
+                if (quote == '"' && strchr("$`\\", c)) {
+                    return EINVAL;
+                }
+            } else if (c == '\'' || c == '"') {
+                quote = c;
+                continue;
+            } else if (strchr(shell_syntax, c)) {
+                return EINVAL;
+            }
+            *write++ = c;
+        }
+        if (quote) {
+            return EINVAL;
+        }
+
+        // The separator (if any) is consumed before the terminator is written
+        if (*read != '\0') {
+            read++;
+        }
+        *write++ = '\0';
+    }
+
+    if (count == 0) {
+        return EINVAL;
+    }
+    argv[count] = NULL;
+    *argc = count;
+    return 0;
+}
+
+/**
+ * @brief Split a copy of line (see launcher_split()) for later spawning
+ * @return 0, or EINVAL/E2BIG/ENOMEM; command needs no release on failure
+ */
+int launcher_command_init(launcher_command_t *command, const char *line) {
+    int argc;
+
+    memset(command, 0, sizeof(*command));
+    if (!line) {
+        return EINVAL;
+    }
+
+    command->line = strdup(line);
+    if (!command->line) {
+        return ENOMEM;
+    }
+
+    int result = launcher_split(command->line, command->argv, LAUNCHER_MAX_ARGS, &argc);
+    if (result != 0) {
+        free(command->line);
+        command->line = NULL;
+    }
+    return result;
+}
+
+/**
+ * @brief Free a command prepared by launcher_command_init()
+ */
+void launcher_command_release(launcher_command_t *command) {
+    free(command->line);
+    command->line = NULL;
+    command->argv[0] = NULL;
+}
+
+/*============================================================================
+ * SPAWNING
+ *============================================================================*/
+
+/**
+ * @brief posix_spawnp() with vfork semantics and optional file actions
+ */
+static int spawn_with_actions(char *const argv[], const posix_spawn_file_actions_t *actions,
+                              pid_t *pid) {
+    posix_spawnattr_t attr;
+
+    if (!argv || !argv[0] || !pid) {
+        return EINVAL;
+    }
+
+    // The child writes to the same descriptors; keep our output before its
+    fflush(NULL);
+
+    int result = posix_spawnattr_init(&attr);
+    if (result != 0) {
+        return result;
+    }
+#ifdef POSIX_SPAWN_USEVFORK
+    // Implied by current glibc; requested explicitly for older versions
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_USEVFORK);
+#endif
+
+    result = posix_spawnp(pid, argv[0], actions, &attr, argv, environ);
+    posix_spawnattr_destroy(&attr);
+    return result;
+}
+
+/**
+ * @brief Start argv[0] (searched in PATH) with arguments argv
+ * @param argv NULL-terminated argument vector
+ * @param[out] pid Child process id
+ * @return 0 or the errno of the failed spawn (ENOENT if not found, ...)
+ */
+int launcher_spawn(char *const argv[], pid_t *pid) {
+    return spawn_with_actions(argv, NULL, pid);
+}
+
+/**
+ * @brief Spawn argv with some of its standard descriptors redirected
+ * @param stdin_fd, stdout_fd, stderr_fd Descriptor to install as fd 0, 1
+ *        and 2 in the child, or -1 to inherit ours
+ * @param[out] pid Child process id
+ *
+ * The child gets its own copies of the descriptors. Close ours once this
+ * returns: while the parent still holds the write end of a pipe, whoever
+ * reads the other end never sees end of file.
+ */
+int launcher_spawn_fds(char *const argv[], int stdin_fd, int stdout_fd, int stderr_fd,
+                       pid_t *pid) {
+    const int sources[] = { stdin_fd, stdout_fd, stderr_fd };
+    const int targets[] = { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO };
+    posix_spawn_file_actions_t actions;
+
+    int result = posix_spawn_file_actions_init(&actions);
+    if (result != 0) {
+        return result;
+    }
+    // dup2 clears close-on-exec on the child's copy only
+    for (int i = 0; i < 3 && result == 0; i++) {
+        if (sources[i] >= 0) {
+            result = posix_spawn_file_actions_adddup2(&actions, sources[i], targets[i]);
+        }
+    }
+    if (result == 0) {
+        result = spawn_with_actions(argv, &actions, pid);
+    }
+    posix_spawn_file_actions_destroy(&actions);
+    return result;
+}
+
+/**
+ * @brief Wait for a child started by launcher_spawn()
+ * @param[out] status Raw wait status
+ */
+int launcher_wait(pid_t pid, int *status) {
+    return launcher_wait_usage(pid, status, NULL);
+}
+
+/**
+ * @brief Wait for a child and collect the resources it used
+ * @param[out] status Raw wait status
+ * @param[out] usage The child's rusage from wait4(), or NULL
+ */
+int launcher_wait_usage(pid_t pid, int *status, struct rusage *usage) {
+    while (wait4(pid, status, 0, usage) == -1) {
+        if (errno != EINTR) {
+            return errno;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Open a pidfd for a child, to wait for its exit with poll or epoll
+ * @return The descriptor, or -1 with errno set (ENOSYS before Linux 5.3)
+ */
+int launcher_pidfd_open(pid_t pid) {
+    return (int)syscall(SYS_pidfd_open, pid, 0);
+}
+
+/**
+ * @brief Spawn argv and wait for it
+ */
+static int run_usage(char *const argv[], int *status, struct rusage *usage) {
+    pid_t pid;
+
+    int result = launcher_spawn(argv, &pid);
+    if (result != 0) {
+        return result;
+    }
+    return launcher_wait_usage(pid, status, usage);
+}
+
+/**
+ * @brief Spawn argv and wait for it
+ * @param[out] status Raw wait status
+ */
+int launcher_run(char *const argv[], int *status) {
+    return run_usage(argv, status, NULL);
+}
+
+/**
+ * @brief Split a command line (see launcher_split()) and run it
+ * @param[out] status Raw wait status
+ */
+int launcher_run_line(const char *command, int *status) {
+    return launcher_run_line_usage(command, status, NULL);
+}
+
+/**
+ * @brief launcher_run_line(), also returning the child's resource usage
+ * @param[out] usage The child's rusage from wait4(), or NULL
+ */
+int launcher_run_line_usage(const char *command, int *status, struct rusage *usage) {
+    char *argv[LAUNCHER_MAX_ARGS];
+    int argc;
+
+    if (!command) {
+        return EINVAL;
+    }
+
+    char *line = strdup(command);
+    if (!line) {
+        return ENOMEM;
+    }
+
+    int result = launcher_split(line, argv, LAUNCHER_MAX_ARGS, &argc);
+    if (result == 0) {
+        result = run_usage(argv, status, usage);
+    }
+
+    free(line);
+    return result;
+}
+
+/*============================================================================
+ * OUTPUT CAPTURE
+ *============================================================================*/
+
+/**
+ * @brief Append one read() from fd to a growing output buffer
+ * @param[out] bytes Bytes appended; 0 at end of file
+ * @return 0 or the errno of the failed read (EAGAIN for an empty
+ *         non-blocking descriptor)
+ *
+ * The read asks for all the free space left, so once the buffer is large a
+ * read returns whatever the pipe holds (up to LAUNCHER_PIPE_SIZE). The data
+ * stays NUL-terminated after every call.
+ */
+int launcher_output_append(launcher_output_t *output, int fd, size_t *bytes) {
+    *bytes = 0;
+
+    // Keep one byte for the terminating NUL
+    if (output->capacity - output->length < LAUNCHER_READ_CHUNK + 1) {
+        size_t capacity = output->capacity ? output->capacity * 2 : LAUNCHER_READ_CHUNK * 2;
+        char *data = realloc(output->data, capacity);
+        if (!data) {
+            return ENOMEM;
+        }
+        output->data = data;
+        output->capacity = capacity;
+        output->data[output->length] = '\0';
+    }
+
+    ssize_t result;
+    do {
+        result = read(fd, output->data + output->length, output->capacity - output->length - 1);
+    } while (result == -1 && errno == EINTR);
+    if (result == -1) {
+        return errno;
+    }
+
+    output->length += (size_t)result;
+    output->data[output->length] = '\0';
+    *bytes = (size_t)result;
+    return 0;
+}
+
+/**
+ * @brief Read fd to end of file into a growing buffer
+ */
+static int read_to_end(int fd, launcher_output_t *output) {
+    size_t bytes;
+
+    do {
+        int result = launcher_output_append(output, fd, &bytes);
+        if (result != 0) {
+            return result;
+        }
+    } while (bytes > 0);
+    return 0;
+}
+
+/**
+ * @brief Capture through a pipe, drained while the child runs
+ */
+static int capture_pipe(char *const argv[], launcher_output_t *output, int *status,
+                        struct rusage *usage) {
+    int fds[2];
+    pid_t pid;
+
+    if (pipe2(fds, O_CLOEXEC) == -1) {
+        return errno;
+    }
+    // Best effort; unprivileged callers are limited by pipe-max-size
+    fcntl(fds[0], F_SETPIPE_SZ, LAUNCHER_PIPE_SIZE);
+
+    int result = launcher_spawn_fds(argv, -1, fds[1], -1, &pid);
+    close(fds[1]);
+    if (result != 0) {
+        close(fds[0]);
+        return result;
+    }
+
+    result = read_to_end(fds[0], output);
+    // On a read error the child gets SIGPIPE instead of blocking forever
+    close(fds[0]);
+
+    int wait_result = launcher_wait_usage(pid, status, usage);
+    return result != 0 ? result : wait_result;
+}
+
+/**
+ * @brief Capture into a memory file, mapped after the child has exited
+ */
+static int capture_memfd(char *const argv[], launcher_output_t *output, int *status,
+                         struct rusage *usage) {
+    struct stat st;
+    pid_t pid;
+
+    int fd = memfd_create("launcher-output", MFD_CLOEXEC);
+    if (fd == -1) {
+        return errno;
+    }
+
+    int result = launcher_spawn_fds(argv, -1, fd, -1, &pid);
+    if (result == 0) {
+        result = launcher_wait_usage(pid, status, usage);
+    }
+    if (result == 0 && fstat(fd, &st) == -1) {
+        result = errno;
+    }
+    // Growing the file by one byte appends the NUL (new file space reads as zero)
+    if (result == 0 && ftruncate(fd, st.st_size + 1) == -1) {
+        result = errno;
+    }
+    if (result == 0) {
+        size_t size = (size_t)st.st_size + 1;
+        void *data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            result = errno;
+        } else {
+            output->data = data;
+            output->length = (size_t)st.st_size;
+            output->capacity = size;
+            output->mapped = 1;
+        }
+    }
+
+    close(fd);
+    return result;
+}
+
+/**
+ * @brief Run argv and capture its whole stdout, optionally with its rusage
+ */
+static int capture_usage(char *const argv[], launcher_capture_mode_t mode,
+                         launcher_output_t *output, int *status, struct rusage *usage) {
+    if (!output) {
+        return EINVAL;
+    }
+    memset(output, 0, sizeof(*output));
+
+    if (!argv || !argv[0] || !status) {
+        return EINVAL;
+    }
+
+    switch (mode) {
+    case LAUNCHER_CAPTURE_PIPE:
+        return capture_pipe(argv, output, status, usage);
+    case LAUNCHER_CAPTURE_MEMFD:
+        return capture_memfd(argv, output, status, usage);
+    }
+    return EINVAL;
+}
+
+/**
+ * @brief Run argv and capture its whole stdout
+ * @param mode LAUNCHER_CAPTURE_PIPE or LAUNCHER_CAPTURE_MEMFD
+ * @param[out] output Captured output; free with launcher_output_free()
+ *             whatever the result
+ * @param[out] status Raw wait status
+ */
+int launcher_capture(char *const argv[], launcher_capture_mode_t mode,
+                     launcher_output_t *output, int *status) {
+    return capture_usage(argv, mode, output, status, NULL);
+}
+
+/**
+ * @brief Split a command line (see launcher_split()) and capture its stdout
+ */
+int launcher_capture_line(const char *command, launcher_capture_mode_t mode,
+                          launcher_output_t *output, int *status) {
+    return launcher_capture_line_usage(command, mode, output, status, NULL);
+}
+
+/**
+ * @brief launcher_capture_line(), also returning the child's resource usage
+ * @param[out] usage The child's rusage from wait4(), or NULL
+ */
+int launcher_capture_line_usage(const char *command, launcher_capture_mode_t mode,
+                                launcher_output_t *output, int *status,
+                                struct rusage *usage) {
+    char *argv[LAUNCHER_MAX_ARGS];
+    int argc;
+
+    if (!output) {
+        return EINVAL;
+    }
+    memset(output, 0, sizeof(*output));
+
+    if (!command) {
+        return EINVAL;
+    }
+
+    char *line = strdup(command);
+    if (!line) {
+        return ENOMEM;
+    }
+
+    int result = launcher_split(line, argv, LAUNCHER_MAX_ARGS, &argc);
+    if (result == 0) {
+        result = capture_usage(argv, mode, output, status, usage);
+    }
+
+    free(line);
+    return result;
+}
+
+/**
+ * @brief Release captured output; safe on a zeroed or already freed output
+ */
+void launcher_output_free(launcher_output_t *output) {
+    if (!output || !output->data) {
+        return;
+    }
+    if (output->mapped) {
+        munmap(output->data, output->capacity);
+    } else {
+        free(output->data);
+    }
+    memset(output, 0, sizeof(*output));
+}
+
+const char *launcher_capture_mode_name(launcher_capture_mode_t mode) {
+    switch (mode) {
+    case LAUNCHER_CAPTURE_PIPE:
+        return "pipe";
+    case LAUNCHER_CAPTURE_MEMFD:
+        return "memfd";
+    }
+    return "unknown";
+}
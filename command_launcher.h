@@ -0,0 +1,115 @@
+/**
+ * @file command_launcher.h
+ * @brief Shell-free command launcher built on posix_spawn
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * system() runs every command as `/bin/sh -c "..."`: a fork of the whole
+ * caller, an exec of the shell, the shell's own startup and then a second
+ * fork/exec for the command itself. The launcher execs argv directly:
+ * - posix_spawnp() searches PATH and starts the program in one step; glibc
+ *   implements it with vfork semantics (CLONE_VM | CLONE_VFORK), so the
+ *   caller's page tables are never copied, however large it is
+ * - no shell is involved, so arguments are never re-parsed and shell
+ *   injection is impossible
+ *
+ * launcher_split() turns a simple command line into argv for callers that
+ * still hold commands as strings. It understands whitespace and quotes
+ * only; anything that needs a shell (pipes, redirections, variables,
+ * globs, ...) is rejected with EINVAL instead of being passed through.
+ *
+ * launcher_capture() runs a command and returns everything it wrote to
+ * stdout as one pointer and length, never truncated and never scanned:
+ * - LAUNCHER_CAPTURE_PIPE: stdout is a pipe, drained with large read()
+ *   calls straight into a buffer that grows geometrically
+ * - LAUNCHER_CAPTURE_MEMFD: stdout is an anonymous memory file; the child
+ *   writes into it directly and the parent maps it once the child has
+ *   exited, so the parent copies nothing at all
+ * Either way the data is followed by a NUL byte (not counted in length), so
+ * text output can be used as a C string.
+ *
+ * The *_usage variants also return the child's resource usage as reported
+ * by wait4() (CPU time, peak RSS, context switches); pass NULL to skip it.
+ *
+ * All functions return 0 or an errno code. Wait statuses are raw waitpid()
+ * statuses; inspect them with WIFEXITED()/WEXITSTATUS().
+ */
+
+#ifndef COMMAND_LAUNCHER_H
+#define COMMAND_LAUNCHER_H
+
+#include <sys/resource.h>
+#include <sys/types.h>
+
+/*============================================================================
+ * CONSTANTS
+ *============================================================================*/
+
+/** Maximum words launcher_run_line() accepts, including the program name */
+#define LAUNCHER_MAX_ARGS 64
+
+/** Minimum free space for a read() from a capture pipe; the buffer doubles below it */
+#define LAUNCHER_READ_CHUNK (64 * 1024)
+
+/** Requested capture pipe size (the default 64 KB costs a wakeup per 64 KB) */
+#define LAUNCHER_PIPE_SIZE (1 << 20)
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+/** How launcher_capture() collects the child's stdout */
+typedef enum {
+    LAUNCHER_CAPTURE_PIPE,
+    LAUNCHER_CAPTURE_MEMFD
+} launcher_capture_mode_t;
+
+/**
+ * @brief Captured output; release with launcher_output_free()
+ */
+typedef struct {
+    char *data;                 /**< Output followed by a NUL byte */
+    size_t length;              /**< Bytes of output, excluding the NUL */
+    size_t capacity;            /**< Bytes allocated or mapped at data */
+    int mapped;                 /**< data is a mapping rather than malloc'd */
+} launcher_output_t;
+
+/**
+ * @brief A command line split into words that live as long as it does;
+ *        release with launcher_command_release()
+ */
+typedef struct {
+    char *line;                         /**< Owned copy the words point into */
+    char *argv[LAUNCHER_MAX_ARGS];      /**< Words, followed by a NULL */
+} launcher_command_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+int launcher_split(char *line, char *argv[], int max_args, int *argc);
+int launcher_command_init(launcher_command_t *command, const char *line);
+void launcher_command_release(launcher_command_t *command);
+
+int launcher_spawn(char *const argv[], pid_t *pid);
+int launcher_spawn_fds(char *const argv[], int stdin_fd, int stdout_fd, int stderr_fd,
+                       pid_t *pid);
+int launcher_wait(pid_t pid, int *status);
+int launcher_wait_usage(pid_t pid, int *status, struct rusage *usage);
+int launcher_pidfd_open(pid_t pid);
+int launcher_run(char *const argv[], int *status);
+int launcher_run_line(const char *command, int *status);
+int launcher_run_line_usage(const char *command, int *status, struct rusage *usage);
+
+int launcher_capture(char *const argv[], launcher_capture_mode_t mode,
+                     launcher_output_t *output, int *status);
+int launcher_capture_line(const char *command, launcher_capture_mode_t mode,
+                          launcher_output_t *output, int *status);
+int launcher_capture_line_usage(const char *command, launcher_capture_mode_t mode,
+                                launcher_output_t *output, int *status,
+                                struct rusage *usage);
+int launcher_output_append(launcher_output_t *output, int fd, size_t *bytes);
+void launcher_output_free(launcher_output_t *output);
+const char *launcher_capture_mode_name(launcher_capture_mode_t mode);
+
+#endif /* COMMAND_LAUNCHER_H */
@@ -0,0 +1,245 @@
+/**
+ * @file command_pipeline.c
+ * @brief Pipelines of posix_spawn'ed stages connected with pipe2()
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#define _GNU_SOURCE
+
+#include "command_pipeline.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*============================================================================
+ * BUILDING
+ *============================================================================*/
+
+/**
+ * @brief Start an empty pipeline
+ */
+void pipeline_init(pipeline_t *pipeline, int stop_early) {
+    memset(pipeline, 0, sizeof(*pipeline));
+    pipeline->stop_early = stop_early;
+}
+
+/**
+ * @brief Append a stage; argv must stay valid until the pipeline has run
+ * @return 0, EINVAL, or E2BIG if the pipeline already has
+ *         PIPELINE_MAX_STAGES stages
+ */
+int pipeline_add(pipeline_t *pipeline, char **argv) {
+    if (!pipeline || !argv || !argv[0]) {
+        return EINVAL;
+    }
+    if (pipeline->count == PIPELINE_MAX_STAGES) {
+        return E2BIG;
+    }
+    pipeline->stages[pipeline->count++] = argv;
+    return 0;
+}
+
+/**
+ * @brief Build a pipeline from a line such as "ps aux | head -10"
+ * @return 0, EINVAL for shell syntax or an empty stage, E2BIG or ENOMEM;
+ *         the pipeline needs no release on failure
+ */
+int pipeline_parse(pipeline_t *pipeline, const char *command, int stop_early) {
+    char *segments[PIPELINE_MAX_STAGES];
+    int segment_count = 0;
+    int result = 0;
+
+    pipeline_init(pipeline, stop_early);
+    if (!command) {
+        return EINVAL;
+    }
+    pipeline->line = strdup(command);
+    if (!pipeline->line) {
+        return ENOMEM;
+    }
+
+    // Cut at every '|' outside quotes; launcher_split() handles the rest
+    char quote = '\0';
+    char *start = pipeline->line;
+    for (char *c = pipeline->line;; c++) {
+        if (*c == '\0' || (*c == '|' && !quote)) {
+            if (segment_count == PIPELINE_MAX_STAGES) {
+                result = E2BIG;
+                break;
+            }
+            segments[segment_count++] = start;
+            if (*c == '\0') {
+                break;
+            }
+            *c = '\0';
+            start = c + 1;
+        } else if (quote && *c == quote) {
+            quote = '\0';
+        } else if (!quote && (*c == '\'' || *c == '"')) {
+            quote = *c;
+        }
+    }
+
+    int used = 0;
+    const int capacity = (int)(sizeof(pipeline->words) / sizeof(pipeline->words[0]));
+    for (int i = 0; i < segment_count && result == 0; i++) {
+        int argc;
+        result = launcher_split(segments[i], &pipeline->words[used], capacity - used, &argc);
+        if (result == 0 && argc == 0) {
+            result = EINVAL;
+        }
+        if (result == 0) {
+            pipeline->stages[pipeline->count++] = &pipeline->words[used];
+            used += argc + 1;
+        }
+    }
+
+    if (result != 0) {
+        pipeline_release(pipeline);
+    }
+    return result;
+}
+
+/**
+ * @brief Free what pipeline_parse() allocated
+ */
+void pipeline_release(pipeline_t *pipeline) {
+    free(pipeline->line);
+    pipeline->line = NULL;
+    pipeline->count = 0;
+}
+
+/*============================================================================
+ * RUNNING
+ *============================================================================*/
+
+/**
+ * @brief Connect the stages with pipes and spawn them all
+ * @param stdout_fd Last stage's stdout, or -1 to inherit ours
+ * @return 0, or an errno code once every stage already started is reaped
+ */
+static int launch_stages(pipeline_t *pipeline, int stdout_fd) {
+    int input = -1;
+    int started = 0;
+    int result = 0;
+
+    for (int i = 0; i < pipeline->count && result == 0; i++) {
+        int fds[2] = { -1, -1 };
+        int output = stdout_fd;
+
+        if (i < pipeline->count - 1) {
+            if (pipe2(fds, O_CLOEXEC) == -1) {
+                result = errno;
+                break;
+            }
+            output = fds[1];
+        }
+        result = launcher_spawn_fds(pipeline->stages[i], input, output, -1, &pipeline->pids[i]);
+        if (result == 0) {
+            started++;
+        }
+
+        // Both ends are the children's now (see launcher_spawn_fds())
+        if (input >= 0) {
+            close(input);
+        }
+        if (fds[1] >= 0) {
+            close(fds[1]);
+        }
+        input = fds[0];
+    }
+    if (input >= 0) {
+        close(input);
+    }
+
+    if (result != 0) {
+        for (int i = 0; i < started; i++) {
+            kill(pipeline->pids[i], SIGKILL);
+            launcher_wait(pipeline->pids[i], &pipeline->statuses[i]);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Reap every stage, the last one first
+ */
+static int wait_stages(pipeline_t *pipeline, int *status) {
+    int last = pipeline->count - 1;
+
+    int result = launcher_wait(pipeline->pids[last], &pipeline->statuses[last]);
+    for (int i = 0; i < last; i++) {
+        // Unreaped, so the pid cannot have been reused; exited stages ignore it
+        if (pipeline->stop_early) {
+            kill(pipeline->pids[i], SIGPIPE);
+        }
+        int wait_result = launcher_wait(pipeline->pids[i], &pipeline->statuses[i]);
+        if (result == 0) {
+            result = wait_result;
+        }
+    }
+    *status = pipeline->statuses[last];
+    return result;
+}
+
+/**
+ * @brief Run the pipeline with the last stage writing to our stdout
+ * @param[out] status Raw wait status of the last stage
+ */
+int pipeline_run(pipeline_t *pipeline, int *status) {
+    if (!pipeline || pipeline->count == 0 || !status) {
+        return EINVAL;
+    }
+
+    int result = launch_stages(pipeline, -1);
+    if (result != 0) {
+        return result;
+    }
+    return wait_stages(pipeline, status);
+}
+
+/**
+ * @brief Run the pipeline and capture everything its last stage writes
+ * @param[out] output Captured output; free with launcher_output_free()
+ *             whatever the result
+ * @param[out] status Raw wait status of the last stage
+ */
+int pipeline_capture(pipeline_t *pipeline, launcher_output_t *output, int *status) {
+    int fds[2];
+
+    if (!output) {
+        return EINVAL;
+    }
+    memset(output, 0, sizeof(*output));
+    if (!pipeline || pipeline->count == 0 || !status) {
+        return EINVAL;
+    }
+
+    if (pipe2(fds, O_CLOEXEC) == -1) {
+        return errno;
+    }
+    // Best effort: fewer wakeups for large outputs
+    fcntl(fds[0], F_SETPIPE_SZ, LAUNCHER_PIPE_SIZE);
+
+    int result = launch_stages(pipeline, fds[1]);
+    close(fds[1]);
+    if (result != 0) {
+        close(fds[0]);
+        return result;
+    }
+
+    size_t bytes;
+    do {
+        result = launcher_output_append(output, fds[0], &bytes);
+    } while (result == 0 && bytes > 0);
+    // On a read error the last stage gets SIGPIPE instead of blocking forever
+    close(fds[0]);
+
+    int wait_result = wait_stages(pipeline, status);
+    return result != 0 ? result : wait_result;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file command_pipeline.h
+ * @brief Shell-free multi-stage pipelines (a | b | c) built on posix_spawn
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * A pipeline is a list of argv arrays. pipeline_run() and pipeline_capture()
+ * connect consecutive stages with pipe2() and start every stage with the
+ * posix_spawn launcher (command_launcher.h), which is all `sh -c "a | b"`
+ * does after it has started and parsed the line. Stages run concurrently;
+ * only the parent's end of the final output differs between the two
+ * (inherited stdout, or a captured buffer).
+ *
+ * As in the shell, a pipeline's status is its last stage's; every stage's
+ * own status is kept in statuses[].
+ *
+ * With stop_early set, the pipeline is over when its last stage exits:
+ * stages still running are sent SIGPIPE (what they would get on their next
+ * write) instead of being waited for. Without it, `tail -f log | head -1`
+ * only returns once tail writes again.
+ *
+ * pipeline_parse() builds a pipeline from a line such as "ps aux | head -10":
+ * '|' outside quotes separates stages, each split as launcher_split() does;
+ * any other shell syntax is refused with EINVAL.
+ *
+ * All functions return 0 or an errno code.
+ */
+
+#ifndef COMMAND_PIPELINE_H
+#define COMMAND_PIPELINE_H
+
+#include <sys/types.h>
+
+#include "command_launcher.h"
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+/** Maximum number of stages in a pipeline */
+#define PIPELINE_MAX_STAGES 16
+
+/**
+ * @brief Stages of a pipeline and, after it has run, their results
+ */
+typedef struct {
+    char **stages[PIPELINE_MAX_STAGES];     /**< argv of each stage, in order */
+    int count;
+    int stop_early;                         /**< SIGPIPE earlier stages once the last exits */
+    pid_t pids[PIPELINE_MAX_STAGES];
+    int statuses[PIPELINE_MAX_STAGES];      /**< Raw wait status of each stage */
+
+    /** Internal: owned copy of a parsed line and its words */
+    char *line;
+    char *words[LAUNCHER_MAX_ARGS + PIPELINE_MAX_STAGES];
+} pipeline_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+void pipeline_init(pipeline_t *pipeline, int stop_early);
+int pipeline_add(pipeline_t *pipeline, char **argv);
+int pipeline_parse(pipeline_t *pipeline, const char *command, int stop_early);
+void pipeline_release(pipeline_t *pipeline);
+
+int pipeline_run(pipeline_t *pipeline, int *status);
+int pipeline_capture(pipeline_t *pipeline, launcher_output_t *output, int *status);
+
+#endif /* COMMAND_PIPELINE_H */
@@ -0,0 +1,317 @@
+/**
+ * @file command_runner.c
+ * @brief Parallel command runner: one epoll loop over output pipes and pidfds
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#define _GNU_SOURCE
+
+#include "command_runner.h"
+#include "clock_ns.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/wait.h>
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+/** Events fetched per epoll_wait() call */
+#define RUNNER_MAX_EVENTS 64
+
+/**
+ * Descriptors of a running job. The epoll data of each descriptor is
+ * (job index << SOURCE_BITS) | source.
+ */
+enum {
+    SOURCE_STDOUT = 0,
+    SOURCE_STDERR = 1,
+    SOURCE_PIDFD = 2,
+    SOURCE_COUNT = 3,
+    SOURCE_BITS = 2
+};
+
+/**
+ * @brief Runner-private state of one job
+ */
+typedef struct {
+    pid_t pid;
+    int fds[SOURCE_COUNT];      /**< -1 once closed */
+    int open;                   /**< Descriptors still open */
+    long long start_ns;
+} job_state_t;
+
+/*============================================================================
+ * UTILITY FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Close one descriptor of a job and take it out of the epoll set
+ */
+static void close_source(int epoll_fd, job_state_t *state, int source) {
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, state->fds[source], NULL);
+    close(state->fds[source]);
+    state->fds[source] = -1;
+    state->open--;
+}
+
+/*============================================================================
+ * JOBS
+ *============================================================================*/
+
+/**
+ * @brief Prepare a job from a command line (see launcher_split())
+ * @return 0, or EINVAL/E2BIG/ENOMEM; the job needs no release on failure
+ */
+int runner_job_init(runner_job_t *job, const char *command) {
+    memset(job, 0, sizeof(*job));
+    int result = launcher_command_init(&job->command, command);
+    if (result == 0) {
+        job->argv = job->command.argv;
+    }
+    return result;
+}
+
+/**
+ * @brief Free a job's command and captured output
+ */
+void runner_job_release(runner_job_t *job) {
+    launcher_output_free(&job->out);
+    launcher_output_free(&job->err);
+    launcher_command_release(&job->command);
+    job->argv = NULL;
+}
+
+/**
+ * @brief Spawn a job with piped stdout/stderr and register it with epoll
+ * @return 0 if the job is running; otherwise job->error is set and the job
+ *         is already complete
+ */
+static int start_job(int epoll_fd, runner_job_t *job, job_state_t *state, int index) {
+    int out_pipe[2] = { -1, -1 };
+    int err_pipe[2] = { -1, -1 };
+    int result = 0;
+
+    launcher_output_free(&job->out);
+    launcher_output_free(&job->err);
+    job->status = 0;
+    job->error = 0;
+    job->elapsed_ns = 0;
+    state->start_ns = now_ns();
+    state->open = 0;
+
+    if (pipe2(out_pipe, O_CLOEXEC) == -1 || pipe2(err_pipe, O_CLOEXEC) == -1) {
+        result = errno;
+    }
+    if (result == 0) {
+        result = launcher_spawn_fds(job->argv, -1, out_pipe[1], err_pipe[1], &state->pid);
+    }
+    if (out_pipe[1] >= 0) {
+        close(out_pipe[1]);
+    }
+    if (err_pipe[1] >= 0) {
+        close(err_pipe[1]);
+    }
+    if (result != 0) {
+        if (out_pipe[0] >= 0) {
+            close(out_pipe[0]);
+        }
+        if (err_pipe[0] >= 0) {
+            close(err_pipe[0]);
+        }
+        job->error = result;
+        return result;
+    }
+
+    state->fds[SOURCE_STDOUT] = out_pipe[0];
+    state->fds[SOURCE_STDERR] = err_pipe[0];
+    state->fds[SOURCE_PIDFD] = launcher_pidfd_open(state->pid);
+    if (state->fds[SOURCE_PIDFD] == -1) {
+        result = errno;
+    }
+
+    for (int source = 0; source < SOURCE_COUNT && result == 0; source++) {
+        struct epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN;
+        event.data.u64 = ((uint64_t)index << SOURCE_BITS) | (uint64_t)source;
+
+        // Only the parent's (read) side is non-blocking
+        if (source != SOURCE_PIDFD) {
+            fcntl(state->fds[source], F_SETFL, O_NONBLOCK);
+        }
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, state->fds[source], &event) == -1) {
+            result = errno;
+        }
+    }
+
+    if (result != 0) {
+        // Cannot supervise it: stop the child and reap it here
+        for (int source = 0; source < SOURCE_COUNT; source++) {
+            if (state->fds[source] >= 0) {
+                epoll_ctl(epoll_fd, EPOLL_CTL_DEL, state->fds[source], NULL);
+                close(state->fds[source]);
+                state->fds[source] = -1;
+            }
+        }
+        kill(state->pid, SIGKILL);
+        launcher_wait(state->pid, &job->status);
+        job->error = result;
+        return result;
+    }
+
+    state->open = SOURCE_COUNT;
+    return 0;
+}
+
+/**
+ * @brief Handle readiness of one descriptor of a running job
+ */
+static void handle_event(int epoll_fd, runner_job_t *job, job_state_t *state, int source) {
+    if (source == SOURCE_PIDFD) {
+        // Readable pidfd: the child has exited, so this does not block
+        int result = launcher_wait(state->pid, &job->status);
+        if (result != 0 && job->error == 0) {
+            job->error = result;
+        }
+        close_source(epoll_fd, state, source);
+        return;
+    }
+
+    launcher_output_t *output = (source == SOURCE_STDOUT) ? &job->out : &job->err;
+    size_t bytes;
+    int result = launcher_output_append(output, state->fds[source], &bytes);
+    if (result == EAGAIN) {
+        return;
+    }
+    if (result != 0 && job->error == 0) {
+        job->error = result;
+    }
+    // End of file, or an error after which the pipe is given up
+    if (result != 0 || bytes == 0) {
+        close_source(epoll_fd, state, source);
+    }
+}
+
+/**
+ * @brief Stop and reap every running job after the event loop itself failed
+ */
+static void abandon_jobs(int epoll_fd, runner_job_t *jobs, job_state_t *states, int count,
+                         int error) {
+    for (int i = 0; i < count; i++) {
+        job_state_t *state = &states[i];
+        if (state->open == 0) {
+            continue;
+        }
+        if (state->fds[SOURCE_PIDFD] >= 0) {
+            kill(state->pid, SIGKILL);
+            launcher_wait(state->pid, &jobs[i].status);
+        }
+        for (int source = 0; source < SOURCE_COUNT; source++) {
+            if (state->fds[source] >= 0) {
+                close_source(epoll_fd, state, source);
+            }
+        }
+        jobs[i].error = error;
+        jobs[i].elapsed_ns = now_ns() - state->start_ns;
+    }
+}
+
+/*============================================================================
+ * RUNNER
+ *============================================================================*/
+
+/**
+ * @brief Run every job, at most max_parallel at a time
+ * @param jobs Jobs prepared with runner_job_init(); results are stored in them
+ * @param count Number of jobs
+ * @param max_parallel Maximum number of jobs running at once (> 0)
+ * @return 0 once every job has completed (see each job's error and status),
+ *         or an errno code if the runner itself could not be set up or its
+ *         event loop failed; running jobs are then killed and reaped, and
+ *         they and the jobs never started get that code as their error
+ */
+int runner_run(runner_job_t *jobs, int count, int max_parallel) {
+    struct epoll_event events[RUNNER_MAX_EVENTS];
+
+    if (!jobs || count < 0 || max_parallel < 1) {
+        return EINVAL;
+    }
+    if (count == 0) {
+        return 0;
+    }
+
+    job_state_t *states = calloc((size_t)count, sizeof(job_state_t));
+    if (!states) {
+        return ENOMEM;
+    }
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd == -1) {
+        int result = errno;
+        free(states);
+        return result;
+    }
+
+    int next = 0;
+    int running = 0;
+    int completed = 0;
+    int result = 0;
+
+    while (completed < count) {
+        while (next < count && running < max_parallel) {
+            if (start_job(epoll_fd, &jobs[next], &states[next], next) == 0) {
+                running++;
+            } else {
+                jobs[next].elapsed_ns = now_ns() - states[next].start_ns;
+                completed++;
+            }
+            next++;
+        }
+        if (running == 0) {
+            continue;
+        }
+
+        int ready = epoll_wait(epoll_fd, events, RUNNER_MAX_EVENTS, -1);
+        if (ready == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // Without the loop nothing can be supervised: stop what is running
+            result = errno;
+            abandon_jobs(epoll_fd, jobs, states, next, result);
+            for (; next < count; next++) {
+                jobs[next].error = result;
+            }
+            break;
+        }
+
+        for (int i = 0; i < ready; i++) {
+            int index = (int)(events[i].data.u64 >> SOURCE_BITS);
+            int source = (int)(events[i].data.u64 & ((1u << SOURCE_BITS) - 1));
+            job_state_t *state = &states[index];
+
+            // Stale event for a descriptor closed earlier in this batch
+            if (state->fds[source] == -1) {
+                continue;
+            }
+            handle_event(epoll_fd, &jobs[index], state, source);
+            if (state->open == 0) {
+                jobs[index].elapsed_ns = now_ns() - state->start_ns;
+                running--;
+                completed++;
+            }
+        }
+    }
+
+    close(epoll_fd);
+    free(states);
+    return result;
+}
@@ -0,0 +1,54 @@
+/**
+ * @file command_runner.h
+ * @brief Run many commands concurrently, multiplexing their output with epoll
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * runner_run() starts the jobs of an array in order, keeping at most
+ * max_parallel of them running, and returns when every job has finished.
+ * A single thread (the caller) drives everything from one epoll set:
+ * - each child's stdout and stderr are non-blocking pipes whose contents
+ *   are appended to the job's own growing buffers as they arrive, so a
+ *   chatty child never blocks on a full pipe
+ * - each child has a pidfd, which becomes readable when the child exits,
+ *   so exits are noticed without SIGCHLD handlers or polling
+ * A job is complete once its process has been reaped and both pipes have
+ * reached end of file; the next pending job is started in its place.
+ *
+ * Jobs are spawned with the posix_spawn launcher (command_launcher.h), so
+ * commands run without a shell. Requires Linux 5.3 or later for pidfds.
+ */
+
+#ifndef COMMAND_RUNNER_H
+#define COMMAND_RUNNER_H
+
+#include "command_launcher.h"
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+/**
+ * @brief One command and, after runner_run(), its result
+ */
+typedef struct {
+    char **argv;                /**< Command to run; set by runner_job_init() */
+    launcher_output_t out;      /**< Everything written to stdout */
+    launcher_output_t err;      /**< Everything written to stderr */
+    int status;                 /**< Raw wait status */
+    int error;                  /**< errno if the job could not run, else 0 */
+    long long elapsed_ns;       /**< Spawn to completion */
+
+    launcher_command_t command; /**< Internal: owns the words of argv */
+} runner_job_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+int runner_job_init(runner_job_t *job, const char *command);
+void runner_job_release(runner_job_t *job);
+
+int runner_run(runner_job_t *jobs, int count, int max_parallel);
+
+#endif /* COMMAND_RUNNER_H */
@@ -0,0 +1,304 @@
+/**
+ * @file command_stats.c
+ * @brief Per-command rusage and wall-time histograms, table and CSV output
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#define _GNU_SOURCE
+
+#include "command_stats.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+
+#include "latency_histogram.h"
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+/** Metrics recorded for every run, each in its own histogram */
+enum {
+    METRIC_WALL,
+    METRIC_USER,
+    METRIC_SYSTEM,
+    METRIC_MAX_RSS,
+    METRIC_VOLUNTARY,
+    METRIC_INVOLUNTARY,
+    METRIC_COUNT
+};
+
+static const struct {
+    const char *name;
+    const char *unit;
+} metrics[METRIC_COUNT] = {
+    { "wall", "ns" },
+    { "user_cpu", "ns" },
+    { "sys_cpu", "ns" },
+    { "max_rss", "KiB" },
+    { "voluntary_switches", "count" },
+    { "involuntary_switches", "count" }
+};
+
+/**
+ * @brief Aggregate of every run of one command line of one kind
+ */
+typedef struct command_entry {
+    char command[COMMAND_STATS_NAME_LENGTH];
+    command_kind_t kind;
+    unsigned long runs;
+    unsigned long failures;         /**< Runs that did not exit with status 0 */
+    latency_histogram_t histograms[METRIC_COUNT];
+    struct command_entry *next;
+} command_entry_t;
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+static pthread_mutex_t stats_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** Entries in order of first run */
+static command_entry_t *first_entry = NULL;
+static command_entry_t *last_entry = NULL;
+
+/*============================================================================
+ * UTILITY FUNCTIONS
+ *============================================================================*/
+
+static const char *kind_name(command_kind_t kind) {
+    return kind == COMMAND_KIND_BUILTIN ? "builtin" : "external";
+}
+
+static uint64_t timeval_ns(const struct timeval *tv) {
+    long long ns = (long long)tv->tv_sec * 1000000000LL + (long long)tv->tv_usec * 1000LL;
+    return ns > 0 ? (uint64_t)ns : 0;
+}
+
+static uint64_t non_negative(long value) {
+    return value > 0 ? (uint64_t)value : 0;
+}
+
+static void timeval_subtract(const struct timeval *a, const struct timeval *b,
+                             struct timeval *result) {
+    result->tv_sec = a->tv_sec - b->tv_sec;
+    result->tv_usec = a->tv_usec - b->tv_usec;
+    if (result->tv_usec < 0) {
+        result->tv_sec--;
+        result->tv_usec += 1000000;
+    }
+}
+
+/**
+ * @brief Find or create the entry of a command (stats_mutex held)
+ */
+static command_entry_t *find_entry(const char *command, command_kind_t kind) {
+    char name[COMMAND_STATS_NAME_LENGTH];
+    snprintf(name, sizeof(name), "%s", command);
+
+    for (command_entry_t *entry = first_entry; entry; entry = entry->next) {
+        if (entry->kind == kind && strcmp(entry->command, name) == 0) {
+            return entry;
+        }
+    }
+
+    command_entry_t *entry = calloc(1, sizeof(command_entry_t));
+    if (!entry) {
+        return NULL;
+    }
+    memcpy(entry->command, name, sizeof(name));
+    entry->kind = kind;
+    for (int i = 0; i < METRIC_COUNT; i++) {
+        latency_histogram_init(&entry->histograms[i]);
+    }
+    if (last_entry) {
+        last_entry->next = entry;
+    } else {
+        first_entry = entry;
+    }
+    last_entry = entry;
+    return entry;
+}
+
+/**
+ * @brief Write a CSV field, quoted if it needs to be
+ */
+static void write_csv_field(FILE *out, const char *text) {
+    if (!strpbrk(text, ",\"\n")) {
+        fputs(text, out);
+        return;
+    }
+    fputc('"', out);
+    for (const char *c = text; *c; c++) {
+        if (*c == '"') {
+            fputc('"', out);
+        }
+        fputc(*c, out);
+    }
+    fputc('"', out);
+}
+
+/*============================================================================
+ * RECORDING
+ *============================================================================*/
+
+/**
+ * @brief Record one run of a command
+ * @param command Command line; runs are aggregated per line and kind
+ * @param status Wait status; anything but exit status 0 counts as a failure
+ * @param wall_ns Wall-clock time from start to completion
+ * @param usage Resources used by the run; NULL records wall time only
+ */
+void command_stats_record(const char *command, command_kind_t kind, int status,
+                          long long wall_ns, const struct rusage *usage) {
+    if (!command) {
+        return;
+    }
+
+    pthread_mutex_lock(&stats_mutex);
+    command_entry_t *entry = find_entry(command, kind);
+    if (entry) {
+        entry->runs++;
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            entry->failures++;
+        }
+        latency_histogram_record(&entry->histograms[METRIC_WALL],
+                                 wall_ns > 0 ? (uint64_t)wall_ns : 0);
+        if (usage) {
+            latency_histogram_record(&entry->histograms[METRIC_USER],
+                                     timeval_ns(&usage->ru_utime));
+            latency_histogram_record(&entry->histograms[METRIC_SYSTEM],
+                                     timeval_ns(&usage->ru_stime));
+            // Linux reports ru_maxrss in KiB
+            latency_histogram_record(&entry->histograms[METRIC_MAX_RSS],
+                                     non_negative(usage->ru_maxrss));
+            latency_histogram_record(&entry->histograms[METRIC_VOLUNTARY],
+                                     non_negative(usage->ru_nvcsw));
+            latency_histogram_record(&entry->histograms[METRIC_INVOLUNTARY],
+                                     non_negative(usage->ru_nivcsw));
+        }
+    }
+    pthread_mutex_unlock(&stats_mutex);
+}
+
+/**
+ * @brief Resources the calling thread used since a getrusage(RUSAGE_THREAD)
+ * @param before Reading taken before the work
+ * @param[out] usage Difference, in the form wait4() reports for a child;
+ *             ru_maxrss is the growth of the process's peak RSS
+ */
+void command_stats_usage_since(const struct rusage *before, struct rusage *usage) {
+    struct rusage now;
+
+    getrusage(RUSAGE_THREAD, &now);
+    memset(usage, 0, sizeof(*usage));
+    timeval_subtract(&now.ru_utime, &before->ru_utime, &usage->ru_utime);
+    timeval_subtract(&now.ru_stime, &before->ru_stime, &usage->ru_stime);
+    usage->ru_maxrss = now.ru_maxrss - before->ru_maxrss;
+    usage->ru_nvcsw = now.ru_nvcsw - before->ru_nvcsw;
+    usage->ru_nivcsw = now.ru_nivcsw - before->ru_nivcsw;
+}
+
+/*============================================================================
+ * OUTPUT
+ *============================================================================*/
+
+/**
+ * @brief Print one line per command: runs, failures, wall-time p50/p99,
+ *        mean CPU times, median peak RSS and mean context switches
+ */
+void command_stats_report(FILE *out) {
+    pthread_mutex_lock(&stats_mutex);
+
+    fprintf(out, "%-20s %-8s %5s %5s %10s %10s %10s %10s %9s %7s\n", "command", "kind",
+            "runs", "fail", "wall p50", "wall p99", "user mean", "sys mean", "rss p50", "ctxsw");
+    for (command_entry_t *entry = first_entry; entry; entry = entry->next) {
+        const latency_histogram_t *h = entry->histograms;
+        char wall_p50[LATENCY_FORMAT_SIZE];
+        char wall_p99[LATENCY_FORMAT_SIZE];
+        char user[LATENCY_FORMAT_SIZE] = "-";
+        char sys[LATENCY_FORMAT_SIZE] = "-";
+        char rss[32] = "-";
+        char switches[32] = "-";
+
+        latency_format_ns(wall_p50, sizeof(wall_p50),
+                          latency_histogram_percentile(&h[METRIC_WALL], 50.0));
+        latency_format_ns(wall_p99, sizeof(wall_p99),
+                          latency_histogram_percentile(&h[METRIC_WALL], 99.0));
+        // Runs recorded without rusage leave these empty: "-", not zero
+        if (h[METRIC_USER].total_count > 0) {
+            latency_format_ns(user, sizeof(user),
+                              (uint64_t)latency_histogram_mean(&h[METRIC_USER]));
+        }
+        if (h[METRIC_SYSTEM].total_count > 0) {
+            latency_format_ns(sys, sizeof(sys),
+                              (uint64_t)latency_histogram_mean(&h[METRIC_SYSTEM]));
+        }
+        if (h[METRIC_MAX_RSS].total_count > 0) {
+            snprintf(rss, sizeof(rss), "%" PRIu64 "K",
+                     latency_histogram_percentile(&h[METRIC_MAX_RSS], 50.0));
+        }
+        if (h[METRIC_VOLUNTARY].total_count > 0) {
+            snprintf(switches, sizeof(switches), "%.1f",
+                     latency_histogram_mean(&h[METRIC_VOLUNTARY]) +
+                     latency_histogram_mean(&h[METRIC_INVOLUNTARY]));
+        }
+        fprintf(out, "%-20.20s %-8s %5lu %5lu %10s %10s %10s %10s %9s %7s\n",
+                entry->command, kind_name(entry->kind), entry->runs, entry->failures,
+                wall_p50, wall_p99, user, sys, rss, switches);
+    }
+
+    pthread_mutex_unlock(&stats_mutex);
+}
+
+/**
+ * @brief Dump every histogram as CSV: a header, then one row per command,
+ *        kind and metric with count, min, mean, p50, p90, p99 and max
+ * @return 0, or the errno of a failed write
+ */
+int command_stats_write_csv(FILE *out) {
+    pthread_mutex_lock(&stats_mutex);
+
+    fprintf(out, "command,kind,metric,unit,count,min,mean,p50,p90,p99,max\n");
+    for (command_entry_t *entry = first_entry; entry; entry = entry->next) {
+        for (int i = 0; i < METRIC_COUNT; i++) {
+            const latency_histogram_t *h = &entry->histograms[i];
+            if (h->total_count == 0) {
+                continue;
+            }
+            write_csv_field(out, entry->command);
+            fprintf(out, ",%s,%s,%s,%" PRIu64 ",%" PRIu64 ",%.1f,%" PRIu64 ",%" PRIu64
+                    ",%" PRIu64 ",%" PRIu64 "\n",
+                    kind_name(entry->kind), metrics[i].name, metrics[i].unit,
+                    h->total_count, h->min, latency_histogram_mean(h),
+                    latency_histogram_percentile(h, 50.0),
+                    latency_histogram_percentile(h, 90.0),
+                    latency_histogram_percentile(h, 99.0), h->max);
+        }
+    }
+
+    pthread_mutex_unlock(&stats_mutex);
+    return fflush(out) == 0 && !ferror(out) ? 0 : EIO;
+}
+
+/**
+ * @brief Forget every recorded run
+ */
+void command_stats_reset(void) {
+    pthread_mutex_lock(&stats_mutex);
+    command_entry_t *entry = first_entry;
+    while (entry) {
+        command_entry_t *next = entry->next;
+        free(entry);
+        entry = next;
+    }
+    first_entry = NULL;
+    last_entry = NULL;
+    pthread_mutex_unlock(&stats_mutex);
+}
@@ -0,0 +1,56 @@
+/**
+ * @file command_stats.h
+ * @brief Per-command resource accounting with latency histograms
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * Every run of a command is recorded with its wall-clock time and the
+ * resources it used: user and system CPU time, peak RSS and voluntary /
+ * involuntary context switches. For external commands these come from
+ * wait4() (see the launcher's *_usage functions); for builtins, which run
+ * in the calling thread, command_stats_usage_since() turns two
+ * getrusage(RUSAGE_THREAD) readings into the same form (peak RSS is then
+ * how much the builtin raised the process's peak, normally 0).
+ *
+ * Runs are aggregated per command line and kind (external or builtin)
+ * into latency histograms (latency_histogram.h), one per metric, so
+ * percentiles stay available however many runs are recorded. The
+ * aggregate can be printed as a table or dumped as CSV, one row per
+ * command, kind and metric.
+ *
+ * Thread-safe: recording takes a global mutex, which is cheap next to
+ * starting a process.
+ */
+
+#ifndef COMMAND_STATS_H
+#define COMMAND_STATS_H
+
+#include <stdio.h>
+#include <sys/resource.h>
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+/** Command lines longer than this are aggregated under their prefix */
+#define COMMAND_STATS_NAME_LENGTH 128
+
+/** How a command was run */
+typedef enum {
+    COMMAND_KIND_EXTERNAL,
+    COMMAND_KIND_BUILTIN
+} command_kind_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+void command_stats_record(const char *command, command_kind_t kind, int status,
+                          long long wall_ns, const struct rusage *usage);
+void command_stats_usage_since(const struct rusage *before, struct rusage *usage);
+
+void command_stats_report(FILE *out);
+int command_stats_write_csv(FILE *out);
+void command_stats_reset(void);
+
+#endif /* COMMAND_STATS_H */
@@ -20,8 +20,11 @@
  * - Bit fields in structures
  * - Multi-threading with pthread
  * - Mutex synchronization
+ * - Dependency-ordered jobs on a task graph worker pool
+ * - User-space fibers running thousands of small jobs on a few threads
+ * - Delayed and periodic jobs on a hierarchical timer wheel
  * - Conditional compilation with preprocessor
- * - System command execution
+ * - System command execution (posix_spawn without a shell, or builtins)
  * - Pointer operations and string handling
  * - Advanced bit manipulation techniques
  */
@@ -37,8 +40,24 @@
 #include <unistd.h>
 #include <string.h>
 #include <errno.h>
+#include <limits.h>
+#include <time.h>
+#include <sys/resource.h>
 #include <sys/wait.h>
 
+#include "atomic_counter.h"
+#include "builtin_commands.h"
+#include "command_launcher.h"
+#include "command_stats.h"
+#include "fiber.h"
+#include "futex_sync.h"
+#include "instrumented_mutex.h"
+#include "numa_topology.h"
+#include "path_cache.h"
+#include "task_graph.h"
+#include "timer_wheel.h"
+#include "workload.h"
+
 /*============================================================================
  * CONFIGURATION AND FEATURE FLAGS
  *============================================================================*/
@@ -50,6 +69,21 @@
 #define ENABLE_ADVANCED_FEATURES  1
 #define ENABLE_SYSTEM_COMMANDS    1
 
+// Pin worker threads round-robin to NUMA nodes
+#define ENABLE_NUMA_PLACEMENT     1
+
+// Run many small jobs as fibers on a few worker threads
+#define ENABLE_FIBER_JOBS         1
+
+// Report job progress from periodic timers and run a delayed job
+#define ENABLE_TIMER_JOBS         1
+
+// Answer echo/date/uname in-process instead of spawning them
+#define ENABLE_BUILTIN_COMMANDS   1
+
+// Account wall time and rusage of every command and report it per command
+#define ENABLE_COMMAND_STATS      1
+
 // Debug flags for conditional compilation (from generic01.c)
 #define DEBUG 0x00 + 0x10 + 0x20 + 0x40
 
@@ -74,18 +108,62 @@
 /** Loop iterations for thread work simulation */
 #define THREAD_WORK_ITERATIONS 0x1FFFFFF
 
+/**
+ * Lock batching for the threading demos: 0 holds global_mutex across the
+ * whole work loop; K > 0 accumulates locally and takes the lock only to
+ * flush every K iterations (see lock_batch_bench for throughput against K)
+ */
+#define LOCK_FLUSH_BATCH 4096
+
+/** Timer jobs: wheel tick, progress report period, delay of the one-shot job */
+#define TIMER_TICK_US 1000
+#define JOB_PROGRESS_INTERVAL_MS 100
+#define DELAYED_JOB_MS 150
+
+/** Worker threads running the counter task graph */
+#define MUTEX_DEMO_WORKERS 2
+
+/** Simple job work: shape (WORKLOAD_CPU, _MEMORY, _POINTER_CHASE) and duration */
+#define SIMPLE_JOB_SHAPE WORKLOAD_CPU
+#define SIMPLE_JOB_DURATION_MS 250
+
+/** Fiber job demonstration: jobs, worker threads, yields per job, work per slice */
+#define FIBER_JOB_COUNT 10000
+#define FIBER_JOB_WORKERS 4
+#define FIBER_JOB_SLICES 4
+#define FIBER_JOB_WORK 0x400
+
 /*============================================================================
  * GLOBAL VARIABLES FOR THREADING
  *============================================================================*/
 
 /** Shared counter for thread demonstrations */
-static volatile long shared_counter = 0;
+static atomic_counter_t shared_counter = ATOMIC_COUNTER_INITIALIZER(0);
 
 /** Counter for job tracking */
-static volatile int job_counter = 0;
+static atomic_counter_t job_counter = ATOMIC_COUNTER_INITIALIZER(0);
+
+/** Work units completed by the simple jobs, flushed under global_mutex */
+static atomic_counter_t job_work_done = ATOMIC_COUNTER_INITIALIZER(0);
+
+/** Calibrated work run by the simple jobs, one unit per iteration */
+static workload_t job_workload;
+
+/** When the timer jobs were scheduled, for reporting their delay */
+static long long timer_jobs_start_ns = 0;
+
+/** Completed fiber jobs and their combined result */
+static atomic_counter_t fiber_jobs_done = ATOMIC_COUNTER_INITIALIZER(0);
+static unsigned long fiber_job_checksum = 0;
 
-/** Mutex for protecting shared resources */
-static pthread_mutex_t global_mutex = PTHREAD_MUTEX_INITIALIZER;
+/** Next worker index for round-robin NUMA placement */
+static int next_worker_index = 0;
+
+/** Releases the demo threads together once all of them are set up */
+static futex_start_gate_t start_gate;
+
+/** Mutex for protecting shared resources; lock statistics are printed at exit */
+static instrumented_mutex_t global_mutex = INSTRUMENTED_MUTEX_INITIALIZER("global_mutex");
 
 /*============================================================================
  * FUNCTION PROTOTYPES
@@ -101,9 +179,16 @@ static void *safe_malloc(size_t size);
 static int *create_heap_value(int val);
 
 // Threading functions
-static void *increment_thread(void *arg);
-static void *decrement_thread(void *arg);
+static void reset_counter_task(void *arg);
+static void increment_task(void *arg);
+static void decrement_task(void *arg);
+static void report_counter_task(void *arg);
 static void *simple_job_thread(void *arg);
+static long locked_counter_updates(atomic_counter_t *counter, long initial,
+                                   long delta, long iterations, const workload_t *work);
+static void fiber_job(void *arg);
+static void job_progress_timer(wheel_timer_t *timer, void *arg);
+static void delayed_job_timer(wheel_timer_t *timer, void *arg);
 
 // Demonstration functions
 static void demonstrate_basic_features(int argc, char **argv);
@@ -112,11 +197,13 @@ static void demonstrate_function_pointers(void);
 static void demonstrate_endianness(void);
 static void demonstrate_bit_fields(void);
 static void demonstrate_threading_simple(void);
+static void demonstrate_fiber_jobs(void);
 static void demonstrate_threading_mutex(void);
 static void demonstrate_system_commands(void);
 static void demonstrate_pointer_operations(void);
 
 // Utility functions
+static void place_worker_thread(const char *thread_name);
 static void print_binary(uint8_t value);
 static void print_separator(const char *title);
 static int safe_system_command(const char *command);
@@ -178,49 +265,74 @@ static int *create_heap_value(int val) {
  *============================================================================*/
 
 /**
- * @brief Thread function that increments shared counter
+ * @brief Task that starts the counter demonstration from zero
  */
-static void *increment_thread(void *arg) {
+static void reset_counter_task(void *arg) {
     (void)arg; // Suppress unused parameter warning
 
-    printf("[INCREMENT_THREAD] Starting\n");
+    atomic_counter_store(&shared_counter, 0, ATOMIC_COUNTER_RELAXED);
+    printf("[RESET_TASK] Initial shared counter: %ld\n",
+           atomic_counter_load(&shared_counter, ATOMIC_COUNTER_RELAXED));
+}
 
-    pthread_mutex_lock(&global_mutex);
-    printf("[INCREMENT_THREAD] Acquired lock, counter = %ld\n", shared_counter);
+/**
+ * @brief Task that increments shared counter
+ */
+static void increment_task(void *arg) {
+    (void)arg; // Suppress unused parameter warning
 
-    shared_counter++;
-    for (long i = 0; i < THREAD_WORK_ITERATIONS; i++) {
-        shared_counter++;
-    }
+    cpu_set_t team_cpus;
+    int saved = pthread_getaffinity_np(pthread_self(), sizeof(team_cpus), &team_cpus) == 0;
 
-    printf("[INCREMENT_THREAD] Final counter = %ld\n", shared_counter);
-    pthread_mutex_unlock(&global_mutex);
+    place_worker_thread("INCREMENT_TASK");
+    instrumented_mutex_set_thread_name("INCREMENT_TASK");
+    printf("[INCREMENT_TASK] Starting\n");
 
-    printf("[INCREMENT_THREAD] Released lock, exiting\n");
-    return NULL;
+    long acquisitions = locked_counter_updates(&shared_counter, 1, 1,
+                                               THREAD_WORK_ITERATIONS, NULL);
+
+    printf("[INCREMENT_TASK] Done after %ld lock acquisitions, counter = %ld\n",
+           acquisitions, atomic_counter_load(&shared_counter, ATOMIC_COUNTER_RELAXED));
+
+    // Team threads (the caller among them) go on to other tasks: unpin
+    if (saved) {
+        pthread_setaffinity_np(pthread_self(), sizeof(team_cpus), &team_cpus);
+    }
 }
 
 /**
- * @brief Thread function that decrements shared counter
+ * @brief Task that decrements shared counter
  */
-static void *decrement_thread(void *arg) {
+static void decrement_task(void *arg) {
     (void)arg; // Suppress unused parameter warning
 
-    printf("[DECREMENT_THREAD] Starting\n");
+    cpu_set_t team_cpus;
+    int saved = pthread_getaffinity_np(pthread_self(), sizeof(team_cpus), &team_cpus) == 0;
+
+    place_worker_thread("DECREMENT_TASK");
+    instrumented_mutex_set_thread_name("DECREMENT_TASK");
+    printf("[DECREMENT_TASK] Starting\n");
+
+    long acquisitions = locked_counter_updates(&shared_counter, 1, -1,
+                                               THREAD_WORK_ITERATIONS, NULL);
 
-    pthread_mutex_lock(&global_mutex);
-    printf("[DECREMENT_THREAD] Acquired lock, counter = %ld\n", shared_counter);
+    printf("[DECREMENT_TASK] Done after %ld lock acquisitions, counter = %ld\n",
+           acquisitions, atomic_counter_load(&shared_counter, ATOMIC_COUNTER_RELAXED));
 
-    shared_counter++;
-    for (long i = 0; i < THREAD_WORK_ITERATIONS; i++) {
-        shared_counter--;
+    // Team threads (the caller among them) go on to other tasks: unpin
+    if (saved) {
+        pthread_setaffinity_np(pthread_self(), sizeof(team_cpus), &team_cpus);
     }
+}
 
-    printf("[DECREMENT_THREAD] Final counter = %ld\n", shared_counter);
-    pthread_mutex_unlock(&global_mutex);
+/**
+ * @brief Task that runs once both counter tasks have finished
+ */
+static void report_counter_task(void *arg) {
+    (void)arg; // Suppress unused parameter warning
 
-    printf("[DECREMENT_THREAD] Released lock, exiting\n");
-    return NULL;
+    printf("[REPORT_TASK] Final shared counter: %ld\n",
+           atomic_counter_load(&shared_counter, ATOMIC_COUNTER_RELAXED));
 }
 
 /**
@@ -229,27 +341,150 @@ static void *decrement_thread(void *arg) {
 static void *simple_job_thread(void *arg) {
     (void)arg; // Suppress unused parameter warning
 
-    pthread_mutex_lock(&global_mutex);
+    place_worker_thread("JOB_THREAD");
+    instrumented_mutex_set_thread_name("JOB_THREAD");
+    futex_start_gate_arrive(&start_gate);
+
+    long current_job = atomic_counter_add_relaxed(&job_counter, 1);
+    printf("\nJob %ld started\n", current_job);
+
+    // Run calibrated work, reporting progress to the shared counter
+    long units = (long)workload_units_for(&job_workload,
+                                          SIMPLE_JOB_DURATION_MS * 1000000LL);
+    long acquisitions = locked_counter_updates(&job_work_done, 0, 1, units,
+                                               &job_workload);
+
+    printf("Job %ld finished after %ld lock acquisitions\n", current_job, acquisitions);
+    return NULL;
+}
+
+/**
+ * @brief Monotonic clock in nanoseconds
+ */
+static long long monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/**
+ * @brief Periodic timer job: report how far the simple jobs have got
+ */
+static void job_progress_timer(wheel_timer_t *timer, void *arg) {
+    (void)timer;
+    (void)arg;
+
+    printf("[TIMER] %6.1f ms: %ld work units done\n",
+           (double)(monotonic_ns() - timer_jobs_start_ns) / 1e6,
+           atomic_counter_load(&job_work_done, ATOMIC_COUNTER_RELAXED));
+}
+
+/**
+ * @brief One-shot timer job
+ */
+static void delayed_job_timer(wheel_timer_t *timer, void *arg) {
+    (void)timer;
+    (void)arg;
 
-    job_counter++;
-    int current_job = job_counter;
-    printf("\nJob %d started\n", current_job);
+    long current_job = atomic_counter_add_relaxed(&job_counter, 1);
+    printf("[TIMER] Delayed job %ld ran after %.1f ms (requested %d ms)\n", current_job,
+           (double)(monotonic_ns() - timer_jobs_start_ns) / 1e6, DELAYED_JOB_MS);
+}
 
-    // Simulate work
-    for (unsigned long i = 0; i < (THREAD_WORK_ITERATIONS / 4); i++) {
-        // Busy wait to simulate work
+/**
+ * @brief Apply `initial` and then `iterations` updates of `delta` to counter
+ *        under global_mutex, running one unit of `work` (if not NULL) per
+ *        iteration
+ *
+ * With LOCK_FLUSH_BATCH == 0 the lock is held across the whole loop, so
+ * other threads wait for all of it. Otherwise the updates accumulate in a
+ * local variable and the lock is taken only to flush every LOCK_FLUSH_BATCH
+ * iterations, so each critical section is a single add.
+ * @return Number of times global_mutex was acquired
+ */
+static long locked_counter_updates(atomic_counter_t *counter, long initial,
+                                   long delta, long iterations, const workload_t *work) {
+#if LOCK_FLUSH_BATCH == 0
+    instrumented_mutex_lock(&global_mutex);
+    // global_mutex orders the updates, so relaxed atomics suffice
+    atomic_counter_add_relaxed(counter, initial);
+    for (long i = 0; i < iterations; i++) {
+        if (work) {
+            workload_run(work, 1);
+        }
+        atomic_counter_add_relaxed(counter, delta);
     }
+    instrumented_mutex_unlock(&global_mutex);
+    return 1;
+#else
+    long pending = initial;
+    long until_flush = LOCK_FLUSH_BATCH;
+    long acquisitions = 0;
 
-    printf("Job %d finished\n", current_job);
-    pthread_mutex_unlock(&global_mutex);
+    for (long i = 0; i < iterations; i++) {
+        if (work) {
+            workload_run(work, 1);
+        }
+        pending += delta;
+        if (--until_flush == 0) {
+            instrumented_mutex_lock(&global_mutex);
+            atomic_counter_add_relaxed(counter, pending);
+            instrumented_mutex_unlock(&global_mutex);
+            acquisitions++;
+            pending = 0;
+            until_flush = LOCK_FLUSH_BATCH;
+        }
+    }
 
-    return NULL;
+    if (pending != 0) {
+        instrumented_mutex_lock(&global_mutex);
+        atomic_counter_add_relaxed(counter, pending);
+        instrumented_mutex_unlock(&global_mutex);
+        acquisitions++;
+    }
+    return acquisitions;
+#endif
+}
+
+/**
+ * @brief Small job run as a fiber; yields between slices of work
+ */
+static void fiber_job(void *arg) {
+    unsigned long job = (unsigned long)(size_t)arg;
+    unsigned long sum = 0;
+
+    for (int slice = 0; slice < FIBER_JOB_SLICES; slice++) {
+        for (unsigned long i = 0; i < FIBER_JOB_WORK; i++) {
+            sum += i ^ job;
+        }
+        fiber_yield();
+    }
+
+    __atomic_add_fetch(&fiber_job_checksum, sum, __ATOMIC_RELAXED);
+    atomic_counter_add_relaxed(&fiber_jobs_done, 1);
 }
 
 /*============================================================================
  * UTILITY FUNCTIONS
  *============================================================================*/
 
+/**
+ * @brief Pin the calling worker thread to the next NUMA node in turn
+ */
+static void place_worker_thread(const char *thread_name) {
+#if ENABLE_NUMA_PLACEMENT
+    const numa_topology_t *topology = numa_topology_get();
+    int worker = __atomic_fetch_add(&next_worker_index, 1, __ATOMIC_RELAXED);
+    int node = numa_topology_node_for_worker(topology, worker);
+
+    if (numa_topology_pin_to_node(topology, node) == 0) {
+        printf("[%s] Pinned to NUMA node%d\n", thread_name, topology->nodes[node].id);
+    }
+#else
+    (void)thread_name;
+#endif
+}
+
 /**
  * @brief Print binary representation of 8-bit value
  */
@@ -271,19 +506,52 @@ static void print_separator(const char *title) {
 
 /**
  * @brief Safely execute system command
+ *
+ * The command is split into argv and exec'd with posix_spawn, without a
+ * shell; shell syntax is refused rather than interpreted. With
+ * ENABLE_BUILTIN_COMMANDS, commands builtin_commands.h reproduces run
+ * in-process instead. With ENABLE_COMMAND_STATS, each run is recorded in
+ * the per-command accounting (command_stats.h).
  */
 static int safe_system_command(const char *command) {
     if (!command) return -1;
 
     printf("Executing: %s\n", command);
-    int result = system(command);
+    int result;
+    int launch_error = ENOTSUP;
+    struct rusage usage;
+    struct rusage before;
+    struct timespec start;
+    command_kind_t kind = COMMAND_KIND_EXTERNAL;
+
+    getrusage(RUSAGE_THREAD, &before);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+#if ENABLE_BUILTIN_COMMANDS
+    launch_error = builtin_run_line(command, stdout, &result);
+    if (launch_error == 0) {
+        kind = COMMAND_KIND_BUILTIN;
+        command_stats_usage_since(&before, &usage);
+    }
+#endif
+    if (launch_error == ENOTSUP) {
+        launch_error = launcher_run_line_usage(command, &result, &usage);
+    }
 
-    if (result == -1) {
-        printf("Command execution failed: %s\n", strerror(errno));
+    if (launch_error != 0) {
+        printf("Command execution failed: %s\n", strerror(launch_error));
         return -1;
     }
 
     printf("Command completed with status: %d\n", WEXITSTATUS(result));
+#if ENABLE_COMMAND_STATS
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    command_stats_record(command, kind, result,
+                         (end.tv_sec - start.tv_sec) * 1000000000LL + (end.tv_nsec - start.tv_nsec),
+                         &usage);
+#else
+    (void)kind;
+#endif
     return 0;
 }
 
@@ -604,63 +872,179 @@ static void demonstrate_threading_simple(void) {
 
     pthread_t threads[2];
 
-    // Reset job counter
-    job_counter = 0;
+    // Calibrate the job work on this thread before any job competes with it
+    int init_result = workload_init(&job_workload, SIMPLE_JOB_SHAPE, 0);
+    if (init_result != 0) {
+        fprintf(stderr, "Failed to set up job workload: %s\n", strerror(init_result));
+        return;
+    }
+    printf("Job work: %s, %d ms each (%lu units of %.1f ns)\n",
+           workload_shape_name(job_workload.shape), SIMPLE_JOB_DURATION_MS,
+           workload_units_for(&job_workload, SIMPLE_JOB_DURATION_MS * 1000000LL),
+           job_workload.ns_per_unit);
+
+    // Reset job counters
+    atomic_counter_store(&job_counter, 0, ATOMIC_COUNTER_RELAXED);
+    atomic_counter_store(&job_work_done, 0, ATOMIC_COUNTER_RELAXED);
+    futex_start_gate_init(&start_gate, 2);
+
+#if ENABLE_TIMER_JOBS
+    // Progress reports and a delayed job, fired by the wheel's timer thread
+    wheel_timer_t progress_timer, delayed_timer;
+    timer_wheel_t *wheel = timer_wheel_create(TIMER_TICK_US);
+    wheel_timer_init(&progress_timer, job_progress_timer, NULL);
+    wheel_timer_init(&delayed_timer, delayed_job_timer, NULL);
+    timer_jobs_start_ns = monotonic_ns();
+    if (!wheel || timer_wheel_start(wheel) != 0) {
+        fprintf(stderr, "Failed to start timer wheel; running without timer jobs\n");
+        timer_wheel_destroy(wheel);
+        wheel = NULL;
+    } else {
+        uint64_t period = timer_wheel_ticks(wheel, JOB_PROGRESS_INTERVAL_MS * 1000ULL);
+        timer_wheel_schedule(wheel, &progress_timer, period, period);
+        timer_wheel_schedule(wheel, &delayed_timer,
+                             timer_wheel_ticks(wheel, DELAYED_JOB_MS * 1000ULL), 0);
+    }
+#endif
 
     // Create threads
     for (int i = 0; i < 2; i++) {
         int result = pthread_create(&threads[i], NULL, simple_job_thread, NULL);
         if (result != 0) {
             fprintf(stderr, "Failed to create thread %d: %s\n", i, strerror(result));
+            futex_start_gate_abort(&start_gate);
+            for (int j = 0; j < i; j++) {
+                pthread_join(threads[j], NULL);
+            }
+#if ENABLE_TIMER_JOBS
+            timer_wheel_destroy(wheel);
+#endif
+            workload_destroy(&job_workload);
             return;
         }
     }
 
+    // Start both jobs at the same moment
+    futex_start_gate_release(&start_gate);
+
     // Wait for threads to complete
     for (int i = 0; i < 2; i++) {
         pthread_join(threads[i], NULL);
     }
 
-    printf("All simple jobs completed\n");
+#if ENABLE_TIMER_JOBS
+    if (wheel) {
+        // Stop the periodic report; the delayed job fires first unless the
+        // jobs finished early, in which case it is cancelled too
+        timer_wheel_cancel(wheel, &progress_timer);
+        timer_wheel_cancel(wheel, &delayed_timer);
+        timer_wheel_destroy(wheel);
+    }
+#endif
+    workload_destroy(&job_workload);
+
+    printf("All simple jobs completed (%ld work units, lock flush batch %d)\n",
+           atomic_counter_load(&job_work_done, ATOMIC_COUNTER_RELAXED), LOCK_FLUSH_BATCH);
+
+#if ENABLE_FIBER_JOBS
+    demonstrate_fiber_jobs();
+#endif
 #else
     printf("Threading demonstration disabled\n");
 #endif
 }
 
+/**
+ * @brief Run FIBER_JOB_COUNT jobs concurrently as fibers instead of threads
+ */
+static void demonstrate_fiber_jobs(void) {
+    printf("\nRunning %d jobs as fibers on %d worker threads...\n",
+           FIBER_JOB_COUNT, FIBER_JOB_WORKERS);
+
+    fiber_scheduler_t *scheduler = fiber_scheduler_create(FIBER_JOB_WORKERS, 0);
+    if (!scheduler) {
+        fprintf(stderr, "Failed to create fiber scheduler\n");
+        return;
+    }
+
+    atomic_counter_store(&fiber_jobs_done, 0, ATOMIC_COUNTER_RELAXED);
+    fiber_job_checksum = 0;
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < FIBER_JOB_COUNT; i++) {
+        int result = fiber_spawn(scheduler, fiber_job, (void *)(size_t)i);
+        if (result != 0) {
+            fprintf(stderr, "Failed to spawn fiber job %d: %s\n", i, strerror(result));
+            break;
+        }
+    }
+
+    int result = fiber_scheduler_run(scheduler);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    fiber_scheduler_destroy(scheduler);
+
+    if (result != 0) {
+        fprintf(stderr, "Failed to run fiber jobs: %s\n", strerror(result));
+        return;
+    }
+
+    double elapsed_ms = (double)(end.tv_sec - start.tv_sec) * 1e3 +
+                        (double)(end.tv_nsec - start.tv_nsec) / 1e6;
+    printf("%ld fiber jobs completed in %.2f ms (%s context switch, checksum 0x%lx)\n",
+           atomic_counter_load(&fiber_jobs_done, ATOMIC_COUNTER_RELAXED), elapsed_ms, fiber_backend_name(), fiber_job_checksum);
+}
+
 /**
  * @brief Demonstrate threading with mutex synchronization (from generic03.c)
+ *
+ * The counter jobs run as a task graph: reset -> {increment, decrement}
+ * -> report, on a pool of MUTEX_DEMO_WORKERS threads. The counter tasks are
+ * pinned to NUMA nodes for as long as they run. They do not wait at the
+ * futex start gate: the graph releases both as soon as reset finishes, and
+ * a task that blocks on another could deadlock a team that had to run with
+ * fewer threads (task_graph_run() falls back to the caller alone).
  */
 static void demonstrate_threading_mutex(void) {
     print_separator("MUTEX SYNCHRONIZED THREADING");
 
 #if ENABLE_THREADING
-    printf("Creating synchronized threads...\n");
-
-    pthread_t threads[2];
-    typedef void *(*thread_func_t)(void *);
-    thread_func_t thread_functions[] = {increment_thread, decrement_thread};
+    printf("Running counter tasks as a dependency graph...\n");
 
-    // Reset shared counter
-    shared_counter = 0;
+    task_graph_t *graph = task_graph_create();
+    if (!graph) {
+        fprintf(stderr, "Failed to create task graph\n");
+        return;
+    }
 
-    printf("Initial shared counter: %ld\n", shared_counter);
+    // Task ids are assigned in order of addition: reset, increment, decrement, report
+    static const task_graph_fn counter_tasks[] = {
+        reset_counter_task, increment_task, decrement_task, report_counter_task
+    };
+    static const int counter_edges[][2] = {     // { task, prerequisite }
+        { 1, 0 }, { 2, 0 }, { 3, 1 }, { 3, 2 }
+    };
 
-    // Create threads
-    for (int i = 0; i < 2; i++) {
-        int result = pthread_create(&threads[i], NULL, thread_functions[i], NULL);
-        if (result != 0) {
-            fprintf(stderr, "Failed to create thread %d: %s\n", i, strerror(result));
-            return;
-        }
+    int result = 0;
+    for (size_t i = 0; i < sizeof(counter_tasks) / sizeof(counter_tasks[0]) && result == 0; i++) {
+        result = task_graph_add(graph, counter_tasks[i], NULL, NULL);
     }
-
-    // Wait for threads to complete
-    for (int i = 0; i < 2; i++) {
-        pthread_join(threads[i], NULL);
+    for (size_t i = 0; i < sizeof(counter_edges) / sizeof(counter_edges[0]) && result == 0; i++) {
+        result = task_graph_depend(graph, counter_edges[i][0], counter_edges[i][1]);
+    }
+    if (result == 0) {
+        result = task_graph_run(graph, MUTEX_DEMO_WORKERS);
     }
 
-    printf("Final shared counter: %ld\n", shared_counter);
-    printf("All synchronized threads completed\n");
+    if (result != 0) {
+        fprintf(stderr, "Failed to run counter tasks: %s\n", strerror(result));
+    } else {
+        task_graph_stats_t stats;
+        task_graph_last_stats(graph, &stats);
+        printf("All synchronized tasks completed (%lu tasks on %d threads, %lu run directly)\n",
+               stats.tasks, stats.threads, stats.direct);
+    }
+    task_graph_destroy(graph);
 #else
     printf("Threading demonstration disabled\n");
 #endif
@@ -677,10 +1061,11 @@ static void demonstrate_system_commands(void) {
 
     // Check if wget is available
     printf("Checking for wget availability...\n");
-    int wget_available = (system("which wget > /dev/null 2>&1") == 0);
+    char wget_path[PATH_MAX];
+    int wget_available = (path_lookup("wget", wget_path, sizeof(wget_path)) == 0);
 
     if (wget_available) {
-        printf("wget is available\n");
+        printf("wget is available at %s\n", wget_path);
         printf("Original command from generic05.c:\n");
         printf("wget -O ffmpeg.tar.xz https://johnvansickle.com/ffmpeg/builds/ffmpeg-git-arm64-static.tar.xz\n");
         printf("(Command execution skipped to avoid unnecessary download)\n");
@@ -696,6 +1081,10 @@ static void demonstrate_system_commands(void) {
     safe_system_command("echo 'Hello from system command!'");
     safe_system_command("date");
     safe_system_command("uname -a");
+#if ENABLE_COMMAND_STATS
+    printf("\nPer-command accounting:\n");
+    command_stats_report(stdout);
+#endif
 #else
     printf("System command demonstration disabled\n");
 #endif
@@ -721,8 +1110,19 @@ int main(int argc, char **argv) {
     printf("  THREADING: %s\n", ENABLE_THREADING ? "ENABLED" : "DISABLED");
     printf("  ADVANCED_FEATURES: %s\n", ENABLE_ADVANCED_FEATURES ? "ENABLED" : "DISABLED");
     printf("  SYSTEM_COMMANDS: %s\n", ENABLE_SYSTEM_COMMANDS ? "ENABLED" : "DISABLED");
+    printf("  NUMA_PLACEMENT: %s\n", ENABLE_NUMA_PLACEMENT ? "ENABLED" : "DISABLED");
+    printf("  FIBER_JOBS: %s\n", ENABLE_FIBER_JOBS ? "ENABLED" : "DISABLED");
+    printf("  TIMER_JOBS: %s\n", ENABLE_TIMER_JOBS ? "ENABLED" : "DISABLED");
+    printf("  LOCK_FLUSH_BATCH: %d\n", LOCK_FLUSH_BATCH);
     printf("  DEBUG FLAGS: 0x%02X\n", DEBUG);
 
+#if ENABLE_THREADING
+    // Report wait/hold latencies of the threading demos when we exit
+    if (instrumented_mutex_report_at_exit(&global_mutex) != 0) {
+        fprintf(stderr, "Failed to register lock statistics report\n");
+    }
+#endif
+
     // Interactive menu loop
     int choice;
     bool running = true;
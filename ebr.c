@@ -0,0 +1,306 @@
+/**
+ * @file ebr.c
+ * @brief Epoch-based reclamation: thread registry, epochs and limbo lists
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#define _GNU_SOURCE
+
+#include "ebr.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+/**
+ * @brief Nodes retired while the global epoch had one particular value
+ */
+typedef struct {
+    unsigned long epoch;
+    ebr_node_t *head;
+} limbo_list_t;
+
+/**
+ * @brief Per-thread record; one cache line of its own so announcing an
+ *        epoch never invalidates another thread's record
+ */
+struct ebr_thread {
+    unsigned long state;        /**< (epoch << 1) | active; read by advancers */
+    ebr_domain_t *domain;
+    ebr_thread_t *next;         /**< Registry link, never changes once published */
+    int in_use;                 /**< Guarded by the registry lock */
+    int depth;                  /**< Nesting level of ebr_enter() */
+    unsigned long since_advance;
+    limbo_list_t limbo[EBR_LIMBO_LISTS];
+    unsigned long retired;      /**< Statistics, written by the owner only */
+    unsigned long reclaimed;
+} __attribute__((aligned(64)));
+
+struct ebr_domain {
+    unsigned long epoch __attribute__((aligned(64)));
+    ebr_thread_t *threads __attribute__((aligned(64)));  /**< Registry, push-only */
+    pthread_mutex_t registry_lock;
+};
+
+/*============================================================================
+ * EPOCHS AND LIMBO LISTS
+ *============================================================================*/
+
+/**
+ * @brief Hand every node of a limbo list to its reclaim callback
+ */
+static void reclaim_list(ebr_thread_t *thread, limbo_list_t *list) {
+    ebr_node_t *node = list->head;
+    unsigned long count = 0;
+
+    list->head = NULL;
+    while (node) {
+        ebr_node_t *next = node->next;
+        node->reclaim(node);
+        node = next;
+        count++;
+    }
+    __atomic_store_n(&thread->reclaimed, thread->reclaimed + count, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Reclaim the lists whose epoch is at least two behind `epoch`
+ * @return Non-zero if some list still holds nodes
+ */
+static int reclaim_expired(ebr_thread_t *thread, unsigned long epoch) {
+    int pending = 0;
+
+    for (int i = 0; i < EBR_LIMBO_LISTS; i++) {
+        limbo_list_t *list = &thread->limbo[i];
+        if (!list->head) {
+            continue;
+        }
+        if (list->epoch + 2 <= epoch) {
+            reclaim_list(thread, list);
+        } else {
+            pending = 1;
+        }
+    }
+    return pending;
+}
+
+/**
+ * @brief Advance the global epoch if every active thread has observed it
+ * @return Non-zero if the epoch was advanced (by us or concurrently)
+ */
+static int try_advance(ebr_domain_t *domain) {
+    unsigned long epoch = __atomic_load_n(&domain->epoch, __ATOMIC_RELAXED);
+
+    // Pairs with the fence in ebr_enter(): either we see the announcement or
+    // that thread sees an epoch at least as new as ours
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    for (ebr_thread_t *thread = __atomic_load_n(&domain->threads, __ATOMIC_ACQUIRE);
+         thread; thread = thread->next) {
+        unsigned long state = __atomic_load_n(&thread->state, __ATOMIC_RELAXED);
+        if ((state & 1) && (state >> 1) != epoch) {
+            return 0;
+        }
+    }
+
+    // Failure means another thread advanced it, which is just as good
+    __atomic_compare_exchange_n(&domain->epoch, &epoch, epoch + 1, 0,
+                                __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+    return 1;
+}
+
+/*============================================================================
+ * DOMAIN
+ *============================================================================*/
+
+/**
+ * @brief Create a reclamation domain
+ * @return The domain, or NULL on allocation failure
+ */
+ebr_domain_t *ebr_domain_create(void) {
+    void *memory = NULL;
+    if (posix_memalign(&memory, 64, sizeof(ebr_domain_t)) != 0) {
+        return NULL;
+    }
+
+    ebr_domain_t *domain = memory;
+    memset(domain, 0, sizeof(*domain));
+    pthread_mutex_init(&domain->registry_lock, NULL);
+    return domain;
+}
+
+/**
+ * @brief Reclaim everything still in limbo and free the domain
+ * @note No thread may use the domain any more
+ */
+void ebr_domain_destroy(ebr_domain_t *domain) {
+    if (!domain) {
+        return;
+    }
+
+    ebr_thread_t *thread = domain->threads;
+    while (thread) {
+        ebr_thread_t *next = thread->next;
+        for (int i = 0; i < EBR_LIMBO_LISTS; i++) {
+            reclaim_list(thread, &thread->limbo[i]);
+        }
+        free(thread);
+        thread = next;
+    }
+
+    pthread_mutex_destroy(&domain->registry_lock);
+    free(domain);
+}
+
+/**
+ * @brief Snapshot the domain's epoch and retire/reclaim totals
+ */
+void ebr_domain_stats(const ebr_domain_t *domain, ebr_stats_t *stats) {
+    stats->epoch = __atomic_load_n(&domain->epoch, __ATOMIC_RELAXED);
+    stats->retired = 0;
+    stats->reclaimed = 0;
+
+    for (const ebr_thread_t *thread = __atomic_load_n(&domain->threads, __ATOMIC_ACQUIRE);
+         thread; thread = thread->next) {
+        stats->retired += __atomic_load_n(&thread->retired, __ATOMIC_RELAXED);
+        stats->reclaimed += __atomic_load_n(&thread->reclaimed, __ATOMIC_RELAXED);
+    }
+}
+
+/*============================================================================
+ * THREADS
+ *============================================================================*/
+
+/**
+ * @brief Register the calling thread, reusing a released record if possible
+ * @return The thread's record, or NULL on allocation failure
+ */
+ebr_thread_t *ebr_thread_register(ebr_domain_t *domain) {
+    pthread_mutex_lock(&domain->registry_lock);
+
+    ebr_thread_t *thread = domain->threads;
+    while (thread && thread->in_use) {
+        thread = thread->next;
+    }
+
+    if (!thread) {
+        void *memory = NULL;
+        if (posix_memalign(&memory, 64, sizeof(ebr_thread_t)) != 0) {
+            pthread_mutex_unlock(&domain->registry_lock);
+            return NULL;
+        }
+        thread = memory;
+        memset(thread, 0, sizeof(*thread));
+        thread->domain = domain;
+        thread->next = domain->threads;
+        // Fully initialized before advancers can reach it
+        __atomic_store_n(&domain->threads, thread, __ATOMIC_RELEASE);
+    }
+
+    thread->in_use = 1;
+    thread->depth = 0;
+    thread->since_advance = 0;
+    pthread_mutex_unlock(&domain->registry_lock);
+    return thread;
+}
+
+/**
+ * @brief Wait until everything this thread retired is reclaimed, then
+ *        release the record for reuse
+ * @note Must be called outside a critical section
+ */
+void ebr_thread_unregister(ebr_thread_t *thread) {
+    if (!thread) {
+        return;
+    }
+
+    ebr_synchronize(thread);
+
+    ebr_domain_t *domain = thread->domain;
+    pthread_mutex_lock(&domain->registry_lock);
+    __atomic_store_n(&thread->state, 0, __ATOMIC_RELEASE);
+    thread->in_use = 0;
+    pthread_mutex_unlock(&domain->registry_lock);
+}
+
+/**
+ * @brief Begin a critical section; nested calls are allowed
+ */
+void ebr_enter(ebr_thread_t *thread) {
+    if (thread->depth++ > 0) {
+        return;
+    }
+
+    unsigned long epoch = __atomic_load_n(&thread->domain->epoch, __ATOMIC_RELAXED);
+    __atomic_store_n(&thread->state, (epoch << 1) | 1, __ATOMIC_RELAXED);
+
+    // The announcement must be visible before any shared pointer is loaded
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/**
+ * @brief End a critical section
+ */
+void ebr_exit(ebr_thread_t *thread) {
+    if (--thread->depth > 0) {
+        return;
+    }
+    __atomic_store_n(&thread->state, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Defer reclaim(node) until no thread can still be reading it
+ *
+ * Call after the node has been unlinked, from inside or outside a critical
+ * section. The node is tagged with the global epoch read after the unlink,
+ * which is never older than the epoch of any reader that could have
+ * loaded a pointer to it.
+ */
+void ebr_retire(ebr_thread_t *thread, ebr_node_t *node, ebr_reclaim_fn reclaim) {
+    ebr_domain_t *domain = thread->domain;
+
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    unsigned long epoch = __atomic_load_n(&domain->epoch, __ATOMIC_RELAXED);
+
+    // A list tagged with another epoch of the same residue is >= 3 behind
+    limbo_list_t *list = &thread->limbo[epoch % EBR_LIMBO_LISTS];
+    if (list->head && list->epoch != epoch) {
+        reclaim_list(thread, list);
+    }
+    list->epoch = epoch;
+    node->reclaim = reclaim;
+    node->next = list->head;
+    list->head = node;
+    __atomic_store_n(&thread->retired, thread->retired + 1, __ATOMIC_RELAXED);
+
+    if (++thread->since_advance >= EBR_ADVANCE_INTERVAL) {
+        thread->since_advance = 0;
+        try_advance(domain);
+        reclaim_expired(thread, __atomic_load_n(&domain->epoch, __ATOMIC_ACQUIRE));
+    }
+}
+
+/**
+ * @brief Block until every node this thread retired has been reclaimed
+ * @note Must be called outside a critical section; waits for other
+ *       threads to leave theirs
+ */
+void ebr_synchronize(ebr_thread_t *thread) {
+    ebr_domain_t *domain = thread->domain;
+
+    for (;;) {
+        unsigned long epoch = __atomic_load_n(&domain->epoch, __ATOMIC_ACQUIRE);
+        if (!reclaim_expired(thread, epoch)) {
+            return;
+        }
+        if (!try_advance(domain)) {
+            sched_yield();
+        }
+    }
+}
@@ -0,0 +1,91 @@
+/**
+ * @file ebr.h
+ * @brief Epoch-based memory reclamation for lock-free data structures
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * A lock-free structure cannot free() a node it has just unlinked: another
+ * thread may have loaded a pointer to it a moment earlier and still be
+ * reading it. EBR defers the free until that is impossible:
+ * - Every access to the structure is bracketed by ebr_enter()/ebr_exit();
+ *   entering announces the global epoch the thread observed
+ * - An unlinked node is handed to ebr_retire(), which files it in the
+ *   calling thread's limbo list tagged with the current global epoch
+ * - The global epoch only advances when every thread inside a critical
+ *   section has announced the current epoch, so a node retired in epoch e
+ *   is unreachable to all readers once the epoch reaches e + 2, and its
+ *   limbo list is reclaimed then
+ *
+ * Critical sections and retirement touch only the calling thread's record
+ * plus one read of the global epoch; no lock is taken on the hot path. The
+ * registry of thread records is scanned lock-free when trying to advance
+ * (every EBR_ADVANCE_INTERVAL retirements) and only registration locks.
+ *
+ * Retired objects embed an ebr_node_t (intrusive, no allocation per
+ * retirement); the reclaim callback receives that node and recovers the
+ * enclosing object.
+ *
+ * A thread that stays inside a critical section stops reclamation for
+ * everyone, so keep sections short and never block inside one.
+ */
+
+#ifndef EBR_H
+#define EBR_H
+
+#include <stddef.h>
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+/** Retirements between attempts to advance the global epoch */
+#define EBR_ADVANCE_INTERVAL 64
+
+/** Number of limbo lists per thread (epochs e, e-1, e-2) */
+#define EBR_LIMBO_LISTS 3
+
+typedef struct ebr_node ebr_node_t;
+
+/** Called once a retired node can no longer be reached by any thread */
+typedef void (*ebr_reclaim_fn)(ebr_node_t *node);
+
+/**
+ * @brief Link embedded in every object that may be retired
+ */
+struct ebr_node {
+    ebr_node_t *next;
+    ebr_reclaim_fn reclaim;
+};
+
+/** Opaque reclamation domain shared by the threads of one structure */
+typedef struct ebr_domain ebr_domain_t;
+
+/** Opaque per-thread record */
+typedef struct ebr_thread ebr_thread_t;
+
+/**
+ * @brief Counters of one domain, for reports
+ */
+typedef struct {
+    unsigned long epoch;        /**< Current global epoch */
+    unsigned long retired;      /**< Nodes passed to ebr_retire() */
+    unsigned long reclaimed;    /**< Nodes handed to their reclaim callback */
+} ebr_stats_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+ebr_domain_t *ebr_domain_create(void);
+void ebr_domain_destroy(ebr_domain_t *domain);
+void ebr_domain_stats(const ebr_domain_t *domain, ebr_stats_t *stats);
+
+ebr_thread_t *ebr_thread_register(ebr_domain_t *domain);
+void ebr_thread_unregister(ebr_thread_t *thread);
+
+void ebr_enter(ebr_thread_t *thread);
+void ebr_exit(ebr_thread_t *thread);
+void ebr_retire(ebr_thread_t *thread, ebr_node_t *node, ebr_reclaim_fn reclaim);
+void ebr_synchronize(ebr_thread_t *thread);
+
+#endif /* EBR_H */
@@ -0,0 +1,391 @@
+/**
+ * @file ebr_bench.c
+ * @brief Lock-free stack stress test with epoch-based reclamation
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * T threads hammer one Treiber stack with a random mix of pushes (malloc a
+ * node) and pops (unlink and free the node). Three ways to free:
+ * - ebr:    pop runs inside an EBR critical section and the node is
+ *           retired; the reclaim callback poisons and frees it
+ * - leak:   popped nodes are only freed after every thread has finished;
+ *           the same lock-free stack with reclamation cost removed
+ * - mutex:  a plain stack under one mutex, nodes freed immediately
+ *
+ * Freeing a popped node immediately in the lock-free stack would be a
+ * use-after-free (another popper may be reading node->next) and can also
+ * corrupt the stack through ABA when malloc hands the address back.
+ *
+ * Every run is checked: the sum of pushed values must equal the sum of
+ * popped values plus what is left on the stack, every node must be freed
+ * exactly once, and no pop may ever see a poisoned node.
+ *
+ * Usage: ./ebr_bench [threads] [operations_per_thread]
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "atomic_counter.h"
+#include "clock_ns.h"
+#include "ebr.h"
+#include "futex_sync.h"
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+#define DEFAULT_OPERATIONS 2000000L
+#define MAX_BENCH_THREADS 64
+
+/** Nodes pushed before the threads start */
+#define PREFILL_NODES 1024
+
+/** Written into a node's value just before it is freed */
+#define POISON_VALUE (-0x5EADBEEFL)
+
+/** Reclamation strategy under test */
+typedef enum {
+    MODE_EBR,
+    MODE_LEAK,
+    MODE_MUTEX
+} reclaim_mode_t;
+
+/**
+ * @brief Stack node; the EBR link is embedded, so retiring needs no allocation
+ */
+typedef struct stack_node {
+    ebr_node_t ebr;
+    struct stack_node *next;
+    long value;
+} stack_node_t;
+
+/**
+ * @brief Per-thread results
+ */
+typedef struct {
+    int index;
+    long pushed_sum;
+    long popped_sum;
+    long poisoned;              /**< Pops that saw a freed node */
+    stack_node_t *deferred;     /**< MODE_LEAK: popped nodes, freed at the end */
+} worker_t;
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+/** Treiber stack top, alone on its cache line */
+static stack_node_t *stack_top __attribute__((aligned(64))) = NULL;
+
+/** MODE_MUTEX stack lock */
+static pthread_mutex_t stack_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** Allocation accounting */
+static atomic_counter_t nodes_allocated = ATOMIC_COUNTER_INITIALIZER(0);
+static atomic_counter_t nodes_freed = ATOMIC_COUNTER_INITIALIZER(0);
+
+/** Run parameters, read-only while workers run */
+static reclaim_mode_t active_mode;
+static long active_operations;
+static ebr_domain_t *domain = NULL;
+static futex_start_gate_t start_gate;
+
+/*============================================================================
+ * NODES
+ *============================================================================*/
+
+static stack_node_t *node_create(long value) {
+    stack_node_t *node = malloc(sizeof(*node));
+    if (!node) {
+        fprintf(stderr, "Out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    node->value = value;
+    atomic_counter_add_relaxed(&nodes_allocated, 1);
+    return node;
+}
+
+/**
+ * @brief Poison and free a node; also the EBR reclaim callback
+ */
+static void node_destroy(stack_node_t *node) {
+    __atomic_store_n(&node->value, POISON_VALUE, __ATOMIC_RELAXED);
+    atomic_counter_add_relaxed(&nodes_freed, 1);
+    free(node);
+}
+
+static void node_reclaim(ebr_node_t *link) {
+    node_destroy((stack_node_t *)((char *)link - offsetof(stack_node_t, ebr)));
+}
+
+/*============================================================================
+ * STACKS
+ *============================================================================*/
+
+/**
+ * @brief Lock-free push; safe without EBR because it never dereferences
+ *        another thread's node
+ */
+static void lockfree_push(stack_node_t *node) {
+    stack_node_t *top = __atomic_load_n(&stack_top, __ATOMIC_RELAXED);
+    do {
+        node->next = top;
+    } while (!__atomic_compare_exchange_n(&stack_top, &top, node, 1,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+/**
+ * @brief Lock-free pop; the caller must keep `top` alive (EBR or leaking)
+ *        while this reads top->next
+ */
+static stack_node_t *lockfree_pop(void) {
+    stack_node_t *top = __atomic_load_n(&stack_top, __ATOMIC_ACQUIRE);
+    while (top) {
+        stack_node_t *next = __atomic_load_n(&top->next, __ATOMIC_RELAXED);
+        if (__atomic_compare_exchange_n(&stack_top, &top, next, 1,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE)) {
+            break;
+        }
+    }
+    return top;
+}
+
+static void mutex_push(stack_node_t *node) {
+    pthread_mutex_lock(&stack_mutex);
+    node->next = stack_top;
+    stack_top = node;
+    pthread_mutex_unlock(&stack_mutex);
+}
+
+static stack_node_t *mutex_pop(void) {
+    pthread_mutex_lock(&stack_mutex);
+    stack_node_t *top = stack_top;
+    if (top) {
+        stack_top = top->next;
+    }
+    pthread_mutex_unlock(&stack_mutex);
+    return top;
+}
+
+/*============================================================================
+ * THREAD FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Worker: random mix of pushes and pops
+ */
+static void *worker_thread(void *arg) {
+    worker_t *worker = (worker_t *)arg;
+    unsigned long rng = 0x9E3779B97F4A7C15UL * (unsigned long)(worker->index + 1);
+    ebr_thread_t *ebr = NULL;
+
+    if (active_mode == MODE_EBR) {
+        ebr = ebr_thread_register(domain);
+        if (!ebr) {
+            fprintf(stderr, "Failed to register EBR thread\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    futex_start_gate_arrive(&start_gate);
+
+    for (long i = 0; i < active_operations; i++) {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+
+        if (rng & 1) {
+            long value = (long)(rng >> 33);
+            stack_node_t *node = node_create(value);
+            worker->pushed_sum += value;
+            if (active_mode == MODE_MUTEX) {
+                mutex_push(node);
+            } else {
+                lockfree_push(node);
+            }
+            continue;
+        }
+
+        stack_node_t *node;
+        if (active_mode == MODE_MUTEX) {
+            node = mutex_pop();
+        } else if (active_mode == MODE_EBR) {
+            ebr_enter(ebr);
+            node = lockfree_pop();
+            ebr_exit(ebr);
+        } else {
+            node = lockfree_pop();
+        }
+        if (!node) {
+            continue;
+        }
+
+        // We unlinked it, so it stays ours until we retire or free it
+        long value = __atomic_load_n(&node->value, __ATOMIC_RELAXED);
+        if (value == POISON_VALUE) {
+            worker->poisoned++;
+        }
+        worker->popped_sum += value;
+
+        if (active_mode == MODE_EBR) {
+            ebr_retire(ebr, &node->ebr, node_reclaim);
+        } else if (active_mode == MODE_LEAK) {
+            node->next = worker->deferred;
+            worker->deferred = node;
+        } else {
+            node_destroy(node);
+        }
+    }
+
+    if (ebr) {
+        ebr_thread_unregister(ebr);
+    }
+    return NULL;
+}
+
+/*============================================================================
+ * BENCHMARK DRIVER
+ *============================================================================*/
+
+static const char *mode_name(reclaim_mode_t mode) {
+    switch (mode) {
+        case MODE_EBR:  return "lock-free + EBR";
+        case MODE_LEAK: return "lock-free, free at end";
+        default:        return "mutex stack";
+    }
+}
+
+/**
+ * @brief Run one mode and verify it
+ * @return 0 if every check passed
+ */
+static int run_mode(reclaim_mode_t mode, int threads, long operations) {
+    static worker_t workers[MAX_BENCH_THREADS];
+    pthread_t ids[MAX_BENCH_THREADS];
+    long prefill_sum = 0;
+
+    atomic_counter_init(&nodes_allocated, 0);
+    atomic_counter_init(&nodes_freed, 0);
+    stack_top = NULL;
+    for (long i = 0; i < PREFILL_NODES; i++) {
+        stack_node_t *node = node_create(i);
+        node->next = stack_top;
+        stack_top = node;
+        prefill_sum += i;
+    }
+
+    active_mode = mode;
+    active_operations = operations;
+    domain = mode == MODE_EBR ? ebr_domain_create() : NULL;
+    if (mode == MODE_EBR && !domain) {
+        fprintf(stderr, "Failed to create EBR domain\n");
+        return -1;
+    }
+
+    memset(workers, 0, sizeof(workers));
+    futex_start_gate_init(&start_gate, (unsigned int)threads);
+    for (int i = 0; i < threads; i++) {
+        workers[i].index = i;
+        int result = pthread_create(&ids[i], NULL, worker_thread, &workers[i]);
+        if (result != 0) {
+            fprintf(stderr, "Failed to create thread %d: %s\n", i, strerror(result));
+            exit(EXIT_FAILURE); // The gate would never open
+        }
+    }
+
+    futex_latch_wait(&start_gate.ready);
+    long long start = now_ns();
+    futex_event_set(&start_gate.go);
+    for (int i = 0; i < threads; i++) {
+        pthread_join(ids[i], NULL);
+    }
+    long long elapsed = now_ns() - start;
+
+    ebr_stats_t stats = { 0, 0, 0 };
+    if (domain) {
+        ebr_domain_stats(domain, &stats);
+        ebr_domain_destroy(domain);
+        domain = NULL;
+    }
+
+    // Totals, then drain everything that is still allocated
+    long pushed = prefill_sum, popped = 0, poisoned = 0, remaining = 0;
+    for (int i = 0; i < threads; i++) {
+        pushed += workers[i].pushed_sum;
+        popped += workers[i].popped_sum;
+        poisoned += workers[i].poisoned;
+        while (workers[i].deferred) {
+            stack_node_t *next = workers[i].deferred->next;
+            node_destroy(workers[i].deferred);
+            workers[i].deferred = next;
+        }
+    }
+    while (stack_top) {
+        stack_node_t *next = stack_top->next;
+        remaining += stack_top->value;
+        node_destroy(stack_top);
+        stack_top = next;
+    }
+
+    long allocated = atomic_counter_load(&nodes_allocated, ATOMIC_COUNTER_RELAXED);
+    long freed = atomic_counter_load(&nodes_freed, ATOMIC_COUNTER_RELAXED);
+    int ok = pushed == popped + remaining && allocated == freed && poisoned == 0;
+
+    printf("%-24s %10.2f %10.1f %10lu %10lu %8lu  %s\n", mode_name(mode),
+           (double)operations * threads / ((double)elapsed / 1e3),
+           (double)elapsed / (double)operations,
+           stats.retired, stats.reclaimed, stats.epoch, ok ? "ok" : "FAILED");
+    if (!ok) {
+        fprintf(stderr, "  pushed %ld, popped %ld + remaining %ld, allocated %ld, freed %ld, poisoned %ld\n",
+                pushed, popped, remaining, allocated, freed, poisoned);
+    }
+    return ok ? 0 : -1;
+}
+
+/*============================================================================
+ * MAIN FUNCTION
+ *============================================================================*/
+
+/**
+ * @brief Main function - stress every mode and report throughput
+ * @return EXIT_SUCCESS if every mode passed its checks
+ */
+int main(int argc, char **argv) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int threads = cpus > 4 ? (int)cpus : 4;
+    long operations = DEFAULT_OPERATIONS;
+
+    if (argc > 1) {
+        threads = (int)strtol(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        operations = strtol(argv[2], NULL, 10);
+    }
+    if (threads < 1 || threads > MAX_BENCH_THREADS || operations <= 0) {
+        fprintf(stderr, "Usage: %s [threads 1..%d] [operations_per_thread > 0]\n",
+                argv[0], MAX_BENCH_THREADS);
+        return EXIT_FAILURE;
+    }
+
+    printf("========================================================\n");
+    printf("    LOCK-FREE STACK + EPOCH-BASED RECLAMATION STRESS\n");
+    printf("========================================================\n");
+    printf("Threads: %d, online CPUs: %ld, operations per thread: %ld\n\n",
+           threads, cpus, operations);
+    printf("%-24s %10s %10s %10s %10s %8s  %s\n", "mode", "Mops/s", "ns/op",
+           "retired", "reclaimed", "epochs", "check");
+
+    int failed = 0;
+    failed |= run_mode(MODE_EBR, threads, operations);
+    failed |= run_mode(MODE_LEAK, threads, operations);
+    failed |= run_mode(MODE_MUTEX, threads, operations);
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,281 @@
+/**
+ * @file false_sharing_bench.c
+ * @brief False sharing benchmark for shared_counter-style counters
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * Every thread increments "its" counter N times; only the memory layout and
+ * the kind of increment differ between configurations:
+ * - adjacent:        one volatile long per thread, packed next to each other,
+ *                    so all counters share one or two cache lines
+ * - padded 64/128:   the same, each counter alone in a 64- or 128-byte slot
+ *                    (128 also defeats the adjacent-line prefetcher)
+ * - thread-local:    a private counter added to one shared atomic every
+ *                    FLUSH_INTERVAL increments
+ * - atomic RMW:      fetch_add on one truly shared counter, relaxed vs
+ *                    seq_cst (both are `lock xadd` on x86)
+ * - atomic store:    load + store on a padded per-thread counter, relaxed
+ *                    vs seq_cst (seq_cst stores need a full fence on x86)
+ *
+ * Reported ns/op is wall time divided by the increments per thread, so on
+ * an ideal machine every non-shared layout would cost the same with 1 or N
+ * threads. Threads start together through a futex start gate. With a single
+ * online CPU the threads never run concurrently and no cache line bounces,
+ * so expect all layouts to look alike there.
+ *
+ * Usage: ./false_sharing_bench [threads] [increments_per_thread]
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "clock_ns.h"
+#include "futex_sync.h"
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+#define DEFAULT_INCREMENTS 20000000L
+#define MAX_BENCH_THREADS 64
+
+/** Largest per-counter slot used by any layout */
+#define MAX_SLOT_SIZE 128
+
+/** Thread-local increments between flushes to the shared counter */
+#define FLUSH_INTERVAL 1024
+
+/**
+ * @brief Shared state of one run
+ */
+typedef struct {
+    unsigned char *arena;       /**< MAX_SLOT_SIZE-aligned counter memory */
+    size_t stride;              /**< Distance between per-thread counters */
+    long increments;
+    futex_start_gate_t gate;
+} run_state_t;
+
+/**
+ * @brief Per-thread argument
+ */
+typedef struct {
+    run_state_t *state;
+    int index;
+} worker_arg_t;
+
+/** Increment loop of one configuration; counter points at the thread's slot */
+typedef void (*increment_fn)(long *counter, long *shared, long increments);
+
+/**
+ * @brief One benchmark configuration
+ */
+typedef struct {
+    const char *name;
+    size_t stride;              /**< Per-thread slot size, 0 for one shared counter */
+    increment_fn increment;
+    int per_thread_result;      /**< Each slot ends at `increments` (else the sum does) */
+} config_t;
+
+/*============================================================================
+ * INCREMENT LOOPS
+ *============================================================================*/
+
+/**
+ * @brief Plain read-modify-write, like the demos' volatile shared_counter
+ */
+static void increment_volatile(long *counter, long *shared, long increments) {
+    volatile long *slot = counter;
+    (void)shared;
+    for (long i = 0; i < increments; i++) {
+        (*slot)++;
+    }
+}
+
+/**
+ * @brief Private counter, flushed to the shared atomic every FLUSH_INTERVAL
+ */
+static void increment_thread_local(long *counter, long *shared, long increments) {
+    long local = 0;
+    (void)counter;
+    for (long i = 0; i < increments; i++) {
+        // Opaque to the optimizer so the loop is not folded into one add
+        __asm__ __volatile__("" : "+r"(local));
+        local++;
+        if (local == FLUSH_INTERVAL) {
+            __atomic_add_fetch(shared, local, __ATOMIC_RELAXED);
+            local = 0;
+        }
+    }
+    __atomic_add_fetch(shared, local, __ATOMIC_RELAXED);
+}
+
+static void increment_rmw_relaxed(long *counter, long *shared, long increments) {
+    (void)counter;
+    for (long i = 0; i < increments; i++) {
+        __atomic_fetch_add(shared, 1, __ATOMIC_RELAXED);
+    }
+}
+
+static void increment_rmw_seq_cst(long *counter, long *shared, long increments) {
+    (void)counter;
+    for (long i = 0; i < increments; i++) {
+        __atomic_fetch_add(shared, 1, __ATOMIC_SEQ_CST);
+    }
+}
+
+static void increment_store_relaxed(long *counter, long *shared, long increments) {
+    (void)shared;
+    for (long i = 0; i < increments; i++) {
+        long value = __atomic_load_n(counter, __ATOMIC_RELAXED);
+        __atomic_store_n(counter, value + 1, __ATOMIC_RELAXED);
+    }
+}
+
+static void increment_store_seq_cst(long *counter, long *shared, long increments) {
+    (void)shared;
+    for (long i = 0; i < increments; i++) {
+        long value = __atomic_load_n(counter, __ATOMIC_SEQ_CST);
+        __atomic_store_n(counter, value + 1, __ATOMIC_SEQ_CST);
+    }
+}
+
+/** Every configuration, in report order */
+static const config_t configs[] = {
+    { "adjacent (volatile)",       sizeof(long), increment_volatile,      1 },
+    { "padded 64 (volatile)",      64,           increment_volatile,      1 },
+    { "padded 128 (volatile)",     128,          increment_volatile,      1 },
+    { "thread-local + flush",      0,            increment_thread_local,  0 },
+    { "shared fetch_add relaxed",  0,            increment_rmw_relaxed,   0 },
+    { "shared fetch_add seq_cst",  0,            increment_rmw_seq_cst,   0 },
+    { "adjacent store relaxed",    sizeof(long), increment_store_relaxed, 1 },
+    { "padded 64 store relaxed",   64,           increment_store_relaxed, 1 },
+    { "padded 64 store seq_cst",   64,           increment_store_seq_cst, 1 },
+};
+
+/** Configuration being run; read-only while workers run */
+static const config_t *active_config = NULL;
+
+/*============================================================================
+ * THREAD FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Worker: wait for the common start, then run the increment loop
+ */
+static void *worker_thread(void *arg) {
+    worker_arg_t *worker = (worker_arg_t *)arg;
+    run_state_t *state = worker->state;
+    long *shared = (long *)state->arena;
+    long *counter = (long *)(state->arena + state->stride * (size_t)worker->index);
+
+    futex_start_gate_arrive(&state->gate);
+    active_config->increment(counter, shared, state->increments);
+    return NULL;
+}
+
+/**
+ * @brief Run one configuration
+ * @return ns per increment per thread, or -1.0 if the final counts are wrong
+ */
+static double run_config(const config_t *config, int threads, long increments) {
+    static unsigned char arena[MAX_BENCH_THREADS * MAX_SLOT_SIZE]
+        __attribute__((aligned(MAX_SLOT_SIZE)));
+    run_state_t state;
+    pthread_t ids[MAX_BENCH_THREADS];
+    worker_arg_t args[MAX_BENCH_THREADS];
+
+    memset(arena, 0, sizeof(arena));
+    state.arena = arena;
+    state.stride = config->stride;
+    state.increments = increments;
+    active_config = config;
+    futex_start_gate_init(&state.gate, (unsigned int)threads);
+
+    for (int i = 0; i < threads; i++) {
+        args[i].state = &state;
+        args[i].index = i;
+        int result = pthread_create(&ids[i], NULL, worker_thread, &args[i]);
+        if (result != 0) {
+            fprintf(stderr, "Failed to create thread %d: %s\n", i, strerror(result));
+            exit(EXIT_FAILURE); // The gate would never open
+        }
+    }
+
+    futex_latch_wait(&state.gate.ready);
+    long long start = now_ns();
+    futex_event_set(&state.gate.go);
+    for (int i = 0; i < threads; i++) {
+        pthread_join(ids[i], NULL);
+    }
+    long long elapsed = now_ns() - start;
+
+    // Verify nothing was lost: per-thread slots or the one shared counter
+    if (config->per_thread_result) {
+        for (int i = 0; i < threads; i++) {
+            if (*(long *)(arena + config->stride * (size_t)i) != increments) {
+                return -1.0;
+            }
+        }
+    } else if (*(long *)arena != increments * threads) {
+        return -1.0;
+    }
+
+    return (double)elapsed / (double)increments;
+}
+
+/*============================================================================
+ * MAIN FUNCTION
+ *============================================================================*/
+
+/**
+ * @brief Main function - runs every configuration with 1 and N threads
+ * @return EXIT_SUCCESS on success, EXIT_FAILURE on bad arguments or lost counts
+ */
+int main(int argc, char **argv) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int threads = cpus > 2 ? (int)cpus : 2;
+    long increments = DEFAULT_INCREMENTS;
+
+    if (argc > 1) {
+        threads = (int)strtol(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        increments = strtol(argv[2], NULL, 10);
+    }
+    if (threads < 1 || threads > MAX_BENCH_THREADS || increments <= 0) {
+        fprintf(stderr, "Usage: %s [threads 1..%d] [increments_per_thread > 0]\n",
+                argv[0], MAX_BENCH_THREADS);
+        return EXIT_FAILURE;
+    }
+
+    printf("========================================================\n");
+    printf("    FALSE SHARING BENCHMARK\n");
+    printf("========================================================\n");
+    printf("Threads: %d, online CPUs: %ld, increments per thread: %ld\n",
+           threads, cpus, increments);
+    if (cpus < 2) {
+        printf("Note: one CPU, threads time-slice and no cache line is contended\n");
+    }
+    printf("\n%-28s %14s %14s %10s\n", "configuration", "1 thread ns/op",
+           "N threads ns/op", "slowdown");
+
+    int failed = 0;
+    for (size_t c = 0; c < sizeof(configs) / sizeof(configs[0]); c++) {
+        double single = run_config(&configs[c], 1, increments);
+        double multi = run_config(&configs[c], threads, increments);
+
+        if (single < 0.0 || multi < 0.0) {
+            printf("%-28s %14s %14s %10s\n", configs[c].name, "LOST", "LOST", "-");
+            failed = 1;
+            continue;
+        }
+        printf("%-28s %14.2f %14.2f %9.1fx\n", configs[c].name, single, multi, multi / single);
+    }
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,667 @@
+/**
+ * @file fiber.c
+ * @brief Fiber context switching, stacks and the work-stealing scheduler
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#define _GNU_SOURCE
+
+#include "fiber.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#if !defined(FIBER_USE_UCONTEXT) && !defined(__x86_64__)
+#define FIBER_USE_UCONTEXT 1
+#endif
+
+#ifdef FIBER_USE_UCONTEXT
+#include <ucontext.h>
+#endif
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+/** Stacks per mmap(); keeps 100k fibers far below vm.max_map_count */
+#define FIBER_SLAB_STACKS 256
+
+/** Words at the bottom of each stack that must stay zero */
+#define FIBER_CANARY_WORDS 16
+
+
+typedef struct fiber fiber_t;
+typedef struct fiber_worker fiber_worker_t;
+
+/** Saved registers of a suspended fiber or scheduler loop */
+typedef struct {
+#ifdef FIBER_USE_UCONTEXT
+    ucontext_t ucontext;
+#else
+    void *stack_pointer;        /**< Callee-saved registers live on the stack */
+#endif
+} fiber_context_t;
+
+/** Fiber control block, stored at the top of the fiber's own stack */
+struct fiber {
+    fiber_context_t context;
+    fiber_function_t function;
+    void *arg;
+    fiber_t *next;              /**< Run queue or free list link */
+    fiber_worker_t *worker;     /**< Worker currently running this fiber */
+    int finished;
+    uint64_t *canary;           /**< Lowest FIBER_CANARY_WORDS words; stay zero */
+};
+
+/** One mmap() holding the stacks of FIBER_SLAB_STACKS fibers */
+typedef struct stack_slab {
+    struct stack_slab *next;
+    void *memory;
+} stack_slab_t;
+
+/** FIFO of runnable fibers */
+typedef struct {
+    pthread_mutex_t lock;
+    fiber_t *head;
+    fiber_t *tail;
+    long count;
+} run_queue_t;
+
+/** One worker thread; cache-line aligned so queues do not share lines */
+struct fiber_worker {
+    run_queue_t queue;
+    fiber_context_t context;    /**< Scheduler loop, resumed when a fiber yields */
+    fiber_scheduler_t *scheduler;
+    int index;
+    pthread_t thread;
+} __attribute__((aligned(64)));
+
+struct fiber_scheduler {
+    fiber_worker_t *workers;
+    int worker_count;
+    size_t stack_size;          /**< Per fiber, page aligned */
+    long live;                  /**< Spawned and not yet finished */
+    unsigned int next_queue;    /**< Round-robin target for outside spawns */
+
+    pthread_mutex_t free_lock;
+    fiber_t *free_list;         /**< Finished fibers ready for reuse */
+    stack_slab_t *slabs;
+    int slab_unused;            /**< Stacks not yet handed out in slabs->memory */
+
+    pthread_mutex_t idle_lock;
+    pthread_cond_t idle_cond;
+    unsigned long idle_generation; /**< Bumped whenever idle workers should look again */
+    int idle_workers;
+};
+
+/** Worker running on this thread, NULL outside the scheduler */
+static __thread fiber_worker_t *current_worker = NULL;
+
+/** Fiber running on this thread, NULL in the scheduler loop */
+static __thread fiber_t *current_fiber = NULL;
+
+/*============================================================================
+ * CONTEXT SWITCH
+ *============================================================================*/
+
+void fiber_entry(fiber_t *fiber) __attribute__((visibility("hidden"), noreturn, used));
+
+#ifdef FIBER_USE_UCONTEXT
+
+/**
+ * @brief makecontext() entry; the fiber is taken from thread-local state
+ *        because makecontext() only passes int arguments portably
+ */
+static void fiber_ucontext_entry(void) {
+    fiber_entry(current_fiber);
+}
+
+static void context_init(fiber_t *fiber, void *stack_base, void *stack_top) {
+    getcontext(&fiber->context.ucontext);
+    fiber->context.ucontext.uc_stack.ss_sp = stack_base;
+    fiber->context.ucontext.uc_stack.ss_size = (size_t)((char *)stack_top - (char *)stack_base);
+    fiber->context.ucontext.uc_link = NULL;
+    makecontext(&fiber->context.ucontext, fiber_ucontext_entry, 0);
+}
+
+static void context_switch(fiber_context_t *from, fiber_context_t *to) {
+    swapcontext(&from->ucontext, &to->ucontext);
+}
+
+#else
+
+void fiber_switch_context(void **save_stack_pointer, void *load_stack_pointer)
+    __attribute__((visibility("hidden")));
+void fiber_trampoline(void) __attribute__((visibility("hidden")));
+
+/*
+ * fiber_switch_context(save, load): push the System V callee-saved registers
+ * plus MXCSR and the x87 control word, store %rsp to *save, switch to the
+ * stack `load` and pop the same frame from it.
+ *
+ * fiber_trampoline: first "return address" of a new fiber; the fiber
+ * pointer arrives in %r12 from the initial frame built by context_init().
+ */
+__asm__(
+    ".text\n"
+    ".p2align 4\n"
+    ".globl fiber_switch_context\n"
+    ".hidden fiber_switch_context\n"
+    ".type fiber_switch_context, @function\n"
+    "fiber_switch_context:\n"
+    "    pushq %rbp\n"
+    "    pushq %rbx\n"
+    "    pushq %r12\n"
+    "    pushq %r13\n"
+    "    pushq %r14\n"
+    "    pushq %r15\n"
+    "    subq $8, %rsp\n"
+    "    stmxcsr (%rsp)\n"
+    "    fnstcw 4(%rsp)\n"
+    "    movq %rsp, (%rdi)\n"
+    "    movq %rsi, %rsp\n"
+    "    ldmxcsr (%rsp)\n"
+    "    fldcw 4(%rsp)\n"
+    "    addq $8, %rsp\n"
+    "    popq %r15\n"
+    "    popq %r14\n"
+    "    popq %r13\n"
+    "    popq %r12\n"
+    "    popq %rbx\n"
+    "    popq %rbp\n"
+    "    ret\n"
+    ".size fiber_switch_context, .-fiber_switch_context\n"
+    "\n"
+    ".p2align 4\n"
+    ".globl fiber_trampoline\n"
+    ".hidden fiber_trampoline\n"
+    ".type fiber_trampoline, @function\n"
+    "fiber_trampoline:\n"
+    "    movq %r12, %rdi\n"
+    "    call fiber_entry\n"
+    "    ud2\n"
+    ".size fiber_trampoline, .-fiber_trampoline\n"
+);
+
+/** Default MXCSR (all exceptions masked) and x87 control word, as stored */
+#define INITIAL_FP_CONTROL 0x0000037F00001F80ULL
+
+/**
+ * @brief Build the frame fiber_switch_context() pops on the first switch
+ *
+ * The trampoline's address sits at the top so that %rsp is 16-byte aligned
+ * after `ret`, as the ABI requires before the `call fiber_entry`.
+ */
+static void context_init(fiber_t *fiber, void *stack_base, void *stack_top) {
+    uint64_t *sp = (uint64_t *)stack_top;
+    (void)stack_base;
+
+    *--sp = (uint64_t)(uintptr_t)fiber_trampoline;  // return address
+    *--sp = 0;                                      // rbp
+    *--sp = 0;                                      // rbx
+    *--sp = (uint64_t)(uintptr_t)fiber;             // r12
+    *--sp = 0;                                      // r13
+    *--sp = 0;                                      // r14
+    *--sp = 0;                                      // r15
+    *--sp = INITIAL_FP_CONTROL;                     // mxcsr, x87 cw
+    fiber->context.stack_pointer = sp;
+}
+
+static void context_switch(fiber_context_t *from, fiber_context_t *to) {
+    fiber_switch_context(&from->stack_pointer, to->stack_pointer);
+}
+
+#endif /* FIBER_USE_UCONTEXT */
+
+/**
+ * @brief First function on every fiber stack; never returns
+ *
+ * Uses fiber->worker rather than thread-local state after running the body:
+ * the fiber may have been stolen by another worker thread in between.
+ */
+void fiber_entry(fiber_t *fiber) {
+    fiber->function(fiber->arg);
+    fiber->finished = 1;
+    context_switch(&fiber->context, &fiber->worker->context);
+    abort(); // A finished fiber is never resumed
+}
+
+/*============================================================================
+ * RUN QUEUES
+ *============================================================================*/
+
+static void queue_push(run_queue_t *queue, fiber_t *fiber) {
+    fiber->next = NULL;
+    pthread_mutex_lock(&queue->lock);
+    if (queue->tail) {
+        queue->tail->next = fiber;
+    } else {
+        queue->head = fiber;
+    }
+    queue->tail = fiber;
+    queue->count++;
+    pthread_mutex_unlock(&queue->lock);
+}
+
+static fiber_t *queue_pop(run_queue_t *queue) {
+    pthread_mutex_lock(&queue->lock);
+    fiber_t *fiber = queue->head;
+    if (fiber) {
+        queue->head = fiber->next;
+        if (!queue->head) {
+            queue->tail = NULL;
+        }
+        queue->count--;
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return fiber;
+}
+
+/**
+ * @brief Move the older half of victim's queue to thief's queue
+ * @return One of the stolen fibers to run now, or NULL if victim was empty
+ */
+static fiber_t *queue_steal_half(run_queue_t *victim, run_queue_t *thief) {
+    pthread_mutex_lock(&victim->lock);
+    long take = (victim->count + 1) / 2;
+    if (take == 0) {
+        pthread_mutex_unlock(&victim->lock);
+        return NULL;
+    }
+
+    fiber_t *first = victim->head;
+    fiber_t *last = first;
+    for (long i = 1; i < take; i++) {
+        last = last->next;
+    }
+    victim->head = last->next;
+    if (!victim->head) {
+        victim->tail = NULL;
+    }
+    victim->count -= take;
+    pthread_mutex_unlock(&victim->lock);
+
+    last->next = NULL;
+    fiber_t *rest = first->next;
+    while (rest) {
+        fiber_t *next = rest->next;
+        queue_push(thief, rest);
+        rest = next;
+    }
+    return first;
+}
+
+/**
+ * @brief Wake one idle worker if any is waiting for work
+ *
+ * The fence orders the preceding queue update before the read of
+ * idle_workers; a worker going idle raises idle_workers before rescanning
+ * the queues, so one side always sees the other.
+ */
+static void notify_work(fiber_scheduler_t *scheduler) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&scheduler->idle_workers, __ATOMIC_RELAXED) > 0) {
+        pthread_mutex_lock(&scheduler->idle_lock);
+        scheduler->idle_generation++;
+        pthread_cond_signal(&scheduler->idle_cond);
+        pthread_mutex_unlock(&scheduler->idle_lock);
+    }
+}
+
+/**
+ * @brief Wake every idle worker (all fibers finished)
+ */
+static void notify_all(fiber_scheduler_t *scheduler) {
+    pthread_mutex_lock(&scheduler->idle_lock);
+    scheduler->idle_generation++;
+    pthread_cond_broadcast(&scheduler->idle_cond);
+    pthread_mutex_unlock(&scheduler->idle_lock);
+}
+
+/*============================================================================
+ * FIBER ALLOCATION
+ *============================================================================*/
+
+/**
+ * @brief Reuse a finished fiber or carve a new stack from the current slab
+ */
+static fiber_t *fiber_allocate(fiber_scheduler_t *scheduler) {
+    pthread_mutex_lock(&scheduler->free_lock);
+    fiber_t *fiber = scheduler->free_list;
+    if (fiber) {
+        scheduler->free_list = fiber->next;
+        pthread_mutex_unlock(&scheduler->free_lock);
+        return fiber;
+    }
+
+    if (scheduler->slab_unused == 0) {
+        stack_slab_t *slab = malloc(sizeof(*slab));
+        if (!slab) {
+            pthread_mutex_unlock(&scheduler->free_lock);
+            return NULL;
+        }
+        slab->memory = mmap(NULL, scheduler->stack_size * FIBER_SLAB_STACKS,
+                            PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK | MAP_NORESERVE, -1, 0);
+        if (slab->memory == MAP_FAILED) {
+            free(slab);
+            pthread_mutex_unlock(&scheduler->free_lock);
+            return NULL;
+        }
+        slab->next = scheduler->slabs;
+        scheduler->slabs = slab;
+        scheduler->slab_unused = FIBER_SLAB_STACKS;
+    }
+
+    scheduler->slab_unused--;
+    char *stack = (char *)scheduler->slabs->memory +
+                  (size_t)scheduler->slab_unused * scheduler->stack_size;
+    pthread_mutex_unlock(&scheduler->free_lock);
+
+    size_t block = (sizeof(fiber_t) + 63) & ~(size_t)63;
+    fiber = (fiber_t *)(stack + scheduler->stack_size - block);
+    fiber->canary = (uint64_t *)stack;
+    return fiber;
+}
+
+static void fiber_recycle(fiber_scheduler_t *scheduler, fiber_t *fiber) {
+    pthread_mutex_lock(&scheduler->free_lock);
+    fiber->next = scheduler->free_list;
+    scheduler->free_list = fiber;
+    pthread_mutex_unlock(&scheduler->free_lock);
+}
+
+/**
+ * @brief Abort if the fiber has written to the bottom of its stack
+ *
+ * Fresh anonymous memory reads as zero, so the canary costs nothing to set
+ * up and reading it never allocates a page. Checked every time a fiber
+ * switches back to its worker. Best effort: a frame larger than the canary
+ * can skip over it without writing it.
+ */
+static void check_stack(const fiber_t *fiber) {
+    uint64_t written = 0;
+    for (int i = 0; i < FIBER_CANARY_WORDS; i++) {
+        written |= fiber->canary[i];
+    }
+    if (written != 0) {
+        fprintf(stderr, "fiber: stack overflow detected, increase the stack size\n");
+        abort();
+    }
+}
+
+/*============================================================================
+ * WORKERS
+ *============================================================================*/
+
+/**
+ * @brief Next fiber for this worker: own queue, then steal, then sleep
+ * @return NULL once every fiber has finished
+ */
+static fiber_t *next_fiber(fiber_worker_t *worker) {
+    fiber_scheduler_t *scheduler = worker->scheduler;
+    int count = scheduler->worker_count;
+
+    for (;;) {
+        fiber_t *fiber = queue_pop(&worker->queue);
+        for (int i = 1; !fiber && i < count; i++) {
+            fiber_worker_t *victim = &scheduler->workers[(worker->index + i) % count];
+            fiber = queue_steal_half(&victim->queue, &worker->queue);
+        }
+        if (fiber) {
+            return fiber;
+        }
+        if (__atomic_load_n(&scheduler->live, __ATOMIC_ACQUIRE) == 0) {
+            return NULL;
+        }
+
+        // Announce ourselves before the final scan so pushers notice us
+        pthread_mutex_lock(&scheduler->idle_lock);
+        unsigned long generation = scheduler->idle_generation;
+        __atomic_add_fetch(&scheduler->idle_workers, 1, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&scheduler->idle_lock);
+
+        for (int i = 0; !fiber && i < count; i++) {
+            fiber_worker_t *victim = &scheduler->workers[(worker->index + i) % count];
+            fiber = queue_steal_half(&victim->queue, &worker->queue);
+        }
+
+        if (!fiber) {
+            pthread_mutex_lock(&scheduler->idle_lock);
+            while (generation == scheduler->idle_generation &&
+                   __atomic_load_n(&scheduler->live, __ATOMIC_ACQUIRE) > 0) {
+                pthread_cond_wait(&scheduler->idle_cond, &scheduler->idle_lock);
+            }
+            pthread_mutex_unlock(&scheduler->idle_lock);
+        }
+        __atomic_sub_fetch(&scheduler->idle_workers, 1, __ATOMIC_RELAXED);
+
+        if (fiber) {
+            return fiber;
+        }
+    }
+}
+
+/**
+ * @brief Worker thread: resume fibers until none are left
+ */
+static void *worker_main(void *arg) {
+    fiber_worker_t *worker = (fiber_worker_t *)arg;
+    fiber_scheduler_t *scheduler = worker->scheduler;
+    fiber_t *fiber;
+
+    current_worker = worker;
+    while ((fiber = next_fiber(worker)) != NULL) {
+        fiber->worker = worker;
+        current_fiber = fiber;
+        context_switch(&worker->context, &fiber->context);
+        current_fiber = NULL;
+        check_stack(fiber);
+
+        // The fiber is off its stack now, so it is safe to hand it on
+        if (fiber->finished) {
+            fiber_recycle(scheduler, fiber);
+            if (__atomic_sub_fetch(&scheduler->live, 1, __ATOMIC_ACQ_REL) == 0) {
+                notify_all(scheduler);
+            }
+        } else {
+            queue_push(&worker->queue, fiber);
+            notify_work(scheduler);
+        }
+    }
+    current_worker = NULL;
+    return NULL;
+}
+
+/*============================================================================
+ * PUBLIC API
+ *============================================================================*/
+
+/**
+ * @brief Create a scheduler
+ * @param workers Worker threads; <= 0 means one per online CPU
+ * @param stack_size Bytes per fiber including its control block; 0 for
+ *        FIBER_DEFAULT_STACK_SIZE. Rounded up to whole pages.
+ * @return The scheduler, or NULL on invalid arguments or allocation failure
+ */
+fiber_scheduler_t *fiber_scheduler_create(int workers, size_t stack_size) {
+    long page = sysconf(_SC_PAGESIZE);
+    if (page <= 0) {
+        page = 4096;
+    }
+    if (workers <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        workers = cpus > 0 ? (int)cpus : 1;
+    }
+    if (stack_size == 0) {
+        stack_size = FIBER_DEFAULT_STACK_SIZE;
+    }
+    if (stack_size < FIBER_MIN_STACK_SIZE || stack_size < sizeof(fiber_t) * 2) {
+        return NULL;
+    }
+
+    fiber_scheduler_t *scheduler = calloc(1, sizeof(*scheduler));
+    if (!scheduler) {
+        return NULL;
+    }
+
+    void *memory = NULL;
+    if (posix_memalign(&memory, 64, sizeof(fiber_worker_t) * (size_t)workers) != 0) {
+        free(scheduler);
+        return NULL;
+    }
+    scheduler->workers = memory;
+    memset(scheduler->workers, 0, sizeof(fiber_worker_t) * (size_t)workers);
+
+    scheduler->worker_count = workers;
+    scheduler->stack_size = (stack_size + (size_t)page - 1) & ~((size_t)page - 1);
+    pthread_mutex_init(&scheduler->free_lock, NULL);
+    pthread_mutex_init(&scheduler->idle_lock, NULL);
+    pthread_cond_init(&scheduler->idle_cond, NULL);
+
+    for (int i = 0; i < workers; i++) {
+        pthread_mutex_init(&scheduler->workers[i].queue.lock, NULL);
+        scheduler->workers[i].scheduler = scheduler;
+        scheduler->workers[i].index = i;
+    }
+    return scheduler;
+}
+
+/**
+ * @brief Free the scheduler and every fiber stack, run or not
+ * @note Must not be called while fiber_scheduler_run() is active
+ */
+void fiber_scheduler_destroy(fiber_scheduler_t *scheduler) {
+    if (!scheduler) {
+        return;
+    }
+    for (int i = 0; i < scheduler->worker_count; i++) {
+        pthread_mutex_destroy(&scheduler->workers[i].queue.lock);
+    }
+    while (scheduler->slabs) {
+        stack_slab_t *next = scheduler->slabs->next;
+        munmap(scheduler->slabs->memory, scheduler->stack_size * FIBER_SLAB_STACKS);
+        free(scheduler->slabs);
+        scheduler->slabs = next;
+    }
+
+    pthread_mutex_destroy(&scheduler->free_lock);
+    pthread_mutex_destroy(&scheduler->idle_lock);
+    pthread_cond_destroy(&scheduler->idle_cond);
+    free(scheduler->workers);
+    free(scheduler);
+}
+
+/**
+ * @brief Create a fiber that will run function(arg)
+ *
+ * Callable from outside the scheduler (fibers are dealt round-robin to the
+ * worker queues) or from a running fiber (queued on the current worker).
+ *
+ * @return 0 on success, EINVAL or ENOMEM on failure
+ */
+int fiber_spawn(fiber_scheduler_t *scheduler, fiber_function_t function, void *arg) {
+    if (!scheduler || !function) {
+        return EINVAL;
+    }
+
+    fiber_t *fiber = fiber_allocate(scheduler);
+    if (!fiber) {
+        return ENOMEM;
+    }
+
+    fiber->function = function;
+    fiber->arg = arg;
+    fiber->finished = 0;
+    fiber->worker = NULL;
+    void *stack_base = fiber->canary + FIBER_CANARY_WORDS;
+    void *stack_top = (void *)((uintptr_t)fiber & ~(uintptr_t)15);
+    context_init(fiber, stack_base, stack_top);
+
+    __atomic_add_fetch(&scheduler->live, 1, __ATOMIC_ACQ_REL);
+
+    fiber_worker_t *worker = current_worker;
+    if (!worker || worker->scheduler != scheduler) {
+        unsigned int slot = __atomic_fetch_add(&scheduler->next_queue, 1, __ATOMIC_RELAXED);
+        worker = &scheduler->workers[slot % (unsigned int)scheduler->worker_count];
+    }
+    queue_push(&worker->queue, fiber);
+    notify_work(scheduler);
+    return 0;
+}
+
+/**
+ * @brief Run every spawned fiber (and those they spawn) to completion
+ *
+ * Starts the worker threads and joins them. If only some workers can be
+ * created the others' queues are drained by stealing.
+ *
+ * @return 0 on success, EDEADLK if called from a fiber, or the
+ *         pthread_create error if no worker could be started
+ */
+int fiber_scheduler_run(fiber_scheduler_t *scheduler) {
+    if (!scheduler) {
+        return EINVAL;
+    }
+    if (current_worker) {
+        return EDEADLK;
+    }
+    if (__atomic_load_n(&scheduler->live, __ATOMIC_ACQUIRE) == 0) {
+        return 0;
+    }
+
+    int started = 0;
+    int error = 0;
+    for (int i = 0; i < scheduler->worker_count; i++) {
+        fiber_worker_t *worker = &scheduler->workers[i];
+        int result = pthread_create(&worker->thread, NULL, worker_main, worker);
+        if (result != 0) {
+            error = result;
+            break;
+        }
+        started++;
+    }
+
+    for (int i = 0; i < started; i++) {
+        pthread_join(scheduler->workers[i].thread, NULL);
+    }
+    return started > 0 ? 0 : error;
+}
+
+/**
+ * @brief Let the other runnable fibers on this worker run
+ *
+ * A no-op outside a fiber, so shared job code can call it unconditionally.
+ */
+void fiber_yield(void) {
+    fiber_t *self = current_fiber;
+    if (!self) {
+        return;
+    }
+    context_switch(&self->context, &self->worker->context);
+}
+
+/**
+ * @brief Index of the worker running the caller, or -1 outside a fiber
+ */
+int fiber_worker_index(void) {
+    return current_fiber ? current_worker->index : -1;
+}
+
+/**
+ * @brief Name of the compiled-in context switch implementation
+ */
+const char *fiber_backend_name(void) {
+#ifdef FIBER_USE_UCONTEXT
+    return "ucontext";
+#else
+    return "x86-64 assembly";
+#endif
+}
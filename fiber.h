@@ -0,0 +1,77 @@
+/**
+ * @file fiber.h
+ * @brief User-space fibers on an M:N work-stealing scheduler
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * A fiber is a function with its own small stack that runs on one of a few
+ * worker threads and gives up the CPU cooperatively with fiber_yield().
+ * Switching fibers saves and restores only the callee-saved registers and
+ * never enters the kernel. A whole fiber_yield() (switch to the worker,
+ * requeue under the run queue lock, switch to the next fiber) measures
+ * about 160-170 ns in fiber_bench on a small VM, against about 4 us for a
+ * mutex and condition variable handoff between kernel threads. And 100k
+ * concurrent fibers need 100k small stacks instead of 100k kernel threads.
+ *
+ * Scheduling:
+ * - Every worker owns a FIFO run queue; a yielding fiber goes to the back
+ *   of its worker's queue
+ * - A worker whose queue is empty steals from the other queues, and sleeps
+ *   on a condition variable only when there is nothing to steal
+ * - fiber_scheduler_run() returns once every fiber has finished
+ *
+ * Stacks are carved from mmap()ed slabs of 256 (one mapping each, so 100k
+ * fibers stay far below the kernel's vm.max_map_count, which per-stack guard
+ * pages would exceed). The fiber control block sits at the top of its stack.
+ * The bottom 128 bytes must stay zero and are checked on every switch back
+ * to the scheduler (best effort: a large frame can jump over them). A fiber
+ * that never recurses deeply touches one page. Finished fibers are recycled
+ * for later spawns.
+ *
+ * The context switch is hand-written for x86-64. Other architectures, or
+ * builds with -DFIBER_USE_UCONTEXT, use swapcontext(), which also saves the
+ * signal mask (one system call per switch).
+ *
+ * A fiber must not block its worker for long (sleeping, waiting on a
+ * condition variable): the other fibers queued on that worker wait too,
+ * until another worker steals them.
+ *
+ * A fiber may resume on a different worker thread after fiber_yield(), so
+ * it must not hold a mutex or rely on thread-local variables across a yield.
+ */
+
+#ifndef FIBER_H
+#define FIBER_H
+
+#include <stddef.h>
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+/** Default stack size per fiber (its control block is carved from the top) */
+#define FIBER_DEFAULT_STACK_SIZE (16 * 1024)
+
+/** Smallest accepted stack size */
+#define FIBER_MIN_STACK_SIZE (4 * 1024)
+
+/** Fiber entry point */
+typedef void (*fiber_function_t)(void *arg);
+
+/** Opaque scheduler */
+typedef struct fiber_scheduler fiber_scheduler_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+fiber_scheduler_t *fiber_scheduler_create(int workers, size_t stack_size);
+void fiber_scheduler_destroy(fiber_scheduler_t *scheduler);
+int fiber_spawn(fiber_scheduler_t *scheduler, fiber_function_t function, void *arg);
+int fiber_scheduler_run(fiber_scheduler_t *scheduler);
+
+void fiber_yield(void);
+int fiber_worker_index(void);
+const char *fiber_backend_name(void);
+
+#endif /* FIBER_H */
@@ -0,0 +1,333 @@
+/**
+ * @file fiber_bench.c
+ * @brief Fiber vs pthread context switch cost and 100k-job throughput
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * 1. Context switch: two fibers on one worker yield to each other N times,
+ *    compared with two threads handing a token back and forth through a
+ *    mutex + condition variable. Both threads are pinned to the same CPU so
+ *    every hand-off is a real kernel context switch.
+ * 2. Concurrent jobs: J jobs that each do S slices of work with a yield in
+ *    between, all alive at the same time on W worker threads. For scale,
+ *    the same job is run thread-per-job (create + join) for a sample.
+ *
+ * Usage: ./fiber_bench [jobs] [workers] [switches]
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+
+#include "clock_ns.h"
+#include "fiber.h"
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+#define DEFAULT_JOBS 100000
+#define DEFAULT_WORKERS 4
+#define DEFAULT_SWITCHES 1000000
+
+/** Work slices per job, with a yield after each */
+#define JOB_SLICES 8
+
+/** Iterations of arithmetic per slice */
+#define SLICE_WORK 200
+
+/** Thread-per-job comparison runs this many jobs, this many at a time */
+#define THREAD_SAMPLE_JOBS 2000
+#define THREAD_BATCH 100
+
+/**
+ * @brief Token passed between two pthreads
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    int turn;
+    long rounds;
+    int cpu;
+} ping_pong_t;
+
+/**
+ * @brief Argument of one ping-pong side
+ */
+typedef struct {
+    ping_pong_t *shared;
+    int side;
+} ping_pong_arg_t;
+
+/** Result accumulator shared by every job */
+static unsigned long job_checksum = 0;
+static long jobs_done = 0;
+
+/** Switches per fiber in the ping-pong measurement */
+static long fiber_rounds = 0;
+
+/*============================================================================
+ * UTILITY FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Peak resident set size of the process in MiB
+ */
+static double peak_rss_mb(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (double)usage.ru_maxrss / 1024.0;
+}
+
+/**
+ * @brief Pin the calling thread to one CPU
+ */
+static void pin_to_cpu(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    sched_setaffinity(0, sizeof(set), &set);
+}
+
+/**
+ * @brief First CPU this process may run on
+ */
+static int first_allowed_cpu(void) {
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &set)) {
+                return cpu;
+            }
+        }
+    }
+    return 0;
+}
+
+/*============================================================================
+ * CONTEXT SWITCH
+ *============================================================================*/
+
+/**
+ * @brief Fiber side of the ping-pong: yield fiber_rounds times
+ */
+static void ping_pong_fiber(void *arg) {
+    (void)arg;
+    for (long i = 0; i < fiber_rounds; i++) {
+        fiber_yield();
+    }
+}
+
+/**
+ * @brief Nanoseconds per fiber-to-fiber switch on a single worker
+ */
+static double fiber_switch_ns(long switches) {
+    fiber_scheduler_t *scheduler = fiber_scheduler_create(1, 0);
+    if (!scheduler) {
+        fprintf(stderr, "Failed to create fiber scheduler\n");
+        exit(EXIT_FAILURE);
+    }
+
+    fiber_rounds = switches / 2;
+    fiber_spawn(scheduler, ping_pong_fiber, NULL);
+    fiber_spawn(scheduler, ping_pong_fiber, NULL);
+
+    long long start = now_ns();
+    fiber_scheduler_run(scheduler);
+    long long elapsed = now_ns() - start;
+
+    fiber_scheduler_destroy(scheduler);
+    return (double)elapsed / (double)(fiber_rounds * 2);
+}
+
+/**
+ * @brief Thread side of the ping-pong: wait for our turn, pass it on
+ */
+static void *ping_pong_thread(void *arg) {
+    ping_pong_arg_t *side = (ping_pong_arg_t *)arg;
+    ping_pong_t *shared = side->shared;
+
+    pin_to_cpu(shared->cpu);
+    pthread_mutex_lock(&shared->lock);
+    for (long i = 0; i < shared->rounds; i++) {
+        while (shared->turn != side->side) {
+            pthread_cond_wait(&shared->changed, &shared->lock);
+        }
+        shared->turn = !side->side;
+        pthread_cond_signal(&shared->changed);
+    }
+    pthread_mutex_unlock(&shared->lock);
+    return NULL;
+}
+
+/**
+ * @brief Nanoseconds per thread-to-thread hand-off on one CPU
+ */
+static double thread_switch_ns(long switches) {
+    ping_pong_t shared;
+    ping_pong_arg_t sides[2] = { { &shared, 0 }, { &shared, 1 } };
+    pthread_t threads[2];
+
+    pthread_mutex_init(&shared.lock, NULL);
+    pthread_cond_init(&shared.changed, NULL);
+    shared.turn = 0;
+    shared.rounds = switches / 2;
+    shared.cpu = first_allowed_cpu();
+
+    long long start = now_ns();
+    for (int i = 0; i < 2; i++) {
+        if (pthread_create(&threads[i], NULL, ping_pong_thread, &sides[i]) != 0) {
+            fprintf(stderr, "Failed to create ping-pong thread\n");
+            exit(EXIT_FAILURE); // The other side would wait forever
+        }
+    }
+    for (int i = 0; i < 2; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    long long elapsed = now_ns() - start;
+
+    pthread_cond_destroy(&shared.changed);
+    pthread_mutex_destroy(&shared.lock);
+    return (double)elapsed / (double)(shared.rounds * 2);
+}
+
+/*============================================================================
+ * CONCURRENT JOBS
+ *============================================================================*/
+
+/**
+ * @brief One slice of arithmetic work
+ */
+static unsigned long job_slice(unsigned long seed) {
+    unsigned long x = seed | 1;
+    for (int i = 0; i < SLICE_WORK; i++) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+    }
+    return x;
+}
+
+/**
+ * @brief Job body shared by the fiber and thread versions
+ */
+static void run_job(unsigned long id) {
+    unsigned long value = id;
+    for (int s = 0; s < JOB_SLICES; s++) {
+        value = job_slice(value);
+        fiber_yield();
+    }
+    __atomic_add_fetch(&job_checksum, value & 0xFFFF, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&jobs_done, 1, __ATOMIC_RELAXED);
+}
+
+static void job_fiber(void *arg) {
+    run_job((unsigned long)(size_t)arg);
+}
+
+static void *job_thread(void *arg) {
+    run_job((unsigned long)(size_t)arg);
+    return NULL;
+}
+
+/*============================================================================
+ * MAIN FUNCTION
+ *============================================================================*/
+
+/**
+ * @brief Main function - runs the switch and throughput comparisons
+ * @return EXIT_SUCCESS on success, EXIT_FAILURE on error or lost jobs
+ */
+int main(int argc, char **argv) {
+    long jobs = DEFAULT_JOBS;
+    int workers = DEFAULT_WORKERS;
+    long switches = DEFAULT_SWITCHES;
+
+    if (argc > 1) {
+        jobs = strtol(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        workers = (int)strtol(argv[2], NULL, 10);
+    }
+    if (argc > 3) {
+        switches = strtol(argv[3], NULL, 10);
+    }
+    if (jobs <= 0 || workers <= 0 || switches < 2) {
+        fprintf(stderr, "Usage: %s [jobs > 0] [workers > 0] [switches >= 2]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    printf("========================================================\n");
+    printf("    FIBER VS PTHREAD BENCHMARK\n");
+    printf("========================================================\n");
+    printf("Fiber backend: %s, stack: %d KiB\n\n", fiber_backend_name(),
+           FIBER_DEFAULT_STACK_SIZE / 1024);
+
+    printf("Context switch (%ld switches):\n", switches);
+    double fiber_ns = fiber_switch_ns(switches);
+    double thread_ns = thread_switch_ns(switches);
+    printf("  %-28s %10.1f ns/switch\n", "fiber_yield (1 worker)", fiber_ns);
+    printf("  %-28s %10.1f ns/switch\n", "pthread mutex+condvar (1 CPU)", thread_ns);
+    printf("  %-28s %10.1fx\n\n", "thread / fiber", thread_ns / fiber_ns);
+
+    // Fibers: every job is spawned before any runs, so all are alive at once
+    fiber_scheduler_t *scheduler = fiber_scheduler_create(workers, 0);
+    if (!scheduler) {
+        fprintf(stderr, "Failed to create fiber scheduler\n");
+        return EXIT_FAILURE;
+    }
+
+    long long start = now_ns();
+    for (long i = 0; i < jobs; i++) {
+        int result = fiber_spawn(scheduler, job_fiber, (void *)(size_t)i);
+        if (result != 0) {
+            fprintf(stderr, "Failed to spawn fiber %ld: %s\n", i, strerror(result));
+            fiber_scheduler_destroy(scheduler);
+            return EXIT_FAILURE;
+        }
+    }
+    long long spawned = now_ns();
+    fiber_scheduler_run(scheduler);
+    long long finished = now_ns();
+    fiber_scheduler_destroy(scheduler);
+
+    long fiber_jobs = jobs_done;
+    double fiber_job_us = (double)(finished - start) / 1e3 / (double)jobs;
+    printf("%ld concurrent jobs, %d slices each, on %d workers:\n", jobs, JOB_SLICES, workers);
+    printf("  %-28s %10.1f ms\n", "spawn", (double)(spawned - start) / 1e6);
+    printf("  %-28s %10.1f ms\n", "run to completion", (double)(finished - spawned) / 1e6);
+    printf("  %-28s %10.2f us/job\n", "fibers", fiber_job_us);
+    printf("  %-28s %10.1f MiB\n", "peak RSS", peak_rss_mb());
+
+    // Threads: a sample, THREAD_BATCH at a time
+    long sample = jobs < THREAD_SAMPLE_JOBS ? jobs : THREAD_SAMPLE_JOBS;
+    pthread_t threads[THREAD_BATCH];
+    start = now_ns();
+    for (long base = 0; base < sample; base += THREAD_BATCH) {
+        int batch = 0;
+        for (long i = base; i < sample && i < base + THREAD_BATCH; i++) {
+            if (pthread_create(&threads[batch], NULL, job_thread, (void *)(size_t)i) != 0) {
+                break;
+            }
+            batch++;
+        }
+        for (int i = 0; i < batch; i++) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+    double thread_job_us = (double)(now_ns() - start) / 1e3 / (double)sample;
+    printf("  %-28s %10.2f us/job (sample of %ld, %d at a time)\n",
+           "thread per job", thread_job_us, sample, THREAD_BATCH);
+    printf("  %-28s %10.1fx\n", "thread / fiber", thread_job_us / fiber_job_us);
+
+    if (fiber_jobs != jobs) {
+        fprintf(stderr, "Lost fiber jobs: %ld of %ld completed\n", fiber_jobs, jobs);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
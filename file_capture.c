@@ -0,0 +1,562 @@
+/**
+ * @file file_capture.c
+ * @brief Copy child stdout pipes into files with batched io_uring requests or epoll
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#define _GNU_SOURCE
+
+#include "file_capture.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+
+#include "clock_ns.h"
+#include "io_ring.h"
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+/** Events fetched per epoll_wait() call */
+#define CAPTURE_MAX_EVENTS 64
+
+/**
+ * io_uring requests of a job. The user data of each request is
+ * (job index << OP_BITS) | op.
+ */
+enum {
+    OP_READ = 0,
+    OP_WRITE = 1,               /**< OP_WRITE + buffer index */
+    OP_EXIT = 3,
+    OP_BITS = 2
+};
+
+/** Requests a job can have in flight: a read, two writes and the exit poll */
+#define REQUESTS_PER_JOB 4
+
+/**
+ * @brief Backend-private state of one job
+ */
+typedef struct {
+    pid_t pid;
+    int pipe_fd;                /**< Read end of the child's stdout; -1 once closed */
+    int file_fd;
+    int pidfd;                  /**< -1 once the child has been reaped */
+    int running;
+    long long start_ns;
+
+    /* io_uring only */
+    char *buffers[2];
+    int reading;                /**< Buffer a read is in flight for, or -1 */
+    unsigned write_length[2];   /**< Bytes of a buffer being written; 0 when free */
+    unsigned write_done[2];
+    uint64_t write_offset[2];
+} job_state_t;
+
+/*============================================================================
+ * UTILITY FUNCTIONS
+ *============================================================================*/
+
+static int write_all(int fd, const char *data, size_t length, unsigned long *calls) {
+    while (length > 0) {
+        ssize_t written = write(fd, data, length);
+        (*calls)++;
+        if (written == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+    return 0;
+}
+
+/*============================================================================
+ * JOBS
+ *============================================================================*/
+
+/**
+ * @brief Prepare a job from a command line (see launcher_split())
+ * @param path Output file; not copied, so it must outlive the job
+ * @return 0, or EINVAL/E2BIG/ENOMEM; the job needs no release on failure
+ */
+int file_capture_job_init(file_capture_job_t *job, const char *command, const char *path) {
+    memset(job, 0, sizeof(*job));
+    if (!path) {
+        return EINVAL;
+    }
+
+    int result = launcher_command_init(&job->command, command);
+    if (result == 0) {
+        job->argv = job->command.argv;
+        job->path = path;
+    }
+    return result;
+}
+
+/**
+ * @brief Free a job's command
+ */
+void file_capture_job_release(file_capture_job_t *job) {
+    launcher_command_release(&job->command);
+    job->argv = NULL;
+}
+
+/**
+ * @brief Open the output file and spawn the job with stdout on a pipe
+ * @return 0 if the job is running; otherwise job->error is set and the job
+ *         is already complete
+ */
+static int start_job(file_capture_job_t *job, job_state_t *state) {
+    int fds[2] = { -1, -1 };
+    int result = 0;
+
+    memset(state, 0, sizeof(*state));
+    state->pipe_fd = -1;
+    state->pidfd = -1;
+    state->reading = -1;
+    state->start_ns = now_ns();
+    job->bytes = 0;
+    job->status = 0;
+    job->error = 0;
+    job->elapsed_ns = 0;
+
+    state->file_fd = open(job->path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (state->file_fd == -1 || pipe2(fds, O_CLOEXEC) == -1) {
+        result = errno;
+    }
+    if (result == 0) {
+        // Fewer, larger reads; a smaller pipe is fine if the limit forbids it
+        fcntl(fds[0], F_SETPIPE_SZ, FILE_CAPTURE_BUFFER_SIZE);
+        result = launcher_spawn_fds(job->argv, -1, fds[1], -1, &state->pid);
+    }
+    if (fds[1] >= 0) {
+        close(fds[1]);
+    }
+    if (result == 0) {
+        state->pipe_fd = fds[0];
+        state->pidfd = launcher_pidfd_open(state->pid);
+        if (state->pidfd == -1) {
+            result = errno;
+            kill(state->pid, SIGKILL);
+            launcher_wait(state->pid, &job->status);
+        }
+    } else if (fds[0] >= 0) {
+        close(fds[0]);
+    }
+
+    if (result != 0) {
+        if (state->pipe_fd >= 0) {
+            close(state->pipe_fd);
+            state->pipe_fd = -1;
+        }
+        if (state->file_fd >= 0) {
+            close(state->file_fd);
+        }
+        job->error = result;
+        job->elapsed_ns = now_ns() - state->start_ns;
+        return result;
+    }
+    state->running = 1;
+    return 0;
+}
+
+/**
+ * @brief Reap the child through its readable pidfd
+ */
+static void reap_job(file_capture_job_t *job, job_state_t *state) {
+    int result = launcher_wait(state->pid, &job->status);
+    if (result != 0 && job->error == 0) {
+        job->error = result;
+    }
+    close(state->pidfd);
+    state->pidfd = -1;
+}
+
+/**
+ * @brief Close what is left of a job and record its time
+ */
+static void finish_job(file_capture_job_t *job, job_state_t *state) {
+    if (state->pipe_fd >= 0) {
+        close(state->pipe_fd);
+        state->pipe_fd = -1;
+    }
+    if (close(state->file_fd) != 0 && job->error == 0) {
+        job->error = errno;
+    }
+    free(state->buffers[0]);
+    free(state->buffers[1]);
+    state->buffers[0] = NULL;
+    state->buffers[1] = NULL;
+    state->running = 0;
+    job->elapsed_ns = now_ns() - state->start_ns;
+}
+
+/**
+ * @brief Stop and reap every running job after the backend itself failed
+ */
+static void abandon_jobs(file_capture_job_t *jobs, job_state_t *states, int count, int error) {
+    for (int i = 0; i < count; i++) {
+        if (!states[i].running) {
+            continue;
+        }
+        if (states[i].pidfd >= 0) {
+            kill(states[i].pid, SIGKILL);
+            reap_job(&jobs[i], &states[i]);
+        }
+        jobs[i].error = error;
+        finish_job(&jobs[i], &states[i]);
+    }
+}
+
+/*============================================================================
+ * EPOLL BACKEND
+ *============================================================================*/
+
+/**
+ * @brief One read() per readiness, written straight to the file
+ */
+static void epoll_copy(int epoll_fd, file_capture_job_t *job, job_state_t *state,
+                       char *buffer, file_capture_stats_t *stats) {
+    ssize_t bytes = read(state->pipe_fd, buffer, FILE_CAPTURE_BUFFER_SIZE);
+    stats->reads++;
+    if (bytes == -1 && (errno == EAGAIN || errno == EINTR)) {
+        return;
+    }
+    if (bytes > 0) {
+        // After a failed write keep draining the pipe so the child can finish
+        if (job->error == 0) {
+            job->error = write_all(state->file_fd, buffer, (size_t)bytes, &stats->writes);
+        }
+        job->bytes += (uint64_t)bytes;
+        return;
+    }
+    if (bytes == -1 && job->error == 0) {
+        job->error = errno;
+    }
+    // End of file, or an error after which the pipe is given up
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, state->pipe_fd, NULL);
+    close(state->pipe_fd);
+    state->pipe_fd = -1;
+}
+
+static int run_epoll(file_capture_job_t *jobs, job_state_t *states, int count,
+                     file_capture_stats_t *stats) {
+    struct epoll_event events[CAPTURE_MAX_EVENTS];
+    int running = 0;
+
+    char *buffer = malloc(FILE_CAPTURE_BUFFER_SIZE);
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (!buffer || epoll_fd == -1) {
+        int result = buffer ? errno : ENOMEM;
+        free(buffer);
+        return result;
+    }
+
+    for (int i = 0; i < count; i++) {
+        job_state_t *state = &states[i];
+        if (start_job(&jobs[i], state) != 0) {
+            continue;
+        }
+        struct epoll_event pipe_event = { .events = EPOLLIN, .data.u64 = (uint64_t)i << 1 };
+        struct epoll_event exit_event = { .events = EPOLLIN, .data.u64 = ((uint64_t)i << 1) | 1 };
+        fcntl(state->pipe_fd, F_SETFL, O_NONBLOCK);
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, state->pipe_fd, &pipe_event) == -1 ||
+            epoll_ctl(epoll_fd, EPOLL_CTL_ADD, state->pidfd, &exit_event) == -1) {
+            abandon_jobs(&jobs[i], state, 1, errno);
+            continue;
+        }
+        running++;
+    }
+
+    int result = 0;
+    while (running > 0) {
+        int ready = epoll_wait(epoll_fd, events, CAPTURE_MAX_EVENTS, -1);
+        stats->waits++;
+        if (ready == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            result = errno;
+            abandon_jobs(jobs, states, count, result);
+            break;
+        }
+
+        for (int e = 0; e < ready; e++) {
+            int index = (int)(events[e].data.u64 >> 1);
+            file_capture_job_t *job = &jobs[index];
+            job_state_t *state = &states[index];
+
+            if ((events[e].data.u64 & 1) == 0) {
+                // Stale event for a pipe closed earlier in this batch
+                if (state->pipe_fd >= 0) {
+                    epoll_copy(epoll_fd, job, state, buffer, stats);
+                }
+            } else if (state->pidfd >= 0) {
+                epoll_ctl(epoll_fd, EPOLL_CTL_DEL, state->pidfd, NULL);
+                reap_job(job, state);
+            }
+            if (state->running && state->pipe_fd == -1 && state->pidfd == -1) {
+                finish_job(job, state);
+                running--;
+            }
+        }
+    }
+
+    close(epoll_fd);
+    free(buffer);
+    return result;
+}
+
+/*============================================================================
+ * IO_URING BACKEND
+ *============================================================================*/
+
+static uint64_t user_data(int index, int op) {
+    return ((uint64_t)index << OP_BITS) | (uint64_t)op;
+}
+
+static int queue_read(io_ring_t *ring, int index, job_state_t *state, int buffer,
+                      file_capture_stats_t *stats) {
+    struct io_uring_sqe *sqe = io_ring_get_sqe(ring);
+    if (!sqe) {
+        return EBUSY;
+    }
+    // Pipes have no position: -1 reads at the current one
+    io_ring_prep_rw(sqe, IORING_OP_READ, state->pipe_fd, state->buffers[buffer],
+                    FILE_CAPTURE_BUFFER_SIZE, (uint64_t)-1, user_data(index, OP_READ));
+    state->reading = buffer;
+    stats->reads++;
+    return 0;
+}
+
+static int queue_write(io_ring_t *ring, int index, job_state_t *state, int buffer,
+                       file_capture_stats_t *stats) {
+    struct io_uring_sqe *sqe = io_ring_get_sqe(ring);
+    if (!sqe) {
+        return EBUSY;
+    }
+    unsigned done = state->write_done[buffer];
+    io_ring_prep_rw(sqe, IORING_OP_WRITE, state->file_fd, state->buffers[buffer] + done,
+                    state->write_length[buffer] - done, state->write_offset[buffer] + done,
+                    user_data(index, OP_WRITE + buffer));
+    stats->writes++;
+    return 0;
+}
+
+/**
+ * @brief Act on one completion; follow-up requests are only queued here
+ */
+static int handle_completion(io_ring_t *ring, file_capture_job_t *job, job_state_t *state,
+                             int index, int op, int res, file_capture_stats_t *stats) {
+    if (op == OP_EXIT) {
+        reap_job(job, state);
+        return 0;
+    }
+
+    if (op == OP_READ) {
+        int buffer = state->reading;
+        if (buffer == -1) {
+            // No read is outstanding for this job: not one of ours
+            return 0;
+        }
+        state->reading = -1;
+        if (res == -EINTR || res == -EAGAIN) {
+            return queue_read(ring, index, state, buffer, stats);
+        }
+        if (res <= 0) {
+            if (res < 0 && job->error == 0) {
+                job->error = -res;
+            }
+            close(state->pipe_fd);
+            state->pipe_fd = -1;
+            return 0;
+        }
+
+        // Write this buffer out while the other one is filled
+        state->write_length[buffer] = (unsigned)res;
+        state->write_done[buffer] = 0;
+        state->write_offset[buffer] = job->bytes;
+        job->bytes += (uint64_t)res;
+        int result = queue_write(ring, index, state, buffer, stats);
+        if (result == 0 && state->write_length[1 - buffer] == 0) {
+            result = queue_read(ring, index, state, 1 - buffer, stats);
+        }
+        return result;
+    }
+
+    int buffer = op - OP_WRITE;
+    if (buffer < 0 || buffer > 1 || state->write_length[buffer] == 0) {
+        return 0;
+    }
+    if (res > 0) {
+        state->write_done[buffer] += (unsigned)res;
+        if (state->write_done[buffer] < state->write_length[buffer]) {
+            return queue_write(ring, index, state, buffer, stats);
+        }
+    } else if (res != -EINTR && job->error == 0) {
+        // The data is dropped; reading goes on so the child can finish
+        job->error = res < 0 ? -res : EIO;
+    } else if (res == -EINTR) {
+        return queue_write(ring, index, state, buffer, stats);
+    }
+    state->write_length[buffer] = 0;
+    if (state->reading == -1 && state->pipe_fd >= 0) {
+        return queue_read(ring, index, state, buffer, stats);
+    }
+    return 0;
+}
+
+static int run_io_uring(io_ring_t *ring, file_capture_job_t *jobs, job_state_t *states,
+                        int count, file_capture_stats_t *stats) {
+    int running = 0;
+
+    for (int i = 0; i < count; i++) {
+        job_state_t *state = &states[i];
+        if (start_job(&jobs[i], state) != 0) {
+            continue;
+        }
+        state->buffers[0] = malloc(FILE_CAPTURE_BUFFER_SIZE);
+        state->buffers[1] = malloc(FILE_CAPTURE_BUFFER_SIZE);
+        int result = (state->buffers[0] && state->buffers[1]) ? 0 : ENOMEM;
+        if (result == 0) {
+            // Taken only now: an unprepared entry would still be submitted
+            struct io_uring_sqe *sqe = io_ring_get_sqe(ring);
+            if (!sqe) {
+                result = EBUSY;
+            } else {
+                io_ring_prep_poll(sqe, state->pidfd, POLLIN, user_data(i, OP_EXIT));
+                result = queue_read(ring, i, state, 0, stats);
+            }
+        }
+        if (result != 0) {
+            abandon_jobs(&jobs[i], state, 1, result);
+            continue;
+        }
+        running++;
+    }
+
+    int result = 0;
+    while (running > 0) {
+        // Everything queued since the last call goes in with the wait
+        result = io_ring_submit_and_wait(ring, 1);
+        if (result != 0) {
+            break;
+        }
+
+        struct io_uring_cqe *cqe;
+        while (result == 0 && (cqe = io_ring_peek_cqe(ring)) != NULL) {
+            int index = (int)(cqe->user_data >> OP_BITS);
+            int op = (int)(cqe->user_data & ((1u << OP_BITS) - 1));
+            int res = cqe->res;
+            io_ring_cqe_seen(ring);
+
+            // Left over from a job abandoned while it was being started
+            if (index >= count || !states[index].running) {
+                continue;
+            }
+            file_capture_job_t *job = &jobs[index];
+            job_state_t *state = &states[index];
+            result = handle_completion(ring, job, state, index, op, res, stats);
+            if (state->pipe_fd == -1 && state->pidfd == -1 && state->reading == -1 &&
+                state->write_length[0] == 0 && state->write_length[1] == 0) {
+                finish_job(job, state);
+                running--;
+            }
+        }
+    }
+
+    stats->waits = ring->enters;
+    if (result != 0) {
+        // Requests may still point into the buffers: cancel them first
+        io_ring_destroy(ring);
+        abandon_jobs(jobs, states, count, result);
+    }
+    return result;
+}
+
+/*============================================================================
+ * RUNNER
+ *============================================================================*/
+
+/**
+ * @brief Run every job at once, copying each one's stdout into its file
+ * @param jobs Jobs prepared with file_capture_job_init(); results are stored in them
+ * @param count Number of jobs, at most FILE_CAPTURE_MAX_JOBS
+ * @param backend Backend to use; FILE_CAPTURE_AUTO prefers io_uring
+ * @param[out] stats Backend used and system calls made; may be NULL
+ * @return 0 once every job has completed (see each job's error and status),
+ *         or an errno code if the backend could not be set up (for
+ *         FILE_CAPTURE_IO_URING: ENOSYS/EPERM without io_uring)
+ */
+int file_capture_run(file_capture_job_t *jobs, int count, file_capture_backend_t backend,
+                     file_capture_stats_t *stats) {
+    file_capture_stats_t local_stats;
+    io_ring_t ring;
+
+    if (!stats) {
+        stats = &local_stats;
+    }
+    memset(stats, 0, sizeof(*stats));
+    if (!jobs || count < 0 || count > FILE_CAPTURE_MAX_JOBS) {
+        return EINVAL;
+    }
+
+    int result = 0;
+    if (backend != FILE_CAPTURE_EPOLL) {
+        result = io_ring_init(&ring, (unsigned)(count > 0 ? count : 1) * REQUESTS_PER_JOB);
+        if (result != 0 && backend == FILE_CAPTURE_IO_URING) {
+            stats->backend = FILE_CAPTURE_IO_URING;
+            return result;
+        }
+    }
+    stats->backend = (backend != FILE_CAPTURE_EPOLL && result == 0) ? FILE_CAPTURE_IO_URING
+                                                                    : FILE_CAPTURE_EPOLL;
+    if (count == 0) {
+        if (stats->backend == FILE_CAPTURE_IO_URING) {
+            io_ring_destroy(&ring);
+        }
+        return 0;
+    }
+
+    job_state_t *states = calloc((size_t)count, sizeof(job_state_t));
+    if (!states) {
+        if (stats->backend == FILE_CAPTURE_IO_URING) {
+            io_ring_destroy(&ring);
+        }
+        return ENOMEM;
+    }
+
+    if (stats->backend == FILE_CAPTURE_IO_URING) {
+        result = run_io_uring(&ring, jobs, states, count, stats);
+        if (result == 0) {
+            io_ring_destroy(&ring);
+        }
+    } else {
+        result = run_epoll(jobs, states, count, stats);
+    }
+
+    free(states);
+    return result;
+}
+
+const char *file_capture_backend_name(file_capture_backend_t backend) {
+    switch (backend) {
+    case FILE_CAPTURE_IO_URING:
+        return "io_uring";
+    case FILE_CAPTURE_EPOLL:
+        return "epoll";
+    default:
+        return "auto";
+    }
+}
@@ -0,0 +1,357 @@
+/**
+ * @file file_capture_bench.c
+ * @brief Capturing command output to files: popen+fgets vs epoll vs io_uring
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * Each job is this program re-executed with --generate, writing S megabytes
+ * of 64-byte lines to stdout; the parent stores each job's output in a file
+ * with:
+ * - popen+fgets:  the old execute_command_with_output() loop, one job after
+ *                 another, every line copied to the file with fputs()
+ * - epoll:        file_capture_run(FILE_CAPTURE_EPOLL), all jobs at once,
+ *                 one read() per readiness and a write() per chunk
+ * - io_uring:     file_capture_run(FILE_CAPTURE_IO_URING), reads and writes
+ *                 as batched ring requests (skipped if io_uring is unavailable)
+ *
+ * System calls are the parent's read/write-family calls (syscr + syscw from
+ * /proc/self/io) plus the epoll_wait()/io_uring_enter() calls the backend
+ * made; the spawns themselves are the same for every method and excluded.
+ *
+ * Checks: every file holds exactly the generated bytes, and io_uring makes
+ * fewer system calls than popen+fgets.
+ *
+ * Usage: ./file_capture_bench [megabytes per job] [jobs]
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#include "clock_ns.h"
+#include "file_capture.h"
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+#define DEFAULT_MEGABYTES 64L
+#define DEFAULT_JOBS 4L
+#define LINE_LENGTH 64
+
+/** Generator write size; a whole number of lines */
+#define GENERATE_BLOCK (1 << 20)
+
+/** fgets() line buffer of the old capture loop */
+#define FGETS_LINE_SIZE 4096
+
+/**
+ * @brief Result of capturing every job once with one method
+ */
+typedef struct {
+    double ms;
+    unsigned long io_calls;     /**< read/write-family system calls */
+    unsigned long waits;        /**< epoll_wait() / io_uring_enter() calls */
+    int ok;                     /**< Every job exited 0 and its file matches */
+} method_result_t;
+
+/*============================================================================
+ * UTILITY FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Read and write system calls made by this process so far
+ */
+static unsigned long io_syscalls(void) {
+    unsigned long reads = 0;
+    unsigned long writes = 0;
+    char line[128];
+
+    FILE *file = fopen("/proc/self/io", "r");
+    if (!file) {
+        return 0;
+    }
+    while (fgets(line, sizeof(line), file)) {
+        sscanf(line, "syscr: %lu", &reads);
+        sscanf(line, "syscw: %lu", &writes);
+    }
+    fclose(file);
+    return reads + writes;
+}
+
+/**
+ * @brief Fill a block with whole lines of LINE_LENGTH bytes
+ */
+static void fill_block(char *block) {
+    for (size_t line = 0; line < GENERATE_BLOCK / LINE_LENGTH; line++) {
+        char *start = block + line * LINE_LENGTH;
+        memset(start, 'a' + (int)(line % 26), LINE_LENGTH - 1);
+        start[LINE_LENGTH - 1] = '\n';
+    }
+}
+
+/**
+ * @brief Whether a file holds exactly `bytes` bytes of generated lines
+ */
+static int file_matches(const char *path, long long bytes, const char *block) {
+    struct stat st;
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return 0;
+    }
+    int same = fstat(fd, &st) == 0 && st.st_size == bytes;
+    if (same && bytes > 0) {
+        char *map = mmap(NULL, (size_t)bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        same = map != MAP_FAILED;
+        for (long long offset = 0; same && offset < bytes; offset += GENERATE_BLOCK) {
+            size_t chunk = bytes - offset < GENERATE_BLOCK ? (size_t)(bytes - offset)
+                                                           : GENERATE_BLOCK;
+            same = memcmp(map + offset, block, chunk) == 0;
+        }
+        if (map != MAP_FAILED) {
+            munmap(map, (size_t)bytes);
+        }
+    }
+    close(fd);
+    return same;
+}
+
+/*============================================================================
+ * GENERATOR (CHILD)
+ *============================================================================*/
+
+/**
+ * @brief Write `bytes` bytes of lines to stdout
+ */
+static int generate(long long bytes) {
+    char *block = malloc(GENERATE_BLOCK);
+    if (!block) {
+        return EXIT_FAILURE;
+    }
+    fill_block(block);
+
+    while (bytes > 0) {
+        size_t chunk = bytes < GENERATE_BLOCK ? (size_t)bytes : GENERATE_BLOCK;
+        size_t written = 0;
+        while (written < chunk) {
+            ssize_t result = write(STDOUT_FILENO, block + written, chunk - written);
+            if (result == -1) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                free(block);
+                return EXIT_FAILURE;
+            }
+            written += (size_t)result;
+        }
+        bytes -= (long long)chunk;
+    }
+
+    free(block);
+    return EXIT_SUCCESS;
+}
+
+/*============================================================================
+ * CAPTURE METHODS
+ *============================================================================*/
+
+/**
+ * @brief The old loop, writing each line to the file as it arrives
+ */
+static int capture_popen_fgets(const char *command, const char *path) {
+    char line[FGETS_LINE_SIZE];
+
+    FILE *out = fopen(path, "w");
+    if (!out) {
+        return errno;
+    }
+    FILE *pipe = popen(command, "r");
+    if (!pipe) {
+        int result = errno;
+        fclose(out);
+        return result;
+    }
+
+    while (fgets(line, sizeof(line), pipe) != NULL) {
+        fputs(line, out);
+    }
+
+    int status = pclose(pipe);
+    int closed = fclose(out);
+    return (status != -1 && WIFEXITED(status) && WEXITSTATUS(status) == 0 && closed == 0)
+           ? 0 : ECHILD;
+}
+
+static method_result_t run_popen(char commands[][600], char paths[][64], int jobs,
+                                 long long bytes, const char *block) {
+    method_result_t result = { 0.0, 0, 0, 1 };
+
+    unsigned long before = io_syscalls();
+    long long start = now_ns();
+    for (int i = 0; i < jobs; i++) {
+        result.ok &= capture_popen_fgets(commands[i], paths[i]) == 0;
+    }
+    result.ms = (double)(now_ns() - start) / 1e6;
+    result.io_calls = io_syscalls() - before;
+
+    for (int i = 0; i < jobs; i++) {
+        result.ok &= file_matches(paths[i], bytes, block);
+    }
+    return result;
+}
+
+/**
+ * @brief Run every job with file_capture_run()
+ * @return The result; ok is -1 if the backend is unavailable
+ */
+static method_result_t run_backend(file_capture_backend_t backend, char commands[][600],
+                                   char paths[][64], int jobs, long long bytes,
+                                   const char *block) {
+    method_result_t result = { 0.0, 0, 0, 1 };
+    file_capture_job_t capture_jobs[FILE_CAPTURE_MAX_JOBS];
+    file_capture_stats_t stats;
+
+    for (int i = 0; i < jobs; i++) {
+        if (file_capture_job_init(&capture_jobs[i], commands[i], paths[i]) != 0) {
+            for (int j = 0; j < i; j++) {
+                file_capture_job_release(&capture_jobs[j]);
+            }
+            result.ok = 0;
+            return result;
+        }
+    }
+
+    unsigned long before = io_syscalls();
+    long long start = now_ns();
+    int run_result = file_capture_run(capture_jobs, jobs, backend, &stats);
+    result.ms = (double)(now_ns() - start) / 1e6;
+    result.io_calls = io_syscalls() - before;
+    result.waits = stats.waits;
+
+    if (run_result != 0) {
+        result.ok = (run_result == ENOSYS || run_result == EPERM) ? -1 : 0;
+    }
+    for (int i = 0; i < jobs && run_result == 0; i++) {
+        file_capture_job_t *job = &capture_jobs[i];
+        result.ok &= job->error == 0 && WIFEXITED(job->status) &&
+                     WEXITSTATUS(job->status) == 0 && file_matches(paths[i], bytes, block);
+    }
+    for (int i = 0; i < jobs; i++) {
+        file_capture_job_release(&capture_jobs[i]);
+    }
+    return result;
+}
+
+static void print_result(const char *name, int jobs, long long bytes,
+                         const method_result_t *result) {
+    if (result->ok < 0) {
+        printf("%-12s %4d   io_uring unavailable, skipped\n", name, jobs);
+        return;
+    }
+    double megabytes = (double)bytes * jobs / (1024.0 * 1024.0);
+    unsigned long total = result->io_calls + result->waits;
+    printf("%-12s %4d %9.1f %9.1f %9lu %8lu %9lu %8.1f %6s\n", name, jobs, result->ms,
+           megabytes / (result->ms / 1e3), result->io_calls, result->waits, total,
+           (double)total / megabytes, result->ok ? "same" : "DIFFERS");
+}
+
+/*============================================================================
+ * MAIN FUNCTION
+ *============================================================================*/
+
+/**
+ * @brief Main function - captures the generators' output with every method
+ * @return EXIT_SUCCESS on success, EXIT_FAILURE on bad arguments or a
+ *         failed check
+ */
+int main(int argc, char **argv) {
+    long megabytes = DEFAULT_MEGABYTES;
+    long jobs = DEFAULT_JOBS;
+
+    if (argc == 3 && strcmp(argv[1], "--generate") == 0) {
+        return generate(strtoll(argv[2], NULL, 10));
+    }
+    if (argc > 1) {
+        megabytes = strtol(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        jobs = strtol(argv[2], NULL, 10);
+    }
+    if (megabytes < 1 || megabytes > 4096 || jobs < 1 || jobs > FILE_CAPTURE_MAX_JOBS) {
+        fprintf(stderr, "Usage: %s [megabytes per job 1..4096] [jobs 1..%d]\n", argv[0],
+                FILE_CAPTURE_MAX_JOBS);
+        return EXIT_FAILURE;
+    }
+
+    char self[512];
+    ssize_t self_length = readlink("/proc/self/exe", self, sizeof(self) - 1);
+    if (self_length <= 0) {
+        fprintf(stderr, "Failed to resolve /proc/self/exe: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    self[self_length] = '\0';
+
+    char directory[] = "/tmp/file_capture_bench.XXXXXX";
+    char *block = malloc(GENERATE_BLOCK);
+    if (!block || !mkdtemp(directory)) {
+        fprintf(stderr, "Failed to set up: %s\n", strerror(errno));
+        free(block);
+        return EXIT_FAILURE;
+    }
+    fill_block(block);
+
+    long long bytes = (long long)megabytes * 1024 * 1024;
+    static char commands[FILE_CAPTURE_MAX_JOBS][600];
+    static char paths[FILE_CAPTURE_MAX_JOBS][64];
+    for (int i = 0; i < jobs; i++) {
+        snprintf(commands[i], sizeof(commands[i]), "%s --generate %lld", self, bytes);
+        snprintf(paths[i], sizeof(paths[i]), "%s/job%d.out", directory, i);
+    }
+
+    printf("========================================================\n");
+    printf("    FILE CAPTURE BENCHMARK\n");
+    printf("========================================================\n");
+    printf("%ld MB of %d-byte lines per job\n\n", megabytes, LINE_LENGTH);
+    printf("%-12s %4s %9s %9s %9s %8s %9s %8s %6s\n", "method", "jobs", "ms", "MB/s",
+           "read/wr", "waits", "syscalls", "per MB", "files");
+
+    int failed = 0;
+    int uring_fewer = 1;
+    const int job_counts[] = { 1, (int)jobs };
+    for (int c = 0; c < (jobs > 1 ? 2 : 1); c++) {
+        int count = job_counts[c];
+        method_result_t popen_result = run_popen(commands, paths, count, bytes, block);
+        method_result_t epoll_result = run_backend(FILE_CAPTURE_EPOLL, commands, paths, count,
+                                                   bytes, block);
+        method_result_t uring_result = run_backend(FILE_CAPTURE_IO_URING, commands, paths,
+                                                   count, bytes, block);
+        print_result("popen+fgets", count, bytes, &popen_result);
+        print_result("epoll", count, bytes, &epoll_result);
+        print_result("io_uring", count, bytes, &uring_result);
+
+        failed |= !popen_result.ok || !epoll_result.ok || uring_result.ok == 0;
+        if (uring_result.ok > 0) {
+            uring_fewer &= uring_result.io_calls + uring_result.waits <
+                           popen_result.io_calls + popen_result.waits;
+        }
+    }
+
+    for (int i = 0; i < jobs; i++) {
+        unlink(paths[i]);
+    }
+    rmdir(directory);
+    free(block);
+
+    printf("\nCheck: files %s, io_uring %s: %s\n", failed ? "DIFFER" : "match",
+           uring_fewer ? "makes fewer system calls" : "DOES NOT make fewer system calls",
+           !failed && uring_fewer ? "ok" : "FAILED");
+    return !failed && uring_fewer ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,243 @@
+/**
+ * @file futex_sync.c
+ * @brief Futex-based barrier, event and latch implementation
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#define _GNU_SOURCE
+
+#include "futex_sync.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+/*============================================================================
+ * FUTEX HELPERS
+ *============================================================================*/
+
+/** Hint to the CPU that we are spinning */
+#if defined(__x86_64__) || defined(__i386__)
+#define CPU_RELAX() __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define CPU_RELAX() __asm__ __volatile__("yield" ::: "memory")
+#else
+#define CPU_RELAX() do { } while (0)
+#endif
+
+/**
+ * @brief Sleep while *word == expected (spurious wake-ups are possible)
+ */
+static void futex_wait(unsigned int *word, unsigned int expected) {
+    syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, expected, NULL, NULL, 0);
+}
+
+/**
+ * @brief Wake every thread sleeping on word
+ */
+static void futex_wake_all(unsigned int *word) {
+    syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+}
+
+/**
+ * @brief Number of spin iterations to try before sleeping
+ *
+ * Spinning can only help if the thread we wait for runs on another CPU.
+ */
+static int spin_limit(void) {
+    static int limit = -1;
+    int cached = __atomic_load_n(&limit, __ATOMIC_RELAXED);
+
+    if (cached < 0) {
+        cached = sysconf(_SC_NPROCESSORS_ONLN) > 1 ? FUTEX_SYNC_SPIN_LIMIT : 0;
+        __atomic_store_n(&limit, cached, __ATOMIC_RELAXED);
+    }
+    return cached;
+}
+
+/**
+ * @brief Block until *word != value: spin briefly, then sleep on the futex
+ *
+ * The sleeper count is raised before the final check of the word, and the
+ * waker changes the word before reading the sleeper count (both seq_cst),
+ * so either the waker sees a sleeper and wakes it or the sleeper sees the
+ * new value and never sleeps.
+ */
+static void wait_while_equal(unsigned int *word, unsigned int value, unsigned int *sleepers) {
+    int limit = spin_limit();
+
+    for (int i = 0; i < limit; i++) {
+        if (__atomic_load_n(word, __ATOMIC_ACQUIRE) != value) {
+            return;
+        }
+        CPU_RELAX();
+    }
+
+    __atomic_add_fetch(sleepers, 1, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(word, __ATOMIC_SEQ_CST) == value) {
+        futex_wait(word, value);
+    }
+    __atomic_sub_fetch(sleepers, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Wake sleepers on word if there are any
+ * @note Call after the word has been changed with seq_cst ordering
+ */
+static void wake_if_sleeping(unsigned int *word, unsigned int *sleepers) {
+    if (__atomic_load_n(sleepers, __ATOMIC_SEQ_CST) > 0) {
+        futex_wake_all(word);
+    }
+}
+
+/*============================================================================
+ * BARRIER
+ *============================================================================*/
+
+/**
+ * @brief Initialize a barrier for a fixed number of threads
+ * @return 0 on success, EINVAL if threads is 0
+ */
+int futex_barrier_init(futex_barrier_t *barrier, unsigned int threads) {
+    if (threads == 0) {
+        return EINVAL;
+    }
+    barrier->threshold = threads;
+    barrier->arrived = 0;
+    barrier->generation = 0;
+    barrier->sleepers = 0;
+    return 0;
+}
+
+/**
+ * @brief Wait until `threshold` threads have arrived
+ * @return FUTEX_BARRIER_SERIAL_THREAD for the last arriving thread, 0 otherwise
+ */
+int futex_barrier_wait(futex_barrier_t *barrier) {
+    unsigned int generation = __atomic_load_n(&barrier->generation, __ATOMIC_ACQUIRE);
+
+    if (__atomic_add_fetch(&barrier->arrived, 1, __ATOMIC_ACQ_REL) == barrier->threshold) {
+        // Reset before opening the barrier so the next round starts clean
+        __atomic_store_n(&barrier->arrived, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&barrier->generation, generation + 1, __ATOMIC_SEQ_CST);
+        wake_if_sleeping(&barrier->generation, &barrier->sleepers);
+        return FUTEX_BARRIER_SERIAL_THREAD;
+    }
+
+    wait_while_equal(&barrier->generation, generation, &barrier->sleepers);
+    return 0;
+}
+
+/*============================================================================
+ * EVENT
+ *============================================================================*/
+
+/**
+ * @brief Initialize an event in the unset state
+ */
+void futex_event_init(futex_event_t *event) {
+    event->state = 0;
+    event->sleepers = 0;
+}
+
+/**
+ * @brief Set the event, releasing every current and future waiter
+ */
+void futex_event_set(futex_event_t *event) {
+    __atomic_store_n(&event->state, 1, __ATOMIC_SEQ_CST);
+    wake_if_sleeping(&event->state, &event->sleepers);
+}
+
+/**
+ * @brief Wait until the event is set
+ */
+void futex_event_wait(futex_event_t *event) {
+    wait_while_equal(&event->state, 0, &event->sleepers);
+}
+
+/**
+ * @brief Non-blocking check of the event
+ */
+int futex_event_is_set(const futex_event_t *event) {
+    return __atomic_load_n(&event->state, __ATOMIC_ACQUIRE) != 0;
+}
+
+/*============================================================================
+ * LATCH
+ *============================================================================*/
+
+/**
+ * @brief Initialize a latch with the given count
+ */
+void futex_latch_init(futex_latch_t *latch, unsigned int count) {
+    latch->count = count;
+    latch->sleepers = 0;
+}
+
+/**
+ * @brief Decrement the count, releasing waiters when it reaches zero
+ * @note Counting down more times than the initial count is a usage error
+ */
+void futex_latch_count_down(futex_latch_t *latch) {
+    if (__atomic_sub_fetch(&latch->count, 1, __ATOMIC_SEQ_CST) == 0) {
+        wake_if_sleeping(&latch->count, &latch->sleepers);
+    }
+}
+
+/**
+ * @brief Wait until the count reaches zero
+ */
+void futex_latch_wait(futex_latch_t *latch) {
+    unsigned int count;
+    while ((count = __atomic_load_n(&latch->count, __ATOMIC_ACQUIRE)) != 0) {
+        wait_while_equal(&latch->count, count, &latch->sleepers);
+    }
+}
+
+/**
+ * @brief Count down once, then wait for the count to reach zero
+ */
+void futex_latch_arrive_and_wait(futex_latch_t *latch) {
+    futex_latch_count_down(latch);
+    futex_latch_wait(latch);
+}
+
+/*============================================================================
+ * START GATE
+ *============================================================================*/
+
+/**
+ * @brief Prepare a gate for the given number of workers
+ */
+void futex_start_gate_init(futex_start_gate_t *gate, unsigned int workers) {
+    futex_latch_init(&gate->ready, workers);
+    futex_event_init(&gate->go);
+}
+
+/**
+ * @brief Worker side: report ready, then wait for the common start signal
+ */
+void futex_start_gate_arrive(futex_start_gate_t *gate) {
+    futex_latch_count_down(&gate->ready);
+    futex_event_wait(&gate->go);
+}
+
+/**
+ * @brief Controller side: wait until every worker is ready, then release all
+ */
+void futex_start_gate_release(futex_start_gate_t *gate) {
+    futex_latch_wait(&gate->ready);
+    futex_event_set(&gate->go);
+}
+
+/**
+ * @brief Release whichever workers exist without waiting for the rest
+ *
+ * For error paths where not every worker could be created.
+ */
+void futex_start_gate_abort(futex_start_gate_t *gate) {
+    futex_event_set(&gate->go);
+}
@@ -0,0 +1,98 @@
+/**
+ * @file futex_sync.h
+ * @brief Futex-based barrier, one-shot event and countdown latch
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * Lightweight synchronization primitives built directly on Linux futexes:
+ * - futex_barrier_t: reusable barrier for a fixed number of threads
+ * - futex_event_t:   one-shot gate; waiters block until it is set, forever after
+ *                    it stays open
+ * - futex_latch_t:   countdown; waiters block until the count reaches zero
+ * - futex_start_gate_t: latch + event that releases a group of freshly
+ *                    created threads at the same moment, once all of them
+ *                    have finished their setup
+ *
+ * Every wait first spins for a short, bounded time (only when more than one
+ * CPU is online) and then sleeps in the kernel. Wakers only make the
+ * FUTEX_WAKE system call when some thread is actually asleep, so the common
+ * "everyone arrives at about the same time" case stays in user space.
+ *
+ * All primitives are process-private and statically initializable.
+ */
+
+#ifndef FUTEX_SYNC_H
+#define FUTEX_SYNC_H
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+/** Returned to exactly one thread per barrier round, like pthread's */
+#define FUTEX_BARRIER_SERIAL_THREAD (-1)
+
+/** Spin iterations before sleeping (ignored on single-CPU machines) */
+#define FUTEX_SYNC_SPIN_LIMIT 2000
+
+/**
+ * @brief Reusable barrier
+ */
+typedef struct {
+    unsigned int threshold;     /**< Threads per round */
+    unsigned int arrived;       /**< Threads arrived in the current round */
+    unsigned int generation;    /**< Futex word; bumped when a round completes */
+    unsigned int sleepers;      /**< Threads blocked in the kernel */
+} futex_barrier_t;
+
+/**
+ * @brief One-shot event
+ */
+typedef struct {
+    unsigned int state;         /**< Futex word: 0 unset, 1 set */
+    unsigned int sleepers;      /**< Threads blocked in the kernel */
+} futex_event_t;
+
+/**
+ * @brief Countdown latch
+ */
+typedef struct {
+    unsigned int count;         /**< Futex word: remaining count-downs */
+    unsigned int sleepers;      /**< Threads blocked in the kernel */
+} futex_latch_t;
+
+/**
+ * @brief Synchronized start for a group of worker threads
+ */
+typedef struct {
+    futex_latch_t ready;        /**< Counted down by each worker when set up */
+    futex_event_t go;           /**< Set once to release every worker */
+} futex_start_gate_t;
+
+/** Static initializers */
+#define FUTEX_BARRIER_INITIALIZER(threads) { (threads), 0, 0, 0 }
+#define FUTEX_EVENT_INITIALIZER { 0, 0 }
+#define FUTEX_LATCH_INITIALIZER(count) { (count), 0 }
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+int futex_barrier_init(futex_barrier_t *barrier, unsigned int threads);
+int futex_barrier_wait(futex_barrier_t *barrier);
+
+void futex_event_init(futex_event_t *event);
+void futex_event_set(futex_event_t *event);
+void futex_event_wait(futex_event_t *event);
+int futex_event_is_set(const futex_event_t *event);
+
+void futex_latch_init(futex_latch_t *latch, unsigned int count);
+void futex_latch_count_down(futex_latch_t *latch);
+void futex_latch_wait(futex_latch_t *latch);
+void futex_latch_arrive_and_wait(futex_latch_t *latch);
+
+void futex_start_gate_init(futex_start_gate_t *gate, unsigned int workers);
+void futex_start_gate_arrive(futex_start_gate_t *gate);
+void futex_start_gate_release(futex_start_gate_t *gate);
+void futex_start_gate_abort(futex_start_gate_t *gate);
+
+#endif /* FUTEX_SYNC_H */
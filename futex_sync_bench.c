@@ -0,0 +1,272 @@
+/**
+ * @file futex_sync_bench.c
+ * @brief Futex barrier/event/latch vs pthread_barrier_t benchmark
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * Two measurements, each for the futex primitives and for pthread_barrier_t:
+ * - Barrier round trip: N threads pass the same barrier R times in a row;
+ *   reported as nanoseconds per round
+ * - Start release: N freshly created threads wait at a start gate and the
+ *   main thread opens it; reported as the latency until the last worker
+ *   runs and the skew between the first and last worker (mean of trials)
+ *
+ * Usage: ./futex_sync_bench [threads] [barrier_rounds] [start_trials]
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "clock_ns.h"
+#include "futex_sync.h"
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+#define DEFAULT_ROUNDS 20000
+#define DEFAULT_TRIALS 200
+#define MAX_BENCH_THREADS 64
+
+/** Synchronization flavour under test */
+typedef enum {
+    SYNC_FUTEX = 0,
+    SYNC_PTHREAD = 1
+} sync_kind_t;
+
+/**
+ * @brief Shared state of one run
+ */
+typedef struct {
+    sync_kind_t kind;
+    int rounds;
+    futex_barrier_t futex_barrier;
+    pthread_barrier_t pthread_barrier;
+    futex_start_gate_t gate;
+    long long wake_ns[MAX_BENCH_THREADS];
+} bench_state_t;
+
+/**
+ * @brief Per-thread argument
+ */
+typedef struct {
+    bench_state_t *state;
+    int index;
+} bench_arg_t;
+
+/*============================================================================
+ * UTILITY FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Wait at whichever barrier the run uses
+ */
+static void barrier_wait(bench_state_t *state) {
+    if (state->kind == SYNC_FUTEX) {
+        futex_barrier_wait(&state->futex_barrier);
+    } else {
+        pthread_barrier_wait(&state->pthread_barrier);
+    }
+}
+
+/**
+ * @brief Create threads, recording how many succeeded
+ * @return 0 on success, otherwise a pthread error code
+ */
+static int spawn_threads(pthread_t *threads, bench_arg_t *args, int count,
+                         bench_state_t *state, void *(*function)(void *), int *created) {
+    *created = 0;
+    for (int i = 0; i < count; i++) {
+        args[i].state = state;
+        args[i].index = i;
+        int result = pthread_create(&threads[i], NULL, function, &args[i]);
+        if (result != 0) {
+            return result;
+        }
+        (*created)++;
+    }
+    return 0;
+}
+
+/*============================================================================
+ * BARRIER ROUND TRIP
+ *============================================================================*/
+
+/**
+ * @brief Pass the barrier `rounds` times
+ */
+static void *round_trip_thread(void *arg) {
+    bench_arg_t *bench = (bench_arg_t *)arg;
+    for (int r = 0; r < bench->state->rounds; r++) {
+        barrier_wait(bench->state);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Measure barrier round trips with `threads` participants
+ * @return Nanoseconds per round
+ */
+static double run_round_trip(sync_kind_t kind, int threads, int rounds) {
+    static bench_state_t state;
+    pthread_t ids[MAX_BENCH_THREADS];
+    bench_arg_t args[MAX_BENCH_THREADS];
+    int created;
+
+    memset(&state, 0, sizeof(state));
+    state.kind = kind;
+    state.rounds = rounds;
+    futex_barrier_init(&state.futex_barrier, (unsigned int)threads);
+    pthread_barrier_init(&state.pthread_barrier, NULL, (unsigned int)threads);
+
+    // The main thread is participant 0
+    long long start = now_ns();
+    if (spawn_threads(ids, args, threads - 1, &state, round_trip_thread, &created) != 0) {
+        fprintf(stderr, "Failed to create barrier threads\n");
+        exit(EXIT_FAILURE); // Remaining threads would block forever
+    }
+    for (int r = 0; r < rounds; r++) {
+        barrier_wait(&state);
+    }
+    long long elapsed = now_ns() - start;
+
+    for (int i = 0; i < created; i++) {
+        pthread_join(ids[i], NULL);
+    }
+    pthread_barrier_destroy(&state.pthread_barrier);
+
+    return (double)elapsed / rounds;
+}
+
+/*============================================================================
+ * START RELEASE
+ *============================================================================*/
+
+/**
+ * @brief Wait at the start gate and record when we got through
+ */
+static void *start_thread(void *arg) {
+    bench_arg_t *bench = (bench_arg_t *)arg;
+    bench_state_t *state = bench->state;
+
+    if (state->kind == SYNC_FUTEX) {
+        futex_start_gate_arrive(&state->gate);
+    } else {
+        pthread_barrier_wait(&state->pthread_barrier);
+    }
+    state->wake_ns[bench->index] = now_ns();
+    return NULL;
+}
+
+/**
+ * @brief Mean release latency and skew over `trials` fresh thread groups
+ */
+static void run_start_release(sync_kind_t kind, int threads, int trials,
+                              double *latency_us, double *skew_us) {
+    static bench_state_t state;
+    pthread_t ids[MAX_BENCH_THREADS];
+    bench_arg_t args[MAX_BENCH_THREADS];
+    double latency_total = 0.0, skew_total = 0.0;
+    int created;
+
+    for (int t = 0; t < trials; t++) {
+        memset(&state, 0, sizeof(state));
+        state.kind = kind;
+        futex_start_gate_init(&state.gate, (unsigned int)threads);
+        pthread_barrier_init(&state.pthread_barrier, NULL, (unsigned int)threads + 1);
+
+        if (spawn_threads(ids, args, threads, &state, start_thread, &created) != 0) {
+            fprintf(stderr, "Failed to create start threads\n");
+            exit(EXIT_FAILURE);
+        }
+
+        long long released;
+        if (kind == SYNC_FUTEX) {
+            futex_latch_wait(&state.gate.ready);
+            released = now_ns();
+            futex_event_set(&state.gate.go);
+        } else {
+            // The last arrival opens a pthread barrier; give workers time to block
+            usleep(200);
+            released = now_ns();
+            pthread_barrier_wait(&state.pthread_barrier);
+        }
+
+        for (int i = 0; i < created; i++) {
+            pthread_join(ids[i], NULL);
+        }
+        pthread_barrier_destroy(&state.pthread_barrier);
+
+        long long first = state.wake_ns[0], last = state.wake_ns[0];
+        for (int i = 1; i < threads; i++) {
+            if (state.wake_ns[i] < first) {
+                first = state.wake_ns[i];
+            }
+            if (state.wake_ns[i] > last) {
+                last = state.wake_ns[i];
+            }
+        }
+        latency_total += (double)(last - released) / 1e3;
+        skew_total += (double)(last - first) / 1e3;
+    }
+
+    *latency_us = latency_total / trials;
+    *skew_us = skew_total / trials;
+}
+
+/*============================================================================
+ * MAIN FUNCTION
+ *============================================================================*/
+
+/**
+ * @brief Main function - runs both measurements for both implementations
+ * @return EXIT_SUCCESS on success, EXIT_FAILURE on invalid arguments
+ */
+int main(int argc, char **argv) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int threads = cpus > 4 ? (int)cpus : 4;
+    int rounds = DEFAULT_ROUNDS;
+    int trials = DEFAULT_TRIALS;
+
+    if (argc > 1) {
+        threads = (int)strtol(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        rounds = (int)strtol(argv[2], NULL, 10);
+    }
+    if (argc > 3) {
+        trials = (int)strtol(argv[3], NULL, 10);
+    }
+    if (threads < 2 || threads > MAX_BENCH_THREADS || rounds <= 0 || trials <= 0) {
+        fprintf(stderr, "Usage: %s [threads 2..%d] [barrier_rounds > 0] [start_trials > 0]\n",
+                argv[0], MAX_BENCH_THREADS);
+        return EXIT_FAILURE;
+    }
+
+    printf("========================================================\n");
+    printf("    FUTEX SYNC VS PTHREAD_BARRIER_T BENCHMARK\n");
+    printf("========================================================\n");
+    printf("Threads: %d, online CPUs: %ld, rounds: %d, trials: %d\n\n",
+           threads, cpus, rounds, trials);
+
+    printf("Barrier round trip (%d participants):\n", threads);
+    printf("  %-22s %12.0f ns/round\n", "futex_barrier_t",
+           run_round_trip(SYNC_FUTEX, threads, rounds));
+    printf("  %-22s %12.0f ns/round\n", "pthread_barrier_t",
+           run_round_trip(SYNC_PTHREAD, threads, rounds));
+
+    double latency, skew;
+    printf("\nStart release of %d fresh threads (mean of %d trials):\n", threads, trials);
+    printf("  %-22s %16s %16s\n", "gate", "last wake (us)", "skew (us)");
+    run_start_release(SYNC_FUTEX, threads, trials, &latency, &skew);
+    printf("  %-22s %16.2f %16.2f\n", "futex latch + event", latency, skew);
+    run_start_release(SYNC_PTHREAD, threads, trials, &latency, &skew);
+    printf("  %-22s %16.2f %16.2f\n", "pthread_barrier_t", latency, skew);
+
+    return EXIT_SUCCESS;
+}
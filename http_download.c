@@ -0,0 +1,904 @@
+/**
+ * @file http_download.c
+ * @brief HTTP/1.1 range downloader with pwrite() segments and resumable state
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#define _GNU_SOURCE
+
+#include "http_download.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <netdb.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+
+#include "command_launcher.h"
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+#define STATE_MAGIC "HTTPDL01"
+#define STATE_SUFFIX ".part.state"
+#define PART_SUFFIX ".part"
+#define VALIDATOR_LENGTH 128
+#define URL_PART_LENGTH 2048
+
+/**
+ * @brief A parsed http:// URL
+ */
+typedef struct {
+    char host[256];
+    char port[8];
+    char path[URL_PART_LENGTH];
+} http_url_t;
+
+/**
+ * @brief Response status and headers; the start of the body may already
+ *        sit in buffer
+ */
+typedef struct {
+    int fd;
+    int status;
+    int has_length;
+    uint64_t content_length;
+    int accept_ranges;
+    int chunked;
+    int has_range;
+    uint64_t range_start;       /**< From Content-Range */
+    uint64_t range_total;
+    char location[URL_PART_LENGTH];
+    char validator[VALIDATOR_LENGTH];
+    char buffer[HTTP_HEADER_MAX];
+    size_t body_offset;         /**< Start of unread body bytes in buffer */
+    size_t buffered;            /**< Unread body bytes in buffer */
+} http_response_t;
+
+/**
+ * @brief What a HEAD request revealed
+ */
+typedef struct {
+    int has_length;
+    uint64_t length;
+    int ranges;
+    char validator[VALIDATOR_LENGTH];
+} resource_info_t;
+
+/**
+ * @brief On-disk progress of a segmented download (PATH.part.state)
+ */
+typedef struct {
+    char magic[8];
+    uint64_t size;
+    uint32_t count;
+    uint32_t reserved;
+    char validator[VALIDATOR_LENGTH];
+    uint64_t done[HTTP_MAX_CONNECTIONS];    /**< Bytes written at each segment's start */
+} download_state_t;
+
+/**
+ * @brief One segment and the thread fetching it
+ */
+typedef struct {
+    const http_url_t *url;
+    const char *validator;
+    int data_fd;
+    int state_fd;
+    int index;
+    uint64_t start;
+    uint64_t length;
+    uint64_t done;
+    uint64_t fetched;
+    int retries;
+    int reconnects;
+    int result;
+    int started;
+    pthread_t thread;
+} segment_t;
+
+/*============================================================================
+ * URLS AND CONNECTIONS
+ *============================================================================*/
+
+static int parse_url(const char *url, http_url_t *out) {
+    if (strncasecmp(url, "https://", 8) == 0) {
+        return EPROTONOSUPPORT;
+    }
+    if (strncasecmp(url, "http://", 7) != 0) {
+        return EINVAL;
+    }
+
+    const char *host = url + 7;
+    size_t host_length = strcspn(host, ":/?#");
+    if (host_length == 0 || host_length >= sizeof(out->host)) {
+        return EINVAL;
+    }
+    memcpy(out->host, host, host_length);
+    out->host[host_length] = '\0';
+
+    const char *rest = host + host_length;
+    snprintf(out->port, sizeof(out->port), "80");
+    if (*rest == ':') {
+        rest++;
+        size_t digits = strspn(rest, "0123456789");
+        if (digits == 0 || digits >= sizeof(out->port)) {
+            return EINVAL;
+        }
+        memcpy(out->port, rest, digits);
+        out->port[digits] = '\0';
+        rest += digits;
+    }
+
+    // The fragment is never sent; a bare query still needs a path
+    size_t length = strcspn(rest, "#");
+    int written = snprintf(out->path, sizeof(out->path), "%s%.*s",
+                           *rest == '/' ? "" : "/", (int)length, rest);
+    return (written < 0 || (size_t)written >= sizeof(out->path)) ? EINVAL : 0;
+}
+
+/**
+ * @brief Point url at a redirect target (absolute URL or absolute path)
+ */
+static int follow_location(http_url_t *url, const char *location) {
+    if (location[0] == '/') {
+        int written = snprintf(url->path, sizeof(url->path), "%s", location);
+        return (written < 0 || (size_t)written >= sizeof(url->path)) ? EINVAL : 0;
+    }
+    return parse_url(location, url);
+}
+
+static int http_connect(const http_url_t *url, int *fd_out) {
+    struct addrinfo hints;
+    struct addrinfo *list;
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(url->host, url->port, &hints, &list) != 0) {
+        return EHOSTUNREACH;
+    }
+
+    int result = ECONNREFUSED;
+    for (struct addrinfo *ai = list; ai; ai = ai->ai_next) {
+        int fd = socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd == -1) {
+            result = errno;
+            continue;
+        }
+        struct timeval timeout = { HTTP_TIMEOUT_SECONDS, 0 };
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        if (connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+            *fd_out = fd;
+            result = 0;
+            break;
+        }
+        result = errno;
+        close(fd);
+    }
+    freeaddrinfo(list);
+    return result;
+}
+
+static int send_all(int fd, const char *data, size_t length) {
+    while (length > 0) {
+        ssize_t sent = send(fd, data, length, MSG_NOSIGNAL);
+        if (sent == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno == EAGAIN ? ETIMEDOUT : errno;
+        }
+        data += sent;
+        length -= (size_t)sent;
+    }
+    return 0;
+}
+
+static int write_all(int fd, const char *data, size_t length) {
+    while (length > 0) {
+        ssize_t written = write(fd, data, length);
+        if (written == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+    return 0;
+}
+
+static int pwrite_all(int fd, const char *data, size_t length, uint64_t offset) {
+    while (length > 0) {
+        ssize_t written = pwrite(fd, data, length, (off_t)offset);
+        if (written == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno;
+        }
+        data += written;
+        length -= (size_t)written;
+        offset += (uint64_t)written;
+    }
+    return 0;
+}
+
+/*============================================================================
+ * REQUESTS AND RESPONSES
+ *============================================================================*/
+
+/**
+ * @brief Copy a header value, trimmed, into out
+ */
+static void copy_value(const char *value, size_t length, char *out, size_t size) {
+    while (length > 0 && (*value == ' ' || *value == '\t')) {
+        value++;
+        length--;
+    }
+    while (length > 0 && (value[length - 1] == ' ' || value[length - 1] == '\t')) {
+        length--;
+    }
+    snprintf(out, size, "%.*s", (int)length, value);
+}
+
+/**
+ * @brief Parse the status line and the headers this client uses
+ */
+static int parse_headers(http_response_t *response, size_t header_length) {
+    char value[URL_PART_LENGTH];
+    char last_modified[VALIDATOR_LENGTH] = "";
+    const char *line = response->buffer;
+    const char *end = response->buffer + header_length;
+
+    if (sscanf(line, "HTTP/%*u.%*u %d", &response->status) != 1) {
+        return EIO;
+    }
+
+    for (;;) {
+        const char *next = memmem(line, (size_t)(end - line), "\r\n", 2);
+        if (!next || next == line) {
+            break;
+        }
+        line = next + 2;
+        const char *colon = memchr(line, ':', (size_t)(end - line));
+        const char *line_end = memmem(line, (size_t)(end - line), "\r\n", 2);
+        if (!colon || !line_end || colon > line_end) {
+            continue;
+        }
+        size_t name_length = (size_t)(colon - line);
+        size_t value_length = (size_t)(line_end - colon - 1);
+        copy_value(colon + 1, value_length, value, sizeof(value));
+
+        if (name_length == 14 && strncasecmp(line, "Content-Length", 14) == 0) {
+            response->has_length = 1;
+            response->content_length = strtoull(value, NULL, 10);
+        } else if (name_length == 13 && strncasecmp(line, "Accept-Ranges", 13) == 0) {
+            response->accept_ranges = strcasestr(value, "bytes") != NULL;
+        } else if (name_length == 17 && strncasecmp(line, "Transfer-Encoding", 17) == 0) {
+            response->chunked = strcasestr(value, "chunked") != NULL;
+        } else if (name_length == 13 && strncasecmp(line, "Content-Range", 13) == 0) {
+            unsigned long long first;
+            unsigned long long last;
+            unsigned long long total;
+            if (sscanf(value, "bytes %llu-%llu/%llu", &first, &last, &total) == 3) {
+                response->has_range = 1;
+                response->range_start = first;
+                response->range_total = total;
+            }
+        } else if (name_length == 8 && strncasecmp(line, "Location", 8) == 0) {
+            snprintf(response->location, sizeof(response->location), "%s", value);
+        } else if (name_length == 4 && strncasecmp(line, "ETag", 4) == 0) {
+            copy_value(colon + 1, value_length, response->validator, sizeof(response->validator));
+        } else if (name_length == 13 && strncasecmp(line, "Last-Modified", 13) == 0) {
+            copy_value(colon + 1, value_length, last_modified, sizeof(last_modified));
+        }
+    }
+
+    // A strong validator if there is one
+    if (!response->validator[0]) {
+        memcpy(response->validator, last_modified, sizeof(last_modified));
+    }
+    return 0;
+}
+
+/**
+ * @brief Send a request and read the response headers
+ * @param first,last Byte range to ask for; last == UINT64_MAX means to the
+ *        end, first == UINT64_MAX means no Range header at all
+ * @return 0 with response->fd open (close it), or an errno code
+ */
+static int http_request(const http_url_t *url, const char *method, uint64_t first,
+                        uint64_t last, http_response_t *response) {
+    char request[URL_PART_LENGTH + 512];
+    char range[64] = "";
+
+    memset(response, 0, offsetof(http_response_t, buffer));
+    response->fd = -1;
+    if (first != UINT64_MAX && last != UINT64_MAX) {
+        snprintf(range, sizeof(range), "Range: bytes=%llu-%llu\r\n",
+                 (unsigned long long)first, (unsigned long long)last);
+    } else if (first != UINT64_MAX) {
+        snprintf(range, sizeof(range), "Range: bytes=%llu-\r\n", (unsigned long long)first);
+    }
+    int is_default_port = strcmp(url->port, "80") == 0;
+    int length = snprintf(request, sizeof(request),
+                          "%s %s HTTP/1.1\r\nHost: %s%s%s\r\nUser-Agent: c-demo-downloader\r\n"
+                          "Accept-Encoding: identity\r\nConnection: close\r\n%s\r\n",
+                          method, url->path, url->host, is_default_port ? "" : ":",
+                          is_default_port ? "" : url->port, range);
+    if (length < 0 || (size_t)length >= sizeof(request)) {
+        return EINVAL;
+    }
+
+    int result = http_connect(url, &response->fd);
+    if (result == 0) {
+        result = send_all(response->fd, request, (size_t)length);
+    }
+
+    size_t received = 0;
+    char *header_end = NULL;
+    while (result == 0 && !header_end) {
+        if (received == sizeof(response->buffer)) {
+            result = EIO;
+            break;
+        }
+        ssize_t bytes = recv(response->fd, response->buffer + received,
+                             sizeof(response->buffer) - received, 0);
+        if (bytes == -1 && errno == EINTR) {
+            continue;
+        }
+        if (bytes == -1) {
+            result = errno == EAGAIN ? ETIMEDOUT : errno;
+        } else if (bytes == 0) {
+            result = ECONNRESET;
+        } else {
+            size_t scan_from = received > 3 ? received - 3 : 0;
+            received += (size_t)bytes;
+            header_end = memmem(response->buffer + scan_from, received - scan_from, "\r\n\r\n", 4);
+        }
+    }
+
+    if (result == 0) {
+        size_t header_length = (size_t)(header_end - response->buffer) + 2;
+        result = parse_headers(response, header_length);
+        response->body_offset = header_length + 2;
+        response->buffered = received - response->body_offset;
+    }
+    if (result != 0 && response->fd >= 0) {
+        close(response->fd);
+        response->fd = -1;
+    }
+    return result;
+}
+
+/**
+ * @brief Read body bytes: what came with the headers first, then the socket
+ * @param[out] got Bytes read; 0 at end of stream
+ */
+static int response_read(http_response_t *response, char *buffer, size_t size, size_t *got) {
+    *got = 0;
+    if (response->buffered > 0) {
+        size_t count = response->buffered < size ? response->buffered : size;
+        memcpy(buffer, response->buffer + response->body_offset, count);
+        response->body_offset += count;
+        response->buffered -= count;
+        *got = count;
+        return 0;
+    }
+
+    for (;;) {
+        ssize_t bytes = recv(response->fd, buffer, size, 0);
+        if (bytes >= 0) {
+            *got = (size_t)bytes;
+            return 0;
+        }
+        if (errno != EINTR) {
+            return errno == EAGAIN ? ETIMEDOUT : errno;
+        }
+    }
+}
+
+static int status_error(int status) {
+    return (status == 404 || status == 410) ? ENOENT : EIO;
+}
+
+static int is_redirect(int status) {
+    return status == 301 || status == 302 || status == 303 || status == 307 || status == 308;
+}
+
+/**
+ * @brief Find size, range support and validator, following redirects
+ * @param url Updated to the final location
+ */
+static int probe(http_url_t *url, resource_info_t *info) {
+    http_response_t *response = malloc(sizeof(http_response_t));
+    int result = response ? 0 : ENOMEM;
+
+    memset(info, 0, sizeof(*info));
+    for (int redirects = 0; result == 0; redirects++) {
+        result = http_request(url, "HEAD", UINT64_MAX, UINT64_MAX, response);
+        if (result != 0) {
+            break;
+        }
+        close(response->fd);
+
+        if (is_redirect(response->status) && response->location[0]) {
+            result = redirects < HTTP_MAX_REDIRECTS ? follow_location(url, response->location) : EIO;
+            continue;
+        }
+        if (response->status != 200) {
+            result = status_error(response->status);
+            break;
+        }
+        info->has_length = response->has_length && !response->chunked;
+        info->length = response->content_length;
+        info->ranges = response->accept_ranges;
+        snprintf(info->validator, sizeof(info->validator), "%s", response->validator);
+        break;
+    }
+
+    free(response);
+    return result;
+}
+
+/**
+ * @brief GET url (following redirects) and write the body to fd in order
+ */
+static int stream_to_fd(http_url_t *url, int fd, uint64_t *bytes) {
+    http_response_t *response = malloc(sizeof(http_response_t));
+    char *buffer = malloc(HTTP_BUFFER_SIZE);
+    int result = (response && buffer) ? 0 : ENOMEM;
+
+    *bytes = 0;
+    for (int redirects = 0; result == 0; redirects++) {
+        result = http_request(url, "GET", UINT64_MAX, UINT64_MAX, response);
+        if (result != 0) {
+            break;
+        }
+        if (is_redirect(response->status) && response->location[0]) {
+            close(response->fd);
+            result = redirects < HTTP_MAX_REDIRECTS ? follow_location(url, response->location) : EIO;
+            continue;
+        }
+        if (response->status != 200 || response->chunked) {
+            result = response->chunked ? ENOTSUP : status_error(response->status);
+            close(response->fd);
+            break;
+        }
+
+        size_t got;
+        do {
+            result = response_read(response, buffer, HTTP_BUFFER_SIZE, &got);
+            if (result == 0 && got > 0) {
+                result = write_all(fd, buffer, got);
+                *bytes += got;
+            }
+        } while (result == 0 && got > 0);
+        close(response->fd);
+
+        if (result == 0 && response->has_length && *bytes != response->content_length) {
+            result = ECONNRESET;
+        }
+        break;
+    }
+
+    free(buffer);
+    free(response);
+    return result;
+}
+
+/*============================================================================
+ * SEGMENTS
+ *============================================================================*/
+
+static void segment_bounds(uint64_t size, uint32_t count, uint32_t index,
+                           uint64_t *start, uint64_t *length) {
+    uint64_t base = size / count;
+    *start = base * index;
+    *length = (index == count - 1) ? size - *start : base;
+}
+
+static int is_transient(int error) {
+    return error == ECONNRESET || error == ETIMEDOUT || error == EPIPE ||
+           error == ECONNREFUSED || error == ECONNABORTED;
+}
+
+/**
+ * @brief Write the buffered part of a segment and record the progress
+ */
+static int flush_segment(segment_t *segment, const char *buffer, size_t length) {
+    int result = pwrite_all(segment->data_fd, buffer, length, segment->start + segment->done);
+    if (result != 0) {
+        return result;
+    }
+    segment->done += length;
+    segment->fetched += length;
+    return pwrite_all(segment->state_fd, (const char *)&segment->done, sizeof(segment->done),
+                      offsetof(download_state_t, done) + sizeof(uint64_t) * (size_t)segment->index);
+}
+
+/**
+ * @brief Fetch the rest of a segment over one connection
+ */
+static int fetch_segment(segment_t *segment, char *buffer, http_response_t *response) {
+    uint64_t first = segment->start + segment->done;
+    uint64_t last = segment->start + segment->length - 1;
+
+    int result = http_request(segment->url, "GET", first, last, response);
+    if (result != 0) {
+        return result;
+    }
+    if (response->status != 206 || !response->has_range || response->range_start != first) {
+        close(response->fd);
+        return response->status == 206 || response->status == 200 ? EIO
+                                                                   : status_error(response->status);
+    }
+    // The resource changed under us; the earlier segments are from another version
+    if (segment->validator[0] && response->validator[0] &&
+        strcmp(segment->validator, response->validator) != 0) {
+        close(response->fd);
+        return ESTALE;
+    }
+
+    size_t filled = 0;
+    while (result == 0 && segment->done + filled < segment->length) {
+        uint64_t remaining = segment->length - segment->done - filled;
+        size_t room = HTTP_BUFFER_SIZE - filled;
+        size_t got;
+
+        result = response_read(response, buffer + filled,
+                               remaining < room ? (size_t)remaining : room, &got);
+        if (result == 0 && got == 0) {
+            result = ECONNRESET;
+        }
+        filled += got;
+        if (filled == HTTP_BUFFER_SIZE || segment->done + filled == segment->length) {
+            int flush_result = flush_segment(segment, buffer, filled);
+            filled = 0;
+            result = result != 0 ? result : flush_result;
+        }
+    }
+    // Keep whatever arrived before a failure; a resume starts after it
+    if (filled > 0) {
+        int flush_result = flush_segment(segment, buffer, filled);
+        result = result != 0 ? result : flush_result;
+    }
+    close(response->fd);
+    return result;
+}
+
+static void *segment_thread(void *arg) {
+    segment_t *segment = arg;
+    char *buffer = malloc(HTTP_BUFFER_SIZE);
+    http_response_t *response = malloc(sizeof(http_response_t));
+    int attempts = 0;
+
+    segment->result = (buffer && response) ? 0 : ENOMEM;
+    while (segment->result == 0 && segment->done < segment->length) {
+        segment->result = fetch_segment(segment, buffer, response);
+        if (is_transient(segment->result) && attempts < segment->retries) {
+            attempts++;
+            segment->reconnects++;
+            segment->result = 0;
+        }
+    }
+
+    free(response);
+    free(buffer);
+    return NULL;
+}
+
+/*============================================================================
+ * STATE FILE
+ *============================================================================*/
+
+/**
+ * @brief Load the state of an earlier attempt if it matches the resource
+ */
+static int load_state(const char *state_path, const char *part_path,
+                      const resource_info_t *info, download_state_t *state) {
+    struct stat st;
+
+    int fd = open(state_path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return errno;
+    }
+    ssize_t bytes = pread(fd, state, sizeof(*state), 0);
+    close(fd);
+
+    if (bytes != (ssize_t)sizeof(*state) || memcmp(state->magic, STATE_MAGIC, 8) != 0 ||
+        state->size != info->length || state->count == 0 ||
+        state->count > HTTP_MAX_CONNECTIONS ||
+        strncmp(state->validator, info->validator, sizeof(state->validator)) != 0) {
+        return ESTALE;
+    }
+    if (stat(part_path, &st) == -1 || (uint64_t)st.st_size != info->length) {
+        return ESTALE;
+    }
+    for (uint32_t i = 0; i < state->count; i++) {
+        uint64_t start;
+        uint64_t length;
+        segment_bounds(state->size, state->count, i, &start, &length);
+        if (state->done[i] > length) {
+            return ESTALE;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Reserve the whole file up front
+ */
+static int preallocate(int fd, uint64_t size) {
+    if (size == 0) {
+        return 0;
+    }
+    if (fallocate(fd, 0, 0, (off_t)size) == 0) {
+        return 0;
+    }
+    // Filesystems without fallocate still get the final size
+    return ftruncate(fd, (off_t)size) == 0 ? 0 : errno;
+}
+
+/*============================================================================
+ * DOWNLOADS
+ *============================================================================*/
+
+/**
+ * @brief Fetch the file over one connection into the .part file
+ */
+static int download_single(http_url_t *url, const char *part_path, http_download_stats_t *stats) {
+    int fd = open(part_path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd == -1) {
+        return errno;
+    }
+    int result = stream_to_fd(url, fd, &stats->fetched);
+    if (close(fd) != 0 && result == 0) {
+        result = errno;
+    }
+    stats->connections = 1;
+    return result;
+}
+
+/**
+ * @brief Fetch the missing parts of every segment concurrently
+ */
+static int download_segments(const http_url_t *url, int data_fd, int state_fd,
+                             download_state_t *state, int retries,
+                             http_download_stats_t *stats) {
+    segment_t segments[HTTP_MAX_CONNECTIONS];
+    int result = 0;
+
+    memset(segments, 0, sizeof(segments));
+    for (uint32_t i = 0; i < state->count; i++) {
+        segment_t *segment = &segments[i];
+        segment->url = url;
+        segment->validator = state->validator;
+        segment->data_fd = data_fd;
+        segment->state_fd = state_fd;
+        segment->index = (int)i;
+        segment->done = state->done[i];
+        segment->retries = retries;
+        segment_bounds(state->size, state->count, i, &segment->start, &segment->length);
+        stats->resumed += segment->done;
+
+        if (segment->done < segment->length) {
+            int create_result = pthread_create(&segment->thread, NULL, segment_thread, segment);
+            segment->result = create_result;
+            segment->started = create_result == 0;
+        }
+    }
+
+    for (uint32_t i = 0; i < state->count; i++) {
+        segment_t *segment = &segments[i];
+        if (segment->started) {
+            pthread_join(segment->thread, NULL);
+        }
+        stats->fetched += segment->fetched;
+        stats->reconnects += segment->reconnects;
+        if (segment->result != 0 && result == 0) {
+            result = segment->result;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Download url to path (see the file comment)
+ * @param options NULL for one connection, no resume and no retries
+ * @param[out] stats What happened; may be NULL
+ * @return 0 once path holds the whole resource; on failure PATH.part and
+ *         its state are kept for a later resume
+ */
+int http_download_file(const char *url, const char *path,
+                       const http_download_options_t *options, http_download_stats_t *stats) {
+    http_download_options_t defaults = { 1, 0, 0 };
+    http_download_stats_t local_stats;
+    http_url_t target;
+    resource_info_t info;
+    char part_path[PATH_MAX];
+    char state_path[PATH_MAX];
+
+    if (!url || !path) {
+        return EINVAL;
+    }
+    if (!options) {
+        options = &defaults;
+    }
+    if (!stats) {
+        stats = &local_stats;
+    }
+    memset(stats, 0, sizeof(*stats));
+    if (options->connections < 1 || options->connections > HTTP_MAX_CONNECTIONS ||
+        options->retries < 0) {
+        return EINVAL;
+    }
+
+    int length = snprintf(part_path, sizeof(part_path), "%s" PART_SUFFIX, path);
+    int state_length = snprintf(state_path, sizeof(state_path), "%s" STATE_SUFFIX, path);
+    if (length < 0 || (size_t)length >= sizeof(part_path) ||
+        state_length < 0 || (size_t)state_length >= sizeof(state_path)) {
+        return ENAMETOOLONG;
+    }
+
+    int result = parse_url(url, &target);
+    if (result == 0) {
+        result = probe(&target, &info);
+    }
+    if (result != 0) {
+        return result;
+    }
+    stats->size = info.length;
+    stats->ranges = info.ranges;
+
+    if (!info.has_length || !info.ranges) {
+        result = download_single(&target, part_path, stats);
+        if (result == 0 && rename(part_path, path) != 0) {
+            result = errno;
+        }
+        return result;
+    }
+
+    download_state_t state;
+    int resumed = options->resume && load_state(state_path, part_path, &info, &state) == 0;
+    if (!resumed) {
+        uint64_t max_segments = info.length / HTTP_MIN_SEGMENT;
+        memset(&state, 0, sizeof(state));
+        memcpy(state.magic, STATE_MAGIC, 8);
+        state.size = info.length;
+        state.count = (uint32_t)options->connections;
+        if (state.count > max_segments) {
+            state.count = max_segments > 0 ? (uint32_t)max_segments : 1;
+        }
+        snprintf(state.validator, sizeof(state.validator), "%s", info.validator);
+    }
+    stats->connections = (int)state.count;
+
+    int data_fd = open(part_path, O_RDWR | O_CREAT | O_CLOEXEC | (resumed ? 0 : O_TRUNC), 0644);
+    if (data_fd == -1) {
+        return errno;
+    }
+    int state_fd = open(state_path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (state_fd == -1) {
+        result = errno;
+        close(data_fd);
+        return result;
+    }
+
+    if (!resumed) {
+        result = preallocate(data_fd, info.length);
+        if (result == 0) {
+            result = pwrite_all(state_fd, (const char *)&state, sizeof(state), 0);
+        }
+    }
+    if (result == 0) {
+        result = download_segments(&target, data_fd, state_fd, &state, options->retries, stats);
+    }
+
+    if (close(data_fd) != 0 && result == 0) {
+        result = errno;
+    }
+    close(state_fd);
+    if (result != 0) {
+        return result;
+    }
+
+    if (rename(part_path, path) != 0) {
+        return errno;
+    }
+    unlink(state_path);
+    return 0;
+}
+
+/**
+ * @brief Stream url, in order, into fd (a file, pipe or socket)
+ * @param[out] bytes Body bytes written
+ */
+int http_download_to_fd(const char *url, int fd, uint64_t *bytes) {
+    http_url_t target;
+    uint64_t written = 0;
+
+    if (!url || fd < 0) {
+        return EINVAL;
+    }
+    int result = parse_url(url, &target);
+    if (result == 0) {
+        result = stream_to_fd(&target, fd, &written);
+    }
+    if (bytes) {
+        *bytes = written;
+    }
+    return result;
+}
+
+/**
+ * @brief Download an .xz resource and decompress it on the fly into path
+ * @param[out] compressed_bytes Bytes downloaded; may be NULL
+ * @return 0, an errno code from the transfer, or EIO if xz rejected the data
+ */
+int http_download_xz(const char *url, const char *path, uint64_t *compressed_bytes) {
+    char *argv[] = { "xz", "-dc", NULL };
+    int fds[2];
+    pid_t pid;
+
+    if (!url || !path) {
+        return EINVAL;
+    }
+    int out_fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (out_fd == -1) {
+        return errno;
+    }
+    if (pipe2(fds, O_CLOEXEC) == -1) {
+        int result = errno;
+        close(out_fd);
+        return result;
+    }
+
+    int result = launcher_spawn_fds(argv, fds[0], out_fd, -1, &pid);
+    close(fds[0]);
+    close(out_fd);
+    if (result != 0) {
+        close(fds[1]);
+        return result;
+    }
+
+    // If xz gives up early our writes fail with EPIPE instead of killing us
+    sigset_t pipe_set;
+    sigset_t old_set;
+    sigemptyset(&pipe_set);
+    sigaddset(&pipe_set, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipe_set, &old_set);
+
+    result = http_download_to_fd(url, fds[1], compressed_bytes);
+    close(fds[1]);
+
+    struct timespec no_wait = { 0, 0 };
+    while (sigtimedwait(&pipe_set, NULL, &no_wait) > 0) {
+    }
+    pthread_sigmask(SIG_SETMASK, &old_set, NULL);
+
+    int status;
+    int wait_result = launcher_wait(pid, &status);
+    int xz_failed = wait_result == 0 && (!WIFEXITED(status) || WEXITSTATUS(status) != 0);
+    if (xz_failed && (result == 0 || result == EPIPE)) {
+        result = EIO;
+    }
+    return result != 0 ? result : wait_result;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file http_download.h
+ * @brief Native HTTP downloader: parallel range requests, resume, xz streaming
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * http_download_file() replaces `wget -O file URL` for plain http:// URLs:
+ * - a HEAD request finds the size, whether the server honours Range
+ *   requests and a validator (ETag or Last-Modified); redirects are followed
+ * - the file is split into up to `connections` segments fetched
+ *   concurrently, one thread and one connection each, with
+ *   `Range: bytes=a-b` requests
+ * - every segment is written with pwrite() at its own offset into a file
+ *   preallocated to the full size (fallocate), so segments never contend
+ *   for a file position and the file does not fragment as it fills
+ * - data goes to PATH.part; PATH.part.state records the segment layout, the
+ *   validator and how far each segment got, updated after every write. A
+ *   later call with `resume` continues each segment where it stopped if
+ *   the size and validator still match; otherwise it starts over. On
+ *   success PATH.part is renamed to PATH and the state file removed
+ * - a dropped connection is retried `retries` times per segment, resuming
+ *   at the segment's current offset
+ * Servers without range support, or without a Content-Length, are fetched
+ * over a single connection.
+ *
+ * http_download_to_fd() streams a resource sequentially into any
+ * descriptor, and http_download_xz() uses it to feed `xz -dc` (started with
+ * the posix_spawn launcher), so decompression overlaps the transfer and the
+ * compressed file is never stored.
+ *
+ * Only http:// is supported (https:// returns EPROTONOSUPPORT), and chunked
+ * responses are refused with ENOTSUP. The state file is not fsync'ed: it
+ * survives the process dying, not the machine.
+ *
+ * All functions return 0 or an errno code: EINVAL for a malformed URL,
+ * EHOSTUNREACH if the host does not resolve, ENOENT for 404/410, EIO for
+ * other HTTP errors, ECONNRESET if a connection ended early.
+ */
+
+#ifndef HTTP_DOWNLOAD_H
+#define HTTP_DOWNLOAD_H
+
+#include <stdint.h>
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+/** Upper bound on parallel connections */
+#define HTTP_MAX_CONNECTIONS 16
+
+/** Segments are not made smaller than this */
+#define HTTP_MIN_SEGMENT (256 * 1024)
+
+/** Receive buffer per connection; one pwrite() per filled buffer */
+#define HTTP_BUFFER_SIZE (256 * 1024)
+
+/** Largest response header accepted */
+#define HTTP_HEADER_MAX (16 * 1024)
+
+#define HTTP_MAX_REDIRECTS 5
+
+/** Send/receive timeout of every connection */
+#define HTTP_TIMEOUT_SECONDS 30
+
+/**
+ * @brief How to download
+ */
+typedef struct {
+    int connections;            /**< Parallel range requests, 1..HTTP_MAX_CONNECTIONS */
+    int resume;                 /**< Continue from PATH.part and its state file */
+    int retries;                /**< Reconnects per segment after a dropped connection */
+} http_download_options_t;
+
+/**
+ * @brief What a download did
+ */
+typedef struct {
+    uint64_t size;              /**< Size of the resource */
+    uint64_t fetched;           /**< Body bytes received by this call */
+    uint64_t resumed;           /**< Bytes already present from an earlier call */
+    int connections;            /**< Segments actually used */
+    int ranges;                 /**< Server honoured range requests */
+    int reconnects;             /**< Retries after dropped connections */
+} http_download_stats_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+int http_download_file(const char *url, const char *path,
+                       const http_download_options_t *options, http_download_stats_t *stats);
+int http_download_to_fd(const char *url, int fd, uint64_t *bytes);
+int http_download_xz(const char *url, const char *path, uint64_t *compressed_bytes);
+
+#endif /* HTTP_DOWNLOAD_H */
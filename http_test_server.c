@@ -0,0 +1,370 @@
+/**
+ * @file http_test_server.c
+ * @brief Loopback HTTP/1.1 server with ranges, throttling and dropped connections
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#define _GNU_SOURCE
+
+#include "http_test_server.h"
+#include "clock_ns.h"
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+#define REQUEST_MAX 8192
+#define LISTEN_BACKLOG 64
+#define SEND_TIMEOUT_SECONDS 10
+
+/** Pause before accepting again when out of descriptors or memory */
+#define ACCEPT_BACKOFF_MS 50
+
+/**
+ * @brief One accepted connection, owned by its thread
+ */
+typedef struct {
+    http_test_server_t *server;
+    int fd;
+} connection_t;
+
+/*============================================================================
+ * UTILITY FUNCTIONS
+ *============================================================================*/
+
+static int send_all(int fd, const char *data, size_t length) {
+    while (length > 0) {
+        ssize_t sent = send(fd, data, length, MSG_NOSIGNAL);
+        if (sent == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno;
+        }
+        data += sent;
+        length -= (size_t)sent;
+    }
+    return 0;
+}
+
+/**
+ * @brief Parse a single "bytes=" range against the resource size
+ * @return 1 for a satisfiable range, 0 for one to ignore (serve everything),
+ *         -1 for an unsatisfiable one
+ */
+static int parse_range(const char *value, size_t size, size_t *first, size_t *last) {
+    unsigned long long a;
+    unsigned long long b;
+    int consumed = 0;
+
+    if (strncasecmp(value, "bytes=", 6) != 0 || strchr(value, ',')) {
+        return 0;
+    }
+    value += 6;
+    if (sscanf(value, "-%llu%n", &b, &consumed) == 1 && consumed > 0) {
+        if (b == 0 || size == 0) {
+            return -1;
+        }
+        *first = b >= size ? 0 : size - (size_t)b;
+        *last = size - 1;
+        return 1;
+    }
+    if (sscanf(value, "%llu-%n", &a, &consumed) != 1 || consumed == 0) {
+        return 0;
+    }
+    if (sscanf(value + consumed, "%llu", &b) != 1) {
+        b = size > 0 ? size - 1 : 0;
+    }
+    if (a >= size || b < a) {
+        return -1;
+    }
+    *first = (size_t)a;
+    *last = b >= size ? size - 1 : (size_t)b;
+    return 1;
+}
+
+/*============================================================================
+ * CONNECTIONS
+ *============================================================================*/
+
+/**
+ * @brief Send body bytes, throttled and possibly cut short
+ */
+static void send_body(http_test_server_t *server, int fd, size_t first, size_t length) {
+    uint64_t rate = __atomic_load_n(&server->rate, __ATOMIC_RELAXED);
+    uint64_t drop_after = __atomic_load_n(&server->drop_after, __ATOMIC_RELAXED);
+    long long start = now_ns();
+    size_t sent = 0;
+
+    if (drop_after > 0 && drop_after < length) {
+        length = (size_t)drop_after;
+    }
+    while (sent < length) {
+        size_t slice = length - sent < HTTP_TEST_SERVER_SLICE ? length - sent
+                                                              : HTTP_TEST_SERVER_SLICE;
+        if (send_all(fd, server->data + first + sent, slice) != 0) {
+            return;
+        }
+        sent += slice;
+        if (rate > 0) {
+            long long due = start + (long long)((double)sent * 1e9 / (double)rate);
+            long long wait = due - now_ns();
+            if (wait > 0) {
+                struct timespec ts = { wait / 1000000000LL, wait % 1000000000LL };
+                nanosleep(&ts, NULL);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Read one request and answer it
+ */
+static void serve(http_test_server_t *server, int fd) {
+    char request[REQUEST_MAX + 1];
+    char header[512];
+    size_t received = 0;
+
+    while (!memmem(request, received, "\r\n\r\n", 4)) {
+        if (received == REQUEST_MAX) {
+            return;
+        }
+        ssize_t bytes = recv(fd, request + received, REQUEST_MAX - received, 0);
+        if (bytes <= 0) {
+            return;
+        }
+        received += (size_t)bytes;
+    }
+    request[received] = '\0';
+
+    char method[16];
+    char path[1024];
+    if (sscanf(request, "%15s %1023s", method, path) != 2) {
+        return;
+    }
+    int is_head = strcmp(method, "HEAD") == 0;
+    __atomic_add_fetch(&server->requests, 1, __ATOMIC_RELAXED);
+
+    if (!is_head && strcmp(method, "GET") != 0) {
+        snprintf(header, sizeof(header),
+                 "HTTP/1.1 405 Method Not Allowed\r\nContent-Length: 0\r\n"
+                 "Connection: close\r\n\r\n");
+        send_all(fd, header, strlen(header));
+        return;
+    }
+    if (strncmp(path, "/redirect", 9) == 0) {
+        int length = snprintf(header, sizeof(header),
+                              "HTTP/1.1 302 Found\r\nLocation: %s\r\nContent-Length: 0\r\n"
+                              "Connection: close\r\n\r\n", path[9] ? path + 9 : "/");
+        if (length > 0 && (size_t)length < sizeof(header)) {
+            send_all(fd, header, (size_t)length);
+        }
+        return;
+    }
+
+    size_t first = 0;
+    size_t last = server->size > 0 ? server->size - 1 : 0;
+    int range = 0;
+    char *range_header = strcasestr(request, "\r\nRange:");
+    if (range_header && server->ranges) {
+        range_header += 8;
+        range_header += strspn(range_header, " \t");
+        range = parse_range(range_header, server->size, &first, &last);
+    }
+
+    int length;
+    if (range < 0) {
+        length = snprintf(header, sizeof(header),
+                          "HTTP/1.1 416 Range Not Satisfiable\r\nContent-Range: bytes */%zu\r\n"
+                          "Content-Length: 0\r\nConnection: close\r\n\r\n", server->size);
+        send_all(fd, header, (size_t)length);
+        return;
+    }
+
+    size_t body = server->size == 0 ? 0 : last - first + 1;
+    if (range > 0) {
+        length = snprintf(header, sizeof(header),
+                          "HTTP/1.1 206 Partial Content\r\nContent-Range: bytes %zu-%zu/%zu\r\n",
+                          first, last, server->size);
+    } else {
+        length = snprintf(header, sizeof(header), "HTTP/1.1 200 OK\r\n");
+    }
+    length += snprintf(header + length, sizeof(header) - (size_t)length,
+                       "Content-Length: %zu\r\nAccept-Ranges: %s\r\nETag: %s\r\n"
+                       "Content-Type: application/octet-stream\r\nConnection: close\r\n\r\n",
+                       body, server->ranges ? "bytes" : "none", server->etag);
+    if (send_all(fd, header, (size_t)length) != 0 || is_head) {
+        return;
+    }
+    send_body(server, fd, first, body);
+}
+
+static void *connection_thread(void *arg) {
+    connection_t *connection = arg;
+    http_test_server_t *server = connection->server;
+
+    serve(server, connection->fd);
+    close(connection->fd);
+    free(connection);
+
+    pthread_mutex_lock(&server->lock);
+    if (--server->active == 0) {
+        pthread_cond_broadcast(&server->idle);
+    }
+    pthread_mutex_unlock(&server->lock);
+    return NULL;
+}
+
+static void *acceptor_thread(void *arg) {
+    http_test_server_t *server = arg;
+    pthread_attr_t attr;
+
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    for (;;) {
+        int fd = accept4(server->listen_fd, NULL, NULL, SOCK_CLOEXEC);
+        if (__atomic_load_n(&server->stopping, __ATOMIC_ACQUIRE)) {
+            if (fd >= 0) {
+                close(fd);
+            }
+            break;
+        }
+        if (fd == -1) {
+            if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM) {
+                // Retrying at once would only spin until something is freed
+                struct timespec pause = { 0, ACCEPT_BACKOFF_MS * 1000000L };
+                nanosleep(&pause, NULL);
+                continue;
+            }
+            if (errno == EBADF || errno == EINVAL || errno == ENOTSOCK || errno == EOPNOTSUPP) {
+                // The listening socket itself is unusable: refuse new clients
+                shutdown(server->listen_fd, SHUT_RDWR);
+                break;
+            }
+            // EINTR, ECONNABORTED and network errors concern one connection
+            continue;
+        }
+
+        struct timeval timeout = { SEND_TIMEOUT_SECONDS, 0 };
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        connection_t *connection = malloc(sizeof(connection_t));
+        if (!connection) {
+            close(fd);
+            continue;
+        }
+        connection->server = server;
+        connection->fd = fd;
+
+        pthread_t thread;
+        pthread_mutex_lock(&server->lock);
+        server->active++;
+        pthread_mutex_unlock(&server->lock);
+        if (pthread_create(&thread, &attr, connection_thread, connection) != 0) {
+            pthread_mutex_lock(&server->lock);
+            server->active--;
+            pthread_mutex_unlock(&server->lock);
+            close(fd);
+            free(connection);
+        }
+    }
+    pthread_attr_destroy(&attr);
+    return NULL;
+}
+
+/*============================================================================
+ * SERVER LIFECYCLE
+ *============================================================================*/
+
+/**
+ * @brief Listen on 127.0.0.1 at an ephemeral port and start serving
+ * @return 0 with server->port set, or an errno code
+ */
+int http_test_server_start(http_test_server_t *server) {
+    struct sockaddr_in address;
+    socklen_t address_length = sizeof(address);
+
+    if (!server || (!server->data && server->size > 0)) {
+        return EINVAL;
+    }
+    server->requests = 0;
+    server->stopping = 0;
+    server->active = 0;
+
+    // FNV-1a of the content, so a changed resource gets a new validator
+    uint64_t hash = 1469598103934665603ULL;
+    for (size_t i = 0; i < server->size; i++) {
+        hash = (hash ^ (unsigned char)server->data[i]) * 1099511628211ULL;
+    }
+    snprintf(server->etag, sizeof(server->etag), "\"%016llx\"", (unsigned long long)hash);
+
+    server->listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (server->listen_fd == -1) {
+        return errno;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    if (bind(server->listen_fd, (struct sockaddr *)&address, sizeof(address)) == -1 ||
+        listen(server->listen_fd, LISTEN_BACKLOG) == -1 ||
+        getsockname(server->listen_fd, (struct sockaddr *)&address, &address_length) == -1) {
+        int result = errno;
+        close(server->listen_fd);
+        return result;
+    }
+    server->port = ntohs(address.sin_port);
+
+    pthread_mutex_init(&server->lock, NULL);
+    pthread_cond_init(&server->idle, NULL);
+    int result = pthread_create(&server->acceptor, NULL, acceptor_thread, server);
+    if (result != 0) {
+        pthread_cond_destroy(&server->idle);
+        pthread_mutex_destroy(&server->lock);
+        close(server->listen_fd);
+    }
+    return result;
+}
+
+/**
+ * @brief Stop accepting and wait for every connection to finish
+ */
+void http_test_server_stop(http_test_server_t *server) {
+    __atomic_store_n(&server->stopping, 1, __ATOMIC_RELEASE);
+    // Wakes the acceptor out of accept()
+    shutdown(server->listen_fd, SHUT_RDWR);
+    pthread_join(server->acceptor, NULL);
+    close(server->listen_fd);
+
+    pthread_mutex_lock(&server->lock);
+    while (server->active > 0) {
+        pthread_cond_wait(&server->idle, &server->lock);
+    }
+    pthread_mutex_unlock(&server->lock);
+
+    pthread_cond_destroy(&server->idle);
+    pthread_mutex_destroy(&server->lock);
+}
+
+/**
+ * @brief Format the URL of a path on the server, e.g. "/file"
+ */
+int http_test_server_url(const http_test_server_t *server, const char *path,
+                         char *url, size_t size) {
+    int length = snprintf(url, size, "http://127.0.0.1:%d%s", server->port, path);
+    return (length < 0 || (size_t)length >= size) ? ENAMETOOLONG : 0;
+}
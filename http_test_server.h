@@ -0,0 +1,67 @@
+/**
+ * @file http_test_server.h
+ * @brief Loopback HTTP/1.1 server serving one in-memory resource
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * A stand-in for a download mirror, for exercising http_download.h without
+ * the network: it listens on 127.0.0.1 at an ephemeral port and answers
+ * every GET or HEAD with the same buffer, honouring single Range requests
+ * (206 / 416) unless told not to. A path starting with /redirect is answered
+ * with a 302 to the rest of the path.
+ *
+ * Each connection gets its own thread and is closed after one response.
+ * To model a real link the server can throttle every connection to a byte
+ * rate (so parallel connections add up the way they do against a server
+ * that limits per connection), and it can drop each connection after a
+ * number of body bytes to exercise retries and resume.
+ *
+ * The knobs may be changed between downloads, not during one.
+ */
+
+#ifndef HTTP_TEST_SERVER_H
+#define HTTP_TEST_SERVER_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+/** Bytes sent per send() call, and the granularity of throttling */
+#define HTTP_TEST_SERVER_SLICE (64 * 1024)
+
+/**
+ * @brief Server state; fill in the first block, then start
+ */
+typedef struct {
+    const char *data;           /**< Resource served (not copied) */
+    size_t size;
+    int ranges;                 /**< Honour Range requests */
+    uint64_t rate;              /**< Bytes per second per connection, 0 unlimited */
+    uint64_t drop_after;        /**< Close after this many body bytes, 0 never */
+
+    int port;                   /**< Set by http_test_server_start() */
+    unsigned long requests;     /**< Requests answered so far */
+
+    int listen_fd;
+    int stopping;
+    int active;                 /**< Connection threads still running */
+    char etag[32];
+    pthread_t acceptor;
+    pthread_mutex_t lock;
+    pthread_cond_t idle;
+} http_test_server_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+int http_test_server_start(http_test_server_t *server);
+void http_test_server_stop(http_test_server_t *server);
+int http_test_server_url(const http_test_server_t *server, const char *path,
+                         char *url, size_t size);
+
+#endif /* HTTP_TEST_SERVER_H */
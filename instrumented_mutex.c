@@ -0,0 +1,311 @@
+/**
+ * @file instrumented_mutex.c
+ * @brief Instrumented pthread mutex implementation
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "instrumented_mutex.h"
+#include "clock_ns.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+/*============================================================================
+ * CONSTANTS AND THREAD-LOCAL STATE
+ *============================================================================*/
+
+/** Number of mutexes whose stats each thread can look up without locking */
+#define THREAD_CACHE_SLOTS 8
+
+/**
+ * @brief Per-thread cache entry mapping a mutex to this thread's stats
+ * @note Matched on (owner, generation) only, so stale entries for destroyed
+ *       mutexes are never dereferenced
+ */
+typedef struct {
+    const instrumented_mutex_t *owner;
+    unsigned long generation;
+    lock_thread_stats_t *stats;
+} thread_cache_entry_t;
+
+static __thread thread_cache_entry_t thread_cache[THREAD_CACHE_SLOTS];
+static __thread unsigned int thread_cache_next = 0;
+static __thread char current_thread_name[LOCK_STATS_NAME_LENGTH];
+
+/** Source of unique generations for dynamically initialized mutexes */
+static unsigned long generation_counter = 0;
+
+/** Mutexes to report when the process exits */
+static pthread_mutex_t report_list_lock = PTHREAD_MUTEX_INITIALIZER;
+static instrumented_mutex_t *report_list = NULL;
+static int report_handler_registered = 0;
+
+/*============================================================================
+ * UTILITY FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Find (or create) the calling thread's stats for a mutex
+ * @return Stats entry, or NULL if it could not be allocated
+ */
+static lock_thread_stats_t *lookup_thread_stats(instrumented_mutex_t *mutex) {
+    for (int i = 0; i < THREAD_CACHE_SLOTS; i++) {
+        if (thread_cache[i].owner == mutex &&
+            thread_cache[i].generation == mutex->generation) {
+            return thread_cache[i].stats;
+        }
+    }
+
+    lock_thread_stats_t *stats = malloc(sizeof(*stats));
+    if (!stats) {
+        return NULL;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+    latency_histogram_init(&stats->wait_ns);
+    latency_histogram_init(&stats->hold_ns);
+    if (current_thread_name[0] != '\0') {
+        snprintf(stats->thread_name, sizeof(stats->thread_name), "%s", current_thread_name);
+    } else {
+        snprintf(stats->thread_name, sizeof(stats->thread_name), "thread-%lu",
+                 (unsigned long)pthread_self());
+    }
+
+    pthread_mutex_lock(&mutex->registry_lock);
+    stats->next = mutex->thread_stats;
+    mutex->thread_stats = stats;
+    pthread_mutex_unlock(&mutex->registry_lock);
+
+    thread_cache_entry_t *slot = &thread_cache[thread_cache_next++ % THREAD_CACHE_SLOTS];
+    slot->owner = mutex;
+    slot->generation = mutex->generation;
+    slot->stats = stats;
+
+    return stats;
+}
+
+/**
+ * @brief Print one report row
+ */
+static void print_stats_row(FILE *out, const char *label, unsigned long acquisitions,
+                            unsigned long contended, const latency_histogram_t *wait,
+                            const latency_histogram_t *hold) {
+    char buf[6][LATENCY_FORMAT_SIZE];
+
+    fprintf(out, "  %-20s %9lu %9lu %11s %11s %11s %11s %11s %11s\n",
+            label, acquisitions, contended,
+            latency_format_ns(buf[0], sizeof(buf[0]), latency_histogram_percentile(wait, 50.0)),
+            latency_format_ns(buf[1], sizeof(buf[1]), latency_histogram_percentile(wait, 99.0)),
+            latency_format_ns(buf[2], sizeof(buf[2]), wait->total_count ? wait->max : 0),
+            latency_format_ns(buf[3], sizeof(buf[3]), latency_histogram_percentile(hold, 50.0)),
+            latency_format_ns(buf[4], sizeof(buf[4]), latency_histogram_percentile(hold, 99.0)),
+            latency_format_ns(buf[5], sizeof(buf[5]), hold->total_count ? hold->max : 0));
+}
+
+/**
+ * @brief atexit handler printing every registered mutex
+ */
+static void report_all_at_exit(void) {
+    pthread_mutex_lock(&report_list_lock);
+    for (instrumented_mutex_t *mutex = report_list; mutex; mutex = mutex->next_reported) {
+        instrumented_mutex_report(mutex, stdout);
+    }
+    pthread_mutex_unlock(&report_list_lock);
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Initialize an instrumented mutex
+ * @param mutex The mutex to initialize
+ * @param name Label used in reports (must outlive the mutex)
+ * @return 0 on success, otherwise a pthread error code
+ */
+int instrumented_mutex_init(instrumented_mutex_t *mutex, const char *name) {
+    int result = pthread_mutex_init(&mutex->mutex, NULL);
+    if (result != 0) {
+        return result;
+    }
+
+    result = pthread_mutex_init(&mutex->registry_lock, NULL);
+    if (result != 0) {
+        pthread_mutex_destroy(&mutex->mutex);
+        return result;
+    }
+
+    mutex->name = name;
+    mutex->generation = __atomic_add_fetch(&generation_counter, 1, __ATOMIC_RELAXED);
+    mutex->acquired_at_ns = 0;
+    mutex->holder_stats = NULL;
+    mutex->thread_stats = NULL;
+    mutex->next_reported = NULL;
+    return 0;
+}
+
+/**
+ * @brief Destroy an instrumented mutex and free its statistics
+ * @return 0 on success, otherwise a pthread error code
+ */
+int instrumented_mutex_destroy(instrumented_mutex_t *mutex) {
+    int result = pthread_mutex_destroy(&mutex->mutex);
+    if (result != 0) {
+        return result;
+    }
+
+    // Never leave a dangling entry for the at-exit report
+    pthread_mutex_lock(&report_list_lock);
+    for (instrumented_mutex_t **link = &report_list; *link; link = &(*link)->next_reported) {
+        if (*link == mutex) {
+            *link = mutex->next_reported;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&report_list_lock);
+
+    lock_thread_stats_t *stats = mutex->thread_stats;
+    while (stats) {
+        lock_thread_stats_t *next = stats->next;
+        free(stats);
+        stats = next;
+    }
+    mutex->thread_stats = NULL;
+
+    return pthread_mutex_destroy(&mutex->registry_lock);
+}
+
+/**
+ * @brief Lock the mutex, recording wait time and contention
+ * @return 0 on success, otherwise a pthread error code
+ */
+int instrumented_mutex_lock(instrumented_mutex_t *mutex) {
+    // Look up stats before timing so first-use allocation is not counted
+    lock_thread_stats_t *stats = lookup_thread_stats(mutex);
+    long long start = now_ns();
+    int contended = 0;
+
+    int result = pthread_mutex_trylock(&mutex->mutex);
+    if (result == EBUSY) {
+        contended = 1;
+        result = pthread_mutex_lock(&mutex->mutex);
+    }
+    if (result != 0) {
+        return result;
+    }
+
+    long long acquired = now_ns();
+    mutex->acquired_at_ns = acquired;
+    mutex->holder_stats = stats;
+
+    if (stats) {
+        stats->acquisitions++;
+        stats->contended += (unsigned long)contended;
+        latency_histogram_record(&stats->wait_ns, (uint64_t)(acquired - start));
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Unlock the mutex, recording how long it was held
+ * @return 0 on success, otherwise a pthread error code
+ */
+int instrumented_mutex_unlock(instrumented_mutex_t *mutex) {
+    lock_thread_stats_t *stats = mutex->holder_stats;
+    long long acquired = mutex->acquired_at_ns;
+    long long released = now_ns();
+
+    mutex->holder_stats = NULL;
+    int result = pthread_mutex_unlock(&mutex->mutex);
+
+    // Stats belong to this thread, so record after releasing the lock
+    if (result == 0 && stats) {
+        latency_histogram_record(&stats->hold_ns, (uint64_t)(released - acquired));
+    }
+
+    return result;
+}
+
+/**
+ * @brief Set the label used for the calling thread in subsequent reports
+ * @note Only affects mutexes this thread has not locked yet
+ */
+void instrumented_mutex_set_thread_name(const char *name) {
+    snprintf(current_thread_name, sizeof(current_thread_name), "%s", name ? name : "");
+}
+
+/**
+ * @brief Print per-thread and total wait/hold statistics
+ * @param mutex The mutex to report on
+ * @param out Output stream
+ * @note Threads that use the mutex should have finished (or be quiescent),
+ *       since their histograms are read without synchronization
+ */
+void instrumented_mutex_report(instrumented_mutex_t *mutex, FILE *out) {
+    static latency_histogram_t total_wait;
+    static latency_histogram_t total_hold;
+    static pthread_mutex_t total_lock = PTHREAD_MUTEX_INITIALIZER;
+    unsigned long total_acquisitions = 0;
+    unsigned long total_contended = 0;
+
+    // The merged histograms are too large for the stack of small threads
+    pthread_mutex_lock(&total_lock);
+    latency_histogram_init(&total_wait);
+    latency_histogram_init(&total_hold);
+
+    fprintf(out, "\nLock statistics for %s:\n", mutex->name ? mutex->name : "(unnamed)");
+    fprintf(out, "  %-20s %9s %9s %11s %11s %11s %11s %11s %11s\n",
+            "thread", "acquires", "contended", "wait p50", "wait p99", "wait max",
+            "hold p50", "hold p99", "hold max");
+
+    pthread_mutex_lock(&mutex->registry_lock);
+    for (lock_thread_stats_t *stats = mutex->thread_stats; stats; stats = stats->next) {
+        print_stats_row(out, stats->thread_name, stats->acquisitions, stats->contended,
+                        &stats->wait_ns, &stats->hold_ns);
+        total_acquisitions += stats->acquisitions;
+        total_contended += stats->contended;
+        latency_histogram_merge(&total_wait, &stats->wait_ns);
+        latency_histogram_merge(&total_hold, &stats->hold_ns);
+    }
+    pthread_mutex_unlock(&mutex->registry_lock);
+
+    print_stats_row(out, "TOTAL", total_acquisitions, total_contended,
+                    &total_wait, &total_hold);
+    pthread_mutex_unlock(&total_lock);
+}
+
+/**
+ * @brief Print the mutex's report automatically when the process exits
+ * @return 0 on success, -1 if the exit handler could not be registered
+ * @note The mutex must not be destroyed before exit unless
+ *       instrumented_mutex_destroy() is used, which unregisters it
+ */
+int instrumented_mutex_report_at_exit(instrumented_mutex_t *mutex) {
+    pthread_mutex_lock(&report_list_lock);
+
+    if (!report_handler_registered) {
+        if (atexit(report_all_at_exit) != 0) {
+            pthread_mutex_unlock(&report_list_lock);
+            return -1;
+        }
+        report_handler_registered = 1;
+    }
+
+    for (instrumented_mutex_t *entry = report_list; entry; entry = entry->next_reported) {
+        if (entry == mutex) {
+            pthread_mutex_unlock(&report_list_lock);
+            return 0;
+        }
+    }
+
+    mutex->next_reported = report_list;
+    report_list = mutex;
+
+    pthread_mutex_unlock(&report_list_lock);
+    return 0;
+}
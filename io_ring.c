@@ -0,0 +1,214 @@
+/**
+ * @file io_ring.c
+ * @brief io_uring setup, submission and completion on raw system calls
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#define _GNU_SOURCE
+
+#include "io_ring.h"
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+/*============================================================================
+ * SYSTEM CALLS
+ *============================================================================*/
+
+static int sys_io_uring_setup(unsigned entries, struct io_uring_params *params) {
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                              unsigned flags) {
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+/*============================================================================
+ * SETUP
+ *============================================================================*/
+
+/**
+ * @brief Create an io_uring instance and map its rings
+ * @param entries Submission queue size (the kernel rounds it up to a power
+ *        of two); the completion queue is twice as large
+ * @return 0, or an errno code (ENOSYS/EPERM when io_uring is unavailable)
+ */
+int io_ring_init(io_ring_t *ring, unsigned entries) {
+    struct io_uring_params params;
+
+    memset(ring, 0, sizeof(*ring));
+    memset(&params, 0, sizeof(params));
+    ring->fd = sys_io_uring_setup(entries, &params);
+    if (ring->fd == -1) {
+        return errno;
+    }
+
+    ring->sq_map_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_map_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    int single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap && ring->cq_map_size > ring->sq_map_size) {
+        ring->sq_map_size = ring->cq_map_size;
+    }
+
+    ring->sq_map = mmap(NULL, ring->sq_map_size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+    if (ring->sq_map == MAP_FAILED) {
+        goto fail;
+    }
+    if (single_mmap) {
+        ring->cq_map = ring->sq_map;
+    } else {
+        ring->cq_map = mmap(NULL, ring->cq_map_size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+        if (ring->cq_map == MAP_FAILED) {
+            goto fail;
+        }
+    }
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        goto fail;
+    }
+
+    char *sq = ring->sq_map;
+    ring->sq_head = (unsigned *)(sq + params.sq_off.head);
+    ring->sq_tail = (unsigned *)(sq + params.sq_off.tail);
+    ring->sq_mask = *(unsigned *)(sq + params.sq_off.ring_mask);
+    ring->sq_entries = params.sq_entries;
+    ring->sq_array = (unsigned *)(sq + params.sq_off.array);
+    ring->sq_local_tail = *ring->sq_tail;
+
+    char *cq = ring->cq_map;
+    ring->cq_head = (unsigned *)(cq + params.cq_off.head);
+    ring->cq_tail = (unsigned *)(cq + params.cq_off.tail);
+    ring->cq_mask = *(unsigned *)(cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+    return 0;
+
+fail:;
+    int result = errno;
+    io_ring_destroy(ring);
+    return result;
+}
+
+/**
+ * @brief Unmap the rings and close the instance; in-flight requests are
+ *        cancelled by the kernel
+ */
+void io_ring_destroy(io_ring_t *ring) {
+    if (ring->sqes && ring->sqes != MAP_FAILED) {
+        munmap(ring->sqes, ring->sqes_size);
+    }
+    if (ring->cq_map && ring->cq_map != MAP_FAILED && ring->cq_map != ring->sq_map) {
+        munmap(ring->cq_map, ring->cq_map_size);
+    }
+    if (ring->sq_map && ring->sq_map != MAP_FAILED) {
+        munmap(ring->sq_map, ring->sq_map_size);
+    }
+    if (ring->fd >= 0) {
+        close(ring->fd);
+    }
+    memset(ring, 0, sizeof(*ring));
+    ring->fd = -1;
+}
+
+/*============================================================================
+ * SUBMISSION
+ *============================================================================*/
+
+/**
+ * @brief Next free submission entry, zeroed; it is submitted by the next
+ *        io_ring_submit_and_wait()
+ * @return NULL if the submission ring is full
+ */
+struct io_uring_sqe *io_ring_get_sqe(io_ring_t *ring) {
+    unsigned head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+
+    if (ring->sq_local_tail - head >= ring->sq_entries) {
+        return NULL;
+    }
+    unsigned index = ring->sq_local_tail & ring->sq_mask;
+    struct io_uring_sqe *sqe = &ring->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    ring->sq_array[index] = index;
+    ring->sq_local_tail++;
+    return sqe;
+}
+
+/**
+ * @brief Fill in a read/write-style request (IORING_OP_READ, IORING_OP_WRITE)
+ * @param offset File offset, or (uint64_t)-1 for the current position
+ */
+void io_ring_prep_rw(struct io_uring_sqe *sqe, int opcode, int fd, void *buffer,
+                     unsigned length, uint64_t offset, uint64_t user_data) {
+    sqe->opcode = (uint8_t)opcode;
+    sqe->fd = fd;
+    sqe->addr = (uint64_t)(uintptr_t)buffer;
+    sqe->len = length;
+    sqe->off = offset;
+    sqe->user_data = user_data;
+}
+
+/**
+ * @brief Fill in a one-shot poll for events (POLLIN etc.) on fd
+ */
+void io_ring_prep_poll(struct io_uring_sqe *sqe, int fd, unsigned events, uint64_t user_data) {
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->poll32_events = events;
+    sqe->user_data = user_data;
+}
+
+/**
+ * @brief Submit every queued entry and wait for completions, in one call
+ * @param wait_for Completions to wait for (0 only submits)
+ * @return 0, or an errno code
+ */
+int io_ring_submit_and_wait(io_ring_t *ring, unsigned wait_for) {
+    // Publish the filled entries before the kernel looks at the tail
+    __atomic_store_n(ring->sq_tail, ring->sq_local_tail, __ATOMIC_RELEASE);
+
+    for (;;) {
+        // Entries the kernel has not consumed yet, including any left over
+        unsigned to_submit = ring->sq_local_tail - __atomic_load_n(ring->sq_head,
+                                                                   __ATOMIC_ACQUIRE);
+        unsigned flags = wait_for > 0 ? IORING_ENTER_GETEVENTS : 0;
+        ring->enters++;
+        if (sys_io_uring_enter(ring->fd, to_submit, wait_for, flags) >= 0) {
+            return 0;
+        }
+        if (errno != EINTR) {
+            return errno;
+        }
+    }
+}
+
+/*============================================================================
+ * COMPLETION
+ *============================================================================*/
+
+/**
+ * @brief Oldest unconsumed completion, or NULL if there is none
+ */
+struct io_uring_cqe *io_ring_peek_cqe(io_ring_t *ring) {
+    unsigned head = *ring->cq_head;
+    unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+
+    if (head == tail) {
+        return NULL;
+    }
+    return &ring->cqes[head & ring->cq_mask];
+}
+
+/**
+ * @brief Consume the completion returned by io_ring_peek_cqe()
+ */
+void io_ring_cqe_seen(io_ring_t *ring) {
+    __atomic_store_n(ring->cq_head, *ring->cq_head + 1, __ATOMIC_RELEASE);
+}
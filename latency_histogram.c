@@ -0,0 +1,157 @@
+/**
+ * @file latency_histogram.c
+ * @brief HDR-style log-linear latency histogram implementation
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#include "latency_histogram.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*============================================================================
+ * BUCKET INDEXING
+ *============================================================================*/
+
+/**
+ * @brief Map a value to its bucket index
+ *
+ * Values below LATENCY_HISTOGRAM_SUB_BUCKETS get one bucket each. Larger
+ * values are bucketed by their highest set bit plus the next SUB_BITS bits.
+ */
+static size_t bucket_index(uint64_t value) {
+    if (value < LATENCY_HISTOGRAM_SUB_BUCKETS) {
+        return (size_t)value;
+    }
+
+    int exponent = 63 - __builtin_clzll(value);
+    int shift = exponent - LATENCY_HISTOGRAM_SUB_BITS;
+    size_t sub = (size_t)(value >> shift) & (LATENCY_HISTOGRAM_SUB_BUCKETS - 1);
+
+    return (size_t)(shift + 1) * LATENCY_HISTOGRAM_SUB_BUCKETS + sub;
+}
+
+/**
+ * @brief Highest value that maps to the given bucket
+ */
+static uint64_t bucket_upper_bound(size_t index) {
+    if (index < LATENCY_HISTOGRAM_SUB_BUCKETS) {
+        return (uint64_t)index;
+    }
+
+    int shift = (int)(index / LATENCY_HISTOGRAM_SUB_BUCKETS) - 1;
+    uint64_t sub = index % LATENCY_HISTOGRAM_SUB_BUCKETS;
+    uint64_t lower = ((uint64_t)LATENCY_HISTOGRAM_SUB_BUCKETS + sub) << shift;
+
+    return lower + (((uint64_t)1 << shift) - 1);
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Reset a histogram to empty
+ */
+void latency_histogram_init(latency_histogram_t *histogram) {
+    memset(histogram, 0, sizeof(*histogram));
+    histogram->min = UINT64_MAX;
+}
+
+/**
+ * @brief Record one value
+ */
+void latency_histogram_record(latency_histogram_t *histogram, uint64_t value) {
+    histogram->counts[bucket_index(value)]++;
+    histogram->total_count++;
+    histogram->sum += value;
+    if (value < histogram->min) {
+        histogram->min = value;
+    }
+    if (value > histogram->max) {
+        histogram->max = value;
+    }
+}
+
+/**
+ * @brief Add all values recorded in src to dest
+ */
+void latency_histogram_merge(latency_histogram_t *dest, const latency_histogram_t *src) {
+    for (size_t i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+        dest->counts[i] += src->counts[i];
+    }
+    dest->total_count += src->total_count;
+    dest->sum += src->sum;
+    if (src->min < dest->min) {
+        dest->min = src->min;
+    }
+    if (src->max > dest->max) {
+        dest->max = src->max;
+    }
+}
+
+/**
+ * @brief Value at the given percentile
+ * @param histogram The histogram to query
+ * @param percentile Percentile in the range [0, 100]
+ * @return Upper bound of the bucket holding the percentile (clamped to the
+ *         recorded maximum), or 0 for an empty histogram
+ */
+uint64_t latency_histogram_percentile(const latency_histogram_t *histogram, double percentile) {
+    if (histogram->total_count == 0) {
+        return 0;
+    }
+
+    if (percentile < 0.0) {
+        percentile = 0.0;
+    } else if (percentile > 100.0) {
+        percentile = 100.0;
+    }
+
+    uint64_t target = (uint64_t)((percentile / 100.0) * (double)histogram->total_count + 0.5);
+    if (target == 0) {
+        target = 1;
+    }
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < LATENCY_HISTOGRAM_BUCKETS; i++) {
+        seen += histogram->counts[i];
+        if (seen >= target) {
+            uint64_t value = bucket_upper_bound(i);
+            return value < histogram->max ? value : histogram->max;
+        }
+    }
+
+    return histogram->max;
+}
+
+/**
+ * @brief Arithmetic mean of the recorded values, 0.0 when empty
+ */
+double latency_histogram_mean(const latency_histogram_t *histogram) {
+    if (histogram->total_count == 0) {
+        return 0.0;
+    }
+    return (double)histogram->sum / (double)histogram->total_count;
+}
+
+/**
+ * @brief Format a nanosecond duration with a human-friendly unit
+ * @param buffer Destination buffer (LATENCY_FORMAT_SIZE bytes is enough)
+ * @param size Size of the destination buffer
+ * @param nanoseconds Duration to format
+ * @return buffer, for use directly in printf arguments
+ */
+const char *latency_format_ns(char *buffer, size_t size, uint64_t nanoseconds) {
+    if (nanoseconds < 1000ULL) {
+        snprintf(buffer, size, "%llu ns", (unsigned long long)nanoseconds);
+    } else if (nanoseconds < 1000000ULL) {
+        snprintf(buffer, size, "%.2f us", (double)nanoseconds / 1e3);
+    } else if (nanoseconds < 1000000000ULL) {
+        snprintf(buffer, size, "%.2f ms", (double)nanoseconds / 1e6);
+    } else {
+        snprintf(buffer, size, "%.2f s", (double)nanoseconds / 1e9);
+    }
+    return buffer;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file latency_histogram.h
+ * @brief HDR-style log-linear latency histogram
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * Values (normally nanoseconds) are recorded into buckets whose width grows
+ * with the magnitude of the value: every power of two is split into
+ * LATENCY_HISTOGRAM_SUB_BUCKETS linear sub-buckets. This keeps the relative
+ * error below 1 / LATENCY_HISTOGRAM_SUB_BUCKETS across the full 64-bit range
+ * with a fixed, allocation-free footprint, so recording is a handful of
+ * integer operations and a single increment.
+ *
+ * A histogram is not thread-safe; give each thread its own and merge them
+ * once the threads have finished.
+ */
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*============================================================================
+ * CONSTANTS
+ *============================================================================*/
+
+/** log2 of the number of linear sub-buckets per power of two */
+#define LATENCY_HISTOGRAM_SUB_BITS 4
+
+/** Number of linear sub-buckets per power of two */
+#define LATENCY_HISTOGRAM_SUB_BUCKETS (1 << LATENCY_HISTOGRAM_SUB_BITS)
+
+/** Total number of buckets needed to cover every uint64_t value */
+#define LATENCY_HISTOGRAM_BUCKETS \
+    ((64 - LATENCY_HISTOGRAM_SUB_BITS + 1) * LATENCY_HISTOGRAM_SUB_BUCKETS)
+
+/** Buffer size large enough for latency_format_ns() output */
+#define LATENCY_FORMAT_SIZE 32
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+/**
+ * @brief Log-linear histogram of recorded values
+ */
+typedef struct {
+    uint64_t counts[LATENCY_HISTOGRAM_BUCKETS];
+    uint64_t total_count;
+    uint64_t sum;
+    uint64_t min;
+    uint64_t max;
+} latency_histogram_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+void latency_histogram_init(latency_histogram_t *histogram);
+void latency_histogram_record(latency_histogram_t *histogram, uint64_t value);
+void latency_histogram_merge(latency_histogram_t *dest, const latency_histogram_t *src);
+uint64_t latency_histogram_percentile(const latency_histogram_t *histogram, double percentile);
+double latency_histogram_mean(const latency_histogram_t *histogram);
+const char *latency_format_ns(char *buffer, size_t size, uint64_t nanoseconds);
+
+#endif /* LATENCY_HISTOGRAM_H */
@@ -0,0 +1,202 @@
+/**
+ * @file launcher_bench.c
+ * @brief Process spawn latency and throughput: system() vs fork+execvp vs posix_spawn
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * Runs a trivial program (/bin/true) N times, one after another, with:
+ * - system():        /bin/sh -c, which then runs the program (the old
+ *                    safe_system_command()); recent glibc starts the shell
+ *                    with posix_spawn, so its extra cost is the shell itself
+ * - fork+execvp:     the demonstrate_exec_family() pattern; fork copies the
+ *                    caller's page tables before the child execs
+ * - posix_spawn:     launcher_run(); vfork semantics, nothing is copied
+ *
+ * Each spawn is timed from the call until the child has been reaped. The
+ * whole set is repeated after the parent has grown its resident set by
+ * rss_mb megabytes of touched memory, which is what makes fork expensive
+ * in large processes.
+ *
+ * Checks: every child exits with status 0.
+ *
+ * Usage: ./launcher_bench [spawns] [rss_mb]
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include "clock_ns.h"
+#include "command_launcher.h"
+#include "latency_histogram.h"
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+#define DEFAULT_SPAWNS 500L
+#define DEFAULT_RSS_MB 512L
+
+/** Program every method runs */
+#define SPAWN_PROGRAM "/bin/true"
+
+/**
+ * @brief One spawn method
+ */
+typedef struct {
+    const char *name;
+    int (*spawn)(void);         /**< Runs SPAWN_PROGRAM; raw wait status or -1 */
+} spawn_method_t;
+
+/*============================================================================
+ * SPAWN METHODS
+ *============================================================================*/
+
+static int spawn_system(void) {
+    return system(SPAWN_PROGRAM);
+}
+
+static int spawn_fork_execvp(void) {
+    char *args[] = { SPAWN_PROGRAM, NULL };
+
+    pid_t pid = fork();
+    if (pid == -1) {
+        return -1;
+    }
+    if (pid == 0) {
+        execvp(args[0], args);
+        _exit(127);
+    }
+
+    int status;
+    if (launcher_wait(pid, &status) != 0) {
+        return -1;
+    }
+    return status;
+}
+
+static int spawn_posix_spawn(void) {
+    char *args[] = { SPAWN_PROGRAM, NULL };
+    int status;
+
+    if (launcher_run(args, &status) != 0) {
+        return -1;
+    }
+    return status;
+}
+
+static const spawn_method_t spawn_methods[] = {
+    { "system()", spawn_system },
+    { "fork+execvp", spawn_fork_execvp },
+    { "posix_spawn", spawn_posix_spawn }
+};
+
+/*============================================================================
+ * BENCHMARK
+ *============================================================================*/
+
+/**
+ * @brief Run one method `spawns` times and print its row
+ * @return Number of spawns that failed or exited non-zero
+ */
+static long bench_method(const spawn_method_t *method, long spawns) {
+    latency_histogram_t histogram;
+    long failures = 0;
+
+    latency_histogram_init(&histogram);
+    long long start = now_ns();
+    for (long i = 0; i < spawns; i++) {
+        long long begin = now_ns();
+        int status = method->spawn();
+        latency_histogram_record(&histogram, (uint64_t)(now_ns() - begin));
+        if (status == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            failures++;
+        }
+    }
+    long long elapsed = now_ns() - start;
+
+    char p50[LATENCY_FORMAT_SIZE];
+    char p99[LATENCY_FORMAT_SIZE];
+    char mean[LATENCY_FORMAT_SIZE];
+    printf("%-14s %10.0f %10s %10s %10s  %s\n", method->name,
+           (double)spawns / ((double)elapsed / 1e9),
+           latency_format_ns(mean, sizeof(mean), (uint64_t)latency_histogram_mean(&histogram)),
+           latency_format_ns(p50, sizeof(p50), latency_histogram_percentile(&histogram, 50.0)),
+           latency_format_ns(p99, sizeof(p99), latency_histogram_percentile(&histogram, 99.0)),
+           failures == 0 ? "ok" : "FAILED");
+    return failures;
+}
+
+/**
+ * @brief Run every method at the current resident set size
+ */
+static long bench_all(long spawns, long extra_mb) {
+    long failures = 0;
+
+    printf("\nParent resident set: +%ld MB\n", extra_mb);
+    printf("%-14s %10s %10s %10s %10s  %s\n", "method", "spawns/s", "mean", "p50", "p99", "check");
+    for (size_t i = 0; i < sizeof(spawn_methods) / sizeof(spawn_methods[0]); i++) {
+        failures += bench_method(&spawn_methods[i], spawns);
+    }
+    return failures;
+}
+
+/*============================================================================
+ * MAIN FUNCTION
+ *============================================================================*/
+
+/**
+ * @brief Main function - runs every method with a small and a large parent
+ * @return EXIT_SUCCESS on success, EXIT_FAILURE on bad arguments, setup
+ *         failure or a failed spawn
+ */
+int main(int argc, char **argv) {
+    long spawns = DEFAULT_SPAWNS;
+    long rss_mb = DEFAULT_RSS_MB;
+
+    if (argc > 1) {
+        spawns = strtol(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        rss_mb = strtol(argv[2], NULL, 10);
+    }
+    if (spawns <= 0 || rss_mb < 0) {
+        fprintf(stderr, "Usage: %s [spawns > 0] [rss_mb >= 0]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    printf("========================================================\n");
+    printf("    PROCESS SPAWN BENCHMARK\n");
+    printf("========================================================\n");
+    printf("Program: %s, spawns per method: %ld, /bin/sh used by system()\n",
+           SPAWN_PROGRAM, spawns);
+
+    long failures = bench_all(spawns, 0);
+
+    if (rss_mb > 0) {
+        size_t bytes = (size_t)rss_mb << 20;
+        char *ballast = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ballast == MAP_FAILED) {
+            fprintf(stderr, "Failed to allocate %ld MB: %s\n", rss_mb, strerror(errno));
+            return EXIT_FAILURE;
+        }
+        // Small pages, as in a typical heap: huge pages would hide the page
+        // table copy that fork pays for
+        madvise(ballast, bytes, MADV_NOHUGEPAGE);
+        // Touch every page so it is resident and must be mapped by fork
+        memset(ballast, 1, bytes);
+        failures += bench_all(spawns, rss_mb);
+        munmap(ballast, bytes);
+    }
+
+    printf("\nCheck: %ld failed spawns: %s\n", failures, failures == 0 ? "ok" : "FAILED");
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,249 @@
+/**
+ * @file lock_batch_bench.c
+ * @brief Throughput of a mutex-protected counter against the flush batch K
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * Every thread runs N iterations of a little private work (a few xorshift
+ * steps) and must add each iteration's result to one shared total guarded
+ * by a mutex. The batch K decides how often the lock is taken:
+ * - K = 1:     lock, add, unlock every iteration
+ * - K > 1:     accumulate locally, lock only to flush every K iterations
+ * - whole:     take the lock once and hold it across the entire loop, as
+ *              the demos' increment_thread and simple_job_thread used to
+ *
+ * Reported per K: ns per iteration (wall time / N), total Mops/s, lock
+ * acquisitions, and a check that the shared total matches the sum of the
+ * threads' private totals.
+ *
+ * Usage: ./lock_batch_bench [threads] [iterations_per_thread] [K ...]
+ *        (K = 0 means "hold the lock for the whole loop")
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "clock_ns.h"
+#include "futex_sync.h"
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+#define DEFAULT_ITERATIONS 4000000L
+#define MAX_BENCH_THREADS 64
+#define MAX_BATCHES 32
+
+/** Batch sizes swept when none are given; 0 holds the lock throughout */
+static const long default_batches[] = { 1, 4, 16, 64, 256, 1024, 4096, 65536, 0 };
+
+/**
+ * @brief Per-thread results, padded so workers never share a line
+ */
+typedef struct {
+    int index;
+    unsigned long local_total;      /**< Sum of this thread's contributions */
+    long acquisitions;
+} __attribute__((aligned(64))) worker_t;
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+/** Shared total and its lock */
+static pthread_mutex_t total_mutex = PTHREAD_MUTEX_INITIALIZER;
+static unsigned long shared_total = 0;
+
+/** Run parameters, read-only while workers run */
+static long active_batch = 1;
+static long active_iterations = 0;
+static futex_start_gate_t start_gate;
+
+/*============================================================================
+ * UTILITY FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief One iteration of private work
+ */
+static inline unsigned long work_step(unsigned long *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state & 0xFF;
+}
+
+/*============================================================================
+ * THREAD FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Worker: wait for the common start, then work and flush
+ */
+static void *worker_thread(void *arg) {
+    worker_t *worker = (worker_t *)arg;
+    unsigned long state = 0x9E3779B97F4A7C15UL * (unsigned long)(worker->index + 1);
+    long iterations = active_iterations;
+    long batch = active_batch;
+    unsigned long local_total = 0;
+    long acquisitions = 0;
+
+    futex_start_gate_arrive(&start_gate);
+
+    if (batch == 0) {
+        pthread_mutex_lock(&total_mutex);
+        for (long i = 0; i < iterations; i++) {
+            unsigned long value = work_step(&state);
+            shared_total += value;
+            local_total += value;
+        }
+        pthread_mutex_unlock(&total_mutex);
+        acquisitions = 1;
+    } else {
+        unsigned long pending = 0;
+        long until_flush = batch;
+
+        for (long i = 0; i < iterations; i++) {
+            pending += work_step(&state);
+            if (--until_flush == 0) {
+                pthread_mutex_lock(&total_mutex);
+                shared_total += pending;
+                pthread_mutex_unlock(&total_mutex);
+                acquisitions++;
+                local_total += pending;
+                pending = 0;
+                until_flush = batch;
+            }
+        }
+
+        if (until_flush != batch) {
+            pthread_mutex_lock(&total_mutex);
+            shared_total += pending;
+            pthread_mutex_unlock(&total_mutex);
+            acquisitions++;
+            local_total += pending;
+        }
+    }
+
+    worker->local_total = local_total;
+    worker->acquisitions = acquisitions;
+    return NULL;
+}
+
+/**
+ * @brief Run one batch size
+ * @param[out] acquisitions Lock acquisitions across all threads
+ * @param[out] ok Non-zero if the shared total matches the private totals
+ * @return Wall time in nanoseconds
+ */
+static long long run_batch(long batch, int threads, long iterations,
+                           long *acquisitions, int *ok) {
+    pthread_t ids[MAX_BENCH_THREADS];
+    worker_t workers[MAX_BENCH_THREADS];
+
+    shared_total = 0;
+    active_batch = batch;
+    active_iterations = iterations;
+    futex_start_gate_init(&start_gate, (unsigned int)threads);
+
+    for (int i = 0; i < threads; i++) {
+        memset(&workers[i], 0, sizeof(workers[i]));
+        workers[i].index = i;
+        int result = pthread_create(&ids[i], NULL, worker_thread, &workers[i]);
+        if (result != 0) {
+            fprintf(stderr, "Failed to create thread %d: %s\n", i, strerror(result));
+            exit(EXIT_FAILURE); // The gate would never open
+        }
+    }
+
+    futex_latch_wait(&start_gate.ready);
+    long long start = now_ns();
+    futex_event_set(&start_gate.go);
+    for (int i = 0; i < threads; i++) {
+        pthread_join(ids[i], NULL);
+    }
+    long long elapsed = now_ns() - start;
+
+    unsigned long expected = 0;
+    *acquisitions = 0;
+    for (int i = 0; i < threads; i++) {
+        expected += workers[i].local_total;
+        *acquisitions += workers[i].acquisitions;
+    }
+    *ok = (shared_total == expected);
+    return elapsed;
+}
+
+/*============================================================================
+ * MAIN FUNCTION
+ *============================================================================*/
+
+/**
+ * @brief Main function - sweeps the batch sizes
+ * @return EXIT_SUCCESS on success, EXIT_FAILURE on bad arguments or if a
+ *         shared total did not match
+ */
+int main(int argc, char **argv) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int threads = cpus > 2 ? (int)cpus : 2;
+    long iterations = DEFAULT_ITERATIONS;
+    long batches[MAX_BATCHES];
+    int batch_count = 0;
+
+    if (argc > 1) {
+        threads = (int)strtol(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        iterations = strtol(argv[2], NULL, 10);
+    }
+    for (int i = 3; i < argc && batch_count < MAX_BATCHES; i++) {
+        batches[batch_count++] = strtol(argv[i], NULL, 10);
+    }
+    if (batch_count == 0) {
+        batch_count = (int)(sizeof(default_batches) / sizeof(default_batches[0]));
+        memcpy(batches, default_batches, sizeof(default_batches));
+    }
+
+    int valid = threads >= 1 && threads <= MAX_BENCH_THREADS && iterations > 0;
+    for (int i = 0; i < batch_count; i++) {
+        valid = valid && batches[i] >= 0;
+    }
+    if (!valid) {
+        fprintf(stderr, "Usage: %s [threads 1..%d] [iterations_per_thread > 0] [K >= 0 ...]\n",
+                argv[0], MAX_BENCH_THREADS);
+        return EXIT_FAILURE;
+    }
+
+    printf("========================================================\n");
+    printf("    LOCK FLUSH BATCH THROUGHPUT BENCHMARK\n");
+    printf("========================================================\n");
+    printf("Threads: %d, online CPUs: %ld, iterations per thread: %ld\n\n",
+           threads, cpus, iterations);
+    printf("%-10s %10s %10s %14s  %s\n", "K", "ns/iter", "Mops/s", "acquisitions", "check");
+
+    int failed = 0;
+    for (int i = 0; i < batch_count; i++) {
+        long acquisitions;
+        int ok;
+        long long elapsed = run_batch(batches[i], threads, iterations, &acquisitions, &ok);
+
+        char label[16];
+        if (batches[i] == 0) {
+            snprintf(label, sizeof(label), "whole");
+        } else {
+            snprintf(label, sizeof(label), "%ld", batches[i]);
+        }
+        printf("%-10s %10.2f %10.1f %14ld  %s\n", label,
+               (double)elapsed / (double)iterations,
+               (double)iterations * threads / ((double)elapsed / 1e3),
+               acquisitions, ok ? "ok" : "MISMATCH");
+        failed |= !ok;
+    }
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
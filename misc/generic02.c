@@ -1,12 +1,24 @@
+/*
+ * The jobs run calibrated work from workload.c in the repository root, so
+ * link it in. From the repository root:
+ *   gcc -o generic02 misc/generic02.c workload.c -lpthread
+ */
+
 #include <stdio.h>
 #include <stdlib.h>
 
 #include <pthread.h>
 
+#include "../workload.h"
+
+/* Each job runs this much calibrated CPU work instead of an empty loop */
+#define JOB_DURATION_MS 500
+
 typedef void *my_func_t (void *);
 void *thread_func(void *);
 
 pthread_mutex_t lock;
+workload_t job_work;
 
 
 int counter;
@@ -26,11 +38,18 @@ void main()
     goto done;
   }
 
+  if (workload_init(&job_work, WORKLOAD_CPU, 0) != 0)
+  {
+    printf("\n workload init failed\n");
+    goto done;
+  }
+
   pthread_create(&tid[0],NULL,func1[0],(void *)&i);
   pthread_create(&tid[1],NULL,func1[1],(void *)&i);
 
   pthread_join(tid[0],NULL);
   pthread_join(tid[1],NULL);
+  workload_destroy(&job_work);
 
 done:
   printf("Finish \n");
@@ -41,14 +60,11 @@ void *thread_func(void *a)
 {
     pthread_mutex_lock(&lock);
  // printf("I am Thread Func nik %d \n", *(int *)a);
-    unsigned long i = 0;
     counter += 1;
     printf("\n Job %d started\n", counter);
 
-    for(i=0; i<(0xFFFFFFFF);i++)
-    {
-     /* Do nothing just keep incrementing i */
-    };
+    /* An empty counting loop is deleted at -O2; this work is not */
+    workload_run_for(&job_work, JOB_DURATION_MS * 1000000LL);
 
     printf("\n Job %d finished\n", counter);
 
@@ -0,0 +1,314 @@
+/**
+ * @file numa_topology.c
+ * @brief NUMA topology discovery and placement helpers
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#define _GNU_SOURCE
+
+#include "numa_topology.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+/*============================================================================
+ * CONSTANTS AND GLOBAL STATE
+ *============================================================================*/
+
+#define SYSFS_NODE_DIR "/sys/devices/system/node"
+
+/** Longest cpulist / online line we expect to parse */
+#define LIST_BUFFER_SIZE 4096
+
+static numa_topology_t process_topology;
+static pthread_once_t process_topology_once = PTHREAD_ONCE_INIT;
+
+/*============================================================================
+ * PARSING HELPERS
+ *============================================================================*/
+
+/**
+ * @brief Read the first line of a small sysfs file
+ * @return 0 on success, -1 if the file could not be read
+ */
+static int read_sysfs_line(const char *path, char *buffer, size_t size) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        return -1;
+    }
+
+    char *line = fgets(buffer, (int)size, file);
+    fclose(file);
+    if (!line) {
+        return -1;
+    }
+
+    buffer[strcspn(buffer, "\n")] = '\0';
+    return 0;
+}
+
+/**
+ * @brief Parse a kernel list such as "0-3,8,10-11"
+ * @param list The list text
+ * @param callback Invoked once per listed number
+ * @param context Passed through to callback
+ * @return 0 on success, -1 on malformed input
+ */
+static int parse_list(const char *list, void (*callback)(long value, void *context),
+                      void *context) {
+    const char *cursor = list;
+
+    while (*cursor != '\0') {
+        char *end;
+        long first = strtol(cursor, &end, 10);
+        if (end == cursor || first < 0) {
+            return -1;
+        }
+
+        long last = first;
+        if (*end == '-') {
+            cursor = end + 1;
+            last = strtol(cursor, &end, 10);
+            if (end == cursor || last < first) {
+                return -1;
+            }
+        }
+
+        for (long value = first; value <= last; value++) {
+            callback(value, context);
+        }
+
+        cursor = end;
+        if (*cursor == ',') {
+            cursor++;
+        } else if (*cursor != '\0') {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief parse_list callback adding a CPU to a cpu_set_t
+ */
+static void add_cpu(long cpu, void *context) {
+    if (cpu < CPU_SETSIZE) {
+        CPU_SET((int)cpu, (cpu_set_t *)context);
+    }
+}
+
+/**
+ * @brief parse_list callback collecting node ids
+ */
+typedef struct {
+    int ids[NUMA_MAX_NODES];
+    int count;
+} node_id_list_t;
+
+static void add_node_id(long node, void *context) {
+    node_id_list_t *list = (node_id_list_t *)context;
+    if (list->count < NUMA_MAX_NODES) {
+        list->ids[list->count++] = (int)node;
+    }
+}
+
+/**
+ * @brief Single-node topology holding every allowed CPU
+ */
+static void fallback_topology(numa_topology_t *topology, const cpu_set_t *allowed) {
+    memset(topology, 0, sizeof(*topology));
+    topology->node_count = 1;
+    topology->from_sysfs = 0;
+    topology->nodes[0].id = 0;
+    topology->nodes[0].cpus = *allowed;
+    topology->nodes[0].cpu_count = CPU_COUNT(allowed);
+}
+
+/**
+ * @brief pthread_once initializer for numa_topology_get()
+ */
+static void discover_process_topology(void) {
+    numa_topology_discover(&process_topology);
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Discover the NUMA nodes usable by this process
+ * @param topology Receives the topology (always valid afterwards)
+ * @return 0 if sysfs was used, -1 if the single-node fallback was used
+ */
+int numa_topology_discover(numa_topology_t *topology) {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        for (long cpu = 0; cpu < cpus && cpu < CPU_SETSIZE; cpu++) {
+            CPU_SET((int)cpu, &allowed);
+        }
+    }
+
+    char buffer[LIST_BUFFER_SIZE];
+    node_id_list_t node_ids = { { 0 }, 0 };
+    if (read_sysfs_line(SYSFS_NODE_DIR "/online", buffer, sizeof(buffer)) != 0 ||
+        parse_list(buffer, add_node_id, &node_ids) != 0 || node_ids.count == 0) {
+        fallback_topology(topology, &allowed);
+        return -1;
+    }
+
+    memset(topology, 0, sizeof(*topology));
+    for (int i = 0; i < node_ids.count; i++) {
+        char path[128];
+        cpu_set_t node_cpus;
+
+        snprintf(path, sizeof(path), SYSFS_NODE_DIR "/node%d/cpulist", node_ids.ids[i]);
+        CPU_ZERO(&node_cpus);
+        if (read_sysfs_line(path, buffer, sizeof(buffer)) != 0 ||
+            parse_list(buffer, add_cpu, &node_cpus) != 0) {
+            continue;
+        }
+
+        numa_node_t *node = &topology->nodes[topology->node_count];
+        CPU_AND(&node->cpus, &node_cpus, &allowed);
+        node->cpu_count = CPU_COUNT(&node->cpus);
+        if (node->cpu_count == 0) {
+            continue; // Memory-only node or not allowed for this process
+        }
+        node->id = node_ids.ids[i];
+        topology->node_count++;
+    }
+
+    if (topology->node_count == 0) {
+        fallback_topology(topology, &allowed);
+        return -1;
+    }
+
+    topology->from_sysfs = 1;
+    return 0;
+}
+
+/**
+ * @brief Process-wide topology, discovered on first use
+ */
+const numa_topology_t *numa_topology_get(void) {
+    pthread_once(&process_topology_once, discover_process_topology);
+    return &process_topology;
+}
+
+/**
+ * @brief Node index (into topology->nodes) for the given worker
+ *
+ * Workers are spread round-robin so consecutive workers land on
+ * different nodes and every node's memory bandwidth is used.
+ */
+int numa_topology_node_for_worker(const numa_topology_t *topology, int worker_index) {
+    if (worker_index < 0) {
+        worker_index = -worker_index;
+    }
+    return worker_index % topology->node_count;
+}
+
+/**
+ * @brief Restrict the calling thread to the CPUs of one node
+ * @param topology The topology
+ * @param node_index Index into topology->nodes (not the kernel node id)
+ * @return 0 on success, otherwise an error number
+ */
+int numa_topology_pin_to_node(const numa_topology_t *topology, int node_index) {
+    if (node_index < 0 || node_index >= topology->node_count) {
+        return EINVAL;
+    }
+
+    // pid 0 applies the mask to the calling thread only
+    if (sched_setaffinity(0, sizeof(cpu_set_t), &topology->nodes[node_index].cpus) != 0) {
+        return errno;
+    }
+    return 0;
+}
+
+/**
+ * @brief Node index of the CPU the calling thread is running on
+ * @return Index into topology->nodes, or -1 if unknown
+ */
+int numa_topology_current_node(const numa_topology_t *topology) {
+    int cpu = sched_getcpu();
+    if (cpu < 0) {
+        return -1;
+    }
+
+    for (int i = 0; i < topology->node_count; i++) {
+        if (CPU_ISSET(cpu, &topology->nodes[i].cpus)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Print the topology, one line per node
+ */
+void numa_topology_print(const numa_topology_t *topology) {
+    printf("NUMA topology: %d node(s)%s\n", topology->node_count,
+           topology->from_sysfs ? "" : " (sysfs unavailable, single-node fallback)");
+
+    for (int i = 0; i < topology->node_count; i++) {
+        const numa_node_t *node = &topology->nodes[i];
+        printf("  node%d: %d CPU(s):", node->id, node->cpu_count);
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &node->cpus)) {
+                printf(" %d", cpu);
+            }
+        }
+        printf("\n");
+    }
+}
+
+/**
+ * @brief Allocate memory and fault every page in from the calling thread
+ * @param size Number of bytes
+ * @return Zeroed memory, or NULL on failure. With the default policy its
+ *         pages are on the node the thread ran on while touching them
+ * @note Release with numa_topology_free() using the same size
+ */
+void *numa_topology_alloc_local(size_t size) {
+    if (size == 0) {
+        return NULL;
+    }
+
+    void *memory = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        return NULL;
+    }
+
+    // Fresh anonymous pages are zero; writing one byte per page faults each
+    // page in (normally on this CPU's node) without changing its contents
+    long page_size = sysconf(_SC_PAGESIZE);
+    if (page_size <= 0) {
+        page_size = 4096;
+    }
+    volatile unsigned char *bytes = memory;
+    for (size_t offset = 0; offset < size; offset += (size_t)page_size) {
+        bytes[offset] = 0;
+    }
+
+    return memory;
+}
+
+/**
+ * @brief Free memory from numa_topology_alloc_local()
+ */
+void numa_topology_free(void *memory, size_t size) {
+    if (memory) {
+        munmap(memory, size);
+    }
+}
@@ -0,0 +1,72 @@
+/**
+ * @file numa_topology.h
+ * @brief NUMA topology discovery, thread pinning and first-touch allocation
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * Discovers the NUMA nodes from /sys/devices/system/node without libnuma:
+ * - Node ids come from /sys/devices/system/node/online
+ * - Each node's CPUs come from nodeN/cpulist, restricted to the CPUs this
+ *   process may run on (sched_getaffinity), so containers and taskset work
+ * - Memory-only nodes (no usable CPUs) are skipped
+ *
+ * Without sysfs the topology degrades to a single node holding every allowed
+ * CPU, so callers never need a separate non-NUMA code path.
+ *
+ * Under the default memory policy Linux places an anonymous page on the
+ * node of the CPU that first writes it. numa_topology_alloc_local() writes
+ * every page once from the calling thread, so the pages land on whichever
+ * node that thread runs on at the time; pin it first to pick the node.
+ * This is a request, not a guarantee: a non-default policy (numactl
+ * --membind/--interleave), a node short of free memory, or later migration
+ * (automatic NUMA balancing, swap) can place pages elsewhere, and nothing
+ * here checks where they end up.
+ *
+ * cpu_set_t requires _GNU_SOURCE to be defined before any system header.
+ */
+
+#ifndef NUMA_TOPOLOGY_H
+#define NUMA_TOPOLOGY_H
+
+#include <stddef.h>
+#include <sched.h>
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+/** Maximum number of nodes tracked */
+#define NUMA_MAX_NODES 64
+
+/**
+ * @brief One NUMA node with at least one usable CPU
+ */
+typedef struct {
+    int id;             /**< Kernel node id (nodeN) */
+    int cpu_count;      /**< Number of usable CPUs */
+    cpu_set_t cpus;     /**< Usable CPUs on this node */
+} numa_node_t;
+
+/**
+ * @brief Discovered machine topology
+ */
+typedef struct {
+    int node_count;                     /**< Always >= 1 after discovery */
+    int from_sysfs;                     /**< 0 if the single-node fallback was used */
+    numa_node_t nodes[NUMA_MAX_NODES];
+} numa_topology_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+int numa_topology_discover(numa_topology_t *topology);
+const numa_topology_t *numa_topology_get(void);
+int numa_topology_node_for_worker(const numa_topology_t *topology, int worker_index);
+int numa_topology_pin_to_node(const numa_topology_t *topology, int node_index);
+int numa_topology_current_node(const numa_topology_t *topology);
+void numa_topology_print(const numa_topology_t *topology);
+void *numa_topology_alloc_local(size_t size);
+void numa_topology_free(void *memory, size_t size);
+
+#endif /* NUMA_TOPOLOGY_H */
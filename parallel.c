@@ -0,0 +1,358 @@
+/**
+ * @file parallel.c
+ * @brief parallel_for / parallel_reduce implementation
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#define _GNU_SOURCE
+
+#include "parallel.h"
+#include "numa_topology.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+/** Upper bound on the team size */
+#define MAX_PARALLEL_THREADS 256
+
+/** Partial results are padded to this size to avoid false sharing */
+#define PARTIAL_ALIGNMENT 64
+
+/** Default number of chunks per thread for dynamic/guided schedules */
+#define DEFAULT_CHUNKS_PER_THREAD 16
+
+/**
+ * @brief State shared by all members of one parallel_for/parallel_reduce call
+ */
+typedef struct {
+    parallel_range_t range;
+    long grain;
+    parallel_schedule_t schedule;
+    int num_threads;
+    const numa_topology_t *topology;    /**< Non-NULL when pinning members to nodes */
+
+    /** Next unclaimed index for DYNAMIC and GUIDED, on its own cache line */
+    long next __attribute__((aligned(PARTIAL_ALIGNMENT)));
+
+    parallel_for_fn for_body __attribute__((aligned(PARTIAL_ALIGNMENT)));
+    parallel_reduce_fn reduce_body;
+    void *context;
+    unsigned char *partials;
+    size_t partial_stride;
+    const void *identity;
+    size_t result_size;
+} team_t;
+
+/**
+ * @brief Argument of one spawned team member
+ */
+typedef struct {
+    team_t *team;
+    int index;
+} worker_arg_t;
+
+/*============================================================================
+ * WORKER FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Run the body on one chunk
+ */
+static void run_chunk(team_t *team, int index, long begin, long end) {
+    if (team->reduce_body) {
+        team->reduce_body(begin, end, team->partials + (size_t)index * team->partial_stride,
+                          team->context);
+    } else {
+        team->for_body(begin, end, team->context);
+    }
+}
+
+/**
+ * @brief Claim and run chunks as team member `index` until the range is done
+ */
+static void run_member(team_t *team, int index) {
+    const long end = team->range.end;
+    const long grain = team->grain;
+
+    if (team->topology) {
+        numa_topology_pin_to_node(team->topology,
+                                  numa_topology_node_for_worker(team->topology, index));
+    }
+
+    // Initialize our own partial so its first touch happens on our node
+    if (team->reduce_body) {
+        memcpy(team->partials + (size_t)index * team->partial_stride,
+               team->identity, team->result_size);
+    }
+
+    switch (team->schedule) {
+        case PARALLEL_SCHEDULE_STATIC: {
+            const long stride = grain * team->num_threads;
+            long begin = team->range.begin + grain * index;
+            while (begin < end) {
+                run_chunk(team, index, begin, end - begin > grain ? begin + grain : end);
+                if (end - begin <= stride) {
+                    break;
+                }
+                begin += stride;
+            }
+            break;
+        }
+
+        case PARALLEL_SCHEDULE_DYNAMIC:
+            for (;;) {
+                long begin = __atomic_fetch_add(&team->next, grain, __ATOMIC_RELAXED);
+                if (begin >= end) {
+                    break;
+                }
+                run_chunk(team, index, begin, end - begin > grain ? begin + grain : end);
+            }
+            break;
+
+        case PARALLEL_SCHEDULE_GUIDED:
+            for (;;) {
+                long begin = __atomic_load_n(&team->next, __ATOMIC_RELAXED);
+                long chunk;
+                do {
+                    if (begin >= end) {
+                        return;
+                    }
+                    long remaining = end - begin;
+                    chunk = remaining / (2L * team->num_threads);
+                    if (chunk < grain) {
+                        chunk = grain;
+                    }
+                    if (chunk > remaining) {
+                        chunk = remaining;
+                    }
+                } while (!__atomic_compare_exchange_n(&team->next, &begin, begin + chunk, 0,
+                                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+                run_chunk(team, index, begin, begin + chunk);
+            }
+            break;
+    }
+}
+
+/**
+ * @brief pthread entry point for spawned team members
+ */
+static void *worker_thread(void *arg) {
+    worker_arg_t *worker = (worker_arg_t *)arg;
+    run_member(worker->team, worker->index);
+    return NULL;
+}
+
+/*============================================================================
+ * TEAM MANAGEMENT
+ *============================================================================*/
+
+/**
+ * @brief Work out team size and grain for a call
+ * @return 0 on success, EINVAL for an unknown schedule
+ */
+static int setup_team(team_t *team, parallel_range_t range, long grain,
+                      const parallel_options_t *options) {
+    long count = range.end - range.begin;
+    int threads = options && options->num_threads > 0 ? options->num_threads
+                                                     : parallel_default_threads();
+    parallel_schedule_t schedule = options ? options->schedule : PARALLEL_SCHEDULE_STATIC;
+
+    if (schedule != PARALLEL_SCHEDULE_STATIC && schedule != PARALLEL_SCHEDULE_DYNAMIC &&
+        schedule != PARALLEL_SCHEDULE_GUIDED) {
+        return EINVAL;
+    }
+    if (threads > MAX_PARALLEL_THREADS) {
+        threads = MAX_PARALLEL_THREADS;
+    }
+
+    if (grain <= 0) {
+        long chunks = schedule == PARALLEL_SCHEDULE_STATIC
+                          ? threads : (long)threads * DEFAULT_CHUNKS_PER_THREAD;
+        grain = (count + chunks - 1) / chunks;
+        if (grain < 1) {
+            grain = 1;
+        }
+    }
+
+    // Never start more threads than there are chunks
+    long chunks = count / grain + (count % grain != 0);
+    if (chunks < threads) {
+        threads = chunks > 0 ? (int)chunks : 1;
+    }
+
+    memset(team, 0, sizeof(*team));
+    team->range = range;
+    team->grain = grain;
+    team->schedule = schedule;
+    team->num_threads = threads;
+    team->next = range.begin;
+    if (options && options->numa_placement) {
+        team->topology = numa_topology_get();
+    }
+    return 0;
+}
+
+/**
+ * @brief Run every team member to completion
+ *
+ * The calling thread is member 0. If a worker cannot be spawned, the caller
+ * runs that member's share itself, so the range is always fully processed.
+ */
+static void run_team(team_t *team) {
+    pthread_t threads[MAX_PARALLEL_THREADS];
+    worker_arg_t args[MAX_PARALLEL_THREADS];
+    int spawned = 0;
+    cpu_set_t caller_affinity;
+    int restore_affinity = team->topology &&
+        sched_getaffinity(0, sizeof(caller_affinity), &caller_affinity) == 0;
+
+    for (int i = 1; i < team->num_threads; i++) {
+        args[i].team = team;
+        args[i].index = i;
+        if (pthread_create(&threads[i], NULL, worker_thread, &args[i]) != 0) {
+            break;
+        }
+        spawned = i;
+    }
+
+    for (int i = 0; i < team->num_threads; i++) {
+        if (i == 0 || i > spawned) {
+            run_member(team, i);
+        }
+    }
+
+    for (int i = 1; i <= spawned; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    if (restore_affinity) {
+        sched_setaffinity(0, sizeof(caller_affinity), &caller_affinity);
+    }
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Number of threads used when options do not specify one
+ */
+int parallel_default_threads(void) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < 1) {
+        return 1;
+    }
+    return cpus > MAX_PARALLEL_THREADS ? MAX_PARALLEL_THREADS : (int)cpus;
+}
+
+/**
+ * @brief Human-readable schedule name
+ */
+const char *parallel_schedule_name(parallel_schedule_t schedule) {
+    switch (schedule) {
+        case PARALLEL_SCHEDULE_STATIC:  return "static";
+        case PARALLEL_SCHEDULE_DYNAMIC: return "dynamic";
+        case PARALLEL_SCHEDULE_GUIDED:  return "guided";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Run body over [range.begin, range.end) in parallel
+ * @param range Index range to process
+ * @param grain Chunk size (minimum chunk size for GUIDED); <= 0 picks a default
+ * @param body Called with disjoint sub-ranges that together cover the range
+ * @param context Passed through to body
+ * @param options Team size and schedule, or NULL for defaults (static)
+ * @return 0 on success, EINVAL on invalid arguments
+ */
+int parallel_for(parallel_range_t range, long grain, parallel_for_fn body,
+                 void *context, const parallel_options_t *options) {
+    if (!body || range.end < range.begin) {
+        return EINVAL;
+    }
+    if (range.end == range.begin) {
+        return 0;
+    }
+
+    team_t team;
+    int result = setup_team(&team, range, grain, options);
+    if (result != 0) {
+        return result;
+    }
+    team.for_body = body;
+    team.context = context;
+
+    run_team(&team);
+    return 0;
+}
+
+/**
+ * @brief Reduce [range.begin, range.end) in parallel
+ * @param range Index range to process
+ * @param grain Chunk size (minimum chunk size for GUIDED); <= 0 picks a default
+ * @param result Receives the combined value (result_size bytes)
+ * @param result_size Size of one partial result
+ * @param identity Initial value of every thread's partial result
+ * @param body Folds a sub-range into the calling thread's partial result
+ * @param combine Merges two partial results
+ * @param context Passed through to body and combine
+ * @param options Team size and schedule, or NULL for defaults (static)
+ * @return 0 on success, EINVAL on invalid arguments, ENOMEM on allocation failure
+ */
+int parallel_reduce(parallel_range_t range, long grain, void *result,
+                    size_t result_size, const void *identity,
+                    parallel_reduce_fn body, parallel_combine_fn combine,
+                    void *context, const parallel_options_t *options) {
+    if (!result || result_size == 0 || !identity || !body || !combine ||
+        range.end < range.begin) {
+        return EINVAL;
+    }
+    if (range.end == range.begin) {
+        memcpy(result, identity, result_size);
+        return 0;
+    }
+
+    team_t team;
+    int status = setup_team(&team, range, grain, options);
+    if (status != 0) {
+        return status;
+    }
+
+    // Page-sized partials when pinning, so each can be placed on its own node
+    size_t alignment = PARTIAL_ALIGNMENT;
+    if (team.topology) {
+        long page_size = sysconf(_SC_PAGESIZE);
+        alignment = page_size > PARTIAL_ALIGNMENT ? (size_t)page_size : PARTIAL_ALIGNMENT;
+    }
+    size_t stride = (result_size + alignment - 1) / alignment * alignment;
+    void *partials = NULL;
+    if (posix_memalign(&partials, alignment, stride * (size_t)team.num_threads) != 0) {
+        return ENOMEM;
+    }
+
+    team.reduce_body = body;
+    team.context = context;
+    team.partials = partials;
+    team.partial_stride = stride;
+    team.identity = identity;
+    team.result_size = result_size;
+
+    run_team(&team);
+
+    memcpy(result, partials, result_size);
+    for (int i = 1; i < team.num_threads; i++) {
+        combine(result, (unsigned char *)partials + (size_t)i * stride, context);
+    }
+
+    free(partials);
+    return 0;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file parallel.h
+ * @brief parallel_for / parallel_reduce over POSIX threads
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * Splits an index range [begin, end) into chunks and runs them on a team of
+ * threads (the calling thread is one member of the team). Three chunking
+ * schedules are available, mirroring OpenMP:
+ * - STATIC:  chunks of `grain` indices dealt round-robin to the threads up
+ *            front; no shared state, best for uniform work
+ * - DYNAMIC: threads grab the next `grain` indices from a shared atomic
+ *            cursor; balances irregular work at one atomic per chunk
+ * - GUIDED:  like DYNAMIC but chunks start at remaining / (2 * threads) and
+ *            shrink towards `grain`; fewer grabs for the same balance
+ *
+ * parallel_reduce gives every thread a private, cache-line padded partial
+ * result initialized from an identity value, then combines the partials on
+ * the calling thread, so the body never touches shared state.
+ *
+ * With numa_placement set, team member i is pinned to NUMA node
+ * i % node_count and first-touches its own partial, which is then padded to
+ * a full page so it lands on that node. The calling thread's CPU affinity is
+ * restored before returning.
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <stddef.h>
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+/** Chunk scheduling policy */
+typedef enum {
+    PARALLEL_SCHEDULE_STATIC = 0,
+    PARALLEL_SCHEDULE_DYNAMIC = 1,
+    PARALLEL_SCHEDULE_GUIDED = 2
+} parallel_schedule_t;
+
+/** Half-open index range [begin, end) */
+typedef struct {
+    long begin;
+    long end;
+} parallel_range_t;
+
+/** Team configuration; pass NULL for all defaults */
+typedef struct {
+    int num_threads;                /**< <= 0 means one per online CPU */
+    parallel_schedule_t schedule;   /**< Chunking policy */
+    int numa_placement;             /**< Non-zero pins members round-robin to nodes */
+} parallel_options_t;
+
+/** Loop body: process indices [begin, end) */
+typedef void (*parallel_for_fn)(long begin, long end, void *context);
+
+/** Reduction body: fold indices [begin, end) into this thread's partial */
+typedef void (*parallel_reduce_fn)(long begin, long end, void *partial, void *context);
+
+/** Combine src into dest; must be associative and commutative */
+typedef void (*parallel_combine_fn)(void *dest, const void *src, void *context);
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+int parallel_for(parallel_range_t range, long grain, parallel_for_fn body,
+                 void *context, const parallel_options_t *options);
+
+int parallel_reduce(parallel_range_t range, long grain, void *result,
+                    size_t result_size, const void *identity,
+                    parallel_reduce_fn body, parallel_combine_fn combine,
+                    void *context, const parallel_options_t *options);
+
+int parallel_default_threads(void);
+const char *parallel_schedule_name(parallel_schedule_t schedule);
+
+#endif /* PARALLEL_H */
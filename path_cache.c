@@ -0,0 +1,421 @@
+/**
+ * @file path_cache.c
+ * @brief PATH search with a name cache validated by PATH and directory mtimes
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#define _GNU_SOURCE
+
+#include "path_cache.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+/**
+ * @brief A PATH directory and the state it had when the cache was filled
+ */
+typedef struct {
+    char *path;                 /**< "." for an empty PATH element */
+    int exists;
+    struct timespec mtime;
+} path_dir_t;
+
+/**
+ * @brief Cached result for one name
+ */
+typedef struct path_entry {
+    struct path_entry *next;
+    uint32_t hash;
+    char *name;
+    char *resolved;             /**< NULL if the name was not found */
+    int dir_index;              /**< Directory it was found in, -1 if not found */
+} path_entry_t;
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+static pthread_mutex_t cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** PATH the directory list was built from; NULL before the first lookup */
+static char *cached_path = NULL;
+static path_dir_t *dirs = NULL;
+static int dir_count = 0;
+
+/** A directory changed too recently for its mtime to prove it unchanged */
+static int racy = 0;
+
+/** PATH has relative or empty elements, which resolve against the cwd */
+static int relative_dirs = 0;
+
+/** Working directory the relative elements were resolved in (0/0: none) */
+static dev_t cwd_dev = 0;
+static ino_t cwd_ino = 0;
+
+static path_entry_t *buckets[PATH_CACHE_BUCKETS];
+static path_cache_stats_t stats;
+
+/*============================================================================
+ * UTILITY FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief FNV-1a hash of a name
+ */
+static uint32_t hash_name(const char *name) {
+    uint32_t hash = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)name; *p; p++) {
+        hash ^= *p;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Whether path names an executable regular file
+ */
+static int is_executable(const char *path) {
+    struct stat st;
+    return stat(path, &st) == 0 && S_ISREG(st.st_mode) && access(path, X_OK) == 0;
+}
+
+/**
+ * @brief Copy a result out, or report that it does not fit
+ */
+static int copy_result(const char *path, char *resolved, size_t size) {
+    size_t length = strlen(path);
+    if (length + 1 > size) {
+        return ENAMETOOLONG;
+    }
+    memcpy(resolved, path, length + 1);
+    return 0;
+}
+
+/*============================================================================
+ * CACHE MAINTENANCE (cache_mutex held)
+ *============================================================================*/
+
+static void drop_entries(void) {
+    for (int i = 0; i < PATH_CACHE_BUCKETS; i++) {
+        path_entry_t *entry = buckets[i];
+        while (entry) {
+            path_entry_t *next = entry->next;
+            free(entry->name);
+            free(entry->resolved);
+            free(entry);
+            entry = next;
+        }
+        buckets[i] = NULL;
+    }
+    stats.entries = 0;
+}
+
+static void drop_dirs(void) {
+    for (int i = 0; i < dir_count; i++) {
+        free(dirs[i].path);
+    }
+    free(dirs);
+    dirs = NULL;
+    dir_count = 0;
+    free(cached_path);
+    cached_path = NULL;
+    relative_dirs = 0;
+    cwd_dev = 0;
+    cwd_ino = 0;
+}
+
+/**
+ * @brief Record which directory "." is now
+ * @return Non-zero if it is not the one recorded before
+ */
+static int refresh_cwd(void) {
+    struct stat st;
+    dev_t dev = 0;
+    ino_t ino = 0;
+
+    if (stat(".", &st) == 0) {
+        dev = st.st_dev;
+        ino = st.st_ino;
+    }
+    int changed = dev != cwd_dev || ino != cwd_ino;
+    cwd_dev = dev;
+    cwd_ino = ino;
+    return changed;
+}
+
+/**
+ * @brief Record the current state of a directory
+ * @return Non-zero if it differs from what was recorded before
+ */
+static int refresh_dir(path_dir_t *dir) {
+    struct stat st;
+    int exists = stat(dir->path, &st) == 0;
+    struct timespec mtime = { 0, 0 };
+
+    if (exists) {
+        mtime = st.st_mtim;
+    }
+    int changed = exists != dir->exists || mtime.tv_sec != dir->mtime.tv_sec ||
+                  mtime.tv_nsec != dir->mtime.tv_nsec;
+    dir->exists = exists;
+    dir->mtime = mtime;
+    return changed;
+}
+
+/**
+ * @brief Split PATH into directories and record their state
+ */
+static int build_dirs(const char *path) {
+    cached_path = strdup(path);
+    if (!cached_path) {
+        return ENOMEM;
+    }
+
+    int count = 1;
+    for (const char *p = path; *p; p++) {
+        count += (*p == ':');
+    }
+    dirs = calloc((size_t)count, sizeof(path_dir_t));
+    if (!dirs) {
+        return ENOMEM;
+    }
+
+    const char *start = path;
+    for (int i = 0; i < count; i++) {
+        const char *end = strchr(start, ':');
+        size_t length = end ? (size_t)(end - start) : strlen(start);
+
+        dirs[i].path = length ? strndup(start, length) : strdup(".");
+        if (!dirs[i].path) {
+            return ENOMEM;
+        }
+        relative_dirs |= dirs[i].path[0] != '/';
+        dir_count++;
+        refresh_dir(&dirs[i]);
+        start = end ? end + 1 : start + length;
+    }
+    if (relative_dirs) {
+        refresh_cwd();
+    }
+    return 0;
+}
+
+/**
+ * @brief Whether any directory was modified within PATH_CACHE_RACY_SECONDS
+ */
+static int dirs_racy(void) {
+    struct timespec now;
+
+    // Timestamps come from the coarse clock; it never runs ahead of this one
+    clock_gettime(CLOCK_REALTIME, &now);
+    for (int i = 0; i < dir_count; i++) {
+        if (dirs[i].exists && dirs[i].mtime.tv_sec >= now.tv_sec - PATH_CACHE_RACY_SECONDS) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Make the cache match the current PATH (and working directory)
+ *
+ * Directory states are checked separately, by refresh_dirs(), only as far
+ * as the answer being looked up depends on them.
+ */
+static int validate_path(void) {
+    const char *path = getenv("PATH");
+    if (!path) {
+        path = PATH_CACHE_DEFAULT_PATH;
+    }
+
+    if (!cached_path || strcmp(path, cached_path) != 0) {
+        if (cached_path) {
+            stats.invalidations++;
+        }
+        drop_entries();
+        drop_dirs();
+        int result = build_dirs(path);
+        if (result != 0) {
+            drop_dirs();
+        }
+        return result;
+    }
+
+    // After chdir() a relative element names another directory
+    if (relative_dirs && refresh_cwd()) {
+        stats.invalidations++;
+        drop_entries();
+    }
+    return 0;
+}
+
+/**
+ * @brief Check the first count directories, dropping the cache on a change
+ * @return Non-zero if the cache was dropped
+ *
+ * Every entry was made with all directories freshly recorded, and any
+ * change seen later drops every entry, so a directory's recorded state is
+ * the one each cached answer was based on.
+ */
+static int refresh_dirs(int count) {
+    int changed = 0;
+    for (int i = 0; i < count; i++) {
+        changed |= refresh_dir(&dirs[i]);
+    }
+    if (changed) {
+        stats.invalidations++;
+        drop_entries();
+    }
+    return changed;
+}
+
+/**
+ * @brief Search the directories for name
+ * @param[out] found Malloc'd path, or NULL if not found
+ * @param[out] index Directory it was found in, or -1
+ * @return 0 or ENOMEM
+ */
+static int search_dirs(const char *name, char **found, int *index) {
+    char candidate[PATH_MAX];
+
+    *found = NULL;
+    *index = -1;
+    for (int i = 0; i < dir_count; i++) {
+        if (!dirs[i].exists) {
+            continue;
+        }
+        int length = snprintf(candidate, sizeof(candidate), "%s/%s", dirs[i].path, name);
+        if (length < 0 || (size_t)length >= sizeof(candidate)) {
+            continue;
+        }
+        if (is_executable(candidate)) {
+            *index = i;
+            *found = strdup(candidate);
+            return *found ? 0 : ENOMEM;
+        }
+    }
+    return 0;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Find an executable the way `which` would
+ * @param name Program name; a name containing '/' is checked as given
+ * @param resolved Receives the path of the executable
+ * @param size Size of resolved
+ * @return 0, ENOENT if there is no such executable, ENAMETOOLONG if
+ *         resolved is too small, EINVAL or ENOMEM
+ */
+int path_lookup(const char *name, char *resolved, size_t size) {
+    if (!name || !*name || !resolved || size == 0) {
+        return EINVAL;
+    }
+    if (strchr(name, '/')) {
+        return is_executable(name) ? copy_result(name, resolved, size) : ENOENT;
+    }
+
+    uint32_t hash = hash_name(name);
+    int result;
+
+    pthread_mutex_lock(&cache_mutex);
+    stats.lookups++;
+
+    result = validate_path();
+    if (result != 0) {
+        pthread_mutex_unlock(&cache_mutex);
+        return result;
+    }
+
+    path_entry_t **bucket = &buckets[hash % PATH_CACHE_BUCKETS];
+    path_entry_t *entry = *bucket;
+    while (entry && (entry->hash != hash || strcmp(entry->name, name) != 0)) {
+        entry = entry->next;
+    }
+
+    // A hit depends only on the directories up to the one it was found in:
+    // a later one cannot change the answer. A "not found" depends on all.
+    if (entry && refresh_dirs(entry->resolved ? entry->dir_index + 1 : dir_count)) {
+        entry = NULL;
+    }
+    if (entry) {
+        stats.hits++;
+        result = entry->resolved ? copy_result(entry->resolved, resolved, size) : ENOENT;
+        pthread_mutex_unlock(&cache_mutex);
+        return result;
+    }
+
+    stats.misses++;
+    refresh_dirs(dir_count);
+    racy = dirs_racy();
+    char *found;
+    int index;
+    result = search_dirs(name, &found, &index);
+    if (result == 0 && racy) {
+        // The answer may already be stale without the mtime showing it
+        stats.uncached++;
+    } else if (result == 0) {
+        entry = calloc(1, sizeof(path_entry_t));
+        if (entry) {
+            entry->name = strdup(name);
+        }
+        if (!entry || !entry->name) {
+            free(entry);
+            result = ENOMEM;
+        } else {
+            entry->hash = hash;
+            entry->dir_index = index;
+            entry->resolved = found ? strdup(found) : NULL;
+            if (found && !entry->resolved) {
+                free(entry->name);
+                free(entry);
+                result = ENOMEM;
+            } else {
+                entry->next = *bucket;
+                *bucket = entry;
+                stats.entries++;
+            }
+        }
+    }
+    pthread_mutex_unlock(&cache_mutex);
+
+    if (result == 0) {
+        result = found ? copy_result(found, resolved, size) : ENOENT;
+    }
+    free(found);
+    return result;
+}
+
+/**
+ * @brief Forget every cached result and directory state
+ */
+void path_cache_flush(void) {
+    pthread_mutex_lock(&cache_mutex);
+    drop_entries();
+    drop_dirs();
+    pthread_mutex_unlock(&cache_mutex);
+}
+
+/**
+ * @brief Snapshot the cache counters
+ */
+void path_cache_stats(path_cache_stats_t *out) {
+    pthread_mutex_lock(&cache_mutex);
+    *out = stats;
+    pthread_mutex_unlock(&cache_mutex);
+}
@@ -0,0 +1,74 @@
+/**
+ * @file path_cache.h
+ * @brief In-process executable lookup in PATH with a validated cache
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * path_lookup() does what `which` does (first executable regular file named
+ * `name` in the PATH directories) without starting a process. Results,
+ * including "not found", are cached per name.
+ *
+ * The cache is keyed by the PATH contents and the modification times of
+ * the PATH directories: adding, removing or renaming a file changes its
+ * directory's mtime. Every lookup compares PATH with the cached copy, then
+ * stats the directories its answer depends on: for a name that was found,
+ * those up to and including the one it was found in (a later directory
+ * cannot change the answer); for "not found", all of them. On any
+ * difference the whole cache is dropped. A hit on a name found in the
+ * k-th directory therefore costs k stat() calls and no process.
+ *
+ * Relative and empty PATH elements (an empty one means ".") are searched
+ * like execvp does, relative to the current working directory. When PATH
+ * has any, the working directory's device and inode are part of the key,
+ * so a chdir() drops the cache as well.
+ *
+ * Directory timestamps are coarse (a clock tick, or a second or more on
+ * some filesystems), so a change right after the last look could leave the
+ * mtime unchanged. While any directory was modified within the last
+ * PATH_CACHE_RACY_SECONDS, lookups therefore search without caching.
+ *
+ * Changing the permissions or contents of an existing file does not touch
+ * the directory, so such changes are only seen after path_cache_flush().
+ *
+ * Thread-safe. All functions return 0 or an errno code.
+ */
+
+#ifndef PATH_CACHE_H
+#define PATH_CACHE_H
+
+#include <stddef.h>
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+/** Search path used when PATH is unset (as execvp does) */
+#define PATH_CACHE_DEFAULT_PATH "/bin:/usr/bin"
+
+/** Directories modified more recently than this are not trusted for caching */
+#define PATH_CACHE_RACY_SECONDS 2
+
+/** Hash buckets of the name cache */
+#define PATH_CACHE_BUCKETS 64
+
+/**
+ * @brief Counters, for reports
+ */
+typedef struct {
+    unsigned long lookups;
+    unsigned long hits;             /**< Answered from the cache */
+    unsigned long misses;           /**< Answered by searching the directories */
+    unsigned long uncached;         /**< Misses not cached: a directory was too new */
+    unsigned long invalidations;    /**< Times the cache was dropped as stale */
+    unsigned long entries;          /**< Names currently cached */
+} path_cache_stats_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+int path_lookup(const char *name, char *resolved, size_t size);
+void path_cache_flush(void);
+void path_cache_stats(path_cache_stats_t *stats);
+
+#endif /* PATH_CACHE_H */
@@ -0,0 +1,241 @@
+/**
+ * @file path_cache_bench.c
+ * @brief Locating an executable: `which` subprocess vs in-process PATH lookup
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * Resolves the same program name with:
+ * - which:     `which NAME` spawned and its output captured (the demos'
+ *              old approach, minus the shell some of them added)
+ * - uncached:  path_lookup() after path_cache_flush(), i.e. a full search
+ *              of the PATH directories
+ * - cached:    path_lookup() answered from the cache
+ *
+ * Checks: all three agree, and the cache notices an executable appearing
+ * in and disappearing from a PATH directory: the directory is backdated
+ * past PATH_CACHE_RACY_SECONDS after each change, so answers are cached
+ * (a repeat lookup must be a hit) and only the mtime change drops them.
+ *
+ * Usage: ./path_cache_bench [name] [lookups]
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#include "clock_ns.h"
+#include "command_launcher.h"
+#include "path_cache.h"
+
+/*============================================================================
+ * CONSTANTS
+ *============================================================================*/
+
+#define DEFAULT_NAME "ls"
+#define DEFAULT_LOOKUPS 100000L
+
+/** `which` is much slower; run it this many times fewer */
+#define WHICH_DIVISOR 500
+
+#define PROBE_NAME "path_cache_bench_probe"
+
+/*============================================================================
+ * UTILITY FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Resolve name with a `which` subprocess
+ * @return 0 if found, with the path (newline stripped) in resolved
+ */
+static int which_lookup(const char *name, char *resolved, size_t size) {
+    char *argv[] = { "which", (char *)name, NULL };
+    launcher_output_t output;
+    int status;
+
+    int result = launcher_capture(argv, LAUNCHER_CAPTURE_PIPE, &output, &status);
+    if (result == 0 && (!WIFEXITED(status) || WEXITSTATUS(status) != 0)) {
+        result = ENOENT;
+    }
+    if (result == 0) {
+        char *newline = memchr(output.data, '\n', output.length);
+        if (newline) {
+            *newline = '\0';
+        }
+        snprintf(resolved, size, "%s", output.data);
+    }
+    launcher_output_free(&output);
+    return result;
+}
+
+static void print_row(const char *method, long count, long long elapsed, const char *path) {
+    printf("%-10s %10ld %14.2f  %s\n", method, count,
+           (double)elapsed / (double)count / 1e3, path);
+}
+
+/*============================================================================
+ * INVALIDATION CHECK
+ *============================================================================*/
+
+/**
+ * @brief Set a directory's mtime to some seconds in the past
+ *
+ * A directory modified within PATH_CACHE_RACY_SECONDS is not trusted for
+ * caching, so every change made here is backdated to let the cache keep
+ * results and prove that the mtime change alone invalidates them.
+ */
+static void backdate(const char *dir, int seconds) {
+    struct timespec times[2];
+    clock_gettime(CLOCK_REALTIME, &times[0]);
+    times[0].tv_sec -= seconds;
+    times[1] = times[0];
+    utimensat(AT_FDCWD, dir, times, 0);
+}
+
+/**
+ * @brief Look name up and check the answer and how it was reached
+ * @param expect 0 if name must resolve to path, ENOENT if it must not resolve
+ * @param hits, invalidations Expected increase of those counters
+ * @return Non-zero if anything differs
+ */
+static int expect_lookup(const char *path, int expect, unsigned long hits,
+                         unsigned long invalidations) {
+    path_cache_stats_t before, after;
+    char found[PATH_MAX];
+
+    path_cache_stats(&before);
+    int result = path_lookup(PROBE_NAME, found, sizeof(found));
+    path_cache_stats(&after);
+    return result != expect || (expect == 0 && strcmp(found, path) != 0) ||
+           after.hits - before.hits != hits ||
+           after.invalidations - before.invalidations != invalidations;
+}
+
+/**
+ * @brief Add and remove an executable in a PATH directory
+ * @return Non-zero if the cache missed a change or never cached an answer
+ */
+static int check_invalidation(void) {
+    char dir[] = "/tmp/path_cache_bench.XXXXXX";
+    char probe[PATH_MAX];
+    char new_path[8192];
+    char found[PATH_MAX];
+    int failed = 0;
+
+    if (!mkdtemp(dir)) {
+        fprintf(stderr, "mkdtemp failed: %s\n", strerror(errno));
+        return 1;
+    }
+    backdate(dir, 60);
+    const char *old_path = getenv("PATH");
+    char *saved_path = old_path ? strdup(old_path) : NULL;
+    snprintf(new_path, sizeof(new_path), "%s:%s", dir, old_path ? old_path : "");
+    setenv("PATH", new_path, 1);
+    snprintf(probe, sizeof(probe), "%s/%s", dir, PROBE_NAME);
+
+    // Not there yet: searched once (PATH changed), then answered from the cache
+    path_lookup(PROBE_NAME, found, sizeof(found));
+    failed |= expect_lookup(probe, ENOENT, 1, 0);
+
+    FILE *file = fopen(probe, "w");
+    if (file) {
+        fclose(file);
+        chmod(probe, 0755);
+    }
+    backdate(dir, 50);
+    failed |= expect_lookup(probe, 0, 0, 1);
+    failed |= expect_lookup(probe, 0, 1, 0);
+
+    unlink(probe);
+    backdate(dir, 40);
+    failed |= expect_lookup(probe, ENOENT, 0, 1);
+    failed |= expect_lookup(probe, ENOENT, 1, 0);
+
+    rmdir(dir);
+    if (saved_path) {
+        setenv("PATH", saved_path, 1);
+        free(saved_path);
+    } else {
+        unsetenv("PATH");
+    }
+    failed |= path_lookup(PROBE_NAME, found, sizeof(found)) != ENOENT;
+    return failed;
+}
+
+/*============================================================================
+ * MAIN FUNCTION
+ *============================================================================*/
+
+/**
+ * @brief Main function - times the three lookups and checks invalidation
+ * @return EXIT_SUCCESS on success, EXIT_FAILURE on bad arguments, a name
+ *         that cannot be found, disagreeing results or a stale cache
+ */
+int main(int argc, char **argv) {
+    const char *name = DEFAULT_NAME;
+    long lookups = DEFAULT_LOOKUPS;
+
+    if (argc > 1) {
+        name = argv[1];
+    }
+    if (argc > 2) {
+        lookups = strtol(argv[2], NULL, 10);
+    }
+    if (!*name || strchr(name, '/') || lookups < WHICH_DIVISOR) {
+        fprintf(stderr, "Usage: %s [name without '/'] [lookups >= %d]\n", argv[0], WHICH_DIVISOR);
+        return EXIT_FAILURE;
+    }
+
+    char which_path[PATH_MAX] = "";
+    char uncached_path[PATH_MAX] = "";
+    char cached_path[PATH_MAX] = "";
+    long which_count = lookups / WHICH_DIVISOR;
+    int failed = 0;
+
+    printf("========================================================\n");
+    printf("    PATH LOOKUP BENCHMARK\n");
+    printf("========================================================\n");
+    printf("Name: %s\n\n", name);
+    printf("%-10s %10s %14s  %s\n", "method", "lookups", "us/lookup", "result");
+
+    long long start = now_ns();
+    for (long i = 0; i < which_count; i++) {
+        failed |= which_lookup(name, which_path, sizeof(which_path)) != 0;
+    }
+    print_row("which", which_count, now_ns() - start, which_path);
+
+    start = now_ns();
+    for (long i = 0; i < lookups; i++) {
+        path_cache_flush();
+        failed |= path_lookup(name, uncached_path, sizeof(uncached_path)) != 0;
+    }
+    print_row("uncached", lookups, now_ns() - start, uncached_path);
+
+    path_cache_flush();
+    start = now_ns();
+    for (long i = 0; i < lookups; i++) {
+        failed |= path_lookup(name, cached_path, sizeof(cached_path)) != 0;
+    }
+    print_row("cached", lookups, now_ns() - start, cached_path);
+
+    path_cache_stats_t stats;
+    path_cache_stats(&stats);
+    printf("\nCache: %lu lookups, %lu hits, %lu misses (%lu not cached), %lu invalidations\n",
+           stats.lookups, stats.hits, stats.misses, stats.uncached, stats.invalidations);
+
+    int agree = !failed && strcmp(which_path, uncached_path) == 0 &&
+                strcmp(uncached_path, cached_path) == 0;
+    int stale = check_invalidation();
+    printf("\nCheck: results %s, add/remove in PATH %s: %s\n",
+           agree ? "agree" : "DISAGREE", stale ? "MISSED" : "seen",
+           agree && !stale ? "ok" : "FAILED");
+    return agree && !stale ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,248 @@
+/**
+ * @file pipeline_bench.c
+ * @brief Pipelines through `sh -c` vs spawned directly, and stopping early
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * Part 1 captures the output of the same pipeline, run either way:
+ * - shell:    `sh -c "LINE"` (what popen(LINE) does)
+ * - direct:   pipeline_parse() + pipeline_capture(), stages connected with
+ *             pipe2() and spawned without a shell
+ *
+ * Part 2 runs `PRODUCER | head -n 1`, where the producer (this program
+ * re-executed with --producer) writes one line, then stays silent for a
+ * while before exiting. head is done after the first line; without
+ * stop_early the pipeline still lasts as long as the producer, with it the
+ * producer is sent SIGPIPE as soon as head exits.
+ *
+ * Checks: both ways capture the same bytes; stop_early returns well before
+ * the producer's delay and the producer ended by SIGPIPE.
+ *
+ * Usage: ./pipeline_bench [runs] [producer delay ms]
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "clock_ns.h"
+#include "command_launcher.h"
+#include "command_pipeline.h"
+
+/*============================================================================
+ * CONSTANTS
+ *============================================================================*/
+
+#define DEFAULT_RUNS 200L
+#define DEFAULT_DELAY_MS 300L
+
+static const char *const pipelines[] = {
+    "echo pipeline | cat",
+    "seq 1 20000 | grep 7 | wc -l",
+    // Shaped like the demo's `ps aux | head`, but with output that does not
+    // change between runs, so the two ways can be compared byte for byte
+    "seq 1 50000 | sort -rn | head -n 10"
+};
+
+#define NUM_PIPELINES ((int)(sizeof(pipelines) / sizeof(pipelines[0])))
+
+/*============================================================================
+ * UTILITY FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Producer stage: one line, a silent delay, one more line
+ */
+static int produce(long delay_ms) {
+    struct timespec delay = { delay_ms / 1000, (delay_ms % 1000) * 1000000L };
+
+    printf("first line\n");
+    fflush(stdout);
+    nanosleep(&delay, NULL);
+    printf("second line\n");
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Capture a pipeline through the shell or directly
+ * @return 0 if it ran and its last stage exited with status 0
+ */
+static int capture(const char *line, int direct, launcher_output_t *output) {
+    int status;
+    int result;
+
+    if (direct) {
+        pipeline_t pipeline;
+        result = pipeline_parse(&pipeline, line, 0);
+        if (result != 0) {
+            memset(output, 0, sizeof(*output));
+            return result;
+        }
+        result = pipeline_capture(&pipeline, output, &status);
+        pipeline_release(&pipeline);
+    } else {
+        char *argv[] = { "sh", "-c", (char *)line, NULL };
+        result = launcher_capture(argv, LAUNCHER_CAPTURE_PIPE, output, &status);
+    }
+    if (result == 0 && (!WIFEXITED(status) || WEXITSTATUS(status) != 0)) {
+        result = ECHILD;
+    }
+    return result;
+}
+
+/**
+ * @brief Average microseconds per capture
+ * @return Negative if a capture failed
+ */
+static double time_captures(const char *line, int direct, long runs) {
+    launcher_output_t output;
+
+    long long start = now_ns();
+    for (long i = 0; i < runs; i++) {
+        int result = capture(line, direct, &output);
+        launcher_output_free(&output);
+        if (result != 0) {
+            return -1.0;
+        }
+    }
+    return (double)(now_ns() - start) / (double)runs / 1e3;
+}
+
+/**
+ * @brief Whether both ways capture the same bytes
+ */
+static int outputs_match(const char *line) {
+    launcher_output_t shell;
+    launcher_output_t direct;
+
+    int failed = capture(line, 0, &shell) != 0;
+    failed |= capture(line, 1, &direct) != 0;
+    int same = !failed && shell.length == direct.length &&
+               memcmp(shell.data, direct.data, shell.length) == 0;
+    launcher_output_free(&shell);
+    launcher_output_free(&direct);
+    return same;
+}
+
+/**
+ * @brief Run PRODUCER | head -n 1 and time it
+ * @param[out] producer_status Raw wait status of the producer
+ * @return Milliseconds, or negative on failure
+ */
+static double time_early_exit(char **producer, int stop_early, int *producer_status) {
+    char *head[] = { "head", "-n", "1", NULL };
+    launcher_output_t output;
+    pipeline_t pipeline;
+    int status;
+
+    pipeline_init(&pipeline, stop_early);
+    pipeline_add(&pipeline, producer);
+    pipeline_add(&pipeline, head);
+
+    long long start = now_ns();
+    int result = pipeline_capture(&pipeline, &output, &status);
+    double elapsed_ms = (double)(now_ns() - start) / 1e6;
+
+    int ok = result == 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0 &&
+             strcmp(output.data, "first line\n") == 0;
+    launcher_output_free(&output);
+    *producer_status = pipeline.statuses[0];
+    return ok ? elapsed_ms : -1.0;
+}
+
+static const char *describe_status(int status, char *buffer, size_t size) {
+    if (WIFSIGNALED(status)) {
+        snprintf(buffer, size, "killed by %s", strsignal(WTERMSIG(status)));
+    } else {
+        snprintf(buffer, size, "exited with %d", WEXITSTATUS(status));
+    }
+    return buffer;
+}
+
+/*============================================================================
+ * MAIN FUNCTION
+ *============================================================================*/
+
+/**
+ * @brief Main function - compares shell and direct pipelines, then stop_early
+ * @return EXIT_SUCCESS on success, EXIT_FAILURE on bad arguments or a
+ *         failed check
+ */
+int main(int argc, char **argv) {
+    long runs = DEFAULT_RUNS;
+    long delay_ms = DEFAULT_DELAY_MS;
+
+    if (argc == 3 && strcmp(argv[1], "--producer") == 0) {
+        return produce(strtol(argv[2], NULL, 10));
+    }
+    if (argc > 1) {
+        runs = strtol(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        delay_ms = strtol(argv[2], NULL, 10);
+    }
+    if (runs < 1 || delay_ms < 10) {
+        fprintf(stderr, "Usage: %s [runs >= 1] [producer delay ms >= 10]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    char self[512];
+    ssize_t self_length = readlink("/proc/self/exe", self, sizeof(self) - 1);
+    if (self_length <= 0) {
+        fprintf(stderr, "Failed to resolve /proc/self/exe: %s\n", strerror(errno));
+        return EXIT_FAILURE;
+    }
+    self[self_length] = '\0';
+
+    printf("========================================================\n");
+    printf("    PIPELINE BENCHMARK\n");
+    printf("========================================================\n");
+    printf("Runs per pipeline: %ld\n\n", runs);
+    printf("%-36s %11s %12s %7s\n", "pipeline", "shell (us)", "direct (us)", "output");
+
+    int failed = 0;
+    for (int i = 0; i < NUM_PIPELINES; i++) {
+        double shell_us = time_captures(pipelines[i], 0, runs);
+        double direct_us = time_captures(pipelines[i], 1, runs);
+        int same = outputs_match(pipelines[i]);
+
+        if (shell_us < 0 || direct_us < 0) {
+            printf("%-36s failed to run\n", pipelines[i]);
+            failed = 1;
+            continue;
+        }
+        printf("%-36s %11.1f %12.1f %7s\n", pipelines[i], shell_us, direct_us,
+               same ? "same" : "DIFFERS");
+        failed |= !same;
+    }
+
+    char delay_arg[32];
+    snprintf(delay_arg, sizeof(delay_arg), "%ld", delay_ms);
+    char *producer[] = { self, "--producer", delay_arg, NULL };
+    int waited_status;
+    int stopped_status;
+    char waited_text[64];
+    char stopped_text[64];
+
+    printf("\nproducer (silent for %ld ms) | head -n 1\n", delay_ms);
+    double waited_ms = time_early_exit(producer, 0, &waited_status);
+    double stopped_ms = time_early_exit(producer, 1, &stopped_status);
+    printf("%-14s %10.2f ms  producer %s\n", "wait for all", waited_ms,
+           describe_status(waited_status, waited_text, sizeof(waited_text)));
+    printf("%-14s %10.2f ms  producer %s\n", "stop_early", stopped_ms,
+           describe_status(stopped_status, stopped_text, sizeof(stopped_text)));
+
+    int early_ok = waited_ms >= 0 && stopped_ms >= 0 && stopped_ms < (double)delay_ms / 2 &&
+                   WIFSIGNALED(stopped_status) && WTERMSIG(stopped_status) == SIGPIPE;
+    printf("\nCheck: outputs %s, stop_early %s: %s\n", failed ? "DIFFER" : "match",
+           early_ok ? "returned early" : "DID NOT return early",
+           !failed && early_ok ? "ok" : "FAILED");
+    return !failed && early_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -15,14 +15,51 @@
  * - Thread 1: Increments the counter in a loop
  * - Thread 2: Decrements the counter in a loop
  * Both threads use mutex locks to ensure thread-safe access to the shared counter.
+ *
+ * A monitor thread reports progress from a seqlock-protected snapshot of the
+ * counter state, so it never has to wait for the writer's mutex.
+ *
+ * The mutex is instrumented: wait time, hold time and contention of every
+ * acquisition are reported per thread when the program cleans up.
+ *
+ * Progress output from the counter loops goes through the asynchronous
+ * logger, so the thread holding the mutex only queues a binary record.
+ *
+ * Finally the same counter computation is repeated as a parallel_reduce,
+ * which reaches the same final value without serializing on the mutex, and
+ * as a producer/consumer pipeline: the increment side sends its updates
+ * through an SPSC ring and the decrement side, the counter's only owner,
+ * applies them, so no update ever takes a lock.
+ *
+ * With ENABLE_NUMA_PLACEMENT, workers are pinned round-robin to NUMA nodes
+ * before they allocate anything, so pages they touch first are normally
+ * placed on their node.
+ *
+ * Workers finish their setup and then wait at a futex start gate, so both
+ * are released at the same moment instead of staggered by pthread_create.
+ *
+ * The counter itself is a C11 atomic (atomic_counter.h) rather than a
+ * volatile long, so reads outside the mutex are well defined.
  */
 
+#define _GNU_SOURCE
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <pthread.h>
 #include <unistd.h>
 #include <errno.h>
 #include <string.h>
+#include <time.h>
+
+#include "async_logger.h"
+#include "atomic_counter.h"
+#include "futex_sync.h"
+#include "instrumented_mutex.h"
+#include "numa_topology.h"
+#include "parallel.h"
+#include "seqlock.h"
+#include "spsc_ring.h"
 
 /*============================================================================
  * CONSTANTS AND CONFIGURATION
@@ -34,33 +71,94 @@
 /** Number of worker threads */
 #define NUM_THREADS 2
 
+/** Pin worker threads to NUMA nodes (round-robin by thread id) */
+#define ENABLE_NUMA_PLACEMENT 1
+
+/** Publish the counter state every (mask + 1) loop iterations */
+#define STATE_PUBLISH_MASK 0xFFFF
+
+/** Interval between monitor thread reports in milliseconds */
+#define MONITOR_INTERVAL_MS 50
+
+/** Chunk size for the parallel reduction of the counter computation */
+#define REDUCE_GRAIN 0x10000L
+
+/** Repeat the computation as a producer/consumer pipeline over an SPSC ring */
+#define ENABLE_SPSC_PIPELINE 1
+
+/** Slots in the pipeline ring (rounded up to a power of two) */
+#define PIPELINE_RING_CAPACITY 4096
+
 /** Thread identifiers for better tracking */
 typedef enum {
     THREAD_INCREMENT = 0,
     THREAD_DECREMENT = 1
 } thread_id_t;
 
+/**
+ * @brief Consistent view of the counter state for reporter threads
+ */
+typedef struct {
+    long counter;           /**< Value of shared_counter when published */
+    long iteration;         /**< Loop iteration of the writing thread */
+    int progress_percent;   /**< Writer's progress through its loop */
+    int writer;             /**< thread_id_t of the last writer, -1 if none */
+} counter_snapshot_t;
+
+/**
+ * @brief Counter update sent from the producer to the consumer of the pipeline
+ */
+typedef struct {
+    long delta;             /**< Amount to add to the counter */
+    long iteration;         /**< Producer loop iteration, -1 for the initial update */
+} counter_message_t;
+
+/**
+ * @brief Seqlock-protected counter state
+ */
+typedef struct {
+    seqlock_t lock;
+    counter_snapshot_t data;
+} counter_state_t;
+
 /*============================================================================
  * GLOBAL VARIABLES
  *============================================================================*/
 
 /**
  * @brief Shared counter variable accessed by multiple threads
- * @note Protected by mutex lock to ensure thread safety
+ * @note Updated under counter_mutex; atomic so that every access, including
+ *       reads outside the lock, is free of data races
  */
-static volatile long shared_counter = 0;
+static atomic_counter_t shared_counter = ATOMIC_COUNTER_INITIALIZER(0);
 
 /**
  * @brief Mutex lock for protecting shared resources
  * @note Must be initialized before use and destroyed after use
  */
-static pthread_mutex_t counter_mutex;
+static instrumented_mutex_t counter_mutex;
 
 /**
  * @brief Flag to indicate if mutex was successfully initialized
  */
 static int mutex_initialized = 0;
 
+/**
+ * @brief Counter state published for lock-free readers
+ * @note Written under counter_mutex, read without it via the seqlock
+ */
+static counter_state_t counter_state = { SEQLOCK_INITIALIZER, { 0, 0, 0, -1 } };
+
+/**
+ * @brief Releases all workers together once each has finished its setup
+ */
+static futex_start_gate_t start_gate;
+
+/**
+ * @brief Set while the monitor thread should keep reporting
+ */
+static int monitor_running = 0;
+
 /*============================================================================
  * FUNCTION PROTOTYPES
  *============================================================================*/
@@ -69,9 +167,19 @@ typedef void *(*thread_function_t)(void *);
 
 static void *increment_thread_function(void *arg);
 static void *decrement_thread_function(void *arg);
+static void *monitor_thread_function(void *arg);
 static int initialize_mutex(void);
 static void cleanup_resources(void);
-static void print_thread_info(const char *thread_name, long counter_value);
+static void publish_counter_state(thread_id_t writer, long iteration);
+static void snapshot_counter_state(counter_snapshot_t *snapshot);
+static void print_thread_info(const char *thread_name);
+static double elapsed_ms(const struct timespec *start);
+static void place_worker_thread(const char *thread_name, thread_id_t worker);
+static void counter_reduce_body(long begin, long end, void *partial, void *context);
+static void counter_reduce_combine(void *dest, const void *src, void *context);
+static void demonstrate_parallel_reduction(long serialized_result, double serialized_ms);
+static void *pipeline_producer_function(void *arg);
+static void demonstrate_spsc_pipeline(long serialized_result, double serialized_ms);
 
 /*============================================================================
  * THREAD FUNCTION IMPLEMENTATIONS
@@ -93,10 +201,18 @@ static void *increment_thread_function(void *arg) {
     (void)arg; // Suppress unused parameter warning
 
     const char *thread_name = "INCREMENT_THREAD";
+
+    // Pin first so pages this thread touches first normally land on its node
+    place_worker_thread(thread_name, THREAD_INCREMENT);
+    instrumented_mutex_set_thread_name(thread_name);
+    async_logger_register_thread(thread_name);
+
+    // Wait until every worker is ready so all start at the same moment
+    futex_start_gate_arrive(&start_gate);
     printf("[%s] Starting execution\n", thread_name);
 
     // Acquire mutex lock for thread-safe access
-    int lock_result = pthread_mutex_lock(&counter_mutex);
+    int lock_result = instrumented_mutex_lock(&counter_mutex);
     if (lock_result != 0) {
         fprintf(stderr, "[%s] Failed to acquire mutex: %s\n",
                 thread_name, strerror(lock_result));
@@ -104,30 +220,38 @@ static void *increment_thread_function(void *arg) {
     }
 
     printf("[%s] Acquired mutex lock\n", thread_name);
-    print_thread_info(thread_name, shared_counter);
+    print_thread_info(thread_name);
 
-    // Initial increment
-    shared_counter++;
+    // Initial increment; counter_mutex orders the updates, so relaxed suffices
+    atomic_counter_add_relaxed(&shared_counter, 1);
+    publish_counter_state(THREAD_INCREMENT, 0);
 
     // Perform increment loop
     printf("[%s] Starting increment loop (%d iterations)\n",
            thread_name, LOOP_ITERATIONS);
 
     for (long i = 0; i < LOOP_ITERATIONS; i++) {
-        shared_counter++;
+        atomic_counter_add_relaxed(&shared_counter, 1);
+
+        if ((i & STATE_PUBLISH_MASK) == 0) {
+            publish_counter_state(THREAD_INCREMENT, i);
+        }
 
-        // Optional: Add a small delay every million iterations for demonstration
+        // Report progress every million iterations without formatting here
         if (i % 1000000 == 0 && i > 0) {
-            printf("[%s] Progress: %ld/%d iterations\n",
-                   thread_name, i, LOOP_ITERATIONS);
+            ASYNC_LOG("Progress: %ld/%ld iterations\n", i, (long)LOOP_ITERATIONS);
         }
     }
 
+    // Keep the remaining direct output ordered after the queued progress lines
+    async_log_flush();
+
+    publish_counter_state(THREAD_INCREMENT, LOOP_ITERATIONS);
     printf("[%s] Completed increment loop\n", thread_name);
-    print_thread_info(thread_name, shared_counter);
+    print_thread_info(thread_name);
 
     // Release mutex lock
-    int unlock_result = pthread_mutex_unlock(&counter_mutex);
+    int unlock_result = instrumented_mutex_unlock(&counter_mutex);
     if (unlock_result != 0) {
         fprintf(stderr, "[%s] Failed to release mutex: %s\n",
                 thread_name, strerror(unlock_result));
@@ -155,10 +279,18 @@ static void *decrement_thread_function(void *arg) {
     (void)arg; // Suppress unused parameter warning
 
     const char *thread_name = "DECREMENT_THREAD";
+
+    // Pin first so pages this thread touches first normally land on its node
+    place_worker_thread(thread_name, THREAD_DECREMENT);
+    instrumented_mutex_set_thread_name(thread_name);
+    async_logger_register_thread(thread_name);
+
+    // Wait until every worker is ready so all start at the same moment
+    futex_start_gate_arrive(&start_gate);
     printf("[%s] Starting execution\n", thread_name);
 
     // Acquire mutex lock for thread-safe access
-    int lock_result = pthread_mutex_lock(&counter_mutex);
+    int lock_result = instrumented_mutex_lock(&counter_mutex);
     if (lock_result != 0) {
         fprintf(stderr, "[%s] Failed to acquire mutex: %s\n",
                 thread_name, strerror(lock_result));
@@ -166,30 +298,38 @@ static void *decrement_thread_function(void *arg) {
     }
 
     printf("[%s] Acquired mutex lock\n", thread_name);
-    print_thread_info(thread_name, shared_counter);
+    print_thread_info(thread_name);
 
     // Initial increment (same as original behavior)
-    shared_counter++;
+    atomic_counter_add_relaxed(&shared_counter, 1);
+    publish_counter_state(THREAD_DECREMENT, 0);
 
     // Perform decrement loop
     printf("[%s] Starting decrement loop (%d iterations)\n",
            thread_name, LOOP_ITERATIONS);
 
     for (long i = 0; i < LOOP_ITERATIONS; i++) {
-        shared_counter--;
+        atomic_counter_add_relaxed(&shared_counter, -1);
 
-        // Optional: Add a small delay every million iterations for demonstration
+        if ((i & STATE_PUBLISH_MASK) == 0) {
+            publish_counter_state(THREAD_DECREMENT, i);
+        }
+
+        // Report progress every million iterations without formatting here
         if (i % 1000000 == 0 && i > 0) {
-            printf("[%s] Progress: %ld/%d iterations\n",
-                   thread_name, i, LOOP_ITERATIONS);
+            ASYNC_LOG("Progress: %ld/%ld iterations\n", i, (long)LOOP_ITERATIONS);
         }
     }
 
+    // Keep the remaining direct output ordered after the queued progress lines
+    async_log_flush();
+
+    publish_counter_state(THREAD_DECREMENT, LOOP_ITERATIONS);
     printf("[%s] Completed decrement loop\n", thread_name);
-    print_thread_info(thread_name, shared_counter);
+    print_thread_info(thread_name);
 
     // Release mutex lock
-    int unlock_result = pthread_mutex_unlock(&counter_mutex);
+    int unlock_result = instrumented_mutex_unlock(&counter_mutex);
     if (unlock_result != 0) {
         fprintf(stderr, "[%s] Failed to release mutex: %s\n",
                 thread_name, strerror(unlock_result));
@@ -201,6 +341,29 @@ static void *decrement_thread_function(void *arg) {
     return NULL;
 }
 
+/**
+ * @brief Thread function that periodically reports the counter state
+ * @param arg Thread argument (unused in this implementation)
+ * @return NULL on completion
+ *
+ * Reads the seqlock snapshot instead of taking counter_mutex, so reporting
+ * never delays the worker that currently owns the lock.
+ */
+static void *monitor_thread_function(void *arg) {
+    (void)arg; // Suppress unused parameter warning
+
+    const struct timespec interval = {
+        0, MONITOR_INTERVAL_MS * 1000000L
+    };
+
+    while (__atomic_load_n(&monitor_running, __ATOMIC_ACQUIRE)) {
+        print_thread_info("MONITOR_THREAD");
+        nanosleep(&interval, NULL);
+    }
+
+    return NULL;
+}
+
 /*============================================================================
  * UTILITY FUNCTIONS
  *============================================================================*/
@@ -210,7 +373,7 @@ static void *decrement_thread_function(void *arg) {
  * @return 0 on success, non-zero on failure
  */
 static int initialize_mutex(void) {
-    int result = pthread_mutex_init(&counter_mutex, NULL);
+    int result = instrumented_mutex_init(&counter_mutex, "counter_mutex");
     if (result != 0) {
         fprintf(stderr, "Mutex initialization failed: %s\n", strerror(result));
         return result;
@@ -226,7 +389,9 @@ static int initialize_mutex(void) {
  */
 static void cleanup_resources(void) {
     if (mutex_initialized) {
-        int result = pthread_mutex_destroy(&counter_mutex);
+        instrumented_mutex_report(&counter_mutex, stdout);
+
+        int result = instrumented_mutex_destroy(&counter_mutex);
         if (result != 0) {
             fprintf(stderr, "Mutex destruction failed: %s\n", strerror(result));
         } else {
@@ -237,12 +402,235 @@ static void cleanup_resources(void) {
 }
 
 /**
- * @brief Print thread information with counter value
+ * @brief Publish the current counter state to lock-free readers
+ * @param writer Thread performing the update
+ * @param iteration Loop iteration the writer has reached
+ * @note Caller must hold counter_mutex, which serializes the writers
+ */
+static void publish_counter_state(thread_id_t writer, long iteration) {
+    seqlock_write_begin(&counter_state.lock);
+    SEQLOCK_STORE(counter_state.data.counter,
+                  atomic_counter_load(&shared_counter, ATOMIC_COUNTER_RELAXED));
+    SEQLOCK_STORE(counter_state.data.iteration, iteration);
+    SEQLOCK_STORE(counter_state.data.progress_percent,
+                  (int)(iteration * 100 / LOOP_ITERATIONS));
+    SEQLOCK_STORE(counter_state.data.writer, (int)writer);
+    seqlock_write_end(&counter_state.lock);
+}
+
+/**
+ * @brief Take a consistent snapshot of the counter state without locking
+ * @param snapshot Destination for the copied state
+ */
+static void snapshot_counter_state(counter_snapshot_t *snapshot) {
+    unsigned int seq;
+    do {
+        seq = seqlock_read_begin(&counter_state.lock);
+        snapshot->counter = SEQLOCK_LOAD(counter_state.data.counter);
+        snapshot->iteration = SEQLOCK_LOAD(counter_state.data.iteration);
+        snapshot->progress_percent = SEQLOCK_LOAD(counter_state.data.progress_percent);
+        snapshot->writer = SEQLOCK_LOAD(counter_state.data.writer);
+    } while (seqlock_read_retry(&counter_state.lock, seq));
+}
+
+/**
+ * @brief Print thread information from a snapshot of the counter state
  * @param thread_name Name of the thread for identification
- * @param counter_value Current value of the counter
  */
-static void print_thread_info(const char *thread_name, long counter_value) {
-    printf("[%s] Current counter value: %ld\n", thread_name, counter_value);
+static void print_thread_info(const char *thread_name) {
+    static const char *writer_names[] = { "INCREMENT_THREAD", "DECREMENT_THREAD" };
+    counter_snapshot_t snapshot;
+
+    snapshot_counter_state(&snapshot);
+
+    printf("[%s] Current counter value: %ld (writer: %s, iteration %ld, %d%%)\n",
+           thread_name, snapshot.counter,
+           snapshot.writer >= 0 ? writer_names[snapshot.writer] : "none",
+           snapshot.iteration, snapshot.progress_percent);
+}
+
+/**
+ * @brief Pin the calling worker to its NUMA node when placement is enabled
+ * @param thread_name Name of the thread for identification
+ * @param worker Worker index used for round-robin node selection
+ */
+static void place_worker_thread(const char *thread_name, thread_id_t worker) {
+#if ENABLE_NUMA_PLACEMENT
+    const numa_topology_t *topology = numa_topology_get();
+    int node = numa_topology_node_for_worker(topology, (int)worker);
+
+    int result = numa_topology_pin_to_node(topology, node);
+    if (result != 0) {
+        fprintf(stderr, "[%s] Failed to pin to NUMA node%d: %s\n",
+                thread_name, topology->nodes[node].id, strerror(result));
+    } else {
+        printf("[%s] Pinned to NUMA node%d\n", thread_name, topology->nodes[node].id);
+    }
+#else
+    (void)thread_name;
+    (void)worker;
+#endif
+}
+
+/**
+ * @brief Milliseconds elapsed since start on the monotonic clock
+ */
+static double elapsed_ms(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) * 1e3 +
+           (double)(now.tv_nsec - start->tv_nsec) / 1e6;
+}
+
+/*============================================================================
+ * PARALLEL REDUCTION
+ *============================================================================*/
+
+/**
+ * @brief Fold a slice of the counter updates into a thread-private partial
+ *
+ * Indices [0, LOOP_ITERATIONS) are the increment thread's loop and
+ * [LOOP_ITERATIONS, 2 * LOOP_ITERATIONS) the decrement thread's loop.
+ */
+static void counter_reduce_body(long begin, long end, void *partial, void *context) {
+    (void)context; // Suppress unused parameter warning
+
+    long delta = 0;
+    for (long i = begin; i < end; i++) {
+        delta += (i < LOOP_ITERATIONS) ? 1 : -1;
+    }
+    *(long *)partial += delta;
+}
+
+/**
+ * @brief Sum two partial counter values
+ */
+static void counter_reduce_combine(void *dest, const void *src, void *context) {
+    (void)context; // Suppress unused parameter warning
+    *(long *)dest += *(const long *)src;
+}
+
+/**
+ * @brief Recompute the counter as a reduction with every chunking schedule
+ * @param serialized_result Final counter value of the mutex-serialized run
+ * @param serialized_ms Wall-clock time of the mutex-serialized run
+ */
+static void demonstrate_parallel_reduction(long serialized_result, double serialized_ms) {
+    const parallel_schedule_t schedules[] = {
+        PARALLEL_SCHEDULE_STATIC,
+        PARALLEL_SCHEDULE_DYNAMIC,
+        PARALLEL_SCHEDULE_GUIDED
+    };
+    const parallel_range_t range = { 0, 2L * LOOP_ITERATIONS };
+    const long identity = 0;
+
+    printf("\n=======================================================\n");
+    printf("    PARALLEL REDUCTION OF THE SAME COMPUTATION\n");
+    printf("=======================================================\n");
+    printf("Threads: %d, grain: %ld\n", parallel_default_threads(), REDUCE_GRAIN);
+    printf("%-10s %12s %12s %10s\n", "schedule", "result", "time (ms)", "speedup");
+    printf("%-10s %12ld %12.2f %9.2fx\n", "mutex", serialized_result, serialized_ms, 1.0);
+
+    for (size_t i = 0; i < sizeof(schedules) / sizeof(schedules[0]); i++) {
+        parallel_options_t options = { 0, schedules[i], ENABLE_NUMA_PLACEMENT };
+        struct timespec start;
+        long sum = 0;
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        int result = parallel_reduce(range, REDUCE_GRAIN, &sum, sizeof(sum), &identity,
+                                     counter_reduce_body, counter_reduce_combine,
+                                     NULL, &options);
+        double ms = elapsed_ms(&start);
+
+        if (result != 0) {
+            fprintf(stderr, "parallel_reduce (%s) failed: %s\n",
+                    parallel_schedule_name(schedules[i]), strerror(result));
+            continue;
+        }
+
+        // Both threads start with one increment outside their loops
+        long counter = 2 + sum;
+        printf("%-10s %12ld %12.2f %9.2fx%s\n", parallel_schedule_name(schedules[i]),
+               counter, ms, ms > 0.0 ? serialized_ms / ms : 0.0,
+               counter == serialized_result ? "" : "  MISMATCH");
+    }
+}
+
+/*============================================================================
+ * SPSC PIPELINE
+ *============================================================================*/
+
+/**
+ * @brief Pipeline producer: the increment thread's updates, as messages
+ * @param arg The spsc_ring_t to send on
+ */
+static void *pipeline_producer_function(void *arg) {
+    spsc_ring_t *ring = (spsc_ring_t *)arg;
+
+    for (long i = -1; i < LOOP_ITERATIONS; i++) {
+        counter_message_t *message = spsc_ring_wait_reserve(ring);
+        message->delta = 1;
+        message->iteration = i;
+        spsc_ring_publish(ring);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Recompute the counter with the two threads as a pipeline
+ * @param serialized_result Final counter value of the mutex-serialized run
+ * @param serialized_ms Wall-clock time of the mutex-serialized run
+ *
+ * The consumer (this thread) plays the decrement thread: it does its own
+ * initial increment, then applies each received increment together with
+ * the decrement of the matching loop iteration. It is the only thread that
+ * touches the counter, so the counter needs no lock at all.
+ */
+static void demonstrate_spsc_pipeline(long serialized_result, double serialized_ms) {
+    printf("\n=======================================================\n");
+    printf("    PRODUCER/CONSUMER PIPELINE OVER AN SPSC RING\n");
+    printf("=======================================================\n");
+
+    spsc_ring_t *ring = spsc_ring_create(PIPELINE_RING_CAPACITY, sizeof(counter_message_t));
+    if (!ring) {
+        fprintf(stderr, "Failed to create pipeline ring\n");
+        return;
+    }
+
+    struct timespec start;
+    pthread_t producer;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int result = pthread_create(&producer, NULL, pipeline_producer_function, ring);
+    if (result != 0) {
+        fprintf(stderr, "Failed to create pipeline producer: %s\n", strerror(result));
+        spsc_ring_destroy(ring);
+        return;
+    }
+
+    long counter = 1;
+    long messages = 0;
+    for (long i = -1; i < LOOP_ITERATIONS; i++) {
+        const counter_message_t *message = spsc_ring_wait_front(ring);
+        counter += message->delta;
+        if (message->iteration >= 0) {
+            counter -= 1;
+        }
+        spsc_ring_pop(ring);
+        messages++;
+    }
+
+    pthread_join(producer, NULL);
+    double ms = elapsed_ms(&start);
+
+    printf("Ring: %zu slots of %zu bytes\n", spsc_ring_capacity(ring), sizeof(counter_message_t));
+    printf("%-10s %12s %12s %10s %14s\n", "variant", "result", "time (ms)", "speedup", "messages/s");
+    printf("%-10s %12ld %12.2f %9.2fx %14s\n", "mutex", serialized_result, serialized_ms, 1.0, "-");
+    printf("%-10s %12ld %12.2f %9.2fx %14.0f%s\n", "pipeline", counter, ms,
+           ms > 0.0 ? serialized_ms / ms : 0.0, ms > 0.0 ? (double)messages / ms * 1e3 : 0.0,
+           counter == serialized_result ? "" : "  MISMATCH");
+
+    spsc_ring_destroy(ring);
 }
 
 /*============================================================================
@@ -258,9 +646,14 @@ int main(void) {
     printf("    PTHREAD MUTEX SYNCHRONIZATION DEMONSTRATION\n");
     printf("=======================================================\n\n");
 
-    printf("Initial shared counter value: %ld\n", shared_counter);
+    printf("Initial shared counter value: %ld\n",
+           atomic_counter_load(&shared_counter, ATOMIC_COUNTER_RELAXED));
     printf("Loop iterations per thread: %d\n", LOOP_ITERATIONS);
-    printf("Number of threads: %d\n\n", NUM_THREADS);
+    printf("Number of threads: %d\n", NUM_THREADS);
+#if ENABLE_NUMA_PLACEMENT
+    numa_topology_print(numa_topology_get());
+#endif
+    printf("\n");
 
     // Initialize mutex
     if (initialize_mutex() != 0) {
@@ -282,8 +675,26 @@ int main(void) {
     // Array to store thread identifiers
     pthread_t thread_ids[NUM_THREADS];
     int thread_creation_success = 1;
+    int threads_created = 0;
+
+    // Start the logger that formats the workers' progress output
+    int logger_result = async_logger_start(stdout);
+    if (logger_result != 0) {
+        fprintf(stderr, "Failed to start async logger (%s), logging synchronously\n",
+                strerror(logger_result));
+    }
+
+    // Start the monitor before the workers so it sees the whole run
+    pthread_t monitor_id;
+    __atomic_store_n(&monitor_running, 1, __ATOMIC_RELEASE);
+    int monitor_result = pthread_create(&monitor_id, NULL, monitor_thread_function, NULL);
+    if (monitor_result != 0) {
+        fprintf(stderr, "Failed to create MONITOR_THREAD: %s\n", strerror(monitor_result));
+        __atomic_store_n(&monitor_running, 0, __ATOMIC_RELEASE);
+    }
 
     printf("Creating threads...\n");
+    futex_start_gate_init(&start_gate, NUM_THREADS);
 
     // Create threads
     for (int i = 0; i < NUM_THREADS; i++) {
@@ -294,6 +705,7 @@ int main(void) {
             thread_creation_success = 0;
             break;
         } else {
+            threads_created++;
             printf("Created %s successfully (ID: %lu)\n",
                    thread_names[i], (unsigned long)thread_ids[i]);
         }
@@ -301,10 +713,25 @@ int main(void) {
 
     if (!thread_creation_success) {
         fprintf(stderr, "Thread creation failed. Cleaning up...\n");
+        futex_start_gate_abort(&start_gate);
+        if (monitor_result == 0) {
+            __atomic_store_n(&monitor_running, 0, __ATOMIC_RELEASE);
+            pthread_join(monitor_id, NULL);
+        }
+        // Workers must stop logging before the logger's rings are freed
+        for (int i = 0; i < threads_created; i++) {
+            pthread_join(thread_ids[i], NULL);
+        }
+        async_logger_stop();
         cleanup_resources();
         return EXIT_FAILURE;
     }
 
+    // Release all workers at once and time the run from that moment
+    struct timespec serialized_start;
+    clock_gettime(CLOCK_MONOTONIC, &serialized_start);
+    futex_start_gate_release(&start_gate);
+
     printf("\nWaiting for threads to complete...\n");
 
     // Wait for all threads to complete
@@ -319,14 +746,33 @@ int main(void) {
         }
     }
 
+    if (monitor_result == 0) {
+        __atomic_store_n(&monitor_running, 0, __ATOMIC_RELEASE);
+        pthread_join(monitor_id, NULL);
+    }
+
+    double serialized_ms = elapsed_ms(&serialized_start);
+
+    async_logger_stop();
+    if (async_logger_dropped() > 0) {
+        printf("Async logger dropped %lu progress records\n", async_logger_dropped());
+    }
+
     printf("\n=======================================================\n");
     printf("    THREAD EXECUTION SUMMARY\n");
     printf("=======================================================\n");
-    printf("Final shared counter value: %ld\n", shared_counter);
+    // pthread_join ordered the workers' updates before this read
+    long final_counter = atomic_counter_load(&shared_counter, ATOMIC_COUNTER_RELAXED);
+    printf("Final shared counter value: %ld\n", final_counter);
     printf("Expected value (if perfectly synchronized): 2\n");
     printf("(Each thread increments once initially, then one increments\n");
     printf(" and the other decrements the same number of times)\n");
 
+    demonstrate_parallel_reduction(final_counter, serialized_ms);
+#if ENABLE_SPSC_PIPELINE
+    demonstrate_spsc_pipeline(final_counter, serialized_ms);
+#endif
+
     // Cleanup resources
     cleanup_resources();
 
@@ -0,0 +1,112 @@
+/**
+ * @file seqlock.h
+ * @brief Sequence lock for lock-free readers of small shared state
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * A seqlock lets any number of readers take a consistent snapshot of a
+ * group of fields without ever blocking the writer:
+ * - The writer bumps the sequence to an odd value, updates the fields,
+ *   then bumps it back to an even value
+ * - A reader records the sequence, copies the fields, and retries if the
+ *   sequence was odd or changed while it was copying
+ *
+ * Writers must be serialized externally (e.g. by the mutex that already
+ * protects the data); the seqlock only coordinates writers with readers.
+ * Protected fields should be accessed with SEQLOCK_LOAD/SEQLOCK_STORE so
+ * the concurrent accesses are well defined.
+ */
+
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+/*============================================================================
+ * MACROS
+ *============================================================================*/
+
+/** Static initializer for a seqlock */
+#define SEQLOCK_INITIALIZER { 0 }
+
+/** Read a seqlock-protected field inside a read section */
+#define SEQLOCK_LOAD(field) __atomic_load_n(&(field), __ATOMIC_RELAXED)
+
+/** Write a seqlock-protected field inside a write section */
+#define SEQLOCK_STORE(field, value) \
+    __atomic_store_n(&(field), (value), __ATOMIC_RELAXED)
+
+/** Hint to the CPU that we are spinning */
+#if defined(__x86_64__) || defined(__i386__)
+#define SEQLOCK_CPU_RELAX() __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define SEQLOCK_CPU_RELAX() __asm__ __volatile__("yield" ::: "memory")
+#else
+#define SEQLOCK_CPU_RELAX() do { } while (0)
+#endif
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+/**
+ * @brief Sequence counter; even when idle, odd while a write is in progress
+ */
+typedef struct {
+    unsigned int sequence;
+} seqlock_t;
+
+/*============================================================================
+ * INLINE FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Initialize a seqlock to the idle state
+ */
+static inline void seqlock_init(seqlock_t *lock) {
+    __atomic_store_n(&lock->sequence, 0u, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Start a write section (caller must already exclude other writers)
+ */
+static inline void seqlock_write_begin(seqlock_t *lock) {
+    unsigned int seq = __atomic_load_n(&lock->sequence, __ATOMIC_RELAXED);
+    __atomic_store_n(&lock->sequence, seq + 1, __ATOMIC_RELAXED);
+    // Order the odd sequence before any of the field stores
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Finish a write section and publish the new field values
+ */
+static inline void seqlock_write_end(seqlock_t *lock) {
+    unsigned int seq = __atomic_load_n(&lock->sequence, __ATOMIC_RELAXED);
+    __atomic_store_n(&lock->sequence, seq + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Start a read section
+ * @return Sequence value to pass to seqlock_read_retry()
+ *
+ * Spins while a write is in progress so the returned value is always even.
+ */
+static inline unsigned int seqlock_read_begin(const seqlock_t *lock) {
+    unsigned int seq;
+    while ((seq = __atomic_load_n(&lock->sequence, __ATOMIC_ACQUIRE)) & 1u) {
+        SEQLOCK_CPU_RELAX();
+    }
+    return seq;
+}
+
+/**
+ * @brief Check whether a read section raced with a writer
+ * @param lock The seqlock
+ * @param start Value returned by seqlock_read_begin()
+ * @return Non-zero if the copied fields may be torn and must be re-read
+ */
+static inline int seqlock_read_retry(const seqlock_t *lock, unsigned int start) {
+    // Order the field loads before the sequence re-check
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&lock->sequence, __ATOMIC_RELAXED) != start;
+}
+
+#endif /* SEQLOCK_H */
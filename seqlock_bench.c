@@ -0,0 +1,272 @@
+/**
+ * @file seqlock_bench.c
+ * @brief Benchmark of writer slowdown under concurrent snapshot readers
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * One writer thread repeatedly updates a three-field state (counter,
+ * progress, iteration) while N reader threads continuously take snapshots.
+ * The benchmark reports the writer's cost per update for N = 0, 1, 2, 4, ...
+ * readers, for two ways of protecting the state:
+ * - seqlock: readers never block the writer, they only retry on conflict
+ * - mutex:   readers take the same mutex as the writer
+ *
+ * Every snapshot is checked against the invariant the writer maintains, so
+ * torn reads would show up in the "torn" column (it must always be 0).
+ *
+ * Usage: ./seqlock_bench [writes_per_run] [max_readers]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "clock_ns.h"
+#include "seqlock.h"
+
+/*============================================================================
+ * CONSTANTS AND CONFIGURATION
+ *============================================================================*/
+
+/** Default number of write sections per run */
+#define DEFAULT_WRITES 2000000L
+
+/** Default upper bound on concurrent readers */
+#define DEFAULT_MAX_READERS 4
+
+/** Hard upper bound on concurrent readers */
+#define MAX_READERS 64
+
+/** Protection scheme under test */
+typedef enum {
+    MODE_SEQLOCK = 0,
+    MODE_MUTEX = 1
+} bench_mode_t;
+
+/*============================================================================
+ * TYPES AND GLOBAL VARIABLES
+ *============================================================================*/
+
+/**
+ * @brief Shared state; invariant: progress == counter / 2, iteration == counter + 7
+ */
+typedef struct {
+    seqlock_t lock;
+    pthread_mutex_t mutex;
+    long counter;
+    long progress;
+    long iteration;
+} shared_state_t;
+
+/**
+ * @brief Per-reader statistics
+ */
+typedef struct {
+    long snapshots;
+    long retries;
+    long torn;
+} reader_stats_t;
+
+/**
+ * @brief Arguments for a reader thread
+ */
+typedef struct {
+    bench_mode_t mode;
+    reader_stats_t stats;
+} reader_arg_t;
+
+static shared_state_t state;
+static int writer_done = 0;
+static int readers_ready = 0;
+static long total_torn = 0;
+
+/*============================================================================
+ * THREAD FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Reader thread: take snapshots until the writer finishes
+ */
+static void *reader_thread(void *arg) {
+    reader_arg_t *reader = (reader_arg_t *)arg;
+    long counter, progress, iteration;
+
+    __atomic_add_fetch(&readers_ready, 1, __ATOMIC_ACQ_REL);
+
+    while (!__atomic_load_n(&writer_done, __ATOMIC_ACQUIRE)) {
+        if (reader->mode == MODE_SEQLOCK) {
+            unsigned int seq;
+            for (;;) {
+                seq = seqlock_read_begin(&state.lock);
+                counter = SEQLOCK_LOAD(state.counter);
+                progress = SEQLOCK_LOAD(state.progress);
+                iteration = SEQLOCK_LOAD(state.iteration);
+                if (!seqlock_read_retry(&state.lock, seq)) {
+                    break;
+                }
+                reader->stats.retries++;
+            }
+        } else {
+            pthread_mutex_lock(&state.mutex);
+            counter = state.counter;
+            progress = state.progress;
+            iteration = state.iteration;
+            pthread_mutex_unlock(&state.mutex);
+        }
+
+        if (progress != counter / 2 || iteration != counter + 7) {
+            reader->stats.torn++;
+        }
+        reader->stats.snapshots++;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Perform the timed write sections
+ * @return Elapsed nanoseconds
+ */
+static long long run_writer(bench_mode_t mode, long writes) {
+    long long start = now_ns();
+
+    for (long i = 1; i <= writes; i++) {
+        if (mode == MODE_SEQLOCK) {
+            seqlock_write_begin(&state.lock);
+            SEQLOCK_STORE(state.counter, i);
+            SEQLOCK_STORE(state.progress, i / 2);
+            SEQLOCK_STORE(state.iteration, i + 7);
+            seqlock_write_end(&state.lock);
+        } else {
+            pthread_mutex_lock(&state.mutex);
+            state.counter = i;
+            state.progress = i / 2;
+            state.iteration = i + 7;
+            pthread_mutex_unlock(&state.mutex);
+        }
+    }
+
+    return now_ns() - start;
+}
+
+/*============================================================================
+ * BENCHMARK DRIVER
+ *============================================================================*/
+
+/**
+ * @brief Run one configuration and print a result row
+ * @return Writer nanoseconds per update, or -1.0 on failure
+ */
+static double run_configuration(bench_mode_t mode, int num_readers, long writes,
+                                double baseline_ns) {
+    pthread_t threads[MAX_READERS];
+    reader_arg_t readers[MAX_READERS];
+
+    seqlock_init(&state.lock);
+    state.counter = 0;
+    state.progress = 0;
+    state.iteration = 7;
+    __atomic_store_n(&writer_done, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&readers_ready, 0, __ATOMIC_RELEASE);
+
+    for (int i = 0; i < num_readers; i++) {
+        memset(&readers[i], 0, sizeof(readers[i]));
+        readers[i].mode = mode;
+        int result = pthread_create(&threads[i], NULL, reader_thread, &readers[i]);
+        if (result != 0) {
+            fprintf(stderr, "Failed to create reader %d: %s\n", i, strerror(result));
+            __atomic_store_n(&writer_done, 1, __ATOMIC_RELEASE);
+            for (int j = 0; j < i; j++) {
+                pthread_join(threads[j], NULL);
+            }
+            return -1.0;
+        }
+    }
+
+    // Make sure every reader is actually running before timing the writer
+    while (__atomic_load_n(&readers_ready, __ATOMIC_ACQUIRE) < num_readers) {
+        sched_yield();
+    }
+
+    long long elapsed = run_writer(mode, writes);
+    __atomic_store_n(&writer_done, 1, __ATOMIC_RELEASE);
+
+    reader_stats_t total = { 0, 0, 0 };
+    for (int i = 0; i < num_readers; i++) {
+        pthread_join(threads[i], NULL);
+        total.snapshots += readers[i].stats.snapshots;
+        total.retries += readers[i].stats.retries;
+        total.torn += readers[i].stats.torn;
+    }
+    total_torn += total.torn;
+
+    double ns_per_write = (double)elapsed / (double)writes;
+    double slowdown = baseline_ns > 0.0 ? ns_per_write / baseline_ns : 1.0;
+
+    printf("%-8s %7d %12.2f %9.2fx %14ld %12ld %6ld\n",
+           mode == MODE_SEQLOCK ? "seqlock" : "mutex", num_readers,
+           ns_per_write, slowdown, total.snapshots, total.retries, total.torn);
+
+    return ns_per_write;
+}
+
+/*============================================================================
+ * MAIN FUNCTION
+ *============================================================================*/
+
+/**
+ * @brief Main function - runs the reader-scaling benchmark
+ * @return EXIT_SUCCESS when no torn snapshot was observed
+ */
+int main(int argc, char **argv) {
+    long writes = DEFAULT_WRITES;
+    int max_readers = DEFAULT_MAX_READERS;
+
+    if (argc > 1) {
+        writes = strtol(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        max_readers = (int)strtol(argv[2], NULL, 10);
+    }
+    if (writes <= 0 || max_readers < 0 || max_readers > MAX_READERS) {
+        fprintf(stderr, "Usage: %s [writes_per_run > 0] [max_readers 0..%d]\n",
+                argv[0], MAX_READERS);
+        return EXIT_FAILURE;
+    }
+
+    pthread_mutex_init(&state.mutex, NULL);
+
+    printf("========================================================\n");
+    printf("    SEQLOCK WRITER SLOWDOWN BENCHMARK\n");
+    printf("========================================================\n");
+    printf("Writes per run: %ld, max readers: %d\n\n", writes, max_readers);
+    printf("%-8s %7s %12s %10s %14s %12s %6s\n",
+           "mode", "readers", "ns/write", "slowdown", "snapshots", "retries", "torn");
+
+    for (int mode = MODE_SEQLOCK; mode <= MODE_MUTEX; mode++) {
+        double baseline = 0.0;
+        for (int readers = 0; readers <= max_readers; readers = readers ? readers * 2 : 1) {
+            double result = run_configuration((bench_mode_t)mode, readers, writes, baseline);
+            if (result < 0.0) {
+                pthread_mutex_destroy(&state.mutex);
+                return EXIT_FAILURE;
+            }
+            if (readers == 0) {
+                baseline = result;
+            }
+        }
+        printf("\n");
+    }
+
+    pthread_mutex_destroy(&state.mutex);
+
+    if (total_torn != 0) {
+        fprintf(stderr, "Error: %ld torn snapshots observed\n", total_torn);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,414 @@
+/**
+ * @file spawn_pool.c
+ * @brief Prefork helper pool: argv over SOCK_SEQPACKET, descriptors via SCM_RIGHTS
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#define _GNU_SOURCE
+
+#include "spawn_pool.h"
+
+#include <errno.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/wait.h>
+
+#include "command_launcher.h"
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+/** stdin, stdout and stderr */
+#define STANDARD_FDS 3
+
+/**
+ * @brief Start of a request; argc NUL-terminated strings follow
+ */
+typedef struct {
+    uint32_t argc;
+    uint32_t attached;          /**< Bit i: a descriptor for fd i is attached */
+} request_header_t;
+
+/**
+ * @brief A helper's answer once the command has finished
+ */
+typedef struct {
+    int32_t error;              /**< 0, or the errno of a failed spawn/wait */
+    int32_t status;             /**< Raw wait status */
+    struct rusage usage;
+} reply_t;
+
+/*============================================================================
+ * HELPER PROCESS
+ *============================================================================*/
+
+/**
+ * @brief Take the descriptors out of a received message's ancillary data
+ * @return Number of descriptors stored in fds
+ */
+static int received_fds(struct msghdr *msg, int fds[STANDARD_FDS]) {
+    int count = 0;
+
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(msg); cmsg; cmsg = CMSG_NXTHDR(msg, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+            continue;
+        }
+        int n = (int)((cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+        int *data = (int *)CMSG_DATA(cmsg);
+        for (int i = 0; i < n; i++) {
+            if (count < STANDARD_FDS) {
+                fds[count++] = data[i];
+            } else {
+                close(data[i]);
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Start one requested command, wait for it and fill in the reply
+ */
+static void serve_request(char *message, size_t length, int *fds, int fd_count,
+                          reply_t *reply) {
+    request_header_t header;
+    char *argv[LAUNCHER_MAX_ARGS];
+    int standard[STANDARD_FDS] = { -1, -1, -1 };
+    pid_t pid;
+
+    memset(reply, 0, sizeof(*reply));
+    if (length < sizeof(header)) {
+        reply->error = EINVAL;
+        return;
+    }
+    memcpy(&header, message, sizeof(header));
+    if (header.argc == 0 || header.argc >= LAUNCHER_MAX_ARGS) {
+        reply->error = EINVAL;
+        return;
+    }
+
+    // Every string must end inside the message
+    char *next = message + sizeof(header);
+    char *end = message + length;
+    for (uint32_t i = 0; i < header.argc; i++) {
+        char *nul = next < end ? memchr(next, '\0', (size_t)(end - next)) : NULL;
+        if (!nul) {
+            reply->error = EINVAL;
+            return;
+        }
+        argv[i] = next;
+        next = nul + 1;
+    }
+    argv[header.argc] = NULL;
+
+    int used = 0;
+    for (int i = 0; i < STANDARD_FDS; i++) {
+        if (header.attached & (1u << i)) {
+            if (used == fd_count) {
+                reply->error = EINVAL;
+                return;
+            }
+            standard[i] = fds[used++];
+        }
+    }
+
+    int result = launcher_spawn_fds(argv, standard[0], standard[1], standard[2], &pid);
+    if (result == 0) {
+        int status;
+        result = launcher_wait_usage(pid, &status, &reply->usage);
+        reply->status = status;
+    }
+    reply->error = result;
+}
+
+/**
+ * @brief Helper main loop: one request at a time until the pool goes away
+ */
+static void __attribute__((noreturn)) worker_main(int fd) {
+    static char message[SPAWN_POOL_MESSAGE_SIZE];
+    union {
+        char buffer[CMSG_SPACE(sizeof(int) * STANDARD_FDS)];
+        struct cmsghdr align;
+    } control;
+
+    for (;;) {
+        struct iovec iov = { message, sizeof(message) };
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control.buffer;
+        msg.msg_controllen = sizeof(control.buffer);
+
+        ssize_t length = recvmsg(fd, &msg, MSG_CMSG_CLOEXEC);
+        if (length == -1 && errno == EINTR) {
+            continue;
+        }
+        // The pool closed its end (or is gone): nothing more to do
+        if (length <= 0) {
+            _exit(0);
+        }
+
+        int fds[STANDARD_FDS];
+        int fd_count = received_fds(&msg, fds);
+        reply_t reply;
+        if (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) {
+            memset(&reply, 0, sizeof(reply));
+            reply.error = E2BIG;
+        } else {
+            serve_request(message, (size_t)length, fds, fd_count, &reply);
+        }
+        for (int i = 0; i < fd_count; i++) {
+            close(fds[i]);
+        }
+
+        while (send(fd, &reply, sizeof(reply), MSG_NOSIGNAL) == -1) {
+            if (errno != EINTR) {
+                _exit(0);
+            }
+        }
+    }
+}
+
+/*============================================================================
+ * POOL
+ *============================================================================*/
+
+/**
+ * @brief Fork `workers` helpers; call early, before the heap grows and
+ *        before any thread is started
+ * @return 0, or an errno code (nothing to destroy on failure)
+ */
+int spawn_pool_create(spawn_pool_t *pool, int workers) {
+    if (!pool || workers < 1 || workers > SPAWN_POOL_MAX_WORKERS) {
+        return EINVAL;
+    }
+    memset(pool, 0, sizeof(*pool));
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->idle, NULL);
+
+    // Buffered output would otherwise be written again by a helper
+    fflush(NULL);
+
+    int result = 0;
+    for (int i = 0; i < workers && result == 0; i++) {
+        int pair[2];
+        if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, pair) == -1) {
+            result = errno;
+            break;
+        }
+
+        pid_t pid = fork();
+        if (pid == -1) {
+            result = errno;
+            close(pair[0]);
+            close(pair[1]);
+            break;
+        }
+        if (pid == 0) {
+            // Helpers only talk to the pool, not to each other
+            for (int j = 0; j < pool->count; j++) {
+                close(pool->workers[j].fd);
+            }
+            close(pair[0]);
+            worker_main(pair[1]);
+        }
+
+        close(pair[1]);
+        pool->workers[pool->count].pid = pid;
+        pool->workers[pool->count].fd = pair[0];
+        pool->workers[pool->count].busy = 0;
+        pool->count++;
+    }
+    pool->alive = pool->count;
+
+    if (result != 0) {
+        spawn_pool_destroy(pool);
+    }
+    return result;
+}
+
+/**
+ * @brief Close every helper's socket and reap the helpers; call when no
+ *        spawn_pool_run() is in progress
+ */
+void spawn_pool_destroy(spawn_pool_t *pool) {
+    for (int i = 0; i < pool->count; i++) {
+        spawn_worker_t *worker = &pool->workers[i];
+        if (worker->fd >= 0) {
+            close(worker->fd);
+            worker->fd = -1;
+        }
+        while (waitpid(worker->pid, NULL, 0) == -1 && errno == EINTR) {
+        }
+    }
+    pthread_cond_destroy(&pool->idle);
+    pthread_mutex_destroy(&pool->lock);
+    pool->count = 0;
+    pool->alive = 0;
+}
+
+/**
+ * @brief Send one request and wait for the reply over a helper's socket
+ * @return 0, ECONNRESET if the request never reached the helper, or
+ *         ECONNABORTED if it did but no reply came back
+ */
+static int exchange(int fd, const char *message, size_t length, const int *fds, int fd_count,
+                    reply_t *reply) {
+    union {
+        char buffer[CMSG_SPACE(sizeof(int) * STANDARD_FDS)];
+        struct cmsghdr align;
+    } control;
+    struct iovec iov = { (void *)message, length };
+    struct msghdr msg;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    if (fd_count > 0) {
+        memset(&control, 0, sizeof(control));
+        msg.msg_control = control.buffer;
+        msg.msg_controllen = CMSG_SPACE(sizeof(int) * (size_t)fd_count);
+        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * (size_t)fd_count);
+        memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * (size_t)fd_count);
+    }
+
+    while (sendmsg(fd, &msg, MSG_NOSIGNAL) == -1) {
+        if (errno != EINTR) {
+            return errno == EPIPE ? ECONNRESET : errno;
+        }
+    }
+    for (;;) {
+        ssize_t received = recv(fd, reply, sizeof(*reply), 0);
+        if (received == (ssize_t)sizeof(*reply)) {
+            return 0;
+        }
+        if (received == -1 && errno == EINTR) {
+            continue;
+        }
+        // The helper may already have started the command: not safe to retry
+        return ECONNABORTED;
+    }
+}
+
+/**
+ * @brief Run a command on an idle helper and wait for it to finish
+ * @param argv Command and arguments (searched in PATH like execvp)
+ * @param stdin_fd, stdout_fd, stderr_fd Descriptor for the command's fd 0,
+ *        1 and 2, or -1 for the helper's (the caller's at pool creation)
+ * @param[out] status Raw wait status
+ * @param[out] usage Resources the command used; may be NULL
+ * @return 0, the command's spawn errno, E2BIG if argv does not fit in a
+ *         message, ECONNRESET if the helper was gone before it got the
+ *         request (safe to run the command elsewhere), ECONNABORTED if it
+ *         died after receiving it (the command may have run), or ECHILD
+ *         if no helper is left
+ */
+int spawn_pool_run(spawn_pool_t *pool, char *const argv[], int stdin_fd, int stdout_fd,
+                   int stderr_fd, int *status, struct rusage *usage) {
+    char message[SPAWN_POOL_MESSAGE_SIZE];
+    request_header_t header = { 0, 0 };
+    const int standard[STANDARD_FDS] = { stdin_fd, stdout_fd, stderr_fd };
+    int fds[STANDARD_FDS];
+    int fd_count = 0;
+    reply_t reply;
+
+    if (!pool || !argv || !argv[0] || !status) {
+        return EINVAL;
+    }
+
+    size_t length = sizeof(header);
+    for (; argv[header.argc]; header.argc++) {
+        size_t size = strlen(argv[header.argc]) + 1;
+        if (header.argc + 1 >= LAUNCHER_MAX_ARGS || length + size > sizeof(message)) {
+            return E2BIG;
+        }
+        memcpy(message + length, argv[header.argc], size);
+        length += size;
+    }
+    for (int i = 0; i < STANDARD_FDS; i++) {
+        if (standard[i] >= 0) {
+            header.attached |= 1u << i;
+            fds[fd_count++] = standard[i];
+        }
+    }
+    memcpy(message, &header, sizeof(header));
+
+    pthread_mutex_lock(&pool->lock);
+    spawn_worker_t *worker = NULL;
+    while (!worker && pool->alive > 0) {
+        for (int i = 0; i < pool->count; i++) {
+            if (pool->workers[i].fd >= 0 && !pool->workers[i].busy) {
+                worker = &pool->workers[i];
+                break;
+            }
+        }
+        if (!worker) {
+            pthread_cond_wait(&pool->idle, &pool->lock);
+        }
+    }
+    if (!worker) {
+        pthread_mutex_unlock(&pool->lock);
+        return ECHILD;
+    }
+    worker->busy = 1;
+    pthread_mutex_unlock(&pool->lock);
+
+    // The command may write to the same descriptors; keep our output before its
+    fflush(NULL);
+    int result = exchange(worker->fd, message, length, fds, fd_count, &reply);
+
+    pthread_mutex_lock(&pool->lock);
+    worker->busy = 0;
+    if (result != 0) {
+        // A helper that cannot be talked to is of no further use
+        close(worker->fd);
+        worker->fd = -1;
+        pool->alive--;
+        kill(worker->pid, SIGKILL);
+    }
+    pthread_cond_broadcast(&pool->idle);
+    pthread_mutex_unlock(&pool->lock);
+
+    if (result != 0) {
+        return result;
+    }
+    *status = reply.status;
+    if (usage) {
+        *usage = reply.usage;
+    }
+    return reply.error;
+}
+
+/**
+ * @brief Split a command line (see launcher_split()) and run it on the pool
+ */
+int spawn_pool_run_line(spawn_pool_t *pool, const char *command, int *status,
+                        struct rusage *usage) {
+    char line[SPAWN_POOL_MESSAGE_SIZE];
+    char *argv[LAUNCHER_MAX_ARGS];
+    int argc;
+
+    if (!command) {
+        return EINVAL;
+    }
+    int length = snprintf(line, sizeof(line), "%s", command);
+    if (length < 0 || (size_t)length >= sizeof(line)) {
+        return E2BIG;
+    }
+    int result = launcher_split(line, argv, LAUNCHER_MAX_ARGS, &argc);
+    if (result != 0) {
+        return result;
+    }
+    return spawn_pool_run(pool, argv, -1, -1, -1, status, usage);
+}
@@ -0,0 +1,93 @@
+/**
+ * @file spawn_pool.h
+ * @brief Prefork pool of small helper processes that start commands on request
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * fork() copies the caller's page tables, so its cost grows with the
+ * parent's resident memory; a program that forks commands late, after its
+ * heap has grown, pays for every page it owns. spawn_pool_create() forks
+ * the helpers early, while the process is still small. Each helper then
+ * waits on its end of a SOCK_SEQPACKET socket pair:
+ * - spawn_pool_run() sends argv (NUL-separated strings in one message) and,
+ *   optionally, descriptors for the command's stdin/stdout/stderr as
+ *   SCM_RIGHTS ancillary data
+ * - the helper starts the command with the posix_spawn launcher, waits for
+ *   it with wait4() and replies with the spawn error, the wait status and
+ *   the command's rusage
+ * Commands therefore run as children of the helper, never of the (large)
+ * caller, and no page of the caller is copied after the pool exists.
+ *
+ * A helper is a snapshot of the caller at spawn_pool_create(): commands
+ * run with the environment, working directory, umask, resource limits and
+ * credentials the caller had then, not with its current ones. A caller
+ * that later changes them must start such commands another way.
+ *
+ * The posix_spawn launcher (command_launcher.h) already avoids copying
+ * page tables, and the pool adds a socket round trip and a second process
+ * on every run. So the pool only pays off where commands would otherwise be
+ * started with fork() from a large process.
+ *
+ * A helper serves one command at a time; spawn_pool_run() takes an idle
+ * helper (waiting for one if all are busy), so the pool is thread-safe and
+ * runs up to `workers` commands concurrently. Create the pool before
+ * starting threads: the helpers are fork()ed copies of the caller.
+ *
+ * A helper that dies is dropped from the pool. The request it was given
+ * fails with ECONNRESET if it was never delivered, so callers can run the
+ * command another way, or with ECONNABORTED if it was delivered, in which
+ * case the command may already have run and must not simply be retried.
+ * Once no helper is left spawn_pool_run() returns ECHILD, so callers can
+ * fall back to the launcher.
+ */
+
+#ifndef SPAWN_POOL_H
+#define SPAWN_POOL_H
+
+#include <pthread.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+/** Upper bound on helpers per pool */
+#define SPAWN_POOL_MAX_WORKERS 16
+
+/** Largest request: argv strings plus a small header */
+#define SPAWN_POOL_MESSAGE_SIZE 8192
+
+/**
+ * @brief One helper process and the parent's end of its socket
+ */
+typedef struct {
+    pid_t pid;
+    int fd;                     /**< -1 once the helper is gone */
+    int busy;
+} spawn_worker_t;
+
+/**
+ * @brief A pool of helpers; create with spawn_pool_create()
+ */
+typedef struct {
+    spawn_worker_t workers[SPAWN_POOL_MAX_WORKERS];
+    int count;
+    int alive;                  /**< Helpers still usable */
+    pthread_mutex_t lock;
+    pthread_cond_t idle;
+} spawn_pool_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+int spawn_pool_create(spawn_pool_t *pool, int workers);
+void spawn_pool_destroy(spawn_pool_t *pool);
+
+int spawn_pool_run(spawn_pool_t *pool, char *const argv[], int stdin_fd, int stdout_fd,
+                   int stderr_fd, int *status, struct rusage *usage);
+int spawn_pool_run_line(spawn_pool_t *pool, const char *command, int *status,
+                        struct rusage *usage);
+
+#endif /* SPAWN_POOL_H */
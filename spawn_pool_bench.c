@@ -0,0 +1,238 @@
+/**
+ * @file spawn_pool_bench.c
+ * @brief Spawn latency as the parent's RSS grows: fork+exec vs posix_spawn vs prefork pool
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * The pool is created first, while this process is small. The heap is then
+ * grown in steps (touched, so it is resident), and at every step `true` is
+ * started and waited for N times with:
+ * - fork+exec:    fork(), execvp() in the child, waitpid(); fork copies the
+ *                 page tables of everything resident
+ * - posix_spawn:  launcher_run(); glibc uses CLONE_VFORK, so nothing is
+ *                 copied, but the spawn still happens in the large process
+ * - prefork pool: spawn_pool_run(); argv goes over a socket to a helper
+ *                 forked before the heap grew, which spawns and waits
+ *
+ * Checks: every command exits 0; at the largest RSS the pool is faster
+ * than fork+exec, and its latency grows less than fork+exec's does.
+ *
+ * Usage: ./spawn_pool_bench [max RSS MB] [runs per step]
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "clock_ns.h"
+#include "command_launcher.h"
+#include "spawn_pool.h"
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+#define DEFAULT_MAX_MB 1024L
+#define DEFAULT_RUNS 200L
+#define POOL_WORKERS 2
+
+/** Heap is grown in chunks of this size */
+#define CHUNK_MB 64
+
+/** RSS steps, as fractions of the maximum (in 1/8ths); 0 is the start */
+static const int steps[] = { 0, 1, 2, 4, 8 };
+
+#define NUM_STEPS ((int)(sizeof(steps) / sizeof(steps[0])))
+
+enum {
+    METHOD_FORK,
+    METHOD_SPAWN,
+    METHOD_POOL,
+    METHOD_COUNT
+};
+
+static const char *const method_names[METHOD_COUNT] = {
+    "fork+exec", "posix_spawn", "prefork pool"
+};
+
+/*============================================================================
+ * UTILITY FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Resident set size of this process in MB
+ */
+static double rss_mb(void) {
+    long pages = 0;
+    long resident = 0;
+
+    FILE *file = fopen("/proc/self/statm", "r");
+    if (!file) {
+        return 0.0;
+    }
+    if (fscanf(file, "%ld %ld", &pages, &resident) != 2) {
+        resident = 0;
+    }
+    fclose(file);
+    return (double)resident * (double)sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0);
+}
+
+static int exited_zero(int status) {
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+/**
+ * @brief Start `true` once with a method and wait for it
+ * @return 0 if it ran and exited 0
+ */
+static int run_once(int method, spawn_pool_t *pool) {
+    char *argv[] = { "true", NULL };
+    int status = 0;
+    int result = 0;
+
+    switch (method) {
+    case METHOD_FORK: {
+        pid_t pid = fork();
+        if (pid == -1) {
+            return errno;
+        }
+        if (pid == 0) {
+            execvp(argv[0], argv);
+            _exit(127);
+        }
+        while (waitpid(pid, &status, 0) == -1) {
+            if (errno != EINTR) {
+                return errno;
+            }
+        }
+        break;
+    }
+    case METHOD_SPAWN:
+        result = launcher_run(argv, &status);
+        break;
+    default:
+        result = spawn_pool_run(pool, argv, -1, -1, -1, &status, NULL);
+        break;
+    }
+    return (result == 0 && exited_zero(status)) ? 0 : (result ? result : ECHILD);
+}
+
+/**
+ * @brief Average microseconds per run
+ * @return Negative if a run failed
+ */
+static double time_method(int method, spawn_pool_t *pool, long runs) {
+    long long start = now_ns();
+    for (long i = 0; i < runs; i++) {
+        if (run_once(method, pool) != 0) {
+            return -1.0;
+        }
+    }
+    return (double)(now_ns() - start) / (double)runs / 1e3;
+}
+
+/*============================================================================
+ * MAIN FUNCTION
+ *============================================================================*/
+
+/**
+ * @brief Main function - times every method at growing RSS
+ * @return EXIT_SUCCESS on success, EXIT_FAILURE on bad arguments or a
+ *         failed check
+ */
+int main(int argc, char **argv) {
+    long max_mb = DEFAULT_MAX_MB;
+    long runs = DEFAULT_RUNS;
+    spawn_pool_t pool;
+
+    if (argc > 1) {
+        max_mb = strtol(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        runs = strtol(argv[2], NULL, 10);
+    }
+    if (max_mb < CHUNK_MB || max_mb > 65536 || runs < 1) {
+        fprintf(stderr, "Usage: %s [max RSS MB %d..65536] [runs >= 1]\n", argv[0], CHUNK_MB);
+        return EXIT_FAILURE;
+    }
+
+    // Before anything else, while the process is small
+    int result = spawn_pool_create(&pool, POOL_WORKERS);
+    if (result != 0) {
+        fprintf(stderr, "Failed to create the pool: %s\n", strerror(result));
+        return EXIT_FAILURE;
+    }
+
+    long max_chunks = max_mb / CHUNK_MB;
+    char **chunks = calloc((size_t)max_chunks, sizeof(char *));
+    if (!chunks) {
+        spawn_pool_destroy(&pool);
+        return EXIT_FAILURE;
+    }
+
+    printf("========================================================\n");
+    printf("    SPAWN POOL BENCHMARK\n");
+    printf("========================================================\n");
+    printf("Runs of `true` per step: %ld, pool helpers: %d\n\n", runs, POOL_WORKERS);
+    printf("%9s %13s %13s %13s\n", "RSS (MB)", "fork+exec", "posix_spawn", "prefork pool");
+
+    double first[METHOD_COUNT] = { 0 };
+    double last[METHOD_COUNT] = { 0 };
+    int failed = 0;
+    long allocated = 0;
+
+    for (int s = 0; s < NUM_STEPS && !failed; s++) {
+        long target = max_chunks * steps[s] / 8;
+        for (; allocated < target; allocated++) {
+            chunks[allocated] = malloc((size_t)CHUNK_MB << 20);
+            if (!chunks[allocated]) {
+                fprintf(stderr, "Out of memory at %ld MB\n", allocated * CHUNK_MB);
+                failed = 1;
+                break;
+            }
+            // Touch every page so the heap is resident
+            memset(chunks[allocated], (int)allocated + 1, (size_t)CHUNK_MB << 20);
+        }
+        if (failed) {
+            break;
+        }
+
+        double us[METHOD_COUNT];
+        for (int m = 0; m < METHOD_COUNT; m++) {
+            us[m] = time_method(m, &pool, runs);
+            failed |= us[m] < 0;
+            if (s == 0) {
+                first[m] = us[m];
+            }
+            last[m] = us[m];
+        }
+        printf("%9.0f %10.1f us %10.1f us %10.1f us\n", rss_mb(), us[METHOD_FORK],
+               us[METHOD_SPAWN], us[METHOD_POOL]);
+    }
+
+    for (long i = 0; i < allocated; i++) {
+        free(chunks[i]);
+    }
+    free(chunks);
+    spawn_pool_destroy(&pool);
+
+    double fork_growth = first[METHOD_FORK] > 0 ? last[METHOD_FORK] / first[METHOD_FORK] : 0;
+    double pool_growth = first[METHOD_POOL] > 0 ? last[METHOD_POOL] / first[METHOD_POOL] : 0;
+    printf("\nGrowth from smallest to largest RSS:");
+    for (int m = 0; m < METHOD_COUNT; m++) {
+        printf(" %s %.2fx%s", method_names[m], first[m] > 0 ? last[m] / first[m] : 0.0,
+               m + 1 < METHOD_COUNT ? "," : "\n");
+    }
+
+    int ok = !failed && last[METHOD_POOL] < last[METHOD_FORK] && pool_growth < fork_growth;
+    printf("\nCheck: runs %s, pool %s fork+exec at the largest RSS: %s\n",
+           failed ? "FAILED" : "ok",
+           last[METHOD_POOL] < last[METHOD_FORK] ? "beats" : "DOES NOT beat",
+           ok ? "ok" : "FAILED");
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
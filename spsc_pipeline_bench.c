@@ -0,0 +1,302 @@
+/**
+ * @file spsc_pipeline_bench.c
+ * @brief Producer/consumer pipeline: SPSC ring vs mutex+condvar queue
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * One producer thread sends N small messages to one consumer thread through:
+ * - spsc ring:    spsc_ring_t with cached head/tail indices, waiting by
+ *                 spinning (multi-CPU only) and yielding
+ * - mutex+condvar: a bounded circular queue of the same capacity guarded by
+ *                 one mutex, with "not full" and "not empty" condition
+ *                 variables, the textbook blocking queue
+ *
+ * Every LATENCY_SAMPLE_MASK + 1'th message carries the producer's send time;
+ * the consumer records send-to-receive latency in a latency histogram. The
+ * producer runs flat out, so the latency includes time spent queued behind
+ * a full ring.
+ *
+ * Checks: messages arrive in sequence order and the payload sum matches.
+ *
+ * Usage: ./spsc_pipeline_bench [messages] [capacity]
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "clock_ns.h"
+#include "futex_sync.h"
+#include "latency_histogram.h"
+#include "spsc_ring.h"
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+#define DEFAULT_MESSAGES 10000000L
+#define DEFAULT_CAPACITY 4096L
+
+/** Stamp one message in (mask + 1) with its send time */
+#define LATENCY_SAMPLE_MASK 63
+
+/**
+ * @brief Message passed down the pipeline
+ */
+typedef struct {
+    uint64_t sequence;
+    uint64_t sent_ns;           /**< Send time, 0 if not sampled */
+} message_t;
+
+/**
+ * @brief Bounded blocking queue: the mutex+condvar baseline
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t not_full;
+    pthread_cond_t not_empty;
+    message_t *slots;
+    size_t capacity;
+    size_t head;                /**< Next slot to read */
+    size_t count;               /**< Messages queued */
+} blocking_queue_t;
+
+/**
+ * @brief One queue implementation under test
+ */
+typedef struct {
+    const char *name;
+    void (*send)(const message_t *message);
+    void (*receive)(message_t *message);
+} queue_ops_t;
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+static spsc_ring_t *ring = NULL;
+static blocking_queue_t queue;
+
+/** Run parameters, read-only while the threads run */
+static const queue_ops_t *active_ops = NULL;
+static long active_messages = 0;
+static futex_start_gate_t start_gate;
+
+/*============================================================================
+ * QUEUES
+ *============================================================================*/
+
+static void ring_send(const message_t *message) {
+    message_t *slot = spsc_ring_wait_reserve(ring);
+    *slot = *message;
+    spsc_ring_publish(ring);
+}
+
+static void ring_receive(message_t *message) {
+    const message_t *slot = spsc_ring_wait_front(ring);
+    *message = *slot;
+    spsc_ring_pop(ring);
+}
+
+static int queue_init(blocking_queue_t *q, size_t capacity) {
+    q->slots = malloc(capacity * sizeof(message_t));
+    if (!q->slots) {
+        return -1;
+    }
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->not_full, NULL);
+    pthread_cond_init(&q->not_empty, NULL);
+    q->capacity = capacity;
+    q->head = 0;
+    q->count = 0;
+    return 0;
+}
+
+static void queue_destroy(blocking_queue_t *q) {
+    pthread_cond_destroy(&q->not_empty);
+    pthread_cond_destroy(&q->not_full);
+    pthread_mutex_destroy(&q->lock);
+    free(q->slots);
+}
+
+static void queue_send(const message_t *message) {
+    pthread_mutex_lock(&queue.lock);
+    while (queue.count == queue.capacity) {
+        pthread_cond_wait(&queue.not_full, &queue.lock);
+    }
+    queue.slots[(queue.head + queue.count) % queue.capacity] = *message;
+    queue.count++;
+    pthread_cond_signal(&queue.not_empty);
+    pthread_mutex_unlock(&queue.lock);
+}
+
+static void queue_receive(message_t *message) {
+    pthread_mutex_lock(&queue.lock);
+    while (queue.count == 0) {
+        pthread_cond_wait(&queue.not_empty, &queue.lock);
+    }
+    *message = queue.slots[queue.head];
+    queue.head = (queue.head + 1) % queue.capacity;
+    queue.count--;
+    pthread_cond_signal(&queue.not_full);
+    pthread_mutex_unlock(&queue.lock);
+}
+
+static const queue_ops_t queue_variants[] = {
+    { "spsc ring", ring_send, ring_receive },
+    { "mutex+condvar", queue_send, queue_receive }
+};
+
+/*============================================================================
+ * THREAD FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Producer: send sequence numbers 0..N-1, stamping every sample
+ */
+static void *producer_thread(void *arg) {
+    (void)arg;
+    const queue_ops_t *ops = active_ops;
+    long messages = active_messages;
+
+    futex_start_gate_arrive(&start_gate);
+
+    for (long i = 0; i < messages; i++) {
+        message_t message = { (uint64_t)i, 0 };
+        if ((i & LATENCY_SAMPLE_MASK) == 0) {
+            message.sent_ns = (uint64_t)now_ns();
+        }
+        ops->send(&message);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Consumer: receive N messages, check order, record latency samples
+ * @param histogram Receives the latency samples
+ * @param[out] out_of_order Messages whose sequence number was unexpected
+ * @return Sum of the received sequence numbers
+ */
+static uint64_t consume(latency_histogram_t *histogram, unsigned long *out_of_order) {
+    const queue_ops_t *ops = active_ops;
+    long messages = active_messages;
+    uint64_t sum = 0;
+
+    *out_of_order = 0;
+    for (long i = 0; i < messages; i++) {
+        message_t message;
+        ops->receive(&message);
+        if (message.sequence != (uint64_t)i) {
+            (*out_of_order)++;
+        }
+        if (message.sent_ns != 0) {
+            latency_histogram_record(histogram, (uint64_t)now_ns() - message.sent_ns);
+        }
+        sum += message.sequence;
+    }
+    return sum;
+}
+
+/**
+ * @brief Run one queue variant and print its row
+ * @return Non-zero if a check failed
+ */
+static int bench_variant(const queue_ops_t *ops, long messages) {
+    latency_histogram_t histogram;
+    unsigned long out_of_order;
+    pthread_t producer;
+
+    latency_histogram_init(&histogram);
+    active_ops = ops;
+    active_messages = messages;
+    futex_start_gate_init(&start_gate, 1);
+
+    int result = pthread_create(&producer, NULL, producer_thread, NULL);
+    if (result != 0) {
+        fprintf(stderr, "Failed to create producer: %s\n", strerror(result));
+        exit(EXIT_FAILURE); // The gate would never open
+    }
+
+    // This thread is the consumer
+    futex_latch_wait(&start_gate.ready);
+    long long start = now_ns();
+    futex_event_set(&start_gate.go);
+    uint64_t sum = consume(&histogram, &out_of_order);
+    long long elapsed = now_ns() - start;
+    pthread_join(producer, NULL);
+
+    uint64_t expected_sum = (uint64_t)messages * (uint64_t)(messages - 1) / 2;
+    int ok = out_of_order == 0 && sum == expected_sum;
+
+    char p50[LATENCY_FORMAT_SIZE];
+    char p99[LATENCY_FORMAT_SIZE];
+    char max[LATENCY_FORMAT_SIZE];
+    printf("%-14s %10.2f %10.1f %10s %10s %10s  %s\n", ops->name,
+           (double)messages / ((double)elapsed / 1e9) / 1e6,
+           (double)elapsed / (double)messages,
+           latency_format_ns(p50, sizeof(p50), latency_histogram_percentile(&histogram, 50.0)),
+           latency_format_ns(p99, sizeof(p99), latency_histogram_percentile(&histogram, 99.0)),
+           latency_format_ns(max, sizeof(max), histogram.max),
+           ok ? "ok" : "FAILED");
+    return !ok;
+}
+
+/*============================================================================
+ * MAIN FUNCTION
+ *============================================================================*/
+
+/**
+ * @brief Main function - runs every queue variant
+ * @return EXIT_SUCCESS on success, EXIT_FAILURE on bad arguments, setup
+ *         failure or a message lost, duplicated or reordered
+ */
+int main(int argc, char **argv) {
+    long messages = DEFAULT_MESSAGES;
+    long capacity = DEFAULT_CAPACITY;
+
+    if (argc > 1) {
+        messages = strtol(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        capacity = strtol(argv[2], NULL, 10);
+    }
+    if (messages <= 0 || capacity <= 0) {
+        fprintf(stderr, "Usage: %s [messages > 0] [capacity > 0]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    ring = spsc_ring_create((size_t)capacity, sizeof(message_t));
+    if (!ring) {
+        fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+    // Same number of slots for both, after the ring's power-of-two rounding
+    if (queue_init(&queue, spsc_ring_capacity(ring)) != 0) {
+        fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("========================================================\n");
+    printf("    SPSC PIPELINE BENCHMARK\n");
+    printf("========================================================\n");
+    printf("Messages: %ld of %zu bytes, capacity: %zu, online CPUs: %ld\n",
+           messages, sizeof(message_t), spsc_ring_capacity(ring), sysconf(_SC_NPROCESSORS_ONLN));
+    printf("Latency sampled every %d messages, producer unthrottled\n\n",
+           LATENCY_SAMPLE_MASK + 1);
+    printf("%-14s %10s %10s %10s %10s %10s  %s\n", "queue", "Mmsg/s", "ns/msg",
+           "p50", "p99", "max", "check");
+
+    int failed = 0;
+    for (size_t i = 0; i < sizeof(queue_variants) / sizeof(queue_variants[0]); i++) {
+        failed |= bench_variant(&queue_variants[i], messages);
+    }
+
+    queue_destroy(&queue);
+    spsc_ring_destroy(ring);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
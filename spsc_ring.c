@@ -0,0 +1,129 @@
+/**
+ * @file spsc_ring.c
+ * @brief Allocation of cache-aligned SPSC rings and waiting helpers
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "spsc_ring.h"
+
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/** Hint to the CPU that we are spinning */
+#if defined(__x86_64__) || defined(__i386__)
+#define CPU_RELAX() __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define CPU_RELAX() __asm__ __volatile__("yield" ::: "memory")
+#else
+#define CPU_RELAX() do { } while (0)
+#endif
+
+/**
+ * @brief Allocate a ring
+ * @param capacity Minimum number of slots (rounded up to a power of two)
+ * @param element_size Size of each slot in bytes
+ * @return The new ring, or NULL on invalid arguments or allocation failure
+ */
+spsc_ring_t *spsc_ring_create(size_t capacity, size_t element_size) {
+    if (capacity == 0 || element_size == 0 || capacity > ((size_t)-1 >> 1)) {
+        return NULL;
+    }
+
+    size_t slots = 1;
+    while (slots < capacity) {
+        slots <<= 1;
+    }
+    if (element_size > (size_t)-1 / slots) {
+        return NULL;
+    }
+
+    void *memory = NULL;
+    if (posix_memalign(&memory, SPSC_CACHE_LINE, sizeof(spsc_ring_t)) != 0) {
+        return NULL;
+    }
+    spsc_ring_t *ring = memory;
+    memset(ring, 0, sizeof(*ring));
+
+    memory = NULL;
+    if (posix_memalign(&memory, SPSC_CACHE_LINE, slots * element_size) != 0) {
+        free(ring);
+        return NULL;
+    }
+
+    ring->layout.slots = memory;
+    ring->layout.mask = slots - 1;
+    ring->layout.element_size = element_size;
+    return ring;
+}
+
+/**
+ * @brief Free a ring; both sides must have stopped using it
+ */
+void spsc_ring_destroy(spsc_ring_t *ring) {
+    if (!ring) {
+        return;
+    }
+    free(ring->layout.slots);
+    free(ring);
+}
+
+/**
+ * @brief Number of failed attempts to spin through before yielding
+ *
+ * Spinning can only help if the other side runs on another CPU.
+ */
+static int spin_limit(void) {
+    static int limit = -1;
+    int cached = __atomic_load_n(&limit, __ATOMIC_RELAXED);
+
+    if (cached < 0) {
+        cached = sysconf(_SC_NPROCESSORS_ONLN) > 1 ? SPSC_SPIN_LIMIT : 0;
+        __atomic_store_n(&limit, cached, __ATOMIC_RELAXED);
+    }
+    return cached;
+}
+
+/**
+ * @brief Back off after a failed attempt: spin first, then yield
+ */
+static void backoff(int *attempts) {
+    if (*attempts < spin_limit()) {
+        (*attempts)++;
+        CPU_RELAX();
+    } else {
+        sched_yield();
+    }
+}
+
+/**
+ * @brief spsc_ring_reserve() that waits until a slot is free
+ * @note Producer thread only; never returns NULL
+ */
+void *spsc_ring_wait_reserve(spsc_ring_t *ring) {
+    int attempts = 0;
+    void *slot;
+
+    while (!(slot = spsc_ring_reserve(ring))) {
+        backoff(&attempts);
+    }
+    return slot;
+}
+
+/**
+ * @brief spsc_ring_front() that waits until an element is available
+ * @note Consumer thread only; never returns NULL
+ */
+void *spsc_ring_wait_front(spsc_ring_t *ring) {
+    int attempts = 0;
+    void *slot;
+
+    while (!(slot = spsc_ring_front(ring))) {
+        backoff(&attempts);
+    }
+    return slot;
+}
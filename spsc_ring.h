@@ -0,0 +1,162 @@
+/**
+ * @file spsc_ring.h
+ * @brief Cache-friendly single-producer/single-consumer ring buffer
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * A bounded lock-free queue for exactly one producer thread and one consumer
+ * thread. Design points:
+ * - Producer and consumer indices live on separate cache lines, so the two
+ *   sides do not false-share
+ * - Each side keeps a cached copy of the other side's index and only reloads
+ *   it when the ring looks full (producer) or empty (consumer), so in steady
+ *   state the shared cache lines are rarely touched
+ * - Slots are fixed-size and accessed in place (reserve/publish and
+ *   front/pop), so elements are written and read without an extra copy
+ *
+ * Indices run freely and are masked on access; the capacity is rounded up
+ * to a power of two.
+ *
+ * The plain calls never block. spsc_ring_wait_reserve()/spsc_ring_wait_front()
+ * wait for room or data: they spin briefly (only with more than one CPU
+ * online) and then yield the CPU between attempts.
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stddef.h>
+
+/*============================================================================
+ * CONSTANTS AND MACROS
+ *============================================================================*/
+
+/** Assumed cache line size used to separate producer and consumer state */
+#define SPSC_CACHE_LINE 64
+
+/** Align a member to its own cache line */
+#define SPSC_CACHE_ALIGNED __attribute__((aligned(SPSC_CACHE_LINE)))
+
+/** Failed attempts a waiting side spins before it starts yielding */
+#define SPSC_SPIN_LIMIT 1024
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+/**
+ * @brief SPSC ring; allocate with spsc_ring_create() so alignment is honored
+ */
+typedef struct {
+    /** Consumer-owned: next slot to read and last observed producer tail */
+    struct {
+        size_t head;
+        size_t cached_tail;
+    } consumer SPSC_CACHE_ALIGNED;
+
+    /** Producer-owned: next slot to write and last observed consumer head */
+    struct {
+        size_t tail;
+        size_t cached_head;
+    } producer SPSC_CACHE_ALIGNED;
+
+    /** Read-only after creation */
+    struct {
+        unsigned char *slots;
+        size_t mask;
+        size_t element_size;
+    } layout SPSC_CACHE_ALIGNED;
+} spsc_ring_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+spsc_ring_t *spsc_ring_create(size_t capacity, size_t element_size);
+void spsc_ring_destroy(spsc_ring_t *ring);
+void *spsc_ring_wait_reserve(spsc_ring_t *ring);
+void *spsc_ring_wait_front(spsc_ring_t *ring);
+
+/*============================================================================
+ * PRODUCER SIDE
+ *============================================================================*/
+
+/**
+ * @brief Reserve the next free slot for writing
+ * @return Pointer to the slot, or NULL if the ring is full
+ * @note Producer thread only; follow with spsc_ring_publish()
+ */
+static inline void *spsc_ring_reserve(spsc_ring_t *ring) {
+    size_t tail = __atomic_load_n(&ring->producer.tail, __ATOMIC_RELAXED);
+
+    if (tail - ring->producer.cached_head > ring->layout.mask) {
+        ring->producer.cached_head =
+            __atomic_load_n(&ring->consumer.head, __ATOMIC_ACQUIRE);
+        if (tail - ring->producer.cached_head > ring->layout.mask) {
+            return NULL;
+        }
+    }
+
+    return ring->layout.slots + (tail & ring->layout.mask) * ring->layout.element_size;
+}
+
+/**
+ * @brief Make the slot returned by spsc_ring_reserve() visible to the consumer
+ */
+static inline void spsc_ring_publish(spsc_ring_t *ring) {
+    size_t tail = __atomic_load_n(&ring->producer.tail, __ATOMIC_RELAXED);
+    __atomic_store_n(&ring->producer.tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+/*============================================================================
+ * CONSUMER SIDE
+ *============================================================================*/
+
+/**
+ * @brief Oldest unread slot
+ * @return Pointer to the slot, or NULL if the ring is empty
+ * @note Consumer thread only; follow with spsc_ring_pop() once done with it
+ */
+static inline void *spsc_ring_front(spsc_ring_t *ring) {
+    size_t head = __atomic_load_n(&ring->consumer.head, __ATOMIC_RELAXED);
+
+    if (head == ring->consumer.cached_tail) {
+        ring->consumer.cached_tail =
+            __atomic_load_n(&ring->producer.tail, __ATOMIC_ACQUIRE);
+        if (head == ring->consumer.cached_tail) {
+            return NULL;
+        }
+    }
+
+    return ring->layout.slots + (head & ring->layout.mask) * ring->layout.element_size;
+}
+
+/**
+ * @brief Release the slot returned by spsc_ring_front() back to the producer
+ */
+static inline void spsc_ring_pop(spsc_ring_t *ring) {
+    size_t head = __atomic_load_n(&ring->consumer.head, __ATOMIC_RELAXED);
+    __atomic_store_n(&ring->consumer.head, head + 1, __ATOMIC_RELEASE);
+}
+
+/*============================================================================
+ * EITHER SIDE
+ *============================================================================*/
+
+/**
+ * @brief Whether the consumer has caught up with everything published so far
+ * @note Exact from the producer's point of view; a snapshot otherwise
+ */
+static inline int spsc_ring_empty(const spsc_ring_t *ring) {
+    return __atomic_load_n(&ring->consumer.head, __ATOMIC_ACQUIRE) ==
+           __atomic_load_n(&ring->producer.tail, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Number of usable slots
+ */
+static inline size_t spsc_ring_capacity(const spsc_ring_t *ring) {
+    return ring->layout.mask + 1;
+}
+
+#endif /* SPSC_RING_H */
@@ -6,10 +6,59 @@
  *
  * This program demonstrates various ways to execute system commands from C:
  * - Using system() function
- * - Using popen() for command output capture
+ * - Capturing command output without popen() (command_launcher.h)
  * - Using execvp() family functions
  * - Proper error handling and security considerations
  *
+ * With ENABLE_SPAWN_LAUNCHER, safe_system_command() runs commands through the
+ * posix_spawn launcher (command_launcher.h) instead of system(): argv is
+ * exec'd directly, without forking a /bin/sh for every command.
+ *
+ * Output capture reads the command's stdout pipe with large read() calls
+ * into a buffer that grows as needed, so output is never truncated and is
+ * returned as a pointer and length instead of being scanned line by line.
+ *
+ * `ps aux | head` runs as a shell-free pipeline (command_pipeline.h): the
+ * stages are connected with pipe2() and spawned directly, and ps is stopped
+ * as soon as head has printed its lines.
+ *
+ * With ENABLE_COMMAND_STATS, every command run through safe_system_command()
+ * or execute_command_with_output() is accounted for (command_stats.h): wall
+ * time plus the rusage wait4() reports. The per-command histograms are
+ * printed at the end and dumped to COMMAND_STATS_CSV.
+ *
+ * Executables are located with the in-process PATH cache (path_cache.h)
+ * instead of spawning `which`.
+ *
+ * The same system checks are then run again concurrently by the command
+ * runner (command_runner.h): one epoll loop collects every command's
+ * stdout and stderr and notices exits through pidfds.
+ *
+ * With ENABLE_BUILTIN_COMMANDS, date, uname -a, ls -la and df -h . are
+ * answered in-process (builtin_commands.h) with the same output as the
+ * programs; other commands still run externally. The builtin demonstration
+ * times both ways for each system check.
+ *
+ * The file capture demonstration runs several commands at once with their
+ * stdout copied into files (file_capture.h); with ENABLE_IO_URING_CAPTURE the
+ * copying is done with batched io_uring requests where the kernel allows it,
+ * and with epoll otherwise.
+ *
+ * With ENABLE_NATIVE_DOWNLOAD, the FFmpeg download demonstration also
+ * fetches a file in-process (http_download.h): several parallel Range
+ * requests written with pwrite() into a preallocated file, resumable. The
+ * FFmpeg mirror is https://, which the native client does not speak, so it
+ * downloads from the loopback test server (http_test_server.h) instead.
+ *
+ * With ENABLE_SPAWN_POOL, a few helper processes (spawn_pool.h) are forked
+ * at the very start of main(), while the program is small, and the external
+ * commands of safe_system_command() are started by them: argv is sent over
+ * a Unix socket, so no command is forked from the grown process. Commands
+ * then see the environment and working directory main() started with. If
+ * the pool cannot be created or its helpers die, the launcher is used
+ * instead. The switch is off by default: this program never grows large
+ * enough for the pool to beat the launcher.
+ *
  * Originally inspired by a command to download FFmpeg:
  * wget -O ffmpeg.tar.xz https://johnvansickle.com/ffmpeg/builds/ffmpeg-git-arm64-static.tar.xz
  */
@@ -21,34 +70,142 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <time.h>
+#include <sys/resource.h>
 #include <sys/wait.h>
 #include <errno.h>
+#include <limits.h>
+
+#include "builtin_commands.h"
+#include "command_launcher.h"
+#include "command_pipeline.h"
+#include "command_runner.h"
+#include "command_stats.h"
+#include "file_capture.h"
+#include "http_download.h"
+#include "http_test_server.h"
+#include "path_cache.h"
+#include "spawn_pool.h"
 
 /*============================================================================
  * CONSTANTS AND CONFIGURATION
  *============================================================================*/
 
 #define MAX_COMMAND_LENGTH 1024
-#define MAX_OUTPUT_LENGTH 4096
+#define PS_PREVIEW_LINES 10
 #define FFMPEG_URL "https://johnvansickle.com/ffmpeg/builds/ffmpeg-git-arm64-static.tar.xz"
 #define OUTPUT_FILENAME "ffmpeg.tar.xz"
 
+/** Run safe_system_command() through posix_spawn instead of system() */
+#define ENABLE_SPAWN_LAUNCHER 1
+
+/** Answer date/uname/ls/df in-process instead of spawning them */
+#define ENABLE_BUILTIN_COMMANDS 1
+
+/** Record wall time and rusage of every command run */
+#define ENABLE_COMMAND_STATS 1
+
+/** Copy captured output to files with io_uring when available (epoll otherwise) */
+#define ENABLE_IO_URING_CAPTURE 1
+
+/** Demonstrate the in-process range downloader on a loopback server */
+#define ENABLE_NATIVE_DOWNLOAD 1
+
+/**
+ * Start external commands from helpers forked at startup. Off: this program
+ * stays small and the posix_spawn launcher never copies its page tables,
+ * so the extra hop through a helper only adds latency (spawn_pool_bench)
+ */
+#define ENABLE_SPAWN_POOL 0
+
+/** Helpers in the spawn pool */
+#define SPAWN_POOL_WORKERS 2
+
+/** Size, per-connection rate and connections of the native download */
+#define NATIVE_DOWNLOAD_BYTES (8 * 1024 * 1024)
+#define NATIVE_DOWNLOAD_RATE (16 * 1000 * 1000)
+#define NATIVE_DOWNLOAD_CONNECTIONS 4
+
+/** Where the per-command histograms are dumped as CSV */
+#define COMMAND_STATS_CSV "command_stats.csv"
+
+/** How execute_command_with_output() collects output (pipe or memfd) */
+#define OUTPUT_CAPTURE_MODE LAUNCHER_CAPTURE_PIPE
+
+/** Commands the parallel runner keeps in flight at once */
+#define MAX_PARALLEL_COMMANDS 4
+
+/** Runs of each system check timed by the builtin demonstration */
+#define BUILTIN_TIMING_RUNS 20
+
+/**
+ * @brief A system check run by the system() and parallel runner demos
+ */
+typedef struct {
+    const char *description;
+    const char *command;
+} system_check_t;
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+static const system_check_t system_checks[] = {
+    { "Listing current directory contents", "ls -la" },
+    { "Showing current date and time", "date" },
+    { "Checking disk usage", "df -h ." },
+    { "Showing system information", "uname -a" }
+};
+
+#define NUM_SYSTEM_CHECKS ((int)(sizeof(system_checks) / sizeof(system_checks[0])))
+
+#if ENABLE_SPAWN_POOL
+static spawn_pool_t spawn_pool;
+static int spawn_pool_ready = 0;
+#endif
+
 /*============================================================================
  * FUNCTION PROTOTYPES
  *============================================================================*/
 
-static void demonstrate_system_function(void);
-static void demonstrate_popen_function(void);
+static double demonstrate_system_function(void);
+static void demonstrate_parallel_commands(double sequential_ms);
+static void demonstrate_builtin_commands(void);
+static void demonstrate_command_stats(void);
+static void demonstrate_output_capture(void);
+static void demonstrate_file_capture(void);
 static void demonstrate_exec_family(void);
-static int execute_command_with_output(const char *command, char *output, size_t output_size);
+static int execute_command_with_output(const char *command, launcher_output_t *output);
 static int safe_system_command(const char *command);
+static int run_external_command(const char *command, int *status, struct rusage *usage);
 static void download_ffmpeg_demo(void);
+static void demonstrate_native_download(void);
 static void print_security_warning(void);
+static double elapsed_ms(const struct timespec *start);
+static void record_command(const char *command, command_kind_t kind, int status,
+                           const struct timespec *start, const struct rusage *usage);
 
 /*============================================================================
  * UTILITY FUNCTIONS
  *============================================================================*/
 
+/**
+ * @brief Run a command line without a shell, on the spawn pool when it is up
+ * @return 0 or an errno value (see launcher_run_line_usage())
+ */
+static int run_external_command(const char *command, int *status, struct rusage *usage) {
+#if ENABLE_SPAWN_POOL
+    if (spawn_pool_ready) {
+        int result = spawn_pool_run_line(&spawn_pool, command, status, usage);
+        // Only a request that never reached a helper may be run again
+        if (result != ECONNRESET && result != ECHILD) {
+            return result;
+        }
+    }
+#endif
+    return launcher_run_line_usage(command, status, usage);
+}
+
 /**
  * @brief Safely execute a system command with error checking
  * @param command The command to execute
@@ -62,12 +219,48 @@ static int safe_system_command(const char *command) {
 
     printf("Executing command: %s\n", command);
 
+    struct timespec start;
+    struct rusage usage;
+    command_kind_t kind = COMMAND_KIND_EXTERNAL;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+#if ENABLE_BUILTIN_COMMANDS
+    int result;
+    struct rusage before;
+    getrusage(RUSAGE_THREAD, &before);
+    int launch_error = builtin_run_line(command, stdout, &result);
+
+    if (launch_error == 0) {
+        kind = COMMAND_KIND_BUILTIN;
+        command_stats_usage_since(&before, &usage);
+    } else if (launch_error == ENOTSUP) {
+        launch_error = run_external_command(command, &result, &usage);
+    }
+    if (launch_error != 0) {
+        fprintf(stderr, "Error: Failed to execute command: %s\n", strerror(launch_error));
+        return -1;
+    }
+    record_command(command, kind, result, &start, &usage);
+#elif ENABLE_SPAWN_LAUNCHER
+    int result;
+    int launch_error = run_external_command(command, &result, &usage);
+
+    if (launch_error != 0) {
+        fprintf(stderr, "Error: Failed to execute command: %s\n", strerror(launch_error));
+        return -1;
+    }
+    record_command(command, kind, result, &start, &usage);
+#else
     int result = system(command);
 
     if (result == -1) {
         fprintf(stderr, "Error: Failed to execute command: %s\n", strerror(errno));
         return -1;
     }
+    // system() reaps the child itself, so only the wall-clock time is known
+    (void)usage;
+    record_command(command, kind, result, &start, NULL);
+#endif
 
     // Check if the command was executed successfully
     if (WIFEXITED(result)) {
@@ -86,55 +279,78 @@ static int safe_system_command(const char *command) {
 }
 
 /**
- * @brief Execute a command and capture its output
- * @param command The command to execute
- * @param output Buffer to store the command output
- * @param output_size Size of the output buffer
+ * @brief Execute a command and capture its whole output
+ * @param command The command to execute (no shell syntax)
+ * @param output Receives the output; release it with launcher_output_free()
  * @return 0 on success, -1 on failure
  */
-static int execute_command_with_output(const char *command, char *output, size_t output_size) {
-    if (!command || !output || output_size == 0) {
+static int execute_command_with_output(const char *command, launcher_output_t *output) {
+    if (!command || !output) {
         fprintf(stderr, "Error: Invalid parameters provided\n");
         return -1;
     }
 
     printf("Executing command with output capture: %s\n", command);
 
-    FILE *pipe = popen(command, "r");
-    if (!pipe) {
-        fprintf(stderr, "Error: Failed to open pipe: %s\n", strerror(errno));
-        return -1;
+    int status;
+    int result = ENOTSUP;
+    struct timespec start;
+    struct rusage usage;
+    command_kind_t kind = COMMAND_KIND_EXTERNAL;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+#if ENABLE_BUILTIN_COMMANDS
+    struct rusage before;
+    getrusage(RUSAGE_THREAD, &before);
+    result = builtin_capture_line(command, output, &status);
+    if (result == 0) {
+        kind = COMMAND_KIND_BUILTIN;
+        command_stats_usage_since(&before, &usage);
     }
-
-    // Read command output
-    size_t bytes_read = 0;
-    char *current_pos = output;
-    size_t remaining_space = output_size - 1; // Leave space for null terminator
-
-    while (remaining_space > 0 && fgets(current_pos, remaining_space, pipe) != NULL) {
-        size_t line_length = strlen(current_pos);
-        current_pos += line_length;
-        remaining_space -= line_length;
-        bytes_read += line_length;
+#endif
+    if (result == ENOTSUP) {
+        result = launcher_capture_line_usage(command, OUTPUT_CAPTURE_MODE, output, &status, &usage);
     }
-
-    output[bytes_read] = '\0'; // Ensure null termination
-
-    int exit_status = pclose(pipe);
-    if (exit_status == -1) {
-        fprintf(stderr, "Error: Failed to close pipe: %s\n", strerror(errno));
+    if (result != 0) {
+        fprintf(stderr, "Error: Failed to capture command output: %s\n", strerror(result));
         return -1;
     }
+    record_command(command, kind, status, &start, &usage);
 
-    if (WIFEXITED(exit_status) && WEXITSTATUS(exit_status) == 0) {
-        printf("Command executed successfully, captured %zu bytes of output\n", bytes_read);
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+        printf("Command executed successfully, captured %zu bytes of output\n", output->length);
         return 0;
     } else {
-        fprintf(stderr, "Command failed with exit status: %d\n", WEXITSTATUS(exit_status));
+        fprintf(stderr, "Command failed with exit status: %d\n", WEXITSTATUS(status));
         return -1;
     }
 }
 
+/**
+ * @brief Milliseconds elapsed since start on the monotonic clock
+ */
+static double elapsed_ms(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) * 1e3 +
+           (double)(now.tv_nsec - start->tv_nsec) / 1e6;
+}
+
+/**
+ * @brief Account for a command that started at start and has completed
+ */
+static void record_command(const char *command, command_kind_t kind, int status,
+                           const struct timespec *start, const struct rusage *usage) {
+#if ENABLE_COMMAND_STATS
+    command_stats_record(command, kind, status, (long long)(elapsed_ms(start) * 1e6), usage);
+#else
+    (void)command;
+    (void)kind;
+    (void)status;
+    (void)start;
+    (void)usage;
+#endif
+}
+
 /**
  * @brief Print security warning about system command execution
  */
@@ -147,7 +363,7 @@ static void print_security_warning(void) {
     printf("1. Never pass user input directly to system() without validation\n");
     printf("2. Use absolute paths for commands when possible\n");
     printf("3. Validate and sanitize all input parameters\n");
-    printf("4. Consider using execvp() family for better security\n");
+    printf("4. Consider using posix_spawn()/execvp() with an argv for better security\n");
     printf("5. Be aware of shell injection vulnerabilities\n");
     printf("6. Run with minimal privileges required\n");
     printf("============================================================\n\n");
@@ -159,50 +375,253 @@ static void print_security_warning(void) {
 
 /**
  * @brief Demonstrate the system() function
+ * @return Wall-clock time of running the checks one after another
  */
-static void demonstrate_system_function(void) {
+static double demonstrate_system_function(void) {
     printf("=== SYSTEM() FUNCTION DEMONSTRATION ===\n");
-    printf("The system() function executes a command through the shell.\n\n");
+    printf("The system() function executes a command through the shell.\n");
+#if ENABLE_BUILTIN_COMMANDS
+    printf("Here these commands are answered in-process by builtins instead (no process).\n");
+#elif ENABLE_SPAWN_LAUNCHER
+    printf("Here the commands are exec'd directly with posix_spawn instead (no shell).\n");
+#endif
+    printf("\n");
 
-    // Simple commands
-    printf("1. Listing current directory contents:\n");
-    safe_system_command("ls -la");
+    // Simple commands, one after another
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < NUM_SYSTEM_CHECKS; i++) {
+        printf("%s%d. %s:\n", i > 0 ? "\n" : "", i + 1, system_checks[i].description);
+        safe_system_command(system_checks[i].command);
+    }
+    double sequential_ms = elapsed_ms(&start);
 
-    printf("\n2. Showing current date and time:\n");
-    safe_system_command("date");
+    printf("\n");
+    return sequential_ms;
+}
 
-    printf("\n3. Checking disk usage:\n");
-    safe_system_command("df -h .");
+#if ENABLE_BUILTIN_COMMANDS
+/**
+ * @brief Run the system checks one after another as real processes
+ * @return Wall-clock milliseconds, output captured and discarded like the
+ *         runner's
+ */
+static double time_sequential_processes(void) {
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < NUM_SYSTEM_CHECKS; i++) {
+        launcher_output_t output;
+        int status;
+        launcher_capture_line(system_checks[i].command, OUTPUT_CAPTURE_MODE, &output, &status);
+        launcher_output_free(&output);
+    }
+    return elapsed_ms(&start);
+}
+#endif
 
-    printf("\n4. Showing system information:\n");
-    safe_system_command("uname -a");
+/**
+ * @brief Run the system checks again, concurrently, with the command runner
+ * @param sequential_ms Wall-clock time of the one-after-another run; with
+ *        builtins that run made no processes, so it is re-measured here
+ */
+static void demonstrate_parallel_commands(double sequential_ms) {
+    runner_job_t jobs[NUM_SYSTEM_CHECKS];
+    int prepared = 0;
+
+#if ENABLE_BUILTIN_COMMANDS
+    // Compare processes with processes, not with the in-process builtins
+    sequential_ms = time_sequential_processes();
+#endif
+
+    printf("=== PARALLEL COMMAND RUNNER DEMONSTRATION ===\n");
+    printf("Up to %d commands run at once; one epoll loop collects their stdout and\n",
+           MAX_PARALLEL_COMMANDS);
+    printf("stderr and notices their exits through pidfds.\n\n");
+
+    for (int i = 0; i < NUM_SYSTEM_CHECKS; i++) {
+        int result = runner_job_init(&jobs[i], system_checks[i].command);
+        if (result != 0) {
+            fprintf(stderr, "Error: Cannot prepare '%s': %s\n",
+                    system_checks[i].command, strerror(result));
+            break;
+        }
+        prepared++;
+    }
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int result = runner_run(jobs, prepared, MAX_PARALLEL_COMMANDS);
+    double parallel_ms = elapsed_ms(&start);
 
+    if (result != 0) {
+        fprintf(stderr, "Error: Command runner failed: %s\n", strerror(result));
+    } else {
+        printf("%-10s %6s %10s %10s %10s\n", "command", "exit", "stdout", "stderr", "time (ms)");
+        for (int i = 0; i < prepared; i++) {
+            const runner_job_t *job = &jobs[i];
+            if (job->error != 0) {
+                printf("%-10s failed: %s\n", system_checks[i].command, strerror(job->error));
+                continue;
+            }
+            printf("%-10s %6d %10zu %10zu %10.2f\n", system_checks[i].command,
+                   WIFEXITED(job->status) ? WEXITSTATUS(job->status) : -1,
+                   job->out.length, job->err.length, (double)job->elapsed_ns / 1e6);
+        }
+        printf("\nOne after another: %.2f ms, in parallel: %.2f ms\n", sequential_ms, parallel_ms);
+    }
+
+    for (int i = 0; i < prepared; i++) {
+        runner_job_release(&jobs[i]);
+    }
     printf("\n");
 }
 
 /**
- * @brief Demonstrate the popen() function
+ * @brief Time each system check as a process and as a builtin
  */
-static void demonstrate_popen_function(void) {
-    printf("=== POPEN() FUNCTION DEMONSTRATION ===\n");
-    printf("The popen() function executes a command and captures its output.\n\n");
+static void demonstrate_builtin_commands(void) {
+    printf("=== BUILTIN COMMANDS DEMONSTRATION ===\n");
+    printf("The builtins make the programs' system calls directly (strftime, uname(2),\n");
+    printf("getdents64+statx, statvfs) and print the same output without a process.\n");
+    printf("Both are compared in the C locale (the programs run with LC_ALL=C).\n\n");
+
+    // The builtins format like the C locale; run the programs in it too
+    const char *user_locale = getenv("LC_ALL");
+    char *saved_locale = user_locale ? strdup(user_locale) : NULL;
+    setenv("LC_ALL", "C", 1);
+
+    printf("%-10s %14s %14s %7s\n", "command", "external (us)", "builtin (us)", "output");
+    for (int i = 0; i < NUM_SYSTEM_CHECKS; i++) {
+        const char *command = system_checks[i].command;
+        double external_ms = 0.0;
+        double builtin_ms = 0.0;
+        int failed = 0;
+        int same = 1;
+
+        for (int run = 0; run < BUILTIN_TIMING_RUNS && !failed; run++) {
+            launcher_output_t external;
+            launcher_output_t builtin;
+            int status;
+            struct timespec start;
+            struct rusage usage;
+            struct rusage before;
+
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            int result = launcher_capture_line_usage(command, OUTPUT_CAPTURE_MODE, &external,
+                                                     &status, &usage);
+            external_ms += elapsed_ms(&start);
+            // status and usage are only set when the command ran
+            if (result == 0) {
+                record_command(command, COMMAND_KIND_EXTERNAL, status, &start, &usage);
+            }
+            failed |= result != 0;
+
+            getrusage(RUSAGE_THREAD, &before);
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            result = builtin_capture_line(command, &builtin, &status);
+            builtin_ms += elapsed_ms(&start);
+            if (result == 0) {
+                command_stats_usage_since(&before, &usage);
+                record_command(command, COMMAND_KIND_BUILTIN, status, &start, &usage);
+            }
+            failed |= result != 0;
+
+            // date may tick between the two; one matching run is enough
+            if (!failed && (run == 0 || !same)) {
+                same = external.length == builtin.length &&
+                       memcmp(external.data, builtin.data, external.length) == 0;
+            }
+            launcher_output_free(&external);
+            launcher_output_free(&builtin);
+        }
 
-    char output[MAX_OUTPUT_LENGTH];
+        if (failed) {
+            printf("%-10s failed to run\n", command);
+            continue;
+        }
+        printf("%-10s %14.1f %14.1f %7s\n", command,
+               external_ms * 1e3 / BUILTIN_TIMING_RUNS, builtin_ms * 1e3 / BUILTIN_TIMING_RUNS,
+               same ? "same" : "differs");
+    }
+    printf("\n");
+
+    if (saved_locale) {
+        setenv("LC_ALL", saved_locale, 1);
+        free(saved_locale);
+    } else {
+        unsetenv("LC_ALL");
+    }
+}
+
+/**
+ * @brief Print the per-command accounting and dump it as CSV
+ */
+static void demonstrate_command_stats(void) {
+#if ENABLE_COMMAND_STATS
+    printf("=== COMMAND ACCOUNTING ===\n");
+    printf("Wall time, CPU time, peak RSS and context switches of every command run\n");
+    printf("above (wait4() for processes, getrusage() around builtins):\n\n");
+    command_stats_report(stdout);
+
+    FILE *csv = fopen(COMMAND_STATS_CSV, "w");
+    int result = csv ? command_stats_write_csv(csv) : errno;
+    if (csv && fclose(csv) != 0 && result == 0) {
+        result = errno;
+    }
+    if (result == 0) {
+        printf("\nHistograms written to %s\n\n", COMMAND_STATS_CSV);
+    } else {
+        fprintf(stderr, "Error: Cannot write %s: %s\n\n", COMMAND_STATS_CSV, strerror(result));
+    }
+#endif
+}
+
+/**
+ * @brief Demonstrate capturing command output
+ */
+static void demonstrate_output_capture(void) {
+    printf("=== OUTPUT CAPTURE DEMONSTRATION ===\n");
+    printf("Output is read from the command's stdout with large read() calls into a\n");
+    printf("growing buffer (%s mode), so it is never truncated.\n\n",
+           launcher_capture_mode_name(OUTPUT_CAPTURE_MODE));
+
+    launcher_output_t output;
 
     // Capture command output
     printf("1. Capturing 'ls -la' output:\n");
-    if (execute_command_with_output("ls -la", output, sizeof(output)) == 0) {
-        printf("Output:\n%s\n", output);
+    if (execute_command_with_output("ls -la", &output) == 0) {
+        printf("Output:\n%s\n", output.data);
     }
-
-    printf("2. Capturing 'ps aux | head -10' output:\n");
-    if (execute_command_with_output("ps aux | head -10", output, sizeof(output)) == 0) {
-        printf("Output:\n%s\n", output);
+    launcher_output_free(&output);
+
+    char ps_pipeline[MAX_COMMAND_LENGTH];
+    snprintf(ps_pipeline, sizeof(ps_pipeline), "ps aux | head -n %d", PS_PREVIEW_LINES);
+    printf("2. Capturing '%s' output (pipeline without a shell):\n", ps_pipeline);
+
+    pipeline_t pipeline;
+    int status;
+    int result = pipeline_parse(&pipeline, ps_pipeline, 1);
+    if (result == 0) {
+        result = pipeline_capture(&pipeline, &output, &status);
+        if (result == 0) {
+            printf("Output (%zu bytes, head exited with %d):\n%s\n", output.length,
+                   WIFEXITED(status) ? WEXITSTATUS(status) : -1, output.data);
+        }
+        launcher_output_free(&output);
+        pipeline_release(&pipeline);
+    }
+    if (result != 0) {
+        fprintf(stderr, "Error: Pipeline failed: %s\n", strerror(result));
     }
 
-    printf("3. Checking if wget is available:\n");
-    if (execute_command_with_output("which wget", output, sizeof(output)) == 0) {
-        printf("wget found at: %s", output);
+    printf("3. Checking if wget is available (in-process PATH lookup, no 'which'):\n");
+    char wget_path[PATH_MAX];
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int lookup = path_lookup("wget", wget_path, sizeof(wget_path));
+    double lookup_ms = elapsed_ms(&start);
+    if (lookup == 0) {
+        printf("wget found at: %s (%.1f us)\n", wget_path, lookup_ms * 1e3);
     } else {
         printf("wget not found in PATH\n");
     }
@@ -210,6 +629,57 @@ static void demonstrate_popen_function(void) {
     printf("\n");
 }
 
+/**
+ * @brief Run a few commands at once with their output captured to files
+ */
+static void demonstrate_file_capture(void) {
+    static const char *const commands[] = { "ps aux", "ls -la /usr/bin", "uname -a" };
+    const int count = (int)(sizeof(commands) / sizeof(commands[0]));
+    file_capture_job_t jobs[sizeof(commands) / sizeof(commands[0])];
+    char paths[sizeof(commands) / sizeof(commands[0])][64];
+    file_capture_stats_t stats;
+    int ready = 0;
+
+    printf("=== FILE CAPTURE DEMONSTRATION ===\n");
+    for (int i = 0; i < count; i++) {
+        snprintf(paths[i], sizeof(paths[i]), "/tmp/file_capture_demo.%d.%d", (int)getpid(), i);
+        if (file_capture_job_init(&jobs[i], commands[i], paths[i]) != 0) {
+            break;
+        }
+        ready++;
+    }
+
+    int result = ready == count ? 0 : EINVAL;
+    if (result == 0) {
+        result = file_capture_run(jobs, count,
+                                  ENABLE_IO_URING_CAPTURE ? FILE_CAPTURE_AUTO : FILE_CAPTURE_EPOLL,
+                                  &stats);
+    }
+    if (result == 0) {
+        printf("%d commands copied to files concurrently with %s: %lu waits, %lu reads, "
+               "%lu writes\n", count, file_capture_backend_name(stats.backend),
+               stats.waits, stats.reads, stats.writes);
+        for (int i = 0; i < count; i++) {
+            printf("  %-18s -> %s: %llu bytes%s%s\n", commands[i], paths[i],
+                   (unsigned long long)jobs[i].bytes, jobs[i].error ? ", " : "",
+                   jobs[i].error ? strerror(jobs[i].error) : "");
+#if ENABLE_COMMAND_STATS
+            // Reaped through the pidfd without wait4(): wall time only
+            command_stats_record(commands[i], COMMAND_KIND_EXTERNAL, jobs[i].status,
+                                 jobs[i].elapsed_ns, NULL);
+#endif
+        }
+    } else {
+        fprintf(stderr, "Error: File capture failed: %s\n", strerror(result));
+    }
+
+    for (int i = 0; i < ready; i++) {
+        unlink(paths[i]);
+        file_capture_job_release(&jobs[i]);
+    }
+    printf("\n");
+}
+
 /**
  * @brief Demonstrate the exec family of functions
  */
@@ -249,6 +719,71 @@ static void demonstrate_exec_family(void) {
     printf("\n");
 }
 
+/**
+ * @brief Download a generated file from the loopback server, once over one
+ *        connection and once with parallel range requests
+ */
+static void demonstrate_native_download(void) {
+#if ENABLE_NATIVE_DOWNLOAD
+    http_test_server_t server;
+    char url[128];
+    char path[] = "/tmp/native_download.XXXXXX";
+
+    printf("Native downloader (http_download.h):\n");
+    printf("%s is https://, which the native client does not support;\n", FFMPEG_URL);
+    printf("downloading %d MiB from a loopback server limited to %d MB/s per connection.\n",
+           NATIVE_DOWNLOAD_BYTES / (1024 * 1024), NATIVE_DOWNLOAD_RATE / 1000000);
+
+    char *data = malloc(NATIVE_DOWNLOAD_BYTES);
+    int fd = data ? mkstemp(path) : -1;
+    if (fd == -1) {
+        printf("Failed to set up the download: %s\n\n", strerror(errno));
+        free(data);
+        return;
+    }
+    close(fd);
+    for (size_t i = 0; i < NATIVE_DOWNLOAD_BYTES; i++) {
+        data[i] = (char)(i * 31 + i / 4096);
+    }
+
+    memset(&server, 0, sizeof(server));
+    server.data = data;
+    server.size = NATIVE_DOWNLOAD_BYTES;
+    server.ranges = 1;
+    server.rate = NATIVE_DOWNLOAD_RATE;
+    int result = http_test_server_start(&server);
+    if (result != 0) {
+        printf("Failed to start the loopback server: %s\n\n", strerror(result));
+        unlink(path);
+        free(data);
+        return;
+    }
+    http_test_server_url(&server, "/ffmpeg.tar.xz", url, sizeof(url));
+
+    const int connections[] = { 1, NATIVE_DOWNLOAD_CONNECTIONS };
+    for (int i = 0; i < 2; i++) {
+        http_download_options_t options = { connections[i], 1, 2 };
+        http_download_stats_t stats;
+        struct timespec start;
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        result = http_download_file(url, path, &options, &stats);
+        double ms = elapsed_ms(&start);
+        if (result != 0) {
+            printf("  %d connection(s): failed: %s\n", connections[i], strerror(result));
+            continue;
+        }
+        printf("  %d connection(s): %.1f ms, %.1f MB/s, %d segment(s)\n", connections[i], ms,
+               (double)stats.fetched / 1e3 / ms, stats.connections);
+    }
+
+    http_test_server_stop(&server);
+    unlink(path);
+    free(data);
+    printf("\n");
+#endif
+}
+
 /**
  * @brief Demonstrate downloading FFmpeg (the original use case)
  */
@@ -257,9 +792,11 @@ static void download_ffmpeg_demo(void) {
     printf("This demonstrates the original command from generic05.c\n");
     printf("Original command: wget -O ffmpeg.tar.xz %s\n\n", FFMPEG_URL);
 
-    // Check if wget is available
-    char output[256];
-    if (execute_command_with_output("which wget", output, sizeof(output)) != 0) {
+    demonstrate_native_download();
+
+    // Check if wget is available; answered from the PATH cache this time
+    char wget_path[PATH_MAX];
+    if (path_lookup("wget", wget_path, sizeof(wget_path)) != 0) {
         printf("wget is not available on this system.\n");
         printf("Please install wget first:\n");
         printf("  Ubuntu/Debian: sudo apt-get install wget\n");
@@ -268,7 +805,7 @@ static void download_ffmpeg_demo(void) {
         return;
     }
 
-    printf("wget found at: %s", output);
+    printf("wget found at: %s\n", wget_path);
 
     // Construct the download command
     char download_command[MAX_COMMAND_LENGTH];
@@ -301,26 +838,40 @@ static void download_ffmpeg_demo(void) {
  * @return EXIT_SUCCESS on successful execution
  */
 int main(void) {
+#if ENABLE_SPAWN_POOL
+    // Fork the helpers now, while this process is as small as it gets
+    spawn_pool_ready = spawn_pool_create(&spawn_pool, SPAWN_POOL_WORKERS) == 0;
+#endif
+
     printf("========================================================\n");
     printf("    SYSTEM COMMAND EXECUTION DEMONSTRATION\n");
     printf("========================================================\n\n");
 
     print_security_warning();
 
-    demonstrate_system_function();
-    demonstrate_popen_function();
+    double sequential_ms = demonstrate_system_function();
+    demonstrate_parallel_commands(sequential_ms);
+    demonstrate_builtin_commands();
+    demonstrate_output_capture();
+    demonstrate_file_capture();
     demonstrate_exec_family();
     download_ffmpeg_demo();
+    demonstrate_command_stats();
 
     printf("========================================================\n");
     printf("    DEMONSTRATION COMPLETED\n");
     printf("========================================================\n");
     printf("\nKey takeaways:\n");
     printf("1. system() is simple but can be insecure\n");
-    printf("2. popen() allows output capture\n");
+    printf("2. Output can be captured in full without popen() or a shell\n");
     printf("3. exec family provides better security and control\n");
     printf("4. Always validate input and handle errors\n");
     printf("5. Consider security implications of command execution\n");
 
+#if ENABLE_SPAWN_POOL
+    if (spawn_pool_ready) {
+        spawn_pool_destroy(&spawn_pool);
+    }
+#endif
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,384 @@
+/**
+ * @file task_graph.c
+ * @brief Task graph executor with atomic in-degree counters
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#define _GNU_SOURCE
+
+#include "task_graph.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+/** Upper bound on the team size */
+#define MAX_TASK_GRAPH_THREADS 256
+
+/** Initial capacity of the task array and of each successor list */
+#define INITIAL_TASK_CAPACITY 64
+#define INITIAL_SUCCESSOR_CAPACITY 4
+
+/**
+ * @brief One task and its outgoing edges
+ */
+typedef struct {
+    task_graph_fn fn;
+    void *arg;
+    int dependencies;           /**< Prerequisites recorded by task_graph_depend() */
+    int pending;                /**< Unfinished prerequisites in this run (atomic) */
+    int *successors;            /**< Tasks that depend on this one */
+    int successor_count;
+    int successor_capacity;
+} task_t;
+
+struct task_graph {
+    task_t *tasks;
+    int count;
+    int capacity;
+    int validated;              /**< Non-zero once the graph is known to be acyclic */
+
+    /** Ready queue; every task is queued at most once per run */
+    pthread_mutex_t queue_lock;
+    pthread_cond_t queue_ready;
+    int *queue;
+    int head;
+    int tail;
+    int idle;                   /**< Workers waiting on queue_ready */
+
+    /** Tasks of this run not yet finished, on its own cache line */
+    int remaining __attribute__((aligned(64)));
+
+    /** Statistics of the last run */
+    unsigned long direct __attribute__((aligned(64)));
+    unsigned long queued;
+    int threads;
+};
+
+/*============================================================================
+ * READY QUEUE
+ *============================================================================*/
+
+static void queue_push(task_graph_t *graph, int id) {
+    pthread_mutex_lock(&graph->queue_lock);
+    graph->queue[graph->tail++] = id;
+    if (graph->idle > 0) {
+        pthread_cond_signal(&graph->queue_ready);
+    }
+    pthread_mutex_unlock(&graph->queue_lock);
+}
+
+/**
+ * @brief Take the next ready task, sleeping while there is none
+ * @return Task id, or -1 once every task of the run has finished
+ */
+static int queue_pop(task_graph_t *graph) {
+    int id = -1;
+
+    pthread_mutex_lock(&graph->queue_lock);
+    while (graph->head == graph->tail &&
+           __atomic_load_n(&graph->remaining, __ATOMIC_ACQUIRE) > 0) {
+        graph->idle++;
+        pthread_cond_wait(&graph->queue_ready, &graph->queue_lock);
+        graph->idle--;
+    }
+    if (graph->head != graph->tail) {
+        id = graph->queue[graph->head++];
+    }
+    pthread_mutex_unlock(&graph->queue_lock);
+    return id;
+}
+
+/*============================================================================
+ * EXECUTION
+ *============================================================================*/
+
+/**
+ * @brief Run one task and release its successors
+ * @return A successor that became ready and is now ours to run, or -1
+ */
+static int execute_task(task_graph_t *graph, int id) {
+    task_t *task = &graph->tasks[id];
+    int next = -1;
+
+    task->fn(task->arg);
+
+    for (int i = 0; i < task->successor_count; i++) {
+        int successor = task->successors[i];
+        // acq_rel: the successor sees everything its prerequisites wrote
+        if (__atomic_sub_fetch(&graph->tasks[successor].pending, 1, __ATOMIC_ACQ_REL) == 0) {
+            if (next < 0) {
+                next = successor;
+            } else {
+                queue_push(graph, successor);
+            }
+        }
+    }
+
+    if (__atomic_sub_fetch(&graph->remaining, 1, __ATOMIC_ACQ_REL) == 0) {
+        // Last task: wake everyone waiting for work so they can exit
+        pthread_mutex_lock(&graph->queue_lock);
+        pthread_cond_broadcast(&graph->queue_ready);
+        pthread_mutex_unlock(&graph->queue_lock);
+    }
+    return next;
+}
+
+/**
+ * @brief Team member loop: take ready tasks and follow their chains
+ */
+static void run_member(task_graph_t *graph) {
+    unsigned long direct = 0;
+    unsigned long queued = 0;
+    int id;
+
+    while ((id = queue_pop(graph)) >= 0) {
+        queued++;
+        while ((id = execute_task(graph, id)) >= 0) {
+            direct++;
+        }
+    }
+
+    __atomic_add_fetch(&graph->direct, direct, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&graph->queued, queued, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief pthread entry point for spawned team members
+ */
+static void *worker_thread(void *arg) {
+    run_member((task_graph_t *)arg);
+    return NULL;
+}
+
+/**
+ * @brief Check that the graph has no cycle (Kahn's algorithm)
+ * @return 0 if acyclic, EDEADLK on a cycle, ENOMEM
+ */
+static int validate(task_graph_t *graph) {
+    int *in_degree = malloc((size_t)graph->count * sizeof(int));
+    int *ready = malloc((size_t)graph->count * sizeof(int));
+    if (!in_degree || !ready) {
+        free(in_degree);
+        free(ready);
+        return ENOMEM;
+    }
+
+    int head = 0;
+    int tail = 0;
+    for (int i = 0; i < graph->count; i++) {
+        in_degree[i] = graph->tasks[i].dependencies;
+        if (in_degree[i] == 0) {
+            ready[tail++] = i;
+        }
+    }
+    while (head < tail) {
+        const task_t *task = &graph->tasks[ready[head++]];
+        for (int i = 0; i < task->successor_count; i++) {
+            if (--in_degree[task->successors[i]] == 0) {
+                ready[tail++] = task->successors[i];
+            }
+        }
+    }
+
+    free(in_degree);
+    free(ready);
+    return tail == graph->count ? 0 : EDEADLK;
+}
+
+/*============================================================================
+ * PUBLIC FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Create an empty graph
+ * @return The graph, or NULL on allocation failure
+ */
+task_graph_t *task_graph_create(void) {
+    void *memory = NULL;
+    if (posix_memalign(&memory, 64, sizeof(task_graph_t)) != 0) {
+        return NULL;
+    }
+
+    task_graph_t *graph = memory;
+    memset(graph, 0, sizeof(*graph));
+    pthread_mutex_init(&graph->queue_lock, NULL);
+    pthread_cond_init(&graph->queue_ready, NULL);
+    return graph;
+}
+
+/**
+ * @brief Free the graph; it must not be running
+ */
+void task_graph_destroy(task_graph_t *graph) {
+    if (!graph) {
+        return;
+    }
+    for (int i = 0; i < graph->count; i++) {
+        free(graph->tasks[i].successors);
+    }
+    free(graph->tasks);
+    free(graph->queue);
+    pthread_cond_destroy(&graph->queue_ready);
+    pthread_mutex_destroy(&graph->queue_lock);
+    free(graph);
+}
+
+/**
+ * @brief Add a task
+ * @param[out] id Identifier used with task_graph_depend(); may be NULL
+ * @return 0 on success, EINVAL for a NULL fn, ENOMEM
+ */
+int task_graph_add(task_graph_t *graph, task_graph_fn fn, void *arg, int *id) {
+    if (!fn) {
+        return EINVAL;
+    }
+
+    if (graph->count == graph->capacity) {
+        int capacity = graph->capacity ? graph->capacity * 2 : INITIAL_TASK_CAPACITY;
+        task_t *tasks = realloc(graph->tasks, (size_t)capacity * sizeof(task_t));
+        if (!tasks) {
+            return ENOMEM;
+        }
+        graph->tasks = tasks;
+        graph->capacity = capacity;
+    }
+
+    task_t *task = &graph->tasks[graph->count];
+    memset(task, 0, sizeof(*task));
+    task->fn = fn;
+    task->arg = arg;
+
+    if (id) {
+        *id = graph->count;
+    }
+    graph->count++;
+    graph->validated = 0;
+    return 0;
+}
+
+/**
+ * @brief Make `task` wait for `prerequisite` to finish
+ * @return 0 on success, EINVAL for an unknown id or a self-dependency,
+ *         ENOMEM
+ */
+int task_graph_depend(task_graph_t *graph, int task, int prerequisite) {
+    if (task < 0 || task >= graph->count || prerequisite < 0 ||
+        prerequisite >= graph->count || task == prerequisite) {
+        return EINVAL;
+    }
+
+    task_t *before = &graph->tasks[prerequisite];
+    if (before->successor_count == before->successor_capacity) {
+        int capacity = before->successor_capacity ? before->successor_capacity * 2
+                                                  : INITIAL_SUCCESSOR_CAPACITY;
+        int *successors = realloc(before->successors, (size_t)capacity * sizeof(int));
+        if (!successors) {
+            return ENOMEM;
+        }
+        before->successors = successors;
+        before->successor_capacity = capacity;
+    }
+
+    before->successors[before->successor_count++] = task;
+    graph->tasks[task].dependencies++;
+    graph->validated = 0;
+    return 0;
+}
+
+/**
+ * @brief Run every task once, respecting dependencies
+ * @param num_threads Team size including the caller; <= 0 means one per
+ *        online CPU
+ * @return 0 on success, EDEADLK if the dependencies form a cycle (nothing
+ *         is run), ENOMEM
+ *
+ * If worker threads cannot be created the remaining team members, at worst
+ * the calling thread alone, still run the whole graph.
+ */
+int task_graph_run(task_graph_t *graph, int num_threads) {
+    if (graph->count == 0) {
+        graph->direct = graph->queued = 0;
+        graph->threads = 0;
+        return 0;
+    }
+
+    if (!graph->validated) {
+        int result = validate(graph);
+        if (result != 0) {
+            return result;
+        }
+        graph->validated = 1;
+    }
+
+    int *queue = realloc(graph->queue, (size_t)graph->count * sizeof(int));
+    if (!queue) {
+        return ENOMEM;
+    }
+    graph->queue = queue;
+    graph->head = graph->tail = 0;
+    graph->idle = 0;
+    graph->direct = graph->queued = 0;
+
+    // Reset the in-degree counters; roots are ready immediately
+    for (int i = 0; i < graph->count; i++) {
+        graph->tasks[i].pending = graph->tasks[i].dependencies;
+        if (graph->tasks[i].dependencies == 0) {
+            graph->queue[graph->tail++] = i;
+        }
+    }
+    __atomic_store_n(&graph->remaining, graph->count, __ATOMIC_RELEASE);
+
+    int threads = num_threads;
+    if (threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int)cpus : 1;
+    }
+    if (threads > MAX_TASK_GRAPH_THREADS) {
+        threads = MAX_TASK_GRAPH_THREADS;
+    }
+    if (threads > graph->count) {
+        threads = graph->count;
+    }
+
+    pthread_t ids[MAX_TASK_GRAPH_THREADS];
+    int spawned = 0;
+    for (int i = 1; i < threads; i++) {
+        if (pthread_create(&ids[spawned], NULL, worker_thread, graph) != 0) {
+            break;
+        }
+        spawned++;
+    }
+
+    run_member(graph);
+    for (int i = 0; i < spawned; i++) {
+        pthread_join(ids[i], NULL);
+    }
+
+    graph->threads = spawned + 1;
+    return 0;
+}
+
+/**
+ * @brief Number of tasks in the graph
+ */
+int task_graph_size(const task_graph_t *graph) {
+    return graph->count;
+}
+
+/**
+ * @brief Scheduling counters of the most recent task_graph_run()
+ */
+void task_graph_last_stats(const task_graph_t *graph, task_graph_stats_t *stats) {
+    stats->tasks = graph->direct + graph->queued;
+    stats->direct = graph->direct;
+    stats->queued = graph->queued;
+    stats->threads = graph->threads;
+}
@@ -0,0 +1,64 @@
+/**
+ * @file task_graph.h
+ * @brief Task graph executor: run jobs on a worker pool in dependency order
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * Jobs are added as tasks and ordered with task_graph_depend(); a task runs
+ * only after every task it depends on has finished. task_graph_run() then
+ * executes the whole graph on a team of threads (the calling thread is one
+ * of them) and returns once every task has run.
+ *
+ * Readiness is tracked with one atomic counter per task holding the number
+ * of unfinished prerequisites. A finishing task decrements the counters of
+ * its successors; whoever takes a counter to zero owns that task:
+ * - the first successor that becomes ready is run directly by the same
+ *   thread, so a chain of tasks never touches the shared queue
+ * - further ready successors go to a shared FIFO, from which idle workers
+ *   take them
+ *
+ * Task ids are assigned 0, 1, 2, ... in order of addition.
+ *
+ * A graph can be run any number of times; the counters are reset from the
+ * recorded dependency counts at the start of each run. Tasks and edges may
+ * not be added while a run is in progress.
+ */
+
+#ifndef TASK_GRAPH_H
+#define TASK_GRAPH_H
+
+/*============================================================================
+ * TYPES
+ *============================================================================*/
+
+/** Task body */
+typedef void (*task_graph_fn)(void *arg);
+
+/** Opaque task graph */
+typedef struct task_graph task_graph_t;
+
+/**
+ * @brief Scheduling counters of the last run, for reports
+ */
+typedef struct {
+    unsigned long tasks;        /**< Tasks executed */
+    unsigned long direct;       /**< Run directly by the thread that readied them */
+    unsigned long queued;       /**< Passed through the shared ready queue */
+    int threads;                /**< Team size, including the caller */
+} task_graph_stats_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+task_graph_t *task_graph_create(void);
+void task_graph_destroy(task_graph_t *graph);
+
+int task_graph_add(task_graph_t *graph, task_graph_fn fn, void *arg, int *id);
+int task_graph_depend(task_graph_t *graph, int task, int prerequisite);
+int task_graph_run(task_graph_t *graph, int num_threads);
+
+int task_graph_size(const task_graph_t *graph);
+void task_graph_last_stats(const task_graph_t *graph, task_graph_stats_t *stats);
+
+#endif /* TASK_GRAPH_H */
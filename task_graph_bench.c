@@ -0,0 +1,316 @@
+/**
+ * @file task_graph_bench.c
+ * @brief Task graph executor on wide and deep synthetic graphs
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * Two graph shapes, every task running the same small calibrated CPU job:
+ * - wide: one root, W independent tasks that depend on it, one sink that
+ *         depends on all of them (fan-out / fan-in)
+ * - deep: a chain of D tasks, each depending on the previous one
+ *
+ * Each graph is run three ways:
+ * - serial:      every task body called in order on one thread
+ * - task graph:  task_graph_run() on T threads
+ * - create/join: the demos' old pattern; one pthread per task, created and
+ *                joined level by level (at most T at a time)
+ *
+ * Every task checks that its prerequisites have finished before it runs.
+ *
+ * Usage: ./task_graph_bench [threads] [width] [depth] [task_us]
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "clock_ns.h"
+#include "task_graph.h"
+#include "workload.h"
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+#define DEFAULT_WIDTH 10000
+#define DEFAULT_DEPTH 10000
+#define DEFAULT_TASK_US 2
+#define MAX_BENCH_THREADS 64
+
+/**
+ * @brief One task of a synthetic graph; prerequisites are a contiguous id range
+ */
+typedef struct {
+    int id;
+    int level;                  /**< Tasks of one level are independent */
+    int first_prerequisite;
+    int prerequisite_count;
+    int done;                   /**< Set (release) when the task finished */
+} bench_task_t;
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+static bench_task_t *bench_tasks = NULL;
+static int bench_task_count = 0;
+static workload_t task_work;
+static unsigned long task_units = 0;
+
+/** Tasks that started before a prerequisite had finished */
+static unsigned long order_violations = 0;
+
+/*============================================================================
+ * GRAPHS
+ *============================================================================*/
+
+/**
+ * @brief Task body: verify the prerequisites, work, mark done
+ */
+static void bench_task(void *arg) {
+    bench_task_t *task = (bench_task_t *)arg;
+
+    for (int i = 0; i < task->prerequisite_count; i++) {
+        if (!__atomic_load_n(&bench_tasks[task->first_prerequisite + i].done, __ATOMIC_ACQUIRE)) {
+            __atomic_add_fetch(&order_violations, 1, __ATOMIC_RELAXED);
+        }
+    }
+
+    workload_run(&task_work, task_units);
+    __atomic_store_n(&task->done, 1, __ATOMIC_RELEASE);
+}
+
+static void set_task(int id, int level, int first, int count) {
+    bench_tasks[id].id = id;
+    bench_tasks[id].level = level;
+    bench_tasks[id].first_prerequisite = first;
+    bench_tasks[id].prerequisite_count = count;
+}
+
+/**
+ * @brief Describe a wide graph: root, `width` leaves, sink
+ */
+static int describe_wide(int width) {
+    int count = width + 2;
+    bench_tasks = calloc((size_t)count, sizeof(bench_task_t));
+    if (!bench_tasks) {
+        return -1;
+    }
+    set_task(0, 0, 0, 0);
+    for (int i = 1; i <= width; i++) {
+        set_task(i, 1, 0, 1);
+    }
+    set_task(width + 1, 2, 1, width);
+    return count;
+}
+
+/**
+ * @brief Describe a deep graph: a chain of `depth` tasks
+ */
+static int describe_deep(int depth) {
+    bench_tasks = calloc((size_t)depth, sizeof(bench_task_t));
+    if (!bench_tasks) {
+        return -1;
+    }
+    set_task(0, 0, 0, 0);
+    for (int i = 1; i < depth; i++) {
+        set_task(i, i, i - 1, 1);
+    }
+    return depth;
+}
+
+/**
+ * @brief Build the task graph for the described tasks
+ */
+static task_graph_t *build_graph(void) {
+    task_graph_t *graph = task_graph_create();
+    if (!graph) {
+        return NULL;
+    }
+
+    int result = 0;
+    for (int i = 0; i < bench_task_count && result == 0; i++) {
+        result = task_graph_add(graph, bench_task, &bench_tasks[i], NULL);
+    }
+    for (int i = 0; i < bench_task_count && result == 0; i++) {
+        for (int p = 0; p < bench_tasks[i].prerequisite_count && result == 0; p++) {
+            result = task_graph_depend(graph, i, bench_tasks[i].first_prerequisite + p);
+        }
+    }
+
+    if (result != 0) {
+        fprintf(stderr, "Failed to build task graph: %s\n", strerror(result));
+        task_graph_destroy(graph);
+        return NULL;
+    }
+    return graph;
+}
+
+static void reset_tasks(void) {
+    for (int i = 0; i < bench_task_count; i++) {
+        bench_tasks[i].done = 0;
+    }
+}
+
+/*============================================================================
+ * RUNNERS
+ *============================================================================*/
+
+static long long run_serial(void) {
+    reset_tasks();
+    long long start = now_ns();
+    for (int i = 0; i < bench_task_count; i++) {
+        bench_task(&bench_tasks[i]);
+    }
+    return now_ns() - start;
+}
+
+static long long run_task_graph(task_graph_t *graph, int threads) {
+    reset_tasks();
+    long long start = now_ns();
+    int result = task_graph_run(graph, threads);
+    long long elapsed = now_ns() - start;
+
+    if (result != 0) {
+        fprintf(stderr, "Task graph run failed: %s\n", strerror(result));
+        exit(EXIT_FAILURE);
+    }
+    return elapsed;
+}
+
+static void *create_join_thread(void *arg) {
+    bench_task(arg);
+    return NULL;
+}
+
+/**
+ * @brief One thread per task, created and joined level by level
+ */
+static long long run_create_join(int threads) {
+    pthread_t ids[MAX_BENCH_THREADS];
+
+    reset_tasks();
+    long long start = now_ns();
+    int i = 0;
+    while (i < bench_task_count) {
+        int level = bench_tasks[i].level;
+        int batch = 0;
+        while (i < bench_task_count && bench_tasks[i].level == level && batch < threads) {
+            int result = pthread_create(&ids[batch], NULL, create_join_thread, &bench_tasks[i]);
+            if (result != 0) {
+                fprintf(stderr, "Failed to create thread: %s\n", strerror(result));
+                exit(EXIT_FAILURE);
+            }
+            batch++;
+            i++;
+        }
+        for (int b = 0; b < batch; b++) {
+            pthread_join(ids[b], NULL);
+        }
+    }
+    return now_ns() - start;
+}
+
+/**
+ * @brief Run one graph shape all three ways and print a row
+ * @return Non-zero if an ordering violation was seen
+ */
+static int bench_shape(const char *name, int threads) {
+    task_graph_t *graph = build_graph();
+    if (!graph) {
+        exit(EXIT_FAILURE);
+    }
+
+    order_violations = 0;
+    long long serial = run_serial();
+    long long graph_ns = run_task_graph(graph, threads);
+    task_graph_stats_t stats;
+    task_graph_last_stats(graph, &stats);
+    long long create_join = run_create_join(threads);
+
+    printf("%-6s %8d %11.2f %11.2f %11.2f %11.0f %11.0f %9lu  %s\n", name, bench_task_count,
+           (double)serial / 1e6, (double)graph_ns / 1e6, (double)create_join / 1e6,
+           (double)(graph_ns - serial) / bench_task_count,
+           (double)(create_join - serial) / bench_task_count,
+           stats.direct, order_violations == 0 ? "ok" : "ORDER VIOLATED");
+
+    task_graph_destroy(graph);
+    free(bench_tasks);
+    bench_tasks = NULL;
+    return order_violations != 0;
+}
+
+/*============================================================================
+ * MAIN FUNCTION
+ *============================================================================*/
+
+/**
+ * @brief Main function - runs the wide and the deep graph
+ * @return EXIT_SUCCESS on success, EXIT_FAILURE on bad arguments, setup
+ *         failure or a dependency violation
+ */
+int main(int argc, char **argv) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int threads = cpus > 4 ? (int)cpus : 4;
+    int width = DEFAULT_WIDTH;
+    int depth = DEFAULT_DEPTH;
+    long task_us = DEFAULT_TASK_US;
+
+    if (argc > 1) {
+        threads = (int)strtol(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        width = (int)strtol(argv[2], NULL, 10);
+    }
+    if (argc > 3) {
+        depth = (int)strtol(argv[3], NULL, 10);
+    }
+    if (argc > 4) {
+        task_us = strtol(argv[4], NULL, 10);
+    }
+    if (threads < 1 || threads > MAX_BENCH_THREADS || width < 1 || depth < 1 || task_us < 0) {
+        fprintf(stderr, "Usage: %s [threads 1..%d] [width > 0] [depth > 0] [task_us >= 0]\n",
+                argv[0], MAX_BENCH_THREADS);
+        return EXIT_FAILURE;
+    }
+
+    int result = workload_init(&task_work, WORKLOAD_CPU, 0);
+    if (result != 0) {
+        fprintf(stderr, "Failed to set up task workload: %s\n", strerror(result));
+        return EXIT_FAILURE;
+    }
+    task_units = workload_units_for(&task_work, task_us * 1000LL);
+
+    printf("========================================================\n");
+    printf("    TASK GRAPH SCHEDULER BENCHMARK\n");
+    printf("========================================================\n");
+    printf("Threads: %d, online CPUs: %ld, work per task: %ld us (%lu cpu units)\n\n",
+           threads, cpus, task_us, task_units);
+    printf("%-6s %8s %11s %11s %11s %11s %11s %9s  %s\n", "graph", "tasks", "serial ms",
+           "graph ms", "create ms", "graph +ns", "create +ns", "direct", "check");
+
+    int failed = 0;
+
+    bench_task_count = describe_wide(width);
+    if (bench_task_count < 0) {
+        fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+    failed |= bench_shape("wide", threads);
+
+    bench_task_count = describe_deep(depth);
+    if (bench_task_count < 0) {
+        fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+    failed |= bench_shape("deep", threads);
+
+    printf("\n+ns columns: extra time per task over the serial run\n");
+
+    workload_destroy(&task_work);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,418 @@
+/**
+ * @file timer_wheel.c
+ * @brief Hierarchical timer wheel and its timerfd-driven timer thread
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#define _GNU_SOURCE
+
+#include "timer_wheel.h"
+#include "clock_ns.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/timerfd.h>
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+#define SLOT_MASK (TIMER_WHEEL_SLOTS - 1)
+
+/** Furthest a timer can be filed ahead of the current tick */
+#define WHEEL_RANGE (1ULL << (TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVELS))
+
+/** wheel_timer_t.state values */
+enum {
+    TIMER_IDLE = 0,
+    TIMER_PENDING = 1,          /**< Linked into a slot (or a detached expiry list) */
+    TIMER_FIRING = 2            /**< Callback running; not linked anywhere */
+};
+
+struct timer_wheel {
+    pthread_mutex_t lock;
+    timer_link_t slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+    uint64_t current;           /**< Next tick to process */
+    unsigned long pending;
+    unsigned long fired;
+    unsigned long cascaded;
+
+    /** Timer thread */
+    long long tick_ns;
+    long long origin_ns;        /**< Monotonic time of tick 0 */
+    pthread_t thread;
+    int running;
+    int stopping;
+    int timer_fd;
+};
+
+/*============================================================================
+ * LISTS
+ *============================================================================*/
+
+static void list_init(timer_link_t *head) {
+    head->next = head;
+    head->prev = head;
+}
+
+static int list_empty(const timer_link_t *head) {
+    return head->next == head;
+}
+
+static void list_append(timer_link_t *head, timer_link_t *link) {
+    link->prev = head->prev;
+    link->next = head;
+    head->prev->next = link;
+    head->prev = link;
+}
+
+static void list_unlink(timer_link_t *link) {
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->next = link->prev = link;
+}
+
+/**
+ * @brief Move every node of `from` onto the empty list `to`
+ */
+static void list_move_all(timer_link_t *from, timer_link_t *to) {
+    list_init(to);
+    if (list_empty(from)) {
+        return;
+    }
+    to->next = from->next;
+    to->prev = from->prev;
+    to->next->prev = to;
+    to->prev->next = to;
+    list_init(from);
+}
+
+/*============================================================================
+ * WHEEL
+ *============================================================================*/
+
+/**
+ * @brief File a timer into the slot covering its expiry
+ *
+ * Overdue timers go into the current tick's slot; timers beyond the wheel's
+ * range go into the furthest slot and are re-filed when it is cascaded.
+ */
+static void place_timer(timer_wheel_t *wheel, wheel_timer_t *timer) {
+    uint64_t expires = timer->expires < wheel->current ? wheel->current : timer->expires;
+    uint64_t delta = expires - wheel->current;
+
+    if (delta >= WHEEL_RANGE) {
+        delta = WHEEL_RANGE - 1;
+        expires = wheel->current + delta;
+    }
+
+    int level = 0;
+    while (level < TIMER_WHEEL_LEVELS - 1 &&
+           delta >= (1ULL << (TIMER_WHEEL_SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+
+    int slot = (int)((expires >> (TIMER_WHEEL_SLOT_BITS * level)) & SLOT_MASK);
+    list_append(&wheel->slots[level][slot], &timer->link);
+}
+
+/**
+ * @brief Re-file every timer of one higher-level slot
+ */
+static void cascade(timer_wheel_t *wheel, int level, int slot) {
+    timer_link_t moving;
+
+    list_move_all(&wheel->slots[level][slot], &moving);
+    while (!list_empty(&moving)) {
+        wheel_timer_t *timer = (wheel_timer_t *)moving.next;
+        list_unlink(&timer->link);
+        place_timer(wheel, timer);
+        wheel->cascaded++;
+    }
+}
+
+/**
+ * @brief Process one tick: cascade if a block boundary is reached, then
+ *        fire the tick's slot
+ * @note Called with the lock held; drops it around each callback
+ */
+static unsigned long process_tick(timer_wheel_t *wheel) {
+    uint64_t tick = wheel->current;
+    unsigned long fired = 0;
+
+    for (int level = 1; level < TIMER_WHEEL_LEVELS; level++) {
+        if (((tick >> (TIMER_WHEEL_SLOT_BITS * (level - 1))) & SLOT_MASK) != 0) {
+            break;
+        }
+        cascade(wheel, level, (int)((tick >> (TIMER_WHEEL_SLOT_BITS * level)) & SLOT_MASK));
+    }
+
+    // Detach the slot so timers filed by callbacks land in the real slot.
+    // Detached timers stay PENDING, so they can still be cancelled.
+    timer_link_t expired;
+    list_move_all(&wheel->slots[0][tick & SLOT_MASK], &expired);
+    wheel->current = tick + 1;
+
+    while (!list_empty(&expired)) {
+        wheel_timer_t *timer = (wheel_timer_t *)expired.next;
+        list_unlink(&timer->link);
+        timer->state = TIMER_FIRING;
+        wheel->pending--;
+
+        pthread_mutex_unlock(&wheel->lock);
+        timer->fn(timer, timer->arg);
+        pthread_mutex_lock(&wheel->lock);
+
+        // The callback may have rescheduled (PENDING) or cancelled (IDLE) it
+        if (timer->state == TIMER_FIRING) {
+            if (timer->period > 0) {
+                timer->expires += timer->period;
+                timer->state = TIMER_PENDING;
+                wheel->pending++;
+                place_timer(wheel, timer);
+            } else {
+                timer->state = TIMER_IDLE;
+            }
+        }
+        fired++;
+    }
+
+    wheel->fired += fired;
+    return fired;
+}
+
+/**
+ * @brief Create a wheel with ticks of tick_us microseconds
+ * @return The wheel, or NULL on allocation failure or a zero tick
+ */
+timer_wheel_t *timer_wheel_create(unsigned int tick_us) {
+    if (tick_us == 0) {
+        return NULL;
+    }
+
+    timer_wheel_t *wheel = calloc(1, sizeof(timer_wheel_t));
+    if (!wheel) {
+        return NULL;
+    }
+
+    pthread_mutex_init(&wheel->lock, NULL);
+    for (int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        for (int slot = 0; slot < TIMER_WHEEL_SLOTS; slot++) {
+            list_init(&wheel->slots[level][slot]);
+        }
+    }
+    wheel->tick_ns = (long long)tick_us * 1000;
+    wheel->origin_ns = now_ns();
+    wheel->timer_fd = -1;
+    return wheel;
+}
+
+/**
+ * @brief Stop the timer thread and free the wheel
+ * @note Pending timers are dropped without firing; their memory remains
+ *       the caller's
+ */
+void timer_wheel_destroy(timer_wheel_t *wheel) {
+    if (!wheel) {
+        return;
+    }
+    timer_wheel_stop(wheel);
+    pthread_mutex_destroy(&wheel->lock);
+    free(wheel);
+}
+
+/*============================================================================
+ * TIMERS
+ *============================================================================*/
+
+/**
+ * @brief Prepare a timer for use; must not be called while it is scheduled
+ */
+void wheel_timer_init(wheel_timer_t *timer, wheel_timer_fn fn, void *arg) {
+    memset(timer, 0, sizeof(*timer));
+    timer->link.next = timer->link.prev = &timer->link;
+    timer->fn = fn;
+    timer->arg = arg;
+    timer->state = TIMER_IDLE;
+}
+
+/**
+ * @brief Fire `timer` after delay_ticks, then every period_ticks if non-zero
+ *
+ * The callback runs once the wheel has processed delay_ticks more ticks;
+ * with the timer thread that is between delay_ticks and delay_ticks + 1
+ * ticks from now. Periodic timers are re-armed from their previous expiry,
+ * so they do not drift.
+ * @return 0 on success, EINVAL without a callback, EBUSY if already pending
+ */
+int timer_wheel_schedule(timer_wheel_t *wheel, wheel_timer_t *timer,
+                         uint64_t delay_ticks, uint64_t period_ticks) {
+    if (!timer->fn) {
+        return EINVAL;
+    }
+
+    pthread_mutex_lock(&wheel->lock);
+    if (timer->state == TIMER_PENDING) {
+        pthread_mutex_unlock(&wheel->lock);
+        return EBUSY;
+    }
+
+    timer->expires = wheel->current + delay_ticks;
+    timer->period = period_ticks;
+    timer->state = TIMER_PENDING;
+    wheel->pending++;
+    place_timer(wheel, timer);
+    pthread_mutex_unlock(&wheel->lock);
+    return 0;
+}
+
+/**
+ * @brief Cancel a timer
+ * @return 0 if it was pending or firing (a periodic timer will not be
+ *         re-armed), ENOENT if it was idle
+ * @note A callback already running on the timer thread is not waited for
+ */
+int timer_wheel_cancel(timer_wheel_t *wheel, wheel_timer_t *timer) {
+    int result = 0;
+
+    pthread_mutex_lock(&wheel->lock);
+    switch (timer->state) {
+        case TIMER_PENDING:
+            list_unlink(&timer->link);
+            wheel->pending--;
+            timer->state = TIMER_IDLE;
+            break;
+        case TIMER_FIRING:
+            timer->state = TIMER_IDLE;
+            break;
+        default:
+            result = ENOENT;
+            break;
+    }
+    pthread_mutex_unlock(&wheel->lock);
+    return result;
+}
+
+/**
+ * @brief Convert a duration to ticks, rounding up
+ */
+uint64_t timer_wheel_ticks(const timer_wheel_t *wheel, uint64_t microseconds) {
+    uint64_t tick_us = (uint64_t)wheel->tick_ns / 1000;
+    return (microseconds + tick_us - 1) / tick_us;
+}
+
+/*============================================================================
+ * ADVANCING
+ *============================================================================*/
+
+/**
+ * @brief Process every tick up to and including `tick`, firing due timers
+ * @return Number of callbacks run
+ */
+unsigned long timer_wheel_advance(timer_wheel_t *wheel, uint64_t tick) {
+    unsigned long fired = 0;
+
+    pthread_mutex_lock(&wheel->lock);
+    while (wheel->current <= tick) {
+        if (wheel->pending == 0) {
+            // Nothing filed anywhere, so no slot needs visiting
+            wheel->current = tick + 1;
+            break;
+        }
+        fired += process_tick(wheel);
+    }
+    pthread_mutex_unlock(&wheel->lock);
+    return fired;
+}
+
+/**
+ * @brief Timer thread: wake every tick and catch up with the clock
+ */
+static void *timer_thread(void *arg) {
+    timer_wheel_t *wheel = (timer_wheel_t *)arg;
+    uint64_t expirations;
+
+    while (!__atomic_load_n(&wheel->stopping, __ATOMIC_ACQUIRE)) {
+        if (read(wheel->timer_fd, &expirations, sizeof(expirations)) < 0 && errno != EINTR) {
+            break;
+        }
+        long long elapsed = now_ns() - wheel->origin_ns;
+        if (elapsed >= 0) {
+            timer_wheel_advance(wheel, (uint64_t)(elapsed / wheel->tick_ns));
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Start the timer thread; ticks then follow CLOCK_MONOTONIC
+ * @return 0 on success, EBUSY if already running, or the errno of
+ *         timerfd_create/timerfd_settime/pthread_create
+ */
+int timer_wheel_start(timer_wheel_t *wheel) {
+    if (wheel->running) {
+        return EBUSY;
+    }
+
+    int fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (fd < 0) {
+        return errno;
+    }
+
+    struct itimerspec interval;
+    interval.it_interval.tv_sec = wheel->tick_ns / 1000000000LL;
+    interval.it_interval.tv_nsec = wheel->tick_ns % 1000000000LL;
+    interval.it_value = interval.it_interval;
+    if (timerfd_settime(fd, 0, &interval, NULL) != 0) {
+        int error = errno;
+        close(fd);
+        return error;
+    }
+
+    // Line the clock up with the ticks already processed
+    pthread_mutex_lock(&wheel->lock);
+    wheel->origin_ns = now_ns() - (long long)wheel->current * wheel->tick_ns;
+    pthread_mutex_unlock(&wheel->lock);
+
+    wheel->timer_fd = fd;
+    wheel->stopping = 0;
+    int result = pthread_create(&wheel->thread, NULL, timer_thread, wheel);
+    if (result != 0) {
+        close(fd);
+        wheel->timer_fd = -1;
+        return result;
+    }
+    wheel->running = 1;
+    return 0;
+}
+
+/**
+ * @brief Stop the timer thread (within one tick); timers stay scheduled
+ */
+void timer_wheel_stop(timer_wheel_t *wheel) {
+    if (!wheel->running) {
+        return;
+    }
+    __atomic_store_n(&wheel->stopping, 1, __ATOMIC_RELEASE);
+    pthread_join(wheel->thread, NULL);
+    close(wheel->timer_fd);
+    wheel->timer_fd = -1;
+    wheel->running = 0;
+}
+
+/**
+ * @brief Snapshot the wheel's counters
+ */
+void timer_wheel_stats(timer_wheel_t *wheel, timer_wheel_stats_t *stats) {
+    pthread_mutex_lock(&wheel->lock);
+    stats->tick = wheel->current;
+    stats->pending = wheel->pending;
+    stats->fired = wheel->fired;
+    stats->cascaded = wheel->cascaded;
+    pthread_mutex_unlock(&wheel->lock);
+}
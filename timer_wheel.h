@@ -0,0 +1,97 @@
+/**
+ * @file timer_wheel.h
+ * @brief Hashed hierarchical timer wheel for delayed and periodic jobs
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * Time is counted in ticks of a fixed length chosen at creation. Pending
+ * timers hang in TIMER_WHEEL_LEVELS wheels of TIMER_WHEEL_SLOTS slots each:
+ * - level 0 holds timers due within the next 256 ticks, one slot per tick
+ * - level n holds timers due within 256^(n+1) ticks, one slot per 256^n
+ *   ticks; when the tick counter reaches a slot's range the slot is
+ *   "cascaded": its timers are re-filed into the lower levels
+ * - timers further out than 2^32 ticks wait in the top level and are
+ *   re-filed each time their slot comes round
+ *
+ * Scheduling and cancelling are O(1): a timer is linked into or out of one
+ * slot's doubly linked list. Each timer is cascaded at most once per level,
+ * so expiry is amortized O(1) as well. Timers are intrusive: the caller
+ * owns the wheel_timer_t, so the wheel never allocates per timer.
+ *
+ * timer_wheel_advance() processes ticks up to a given tick. Normally a
+ * single timer thread does that: timer_wheel_start() creates it, and it
+ * wakes once per tick from a timerfd. Callbacks run on that thread without
+ * the wheel lock held, so they may schedule or cancel any timer, including
+ * their own.
+ */
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdint.h>
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+/** Slots per level (2^TIMER_WHEEL_SLOT_BITS) and number of levels */
+#define TIMER_WHEEL_SLOT_BITS 8
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_SLOT_BITS)
+#define TIMER_WHEEL_LEVELS 4
+
+typedef struct wheel_timer wheel_timer_t;
+
+/** Timer callback; runs on the thread that advances the wheel */
+typedef void (*wheel_timer_fn)(wheel_timer_t *timer, void *arg);
+
+/** Doubly linked list node; the slot heads are sentinels */
+typedef struct timer_link {
+    struct timer_link *next;
+    struct timer_link *prev;
+} timer_link_t;
+
+/**
+ * @brief A timer, embedded in or owned by the caller
+ */
+struct wheel_timer {
+    timer_link_t link;          /**< Slot membership; must stay first */
+    uint64_t expires;           /**< Tick at which the timer fires */
+    uint64_t period;            /**< Ticks between firings; 0 for one-shot */
+    wheel_timer_fn fn;
+    void *arg;
+    int state;                  /**< Internal; guarded by the wheel lock */
+};
+
+/** Opaque wheel */
+typedef struct timer_wheel timer_wheel_t;
+
+/**
+ * @brief Counters, for reports
+ */
+typedef struct {
+    uint64_t tick;              /**< Next tick to be processed */
+    unsigned long pending;      /**< Timers currently scheduled */
+    unsigned long fired;        /**< Callbacks run */
+    unsigned long cascaded;     /**< Timers moved to a lower level */
+} timer_wheel_stats_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+timer_wheel_t *timer_wheel_create(unsigned int tick_us);
+void timer_wheel_destroy(timer_wheel_t *wheel);
+
+void wheel_timer_init(wheel_timer_t *timer, wheel_timer_fn fn, void *arg);
+int timer_wheel_schedule(timer_wheel_t *wheel, wheel_timer_t *timer,
+                         uint64_t delay_ticks, uint64_t period_ticks);
+int timer_wheel_cancel(timer_wheel_t *wheel, wheel_timer_t *timer);
+uint64_t timer_wheel_ticks(const timer_wheel_t *wheel, uint64_t microseconds);
+
+unsigned long timer_wheel_advance(timer_wheel_t *wheel, uint64_t tick);
+int timer_wheel_start(timer_wheel_t *wheel);
+void timer_wheel_stop(timer_wheel_t *wheel);
+
+void timer_wheel_stats(timer_wheel_t *wheel, timer_wheel_stats_t *stats);
+
+#endif /* TIMER_WHEEL_H */
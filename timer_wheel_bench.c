@@ -0,0 +1,297 @@
+/**
+ * @file timer_wheel_bench.c
+ * @brief Insert, cancel and expire millions of timers: wheel vs binary heap
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * N timers with random delays in [1, max_ticks] are:
+ * 1. scheduled
+ * 2. half of them cancelled again
+ * 3. expired by advancing the wheel one tick at a time to max_ticks
+ *
+ * The same operations are timed on a binary min-heap with position
+ * tracking (O(log n) insert, cancel and pop), the usual alternative.
+ *
+ * Checks: every surviving timer fires exactly once and exactly at its
+ * expiry tick, cancelled timers never fire, and a periodic timer fires
+ * max_ticks / period times.
+ *
+ * Usage: ./timer_wheel_bench [timers] [max_ticks]
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "clock_ns.h"
+#include "timer_wheel.h"
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+#define DEFAULT_TIMERS 2000000L
+#define DEFAULT_MAX_TICKS (1L << 20)
+
+/** Period of the periodic check timer, in ticks */
+#define PERIODIC_TICKS 1000
+
+/**
+ * @brief Benchmark timer: the wheel timer plus bookkeeping
+ */
+typedef struct {
+    wheel_timer_t timer;
+    uint64_t due;               /**< Expected expiry tick */
+    int fired;
+    int cancelled;
+} bench_timer_t;
+
+/**
+ * @brief Heap entry; `index` tracks the position for O(log n) cancel
+ */
+typedef struct {
+    uint64_t expires;
+    long index;
+} heap_timer_t;
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+/** Tick being processed by the current timer_wheel_advance() call */
+static uint64_t advancing_to = 0;
+static unsigned long wrong_tick = 0;
+static unsigned long periodic_fired = 0;
+
+/** Binary heap of pointers into the heap_timer_t array */
+static heap_timer_t **heap = NULL;
+static long heap_size = 0;
+
+/*============================================================================
+ * UTILITY FUNCTIONS
+ *============================================================================*/
+
+static uint64_t next_random(uint64_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/*============================================================================
+ * CALLBACKS
+ *============================================================================*/
+
+static void bench_timer_fired(wheel_timer_t *timer, void *arg) {
+    bench_timer_t *bench = (bench_timer_t *)arg;
+    (void)timer;
+
+    bench->fired++;
+    if (bench->due != advancing_to) {
+        wrong_tick++;
+    }
+}
+
+static void periodic_fired_fn(wheel_timer_t *timer, void *arg) {
+    (void)timer;
+    (void)arg;
+    periodic_fired++;
+}
+
+/*============================================================================
+ * BINARY HEAP BASELINE
+ *============================================================================*/
+
+static void heap_swap(long a, long b) {
+    heap_timer_t *t = heap[a];
+    heap[a] = heap[b];
+    heap[b] = t;
+    heap[a]->index = a;
+    heap[b]->index = b;
+}
+
+static void heap_sift_up(long i) {
+    while (i > 0 && heap[(i - 1) / 2]->expires > heap[i]->expires) {
+        heap_swap(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+static void heap_sift_down(long i) {
+    for (;;) {
+        long smallest = i;
+        long left = 2 * i + 1;
+        long right = left + 1;
+        if (left < heap_size && heap[left]->expires < heap[smallest]->expires) {
+            smallest = left;
+        }
+        if (right < heap_size && heap[right]->expires < heap[smallest]->expires) {
+            smallest = right;
+        }
+        if (smallest == i) {
+            return;
+        }
+        heap_swap(i, smallest);
+        i = smallest;
+    }
+}
+
+static void heap_insert(heap_timer_t *timer) {
+    heap[heap_size] = timer;
+    timer->index = heap_size++;
+    heap_sift_up(timer->index);
+}
+
+static void heap_remove(heap_timer_t *timer) {
+    long i = timer->index;
+    heap_size--;
+    if (i != heap_size) {
+        heap[i] = heap[heap_size];
+        heap[i]->index = i;
+        heap_sift_down(i);
+        heap_sift_up(i);
+    }
+    timer->index = -1;
+}
+
+/*============================================================================
+ * MAIN FUNCTION
+ *============================================================================*/
+
+/**
+ * @brief Main function - times the wheel, then the heap
+ * @return EXIT_SUCCESS on success, EXIT_FAILURE on bad arguments, setup
+ *         failure or a timer firing wrongly
+ */
+int main(int argc, char **argv) {
+    long count = DEFAULT_TIMERS;
+    long max_ticks = DEFAULT_MAX_TICKS;
+
+    if (argc > 1) {
+        count = strtol(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        max_ticks = strtol(argv[2], NULL, 10);
+    }
+    if (count <= 0 || max_ticks <= 0) {
+        fprintf(stderr, "Usage: %s [timers > 0] [max_ticks > 0]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    bench_timer_t *timers = malloc((size_t)count * sizeof(bench_timer_t));
+    heap_timer_t *heap_timers = malloc((size_t)count * sizeof(heap_timer_t));
+    heap = malloc((size_t)count * sizeof(heap_timer_t *));
+    timer_wheel_t *wheel = timer_wheel_create(1000);
+    if (!timers || !heap_timers || !heap || !wheel) {
+        fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+    for (long i = 0; i < count; i++) {
+        wheel_timer_init(&timers[i].timer, bench_timer_fired, &timers[i]);
+        timers[i].due = 1 + next_random(&rng) % (uint64_t)max_ticks;
+        timers[i].fired = 0;
+        timers[i].cancelled = 0;
+        heap_timers[i].expires = timers[i].due;
+        heap_timers[i].index = -1;
+    }
+
+    printf("========================================================\n");
+    printf("    TIMER WHEEL BENCHMARK\n");
+    printf("========================================================\n");
+    printf("Timers: %ld, delays: 1..%ld ticks, wheel: %d levels x %d slots\n\n",
+           count, max_ticks, TIMER_WHEEL_LEVELS, TIMER_WHEEL_SLOTS);
+
+    // Wheel
+    wheel_timer_t periodic;
+    wheel_timer_init(&periodic, periodic_fired_fn, NULL);
+    timer_wheel_schedule(wheel, &periodic, PERIODIC_TICKS, PERIODIC_TICKS);
+
+    long long start = now_ns();
+    for (long i = 0; i < count; i++) {
+        timer_wheel_schedule(wheel, &timers[i].timer, timers[i].due, 0);
+    }
+    long long wheel_insert = now_ns() - start;
+
+    start = now_ns();
+    for (long i = 0; i < count; i += 2) {
+        timer_wheel_cancel(wheel, &timers[i].timer);
+        timers[i].cancelled = 1;
+    }
+    long long wheel_cancel = now_ns() - start;
+
+    start = now_ns();
+    for (advancing_to = 0; advancing_to <= (uint64_t)max_ticks; advancing_to++) {
+        timer_wheel_advance(wheel, advancing_to);
+    }
+    long long wheel_expire = now_ns() - start;
+    advancing_to = (uint64_t)max_ticks;
+
+    timer_wheel_cancel(wheel, &periodic);
+    timer_wheel_stats_t stats;
+    timer_wheel_stats(wheel, &stats);
+
+    // Heap
+    start = now_ns();
+    for (long i = 0; i < count; i++) {
+        heap_insert(&heap_timers[i]);
+    }
+    long long heap_insert_ns = now_ns() - start;
+
+    start = now_ns();
+    for (long i = 0; i < count; i += 2) {
+        heap_remove(&heap_timers[i]);
+    }
+    long long heap_cancel = now_ns() - start;
+
+    start = now_ns();
+    uint64_t last = 0;
+    unsigned long heap_out_of_order = 0;
+    while (heap_size > 0) {
+        heap_timer_t *top = heap[0];
+        if (top->expires < last) {
+            heap_out_of_order++;
+        }
+        last = top->expires;
+        heap_remove(top);
+    }
+    long long heap_expire = now_ns() - start;
+
+    long survivors = count / 2;
+    unsigned long bad_fires = 0;
+    for (long i = 0; i < count; i++) {
+        if (timers[i].fired != (timers[i].cancelled ? 0 : 1)) {
+            bad_fires++;
+        }
+    }
+
+    printf("%-14s %14s %14s %14s\n", "", "insert ns/op", "cancel ns/op", "expire ns/op");
+    printf("%-14s %14.1f %14.1f %14.1f\n", "timer wheel",
+           (double)wheel_insert / (double)count,
+           (double)wheel_cancel / (double)(count - survivors),
+           (double)wheel_expire / (double)survivors);
+    printf("%-14s %14.1f %14.1f %14.1f\n", "binary heap",
+           (double)heap_insert_ns / (double)count,
+           (double)heap_cancel / (double)(count - survivors),
+           (double)heap_expire / (double)survivors);
+
+    printf("\nWheel: %lu fired, %lu cascade moves (%.2f per timer), %ld ticks processed\n",
+           stats.fired, stats.cascaded, (double)stats.cascaded / (double)count, max_ticks + 1);
+    printf("Wheel expire time includes visiting every tick; heap expire is pops only\n");
+
+    unsigned long expected_periodic = (unsigned long)(max_ticks / PERIODIC_TICKS);
+    int ok = bad_fires == 0 && wrong_tick == 0 && heap_out_of_order == 0 &&
+             periodic_fired == expected_periodic;
+    printf("\nCheck: %lu wrong fire counts, %lu fired at wrong tick, periodic %lu/%lu: %s\n",
+           bad_fires, wrong_tick, periodic_fired, expected_periodic, ok ? "ok" : "FAILED");
+
+    timer_wheel_destroy(wheel);
+    free(heap);
+    free(heap_timers);
+    free(timers);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,298 @@
+/**
+ * @file workload.c
+ * @brief CPU, memory-bandwidth and pointer-chasing work units and calibration
+ * @author Development Team
+ * @date Created: October 2026
+ */
+
+#define _GNU_SOURCE
+
+#include "workload.h"
+#include "clock_ns.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+/** Dependent multiply/xor-shift steps in one CPU unit */
+#define CPU_STEPS_PER_UNIT 64
+
+/** Cache lines read in one MEMORY unit (4 KiB) */
+#define MEMORY_LINES_PER_UNIT 64
+
+/** Dependent cache misses in one POINTER_CHASE unit */
+#define CHASE_HOPS_PER_UNIT 8
+
+/** Calibration samples; the fastest one wins */
+#define CALIBRATION_SAMPLES 3
+
+/**
+ * @brief One cache line of the buffer
+ *
+ * MEMORY sums every word; POINTER_CHASE follows `words[0]` as the index of
+ * the next line on the cycle.
+ */
+typedef struct {
+    unsigned long words[8];
+} workload_line_t;
+
+/*============================================================================
+ * THREAD-LOCAL STATE
+ *============================================================================*/
+
+/** This thread's position in the buffer (a line index, taken modulo slots) */
+static __thread size_t thread_position = 0;
+
+/** This thread's CPU chain value, carried between calls */
+static __thread unsigned long thread_chain = 0x9E3779B97F4A7C15UL;
+
+/** Results are stored here so the work can never be optimized away */
+static __thread volatile unsigned long thread_sink;
+
+/*============================================================================
+ * WORK UNITS
+ *============================================================================*/
+
+static unsigned long run_cpu(unsigned long units) {
+    unsigned long x = thread_chain;
+
+    for (unsigned long u = 0; u < units; u++) {
+        for (int i = 0; i < CPU_STEPS_PER_UNIT; i++) {
+            x = x * 0x5851F42D4C957F2DUL + 0x14057B7EF767814FUL;
+            x ^= x >> 29;
+        }
+    }
+    thread_chain = x;
+    return x;
+}
+
+static unsigned long run_memory(const workload_t *workload, unsigned long units) {
+    const workload_line_t *lines = workload->buffer;
+    size_t position = thread_position % workload->slots;
+    unsigned long sum = 0;
+
+    for (unsigned long u = 0; u < units; u++) {
+        if (position + MEMORY_LINES_PER_UNIT > workload->slots) {
+            position = 0;
+        }
+        for (size_t i = position; i < position + MEMORY_LINES_PER_UNIT; i++) {
+            for (int w = 0; w < 8; w++) {
+                sum += lines[i].words[w];
+            }
+        }
+        position += MEMORY_LINES_PER_UNIT;
+    }
+    thread_position = position;
+    return sum;
+}
+
+static unsigned long run_pointer_chase(const workload_t *workload, unsigned long units) {
+    const workload_line_t *lines = workload->buffer;
+    size_t position = thread_position % workload->slots;
+
+    for (unsigned long u = 0; u < units; u++) {
+        for (int i = 0; i < CHASE_HOPS_PER_UNIT; i++) {
+            position = lines[position].words[0];
+        }
+    }
+    thread_position = position;
+    return position;
+}
+
+/*============================================================================
+ * SETUP AND CALIBRATION
+ *============================================================================*/
+
+/**
+ * @brief Link every line into one random cycle (Sattolo's shuffle), so a
+ *        chase visits the whole buffer in an order no prefetcher can guess
+ */
+static void build_chase_cycle(workload_line_t *lines, size_t slots) {
+    unsigned long rng = 0x2545F4914F6CDD1DUL;
+
+    for (size_t i = 0; i < slots; i++) {
+        lines[i].words[0] = i;
+    }
+    for (size_t i = slots - 1; i > 0; i--) {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+        size_t j = rng % i;
+        unsigned long next = lines[i].words[0];
+        lines[i].words[0] = lines[j].words[0];
+        lines[j].words[0] = next;
+    }
+}
+
+/**
+ * @brief Measure the cost of one unit on the calling thread
+ */
+static void calibrate(workload_t *workload) {
+    double best = 0.0;
+
+    for (int sample = 0; sample < CALIBRATION_SAMPLES; sample++) {
+        unsigned long units = 0;
+        unsigned long batch = 16;
+        long long start = now_ns();
+        long long elapsed = 0;
+
+        while (elapsed < WORKLOAD_CALIBRATION_NS) {
+            workload_run(workload, batch);
+            units += batch;
+            batch *= 2;
+            elapsed = now_ns() - start;
+        }
+
+        double ns_per_unit = (double)elapsed / (double)units;
+        if (sample == 0 || ns_per_unit < best) {
+            best = ns_per_unit;
+        }
+    }
+    workload->ns_per_unit = best;
+}
+
+/**
+ * @brief Allocate, populate and calibrate a workload
+ * @param footprint Buffer size for the memory shapes; 0 selects
+ *        WORKLOAD_DEFAULT_FOOTPRINT. Ignored for WORKLOAD_CPU.
+ * @return 0 on success, EINVAL for an unknown shape or a footprint below
+ *         one unit, ENOMEM if the buffer cannot be allocated
+ * @note Calibration runs on the calling thread for about
+ *       3 * WORKLOAD_CALIBRATION_NS; call it on an otherwise idle machine
+ */
+int workload_init(workload_t *workload, workload_shape_t shape, size_t footprint) {
+    memset(workload, 0, sizeof(*workload));
+    workload->shape = shape;
+
+    switch (shape) {
+        case WORKLOAD_CPU:
+            break;
+
+        case WORKLOAD_MEMORY:
+        case WORKLOAD_POINTER_CHASE: {
+            if (footprint == 0) {
+                footprint = WORKLOAD_DEFAULT_FOOTPRINT;
+            }
+            size_t slots = footprint / sizeof(workload_line_t);
+            if (slots < MEMORY_LINES_PER_UNIT) {
+                return EINVAL;
+            }
+
+            void *memory = NULL;
+            if (posix_memalign(&memory, sizeof(workload_line_t),
+                               slots * sizeof(workload_line_t)) != 0) {
+                return ENOMEM;
+            }
+
+            // Writing every line also faults the pages in before calibration
+            workload_line_t *lines = memory;
+            for (size_t i = 0; i < slots; i++) {
+                for (int w = 0; w < 8; w++) {
+                    lines[i].words[w] = i + (unsigned long)w;
+                }
+            }
+            if (shape == WORKLOAD_POINTER_CHASE) {
+                build_chase_cycle(lines, slots);
+            }
+
+            workload->buffer = memory;
+            workload->slots = slots;
+            workload->footprint = slots * sizeof(workload_line_t);
+            break;
+        }
+
+        default:
+            return EINVAL;
+    }
+
+    calibrate(workload);
+    return 0;
+}
+
+/**
+ * @brief Free the buffer; the workload must not be running
+ */
+void workload_destroy(workload_t *workload) {
+    free(workload->buffer);
+    workload->buffer = NULL;
+    workload->slots = 0;
+}
+
+/*============================================================================
+ * RUNNING WORK
+ *============================================================================*/
+
+/**
+ * @brief Run a fixed number of work units
+ * @return A checksum of the work (also kept in a thread-local sink)
+ */
+unsigned long workload_run(const workload_t *workload, unsigned long units) {
+    unsigned long result;
+
+    switch (workload->shape) {
+        case WORKLOAD_MEMORY:
+            result = run_memory(workload, units);
+            break;
+        case WORKLOAD_POINTER_CHASE:
+            result = run_pointer_chase(workload, units);
+            break;
+        default:
+            result = run_cpu(units);
+            break;
+    }
+    thread_sink = result;
+    return result;
+}
+
+/**
+ * @brief Number of units that take duration_ns on an idle machine
+ * @return At least 1 for a positive duration, 0 otherwise
+ */
+unsigned long workload_units_for(const workload_t *workload, long long duration_ns) {
+    if (duration_ns <= 0) {
+        return 0;
+    }
+    double units = (double)duration_ns / workload->ns_per_unit;
+    return units < 1.0 ? 1 : (unsigned long)(units + 0.5);
+}
+
+/**
+ * @brief Run the amount of work calibrated to take duration_ns
+ */
+unsigned long workload_run_for(const workload_t *workload, long long duration_ns) {
+    return workload_run(workload, workload_units_for(workload, duration_ns));
+}
+
+/*============================================================================
+ * NAMES
+ *============================================================================*/
+
+const char *workload_shape_name(workload_shape_t shape) {
+    switch (shape) {
+        case WORKLOAD_CPU:           return "cpu";
+        case WORKLOAD_MEMORY:        return "memory";
+        case WORKLOAD_POINTER_CHASE: return "pointer-chase";
+        default:                     return "unknown";
+    }
+}
+
+/**
+ * @brief Parse "cpu", "memory" or "pointer-chase" (also "chase")
+ * @return 0 on success, EINVAL for an unknown name
+ */
+int workload_parse_shape(const char *name, workload_shape_t *shape) {
+    if (strcmp(name, "cpu") == 0) {
+        *shape = WORKLOAD_CPU;
+    } else if (strcmp(name, "memory") == 0) {
+        *shape = WORKLOAD_MEMORY;
+    } else if (strcmp(name, "pointer-chase") == 0 || strcmp(name, "chase") == 0) {
+        *shape = WORKLOAD_POINTER_CHASE;
+    } else {
+        return EINVAL;
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file workload.h
+ * @brief Calibrated synthetic work of a requested duration and shape
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * An empty `for` loop is no way to simulate a job: at -O2 the compiler
+ * deletes it, and without optimization its duration depends on the
+ * compiler and machine. A workload runs real work the compiler cannot
+ * remove, in one of three shapes:
+ * - CPU:           a dependent chain of integer multiply/xor-shift steps;
+ *                  no memory traffic, scales perfectly with cores
+ * - MEMORY:        sequential read of a buffer much larger than the caches;
+ *                  bound by memory bandwidth, which concurrent threads share
+ * - POINTER_CHASE: dependent loads along a random cycle through the buffer,
+ *                  one cache miss per hop; bound by memory latency
+ *
+ * Work is measured in units (a few hundred nanoseconds each). Creating a
+ * workload calibrates the cost of one unit on the calling thread, so
+ * workload_units_for() turns a duration into a fixed amount of work. The
+ * amount stays fixed when threads run it concurrently: contention for
+ * bandwidth or cores shows up as a longer run, exactly as it would for a
+ * real job.
+ *
+ * The buffer is shared read-only, so one workload may be run by any number
+ * of threads at once. Each thread keeps its own position in the buffer.
+ */
+
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <stddef.h>
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+/** Buffer size used when 0 is passed; well beyond typical last-level caches */
+#define WORKLOAD_DEFAULT_FOOTPRINT (64UL * 1024 * 1024)
+
+/** Wall time spent measuring one calibration sample */
+#define WORKLOAD_CALIBRATION_NS 20000000LL
+
+/** Shape of the generated work */
+typedef enum {
+    WORKLOAD_CPU,
+    WORKLOAD_MEMORY,
+    WORKLOAD_POINTER_CHASE
+} workload_shape_t;
+
+/**
+ * @brief A calibrated workload
+ */
+typedef struct {
+    workload_shape_t shape;
+    void *buffer;               /**< NULL for WORKLOAD_CPU */
+    size_t footprint;           /**< Buffer size in bytes */
+    size_t slots;               /**< 64-byte lines in the buffer */
+    double ns_per_unit;         /**< Calibrated cost of one unit */
+} workload_t;
+
+/*============================================================================
+ * FUNCTION PROTOTYPES
+ *============================================================================*/
+
+int workload_init(workload_t *workload, workload_shape_t shape, size_t footprint);
+void workload_destroy(workload_t *workload);
+
+unsigned long workload_run(const workload_t *workload, unsigned long units);
+unsigned long workload_units_for(const workload_t *workload, long long duration_ns);
+unsigned long workload_run_for(const workload_t *workload, long long duration_ns);
+
+const char *workload_shape_name(workload_shape_t shape);
+int workload_parse_shape(const char *name, workload_shape_t *shape);
+
+#endif /* WORKLOAD_H */
@@ -0,0 +1,177 @@
+/**
+ * @file workload_bench.c
+ * @brief Accuracy and scaling of the calibrated workload shapes
+ * @author Development Team
+ * @date Created: October 2026
+ *
+ * First shows what the old empty busy loop costs at this optimization level
+ * (nothing at -O2: the loop is deleted). Then, for each workload shape:
+ * - calibrated ns per unit
+ * - 1 thread: how long a job calibrated to `duration` actually takes
+ * - T threads: the same fixed amount of work per thread run concurrently;
+ *   the slowdown over the 1-thread time shows how the shape scales
+ *   (CPU work is limited by cores, memory work by shared bandwidth)
+ *
+ * Usage: ./workload_bench [threads] [duration_ms] [footprint_mb]
+ */
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "clock_ns.h"
+#include "futex_sync.h"
+#include "workload.h"
+
+/*============================================================================
+ * CONSTANTS AND TYPES
+ *============================================================================*/
+
+#define DEFAULT_DURATION_MS 100
+#define DEFAULT_FOOTPRINT_MB 64
+#define MAX_BENCH_THREADS 64
+
+/** The loop the demos used to simulate a job */
+#define EMPTY_LOOP_ITERATIONS 0xFFFFFFFFUL
+
+/**
+ * @brief Per-thread results
+ */
+typedef struct {
+    long long elapsed_ns;
+} worker_t;
+
+/*============================================================================
+ * GLOBAL VARIABLES
+ *============================================================================*/
+
+/** Run parameters, read-only while workers run */
+static const workload_t *active_workload = NULL;
+static unsigned long active_units = 0;
+static futex_start_gate_t start_gate;
+
+/*============================================================================
+ * THREAD FUNCTIONS
+ *============================================================================*/
+
+/**
+ * @brief Worker: wait for the common start, then run the job
+ */
+static void *worker_thread(void *arg) {
+    worker_t *worker = (worker_t *)arg;
+
+    futex_start_gate_arrive(&start_gate);
+
+    long long start = now_ns();
+    workload_run(active_workload, active_units);
+    worker->elapsed_ns = now_ns() - start;
+    return NULL;
+}
+
+/**
+ * @brief Run `units` of work on each of `threads` threads at once
+ * @return Mean per-thread job time in nanoseconds
+ */
+static long long run_threads(const workload_t *workload, unsigned long units, int threads) {
+    pthread_t ids[MAX_BENCH_THREADS];
+    worker_t workers[MAX_BENCH_THREADS];
+
+    active_workload = workload;
+    active_units = units;
+    futex_start_gate_init(&start_gate, (unsigned int)threads);
+
+    for (int i = 0; i < threads; i++) {
+        int result = pthread_create(&ids[i], NULL, worker_thread, &workers[i]);
+        if (result != 0) {
+            fprintf(stderr, "Failed to create thread %d: %s\n", i, strerror(result));
+            exit(EXIT_FAILURE); // The gate would never open
+        }
+    }
+
+    futex_start_gate_release(&start_gate);
+
+    long long total = 0;
+    for (int i = 0; i < threads; i++) {
+        pthread_join(ids[i], NULL);
+        total += workers[i].elapsed_ns;
+    }
+    return total / threads;
+}
+
+/*============================================================================
+ * MAIN FUNCTION
+ *============================================================================*/
+
+/**
+ * @brief Main function - calibrates and runs every shape
+ * @return EXIT_SUCCESS on success, EXIT_FAILURE on bad arguments or setup
+ *         failure
+ */
+int main(int argc, char **argv) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int threads = cpus > 2 ? (int)cpus : 2;
+    long duration_ms = DEFAULT_DURATION_MS;
+    long footprint_mb = DEFAULT_FOOTPRINT_MB;
+
+    if (argc > 1) {
+        threads = (int)strtol(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        duration_ms = strtol(argv[2], NULL, 10);
+    }
+    if (argc > 3) {
+        footprint_mb = strtol(argv[3], NULL, 10);
+    }
+    if (threads < 1 || threads > MAX_BENCH_THREADS || duration_ms <= 0 || footprint_mb <= 0) {
+        fprintf(stderr, "Usage: %s [threads 1..%d] [duration_ms > 0] [footprint_mb > 0]\n",
+                argv[0], MAX_BENCH_THREADS);
+        return EXIT_FAILURE;
+    }
+
+    printf("========================================================\n");
+    printf("    CALIBRATED WORKLOAD BENCHMARK\n");
+    printf("========================================================\n");
+    printf("Threads: %d, online CPUs: %ld, job duration: %ld ms, footprint: %ld MiB\n\n",
+           threads, cpus, duration_ms, footprint_mb);
+
+    long long start = now_ns();
+    for (unsigned long i = 0; i < EMPTY_LOOP_ITERATIONS; i++) {
+        // The old simulated job
+    }
+    printf("Empty loop of 0x%lX iterations: %.3f ms\n\n", EMPTY_LOOP_ITERATIONS,
+           (double)(now_ns() - start) / 1e6);
+
+    printf("%-14s %10s %12s %12s %9s %12s %9s\n", "shape", "ns/unit", "units",
+           "1T ms", "error", "NT ms", "slowdown");
+
+    const workload_shape_t shapes[] = { WORKLOAD_CPU, WORKLOAD_MEMORY, WORKLOAD_POINTER_CHASE };
+    long long duration_ns = duration_ms * 1000000LL;
+
+    for (size_t s = 0; s < sizeof(shapes) / sizeof(shapes[0]); s++) {
+        workload_t workload;
+        int result = workload_init(&workload, shapes[s], (size_t)footprint_mb << 20);
+        if (result != 0) {
+            fprintf(stderr, "Failed to set up %s workload: %s\n",
+                    workload_shape_name(shapes[s]), strerror(result));
+            return EXIT_FAILURE;
+        }
+
+        unsigned long units = workload_units_for(&workload, duration_ns);
+        long long single = run_threads(&workload, units, 1);
+        long long multi = run_threads(&workload, units, threads);
+
+        printf("%-14s %10.1f %12lu %12.2f %8.1f%% %12.2f %8.2fx\n",
+               workload_shape_name(shapes[s]), workload.ns_per_unit, units,
+               (double)single / 1e6,
+               100.0 * (double)(single - duration_ns) / (double)duration_ns,
+               (double)multi / 1e6, (double)multi / (double)single);
+
+        workload_destroy(&workload);
+    }
+
+    return EXIT_SUCCESS;
+}